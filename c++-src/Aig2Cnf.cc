@@ -22,15 +22,38 @@ SatSolver::add_aig(
   const LitMap& lit_map
 )
 {
-  Aig2Cnf aig2cnf(*this, lit_map);
+  // 同じ LitMap と条件リテラルのもとで変換したことがあれば
+  // その結果を再利用する．
+  auto cond_lits = mConditionalLits;
+  sort(cond_lits.begin(), cond_lits.end());
+  Aig2Cnf* aig2cnf = nullptr;
+  for ( auto& p: mAig2CnfList ) {
+    if ( p->match(lit_map, cond_lits) ) {
+      aig2cnf = p.get();
+      break;
+    }
+  }
+  if ( aig2cnf == nullptr ) {
+    mAig2CnfList.push_back(std::make_unique<Aig2Cnf>(*this, lit_map, cond_lits));
+    aig2cnf = mAig2CnfList.back().get();
+  }
+
   vector<vector<SatLiteral>> lits_list;
+  lits_list.reserve(aig_list.size());
   for ( auto& aig: aig_list ) {
-    auto lits = aig2cnf.make_cnf(aig);
+    auto lits = aig2cnf->make_cnf(aig);
     lits_list.push_back(lits);
   }
   return lits_list;
 }
 
+// @brief add_aig() の変換結果をすべて捨てる．
+void
+SatSolver::clear_aig_cache()
+{
+  mAig2CnfList.clear();
+}
+
 
 //////////////////////////////////////////////////////////////////////
 // クラス Aig2Cnf
@@ -42,14 +65,48 @@ Aig2Cnf::make_cnf(
   const AigHandle& aig
 )
 {
-  // 境界条件
+  mFull = mSolver.tseitin_encoding();
+  mReqStack.clear();
+
+  vector<SatLiteral> lits;
+  if ( aig.is_and() && !aig.inv() ) {
+    // AND
+    // すべてのファンインのリテラルが成り立つ必要がある．
+    auto fanin_list = aig.ex_fanin_list();
+    lits.reserve(fanin_list.size());
+    for ( auto& h: fanin_list ) {
+      SatLiteral lit;
+      if ( handle_lit(h, lit) ) {
+	lits.push_back(lit);
+	request(h);
+      }
+    }
+  }
+  else {
+    SatLiteral lit;
+    if ( handle_lit(aig, lit) ) {
+      lits.push_back(lit);
+      request(aig);
+    }
+  }
+  encode();
+  return lits;
+}
+
+// @brief ハンドルに対応するリテラルを得る．
+SizeType
+Aig2Cnf::handle_lit(
+  const AigHandle& aig,
+  SatLiteral& lit
+)
+{
   if ( aig.is_zero() ) {
     // 定数０は充足不可
     throw std::logic_error{"aig is zero"};
   }
   if ( aig.is_one() ) {
     // 定数１は常に充足している．
-    return {};
+    return 0;
   }
   if ( aig.is_input() ) {
     // 対応するリテラルを返す．
@@ -60,75 +117,90 @@ Aig2Cnf::make_cnf(
       buf << "input_id[" << input_id << "] is not registered";
       throw std::logic_error{buf.str()};
     }
-    auto lit = mLitMap.at(input_id);
-    if ( aig.inv() ) {
-      lit = ~lit;
+    lit = mLitMap.at(input_id);
+  }
+  else {
+    // aig.is_and()
+    auto node = aig.inv() ? ~aig : aig;
+    auto p = mAigDict.find(node);
+    if ( p == mAigDict.end() ) {
+      NodeInfo info;
+      info.mLit = mSolver.new_variable(true);
+      p = mAigDict.emplace(node, info).first;
     }
-    return {lit};
+    lit = p->second.mLit;
   }
-
-  if ( mAigDict.count(aig) > 0 ) {
-    // すでに計算済みならその結果を返す．
-    auto lits = mAigDict.at(aig);
-    return lits;
+  if ( aig.inv() ) {
+    lit = ~lit;
   }
+  return 1;
+}
 
-  // aig.is_and()
-  auto fanin_list = aig.ex_fanin_list();
-
-  // 結果のリテラルを格納するリスト
-  vector<SatLiteral> lits;
-  if ( aig.inv() ) {
-    // NAND
-    // いずれかのファンインが成り立たなければよい．
-    lits.reserve(1);
-    auto lit = mSolver.new_variable(true);
-    SizeType ni = fanin_list.size();
-    vector<SatLiteral> tmp_lits;
-    tmp_lits.reserve(ni + 1);
-    tmp_lits.push_back(~lit);
-    for ( SizeType i = 0; i < ni; ++ i ) {
-      auto h = fanin_list[i];
-      auto lits1 = make_cnf(~h);
-      if ( lits1.empty() ) {
-	// たぶんないはず
-	continue;
-      }
-      if ( lits1.size() == 1 ) {
-	auto lit1 = lits1.front();
-	tmp_lits.push_back(lit1);
-      }
-      else {
-	auto lit1 = mSolver.new_variable(false);
-	for ( auto lit2: lits1 ) {
-	  mSolver.add_clause(~lit1, lit2);
-	}
-	tmp_lits.push_back(lit1);
-      }
+// @brief 要求された節を生成する．
+void
+Aig2Cnf::encode()
+{
+  while ( !mReqStack.empty() ) {
+    auto aig = mReqStack.back();
+    mReqStack.pop_back();
+    auto node = aig.inv() ? ~aig : aig;
+    // unordered_map の要素への参照は挿入によって無効にならない．
+    auto& info = mAigDict.at(node);
+    bool done = true;
+    if ( (mFull || !aig.inv()) && !info.mPosDone ) {
+      info.mPosDone = true;
+      make_pos(node, info.mLit);
+      done = false;
     }
-    mSolver.add_clause(tmp_lits);
-    lits.push_back(lit);
-  }
-  else {
-    // AND
-    // すべてのファンインのリテラルが成り立つ必要がある．
-    vector<vector<SatLiteral>> lits_list;
-    lits_list.reserve(fanin_list.size());
-    for ( auto& h: fanin_list ) {
-      auto lits = make_cnf(h);
-      lits_list.push_back(lits);
+    if ( (mFull || aig.inv()) && !info.mNegDone ) {
+      info.mNegDone = true;
+      make_neg(node, info.mLit);
+      done = false;
     }
-    SizeType n = 0;
-    for ( auto& lits: lits_list ) {
-      n += lits.size();
+    if ( done ) {
+      // すでに計算済み
+      ++ mHitNum;
     }
-    lits.reserve(n);
-    for ( auto& lits1: lits_list ) {
-      lits.insert(lits.end(), lits1.begin(), lits1.end());
+  }
+}
+
+// @brief 正の極性の節を生成する．
+void
+Aig2Cnf::make_pos(
+  const AigHandle& node,
+  SatLiteral lit
+)
+{
+  // lit が成り立つ時はすべてのファンインが成り立つ．
+  for ( auto& h: node.ex_fanin_list() ) {
+    SatLiteral lit1;
+    if ( handle_lit(h, lit1) ) {
+      mSolver.add_clause(~lit, lit1);
+      request(h);
     }
   }
-  mAigDict.emplace(aig, lits);
-  return lits;
+}
+
+// @brief 負の極性の節を生成する．
+void
+Aig2Cnf::make_neg(
+  const AigHandle& node,
+  SatLiteral lit
+)
+{
+  // ~lit が成り立つ時はいずれかのファンインが成り立たない．
+  auto fanin_list = node.ex_fanin_list();
+  mTmpLits.clear();
+  mTmpLits.reserve(fanin_list.size() + 1);
+  mTmpLits.push_back(lit);
+  for ( auto& h: fanin_list ) {
+    SatLiteral lit1;
+    if ( handle_lit(h, lit1) ) {
+      mTmpLits.push_back(~lit1);
+      request(~h);
+    }
+  }
+  mSolver.add_clause(mTmpLits);
 }
 
 END_NAMESPACE_YM_SAT
@@ -17,6 +17,20 @@ BEGIN_NAMESPACE_YM_SAT
 //////////////////////////////////////////////////////////////////////
 /// @class Aig2Cnf Aig2Cnf.h "Aig2Cnf.h"
 /// @brief AIG を CNF に変換する補助クラス
+///
+/// 変換結果は SatSolver 側で保持され，同じ LitMap と条件リテラルの
+/// 組み合わせで add_aig() が呼ばれた場合には再利用される．
+/// 条件リテラルのもとで生成された節はその条件のもとでしか
+/// 成り立たないので，条件リテラルが異なる場合は別のオブジェクトとなる．
+///
+/// AND ノードごとに1つの変数を割り当て，その変数が正(AND が成り立つ)
+/// の時の節と負の時の節を別々に生成する．
+/// 通常は実際に用いられる極性の節のみを生成する(Plaisted-Greenbaum 符号化)
+/// が，SatSolver::tseitin_encoding() が true の場合は両方を生成する
+/// (Tseitin 符号化)．
+/// 両方の極性で用いられるノードは結果的に両方の節を持つことになる．
+/// 深い AIG でもスタックを溢れさせないように，節の生成は明示的な
+/// 作業スタックを用いて行う．
 //////////////////////////////////////////////////////////////////////
 class Aig2Cnf
 {
@@ -29,10 +43,12 @@ public:
 
   /// @brief コンストラクタ
   Aig2Cnf(
-    SatSolver& solver,    ///< [in] SATソルバ
-    const LitMap& lit_map ///< [in] AIG の入力番号とリテラルの対応関係を表す辞書
+    SatSolver& solver,                  ///< [in] SATソルバ
+    const LitMap& lit_map,              ///< [in] AIG の入力番号とリテラルの対応関係を表す辞書
+    const vector<SatLiteral>& cond_lits ///< [in] 条件リテラルのリスト(ソート済み)
   ) : mSolver{solver},
-      mLitMap{lit_map}
+      mLitMap{lit_map},
+      mCondLits{cond_lits}
   {
   }
 
@@ -49,12 +65,99 @@ public:
   /// @return リテラルのリストを返す．
   ///
   /// - 与えられた AIG の値が 1 となる条件を表すリテラルを返す．
-  /// - 否定しても 0 となる条件にはならないことに注意
+  /// - Plaisted-Greenbaum 符号化の場合，否定しても 0 となる条件には
+  ///   ならないことに注意
   vector<SatLiteral>
   make_cnf(
     const AigHandle& aig
   );
 
+  /// @brief 生成時の LitMap と条件リテラルが等しい時 true を返す．
+  bool
+  match(
+    const LitMap& lit_map,              ///< [in] AIG の入力番号とリテラルの対応関係を表す辞書
+    const vector<SatLiteral>& cond_lits ///< [in] 条件リテラルのリスト(ソート済み)
+  ) const
+  {
+    return mCondLits == cond_lits && mLitMap == lit_map;
+  }
+
+  /// @brief 変換済みの結果を再利用した回数を返す．
+  SizeType
+  hit_num() const
+  {
+    return mHitNum;
+  }
+
+  /// @brief 変数を割り当てたノード数を返す．
+  SizeType
+  miss_num() const
+  {
+    return mAigDict.size();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // AND ノードの情報
+  struct NodeInfo
+  {
+    SatLiteral mLit;       // 対応するリテラル
+    bool mPosDone{false};  // 正の極性の節を生成済みの時 true
+    bool mNegDone{false};  // 負の極性の節を生成済みの時 true
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハンドルに対応するリテラルを得る．
+  /// @return リテラル数(0 か 1)を返す．
+  ///
+  /// - 定数1の場合は 0 を返す．
+  /// - 入力の場合は対応するリテラルを返す．
+  /// - AND ノードの場合は必要なら変数を割り当てる．
+  ///   節は生成しない．
+  SizeType
+  handle_lit(
+    const AigHandle& aig, ///< [in] 対象のハンドル
+    SatLiteral& lit       ///< [out] 結果のリテラル
+  );
+
+  /// @brief aig のリテラルが aig を含意する節を要求する．
+  void
+  request(
+    const AigHandle& aig ///< [in] 対象のハンドル
+  )
+  {
+    if ( aig.is_and() ) {
+      mReqStack.push_back(aig);
+    }
+  }
+
+  /// @brief 要求された節を生成する．
+  void
+  encode();
+
+  /// @brief 正の極性の節を生成する．
+  void
+  make_pos(
+    const AigHandle& node, ///< [in] 対象のノード(反転なし)
+    SatLiteral lit         ///< [in] ノードのリテラル
+  );
+
+  /// @brief 負の極性の節を生成する．
+  void
+  make_neg(
+    const AigHandle& node, ///< [in] 対象のノード(反転なし)
+    SatLiteral lit         ///< [in] ノードのリテラル
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -67,8 +170,23 @@ private:
   // 入力番号とリテラルの対応関係を表す辞書
   LitMap mLitMap;
 
-  // AigHandle をキーにして対応する SatLiteral のリストを記憶する辞書
-  std::unordered_map<AigHandle, vector<SatLiteral>> mAigDict;
+  // 生成時の条件リテラルのリスト(ソート済み)
+  vector<SatLiteral> mCondLits;
+
+  // 変換済みの結果を再利用した回数
+  SizeType mHitNum{0};
+
+  // 反転なしの AND ノードのハンドルをキーにしてノードの情報を記憶する辞書
+  std::unordered_map<AigHandle, NodeInfo> mAigDict;
+
+  // 節の生成を要求されたハンドルのスタック
+  vector<AigHandle> mReqStack;
+
+  // 節を作るための作業領域
+  vector<SatLiteral> mTmpLits;
+
+  // 両方の極性の節を生成する時 true
+  bool mFull{false};
 
 };
 
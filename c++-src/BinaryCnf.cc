@@ -0,0 +1,189 @@
+
+/// @file BinaryCnf.cc
+/// @brief BinaryCnfWriter/BinaryCnfReader の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BinaryCnf.h"
+#include <climits>
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// 64ビットの値をリトルエンディアンで書き込む．
+void
+put_u64(
+  string& buff,
+  std::uint64_t val
+)
+{
+  for ( int i = 0; i < 8; ++ i ) {
+    buff.push_back(static_cast<char>((val >> (i * 8)) & 0xff));
+  }
+}
+
+// 64ビットの値をリトルエンディアンで読み出す．
+std::uint64_t
+get_u64(
+  const char* p
+)
+{
+  std::uint64_t val = 0;
+  for ( int i = 0; i < 8; ++ i ) {
+    val |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (i * 8);
+  }
+  return val;
+}
+
+// DIMACS 形式のリテラルを符号化する．
+inline
+std::uint64_t
+encode_lit(
+  int lit
+)
+{
+  if ( lit > 0 ) {
+    return static_cast<std::uint64_t>(lit - 1) * 2;
+  }
+  return static_cast<std::uint64_t>(- static_cast<std::int64_t>(lit) - 1) * 2 + 1;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BinaryCnfWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BinaryCnfWriter::BinaryCnfWriter(
+  ostream& s,
+  SizeType var_num,
+  SizeType clause_num,
+  SizeType literal_num
+) : mS{s}
+{
+  mBuff.append(BINARY_CNF_MAGIC, sizeof(BINARY_CNF_MAGIC));
+  put_u64(mBuff, var_num);
+  put_u64(mBuff, clause_num);
+  put_u64(mBuff, literal_num);
+}
+
+// @brief DIMACS 形式のリテラルのリストで表された節を出力する．
+void
+BinaryCnfWriter::put_clause(
+  const vector<int>& lits
+)
+{
+  put_varint(lits.size());
+  std::uint64_t prev = 0;
+  for ( auto lit: lits ) {
+    put_code(encode_lit(lit), prev);
+  }
+  check_flush();
+}
+
+// @brief SatLiteral の配列で表された節を出力する．
+void
+BinaryCnfWriter::put_clause(
+  const SatLiteral* begin,
+  const SatLiteral* end
+)
+{
+  put_varint(end - begin);
+  std::uint64_t prev = 0;
+  for ( auto p = begin; p != end; ++ p ) {
+    auto lit = *p;
+    put_code(static_cast<std::uint64_t>(lit.varid()) * 2 + (lit.is_negative() ? 1 : 0), prev);
+  }
+  check_flush();
+}
+
+// @brief バッファの内容を書き出す．
+void
+BinaryCnfWriter::flush()
+{
+  if ( !mBuff.empty() ) {
+    mS.write(mBuff.data(), mBuff.size());
+    mBuff.clear();
+  }
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BinaryCnfReader
+//////////////////////////////////////////////////////////////////////
+
+// @brief バイナリ CNF 形式のデータの時 true を返す．
+bool
+BinaryCnfReader::check_magic(
+  const char* begin,
+  const char* end
+)
+{
+  return static_cast<SizeType>(end - begin) >= sizeof(BINARY_CNF_MAGIC)
+    && memcmp(begin, BINARY_CNF_MAGIC, sizeof(BINARY_CNF_MAGIC)) == 0;
+}
+
+// @brief コンストラクタ
+BinaryCnfReader::BinaryCnfReader(
+  const char* begin,
+  const char* end
+) : mCur{begin},
+    mEnd{end}
+{
+  if ( static_cast<SizeType>(end - begin) < BINARY_CNF_HEADER_SIZE ||
+       !check_magic(begin, end) ) {
+    mError = true;
+    return;
+  }
+  mVarNum = get_u64(begin + 8);
+  mClauseNum = get_u64(begin + 16);
+  mLiteralNum = get_u64(begin + 24);
+  mCur = begin + BINARY_CNF_HEADER_SIZE;
+}
+
+// @brief 次の節を読み込む．
+bool
+BinaryCnfReader::read_clause(
+  vector<int>& lits
+)
+{
+  lits.clear();
+  if ( mError || mCur == mEnd ) {
+    return false;
+  }
+  std::uint64_t n;
+  if ( !get_varint(n) || n > static_cast<SizeType>(mEnd - mCur) ) {
+    // 1リテラルあたり少なくとも1バイトはあるはず
+    mError = true;
+    return false;
+  }
+  lits.reserve(n);
+  std::uint64_t prev = 0;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    std::uint64_t zz;
+    if ( !get_varint(zz) ) {
+      mError = true;
+      return false;
+    }
+    auto d = static_cast<std::int64_t>(zz >> 1) ^ - static_cast<std::int64_t>(zz & 1);
+    auto code = prev + static_cast<std::uint64_t>(d);
+    prev = code;
+    auto var = code / 2;
+    if ( var >= static_cast<std::uint64_t>(INT_MAX) ) {
+      mError = true;
+      return false;
+    }
+    int lit = static_cast<int>(var + 1);
+    lits.push_back((code & 1) ? - lit : lit);
+  }
+  return true;
+}
+
+END_NAMESPACE_YM_SAT
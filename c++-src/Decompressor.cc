@@ -0,0 +1,353 @@
+
+/// @file Decompressor.cc
+/// @brief Decompressor の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Decompressor.h"
+#include <climits>
+#include <cstring>
+
+#if defined(YM_SAT_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(YM_SAT_HAVE_BZIP2)
+#include <bzlib.h>
+#endif
+#if defined(YM_SAT_HAVE_LZMA)
+#include <lzma.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// 1回の呼び出しで zlib/bzip2 に渡せる最大サイズ
+const SizeType MAX_CHUNK = UINT_MAX;
+
+#if defined(YM_SAT_HAVE_ZLIB)
+
+// gzip 形式の展開を行うクラス
+class GzDecompressor :
+  public Decompressor
+{
+public:
+
+  GzDecompressor(
+    const char* begin,
+    const char* end
+  ) : mNext{begin},
+      mEnd{end}
+  {
+    memset(&mStream, 0, sizeof(mStream));
+    // 15 + 32 で gzip/zlib のヘッダを自動判定する．
+    mOk = inflateInit2(&mStream, 15 + 32) == Z_OK;
+  }
+
+  ~GzDecompressor()
+  {
+    inflateEnd(&mStream);
+  }
+
+  const char*
+  name() const override
+  {
+    return "gzip";
+  }
+
+  bool
+  decode(
+    char* buf,
+    SizeType size,
+    SizeType& out_size
+  ) override
+  {
+    out_size = 0;
+    if ( !mOk ) {
+      return false;
+    }
+    while ( out_size < size ) {
+      if ( mStream.avail_in == 0 ) {
+	if ( mNext == mEnd ) {
+	  if ( !mStreamEnd ) {
+	    // 途中で終わっている．
+	    mOk = false;
+	  }
+	  break;
+	}
+	auto n = std::min<SizeType>(mEnd - mNext, MAX_CHUNK);
+	mStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(mNext));
+	mStream.avail_in = n;
+	mNext += n;
+      }
+      if ( mStreamEnd ) {
+	// 連結された次のストリームに進む．
+	inflateReset(&mStream);
+	mStreamEnd = false;
+      }
+      auto n = std::min<SizeType>(size - out_size, MAX_CHUNK);
+      mStream.next_out = reinterpret_cast<Bytef*>(buf + out_size);
+      mStream.avail_out = n;
+      auto ret = inflate(&mStream, Z_NO_FLUSH);
+      out_size += n - mStream.avail_out;
+      if ( ret == Z_STREAM_END ) {
+	mStreamEnd = true;
+      }
+      else if ( ret != Z_OK ) {
+	mOk = false;
+	break;
+      }
+    }
+    return mOk;
+  }
+
+private:
+
+  // zlib のストリーム
+  z_stream mStream;
+
+  // まだ渡していない入力の先頭
+  const char* mNext;
+
+  // 入力の末尾
+  const char* mEnd;
+
+  // ストリームの終わりに達したら true にするフラグ
+  bool mStreamEnd{false};
+
+  // 正常なら true
+  bool mOk;
+
+};
+
+#endif
+
+#if defined(YM_SAT_HAVE_BZIP2)
+
+// bzip2 形式の展開を行うクラス
+class Bz2Decompressor :
+  public Decompressor
+{
+public:
+
+  Bz2Decompressor(
+    const char* begin,
+    const char* end
+  ) : mNext{begin},
+      mEnd{end}
+  {
+    memset(&mStream, 0, sizeof(mStream));
+    mOk = BZ2_bzDecompressInit(&mStream, 0, 0) == BZ_OK;
+  }
+
+  ~Bz2Decompressor()
+  {
+    BZ2_bzDecompressEnd(&mStream);
+  }
+
+  const char*
+  name() const override
+  {
+    return "bzip2";
+  }
+
+  bool
+  decode(
+    char* buf,
+    SizeType size,
+    SizeType& out_size
+  ) override
+  {
+    out_size = 0;
+    if ( !mOk ) {
+      return false;
+    }
+    while ( out_size < size ) {
+      if ( mStream.avail_in == 0 ) {
+	if ( mNext == mEnd ) {
+	  if ( !mStreamEnd ) {
+	    mOk = false;
+	  }
+	  break;
+	}
+	auto n = std::min<SizeType>(mEnd - mNext, MAX_CHUNK);
+	mStream.next_in = const_cast<char*>(mNext);
+	mStream.avail_in = n;
+	mNext += n;
+      }
+      if ( mStreamEnd ) {
+	// 連結された次のストリームに進む．
+	BZ2_bzDecompressEnd(&mStream);
+	auto next_in = mStream.next_in;
+	auto avail_in = mStream.avail_in;
+	memset(&mStream, 0, sizeof(mStream));
+	if ( BZ2_bzDecompressInit(&mStream, 0, 0) != BZ_OK ) {
+	  mOk = false;
+	  break;
+	}
+	mStream.next_in = next_in;
+	mStream.avail_in = avail_in;
+	mStreamEnd = false;
+      }
+      auto n = std::min<SizeType>(size - out_size, MAX_CHUNK);
+      mStream.next_out = buf + out_size;
+      mStream.avail_out = n;
+      auto ret = BZ2_bzDecompress(&mStream);
+      out_size += n - mStream.avail_out;
+      if ( ret == BZ_STREAM_END ) {
+	mStreamEnd = true;
+      }
+      else if ( ret != BZ_OK ) {
+	mOk = false;
+	break;
+      }
+    }
+    return mOk;
+  }
+
+private:
+
+  // bzip2 のストリーム
+  bz_stream mStream;
+
+  // まだ渡していない入力の先頭
+  const char* mNext;
+
+  // 入力の末尾
+  const char* mEnd;
+
+  // ストリームの終わりに達したら true にするフラグ
+  bool mStreamEnd{false};
+
+  // 正常なら true
+  bool mOk;
+
+};
+
+#endif
+
+#if defined(YM_SAT_HAVE_LZMA)
+
+// xz 形式の展開を行うクラス
+class XzDecompressor :
+  public Decompressor
+{
+public:
+
+  XzDecompressor(
+    const char* begin,
+    const char* end
+  )
+  {
+    mOk = lzma_stream_decoder(&mStream, UINT64_MAX, LZMA_CONCATENATED) == LZMA_OK;
+    // 入力は全てメモリ上にあるので最初から全部渡してしまう．
+    mStream.next_in = reinterpret_cast<const uint8_t*>(begin);
+    mStream.avail_in = end - begin;
+  }
+
+  ~XzDecompressor()
+  {
+    lzma_end(&mStream);
+  }
+
+  const char*
+  name() const override
+  {
+    return "xz";
+  }
+
+  bool
+  decode(
+    char* buf,
+    SizeType size,
+    SizeType& out_size
+  ) override
+  {
+    out_size = 0;
+    if ( !mOk ) {
+      return false;
+    }
+    if ( mStreamEnd ) {
+      return true;
+    }
+    mStream.next_out = reinterpret_cast<uint8_t*>(buf);
+    mStream.avail_out = size;
+    while ( mStream.avail_out > 0 ) {
+      auto ret = lzma_code(&mStream, LZMA_FINISH);
+      if ( ret == LZMA_STREAM_END ) {
+	mStreamEnd = true;
+	break;
+      }
+      if ( ret != LZMA_OK ) {
+	mOk = false;
+	break;
+      }
+    }
+    out_size = size - mStream.avail_out;
+    return mOk;
+  }
+
+private:
+
+  // lzma のストリーム
+  lzma_stream mStream = LZMA_STREAM_INIT;
+
+  // ストリームの終わりに達したら true にするフラグ
+  bool mStreamEnd{false};
+
+  // 正常なら true
+  bool mOk;
+
+};
+
+#endif
+
+// data が magic で始まっていたら true を返す．
+bool
+check_magic(
+  const char* begin,
+  const char* end,
+  const char* magic,
+  SizeType size
+)
+{
+  return static_cast<SizeType>(end - begin) >= size && memcmp(begin, magic, size) == 0;
+}
+
+END_NONAMESPACE
+
+// @brief データの形式を調べて対応するオブジェクトを生成する．
+unique_ptr<Decompressor>
+Decompressor::new_obj(
+  const char* begin,
+  const char* end
+)
+{
+  if ( check_magic(begin, end, "\x1f\x8b", 2) ) {
+#if defined(YM_SAT_HAVE_ZLIB)
+    return unique_ptr<Decompressor>{new GzDecompressor{begin, end}};
+#else
+    throw std::invalid_argument{"gzip format is not supported"};
+#endif
+  }
+  if ( check_magic(begin, end, "BZh", 3) ) {
+#if defined(YM_SAT_HAVE_BZIP2)
+    return unique_ptr<Decompressor>{new Bz2Decompressor{begin, end}};
+#else
+    throw std::invalid_argument{"bzip2 format is not supported"};
+#endif
+  }
+  if ( check_magic(begin, end, "\xfd" "7zXZ\0", 6) ) {
+#if defined(YM_SAT_HAVE_LZMA)
+    return unique_ptr<Decompressor>{new XzDecompressor{begin, end}};
+#else
+    throw std::invalid_argument{"xz format is not supported"};
+#endif
+  }
+  return nullptr;
+}
+
+END_NAMESPACE_YM_SAT
@@ -0,0 +1,824 @@
+
+/// @file DimacsParser.cc
+/// @brief DimacsParser の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "DimacsParser.h"
+#include "Decompressor.h"
+#include "BinaryCnf.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <climits>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DIMACS_USE_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#define DIMACS_USE_MMAP 0
+#endif
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// 1スレッドあたりのチャンクの最小サイズ
+const SizeType MIN_CHUNK_SIZE = 4 * 1024 * 1024;
+
+// 圧縮データを展開する単位
+const SizeType BLOCK_SIZE = 1024 * 1024;
+
+// 展開済みで字句解析を待っているブロック数の上限
+const SizeType MAX_QUEUE = 4;
+
+// 字句解析の状態
+struct ScanState
+{
+  // 読み込んだ改行の数
+  SizeType mLineNum{0};
+
+  // ヘッダを読み込んだら true にするフラグ
+  bool mHasHeader{false};
+
+  // ヘッダの行番号
+  SizeType mHeaderLine{0};
+
+  // 宣言された変数の数
+  SizeType mDecVarNum{0};
+
+  // 宣言された節の数
+  SizeType mDecClauseNum{0};
+
+  // '%' で終わったら true にするフラグ
+  bool mEnd{false};
+
+  // エラーメッセージ
+  // 空ならエラーなし
+  string mError;
+
+  // エラーの行番号
+  SizeType mErrorLine{0};
+
+  // 変数番号の最大値
+  SizeType mMaxVar{0};
+};
+
+// 節ごとに関数を呼び出す出力先
+struct DirectSink
+{
+  // コンストラクタ
+  DirectSink(
+    const DimacsParser::ClauseFunc& func
+  ) : mFunc{func}
+  {
+  }
+
+  void
+  lit(
+    int l
+  )
+  {
+    mLits.push_back(l);
+  }
+
+  void
+  end_clause()
+  {
+    mFunc(mLits);
+    mLits.clear();
+    ++ mClauseNum;
+  }
+
+  // 節を受け取る関数
+  const DimacsParser::ClauseFunc& mFunc;
+
+  // 読み込み中の節のリテラル
+  vector<int> mLits;
+
+  // 節の数
+  SizeType mClauseNum{0};
+};
+
+// 0 を区切りとしてリテラルを平坦に並べる出力先
+struct FlatSink
+{
+  void
+  lit(
+    int l
+  )
+  {
+    mLits.push_back(l);
+  }
+
+  void
+  end_clause()
+  {
+    mLits.push_back(0);
+  }
+
+  // リテラルのリスト
+  vector<int> mLits;
+};
+
+inline
+bool
+is_space(
+  char c
+)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline
+bool
+is_digit(
+  char c
+)
+{
+  return '0' <= c && c <= '9';
+}
+
+// 空白を読み飛ばす．
+inline
+const char*
+skip_space(
+  const char* p,
+  const char* end
+)
+{
+  while ( p < end && is_space(*p) ) {
+    ++ p;
+  }
+  return p;
+}
+
+// 符号なし整数を読み込む．
+// 読み込めなかったら nullptr を返す．
+inline
+const char*
+read_number(
+  const char* p,
+  const char* end,
+  std::int64_t& val
+)
+{
+  if ( p == end || !is_digit(*p) ) {
+    return nullptr;
+  }
+  val = 0;
+  for ( ; p < end && is_digit(*p); ++ p ) {
+    val = val * 10 + (*p - '0');
+    if ( val > INT_MAX ) {
+      return nullptr;
+    }
+  }
+  if ( p < end && !is_space(*p) && *p != '\n' ) {
+    // "12abc" のような場合
+    return nullptr;
+  }
+  return p;
+}
+
+// "p cnf <nv> <nc>" の行を読み込む．
+// p は 'p' の次の位置を指している．
+// 失敗したら nullptr を返す．
+const char*
+read_header(
+  const char* p,
+  const char* end,
+  ScanState& st
+)
+{
+  auto q = skip_space(p, end);
+  if ( q == p || end - q < 3 || strncmp(q, "cnf", 3) != 0 ) {
+    return nullptr;
+  }
+  p = q + 3;
+  q = skip_space(p, end);
+  if ( q == p ) {
+    return nullptr;
+  }
+  std::int64_t nv;
+  p = read_number(q, end, nv);
+  if ( p == nullptr ) {
+    return nullptr;
+  }
+  q = skip_space(p, end);
+  if ( q == p ) {
+    return nullptr;
+  }
+  std::int64_t nc;
+  p = read_number(q, end, nc);
+  if ( p == nullptr ) {
+    return nullptr;
+  }
+  p = skip_space(p, end);
+  if ( p < end && *p != '\n' ) {
+    return nullptr;
+  }
+  st.mDecVarNum = nv;
+  st.mDecClauseNum = nc;
+  return p;
+}
+
+// [p, end) の字句解析を行う．
+//
+// p は行頭を指していなければならない．
+// エラーが起きるか '%' の行を読んだらそこで終わる．
+template<typename Sink>
+void
+scan(
+  const char* p,
+  const char* end,
+  Sink& sink,
+  ScanState& st
+)
+{
+  while ( p < end ) {
+    auto c = *p;
+    if ( c == 'c' ) {
+      // コメント行
+      auto q = static_cast<const char*>(memchr(p, '\n', end - p));
+      if ( q == nullptr ) {
+	break;
+      }
+      p = q + 1;
+      ++ st.mLineNum;
+      continue;
+    }
+    if ( c == 'p' ) {
+      auto lineno = st.mLineNum + 1;
+      if ( st.mHasHeader ) {
+	st.mError = "duplicated 'p' block";
+	st.mErrorLine = lineno;
+	return;
+      }
+      p = read_header(p + 1, end, st);
+      if ( p == nullptr ) {
+	st.mError = "syntax error";
+	st.mErrorLine = lineno;
+	return;
+      }
+      st.mHasHeader = true;
+      st.mHeaderLine = lineno;
+    }
+    else if ( c == '%' ) {
+      st.mEnd = true;
+      return;
+    }
+    else {
+      // 行末までリテラルを読み込む．
+      while ( p < end && *p != '\n' ) {
+	c = *p;
+	if ( is_space(c) ) {
+	  ++ p;
+	  continue;
+	}
+	bool neg = false;
+	if ( c == '-' ) {
+	  neg = true;
+	  ++ p;
+	}
+	std::int64_t val;
+	p = read_number(p, end, val);
+	if ( p == nullptr ) {
+	  st.mError = "syntax error";
+	  st.mErrorLine = st.mLineNum + 1;
+	  return;
+	}
+	if ( val == 0 ) {
+	  sink.end_clause();
+	}
+	else {
+	  if ( st.mMaxVar < static_cast<SizeType>(val) ) {
+	    st.mMaxVar = val;
+	  }
+	  sink.lit(neg ? -val : val);
+	}
+      }
+    }
+    if ( p < end ) {
+      // 改行を読み飛ばす．
+      ++ p;
+      ++ st.mLineNum;
+    }
+  }
+}
+
+// 最終行の行番号を求める．
+SizeType
+last_lineno(
+  const char* begin,
+  const char* end,
+  SizeType newline_num
+)
+{
+  if ( begin < end && *(end - 1) != '\n' ) {
+    return newline_num + 1;
+  }
+  return newline_num;
+}
+
+#if DIMACS_USE_MMAP
+
+// メモリマップしたファイル
+class MappedFile
+{
+public:
+
+  // コンストラクタ
+  MappedFile(
+    const string& filename
+  )
+  {
+    mFd = open(filename.c_str(), O_RDONLY);
+    if ( mFd < 0 ) {
+      return;
+    }
+    struct stat sb;
+    if ( fstat(mFd, &sb) < 0 ) {
+      return;
+    }
+    mSize = sb.st_size;
+    if ( mSize == 0 ) {
+      mOk = true;
+      return;
+    }
+    auto addr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mFd, 0);
+    if ( addr == MAP_FAILED ) {
+      return;
+    }
+    mAddr = static_cast<const char*>(addr);
+    madvise(addr, mSize, MADV_SEQUENTIAL);
+    mOk = true;
+  }
+
+  // デストラクタ
+  ~MappedFile()
+  {
+    if ( mAddr != nullptr ) {
+      munmap(const_cast<char*>(mAddr), mSize);
+    }
+    if ( mFd >= 0 ) {
+      close(mFd);
+    }
+  }
+
+  // 成功したら true を返す．
+  bool
+  ok() const
+  {
+    return mOk;
+  }
+
+  // 先頭のアドレスを返す．
+  const char*
+  begin() const
+  {
+    return mAddr;
+  }
+
+  // 末尾のアドレスを返す．
+  const char*
+  end() const
+  {
+    return mAddr + mSize;
+  }
+
+private:
+
+  // ファイル記述子
+  int mFd{-1};
+
+  // マップしたアドレス
+  const char* mAddr{nullptr};
+
+  // サイズ
+  SizeType mSize{0};
+
+  // 成功フラグ
+  bool mOk{false};
+
+};
+
+#endif
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス DimacsParser
+//////////////////////////////////////////////////////////////////////
+
+// @brief ファイルを読み込む．
+bool
+DimacsParser::read(
+  const string& filename
+)
+{
+#if DIMACS_USE_MMAP
+  MappedFile file{filename};
+  if ( file.ok() ) {
+    return parse(file.begin(), file.end());
+  }
+#endif
+  ifstream s{filename};
+  if ( !s ) {
+    mMessageList.clear();
+    mMessageList.push_back("Error: cannot open " + filename);
+    return false;
+  }
+  return read(s);
+}
+
+// @brief ストリームから読み込む．
+bool
+DimacsParser::read(
+  istream& s
+)
+{
+  string data;
+  char buff[64 * 1024];
+  while ( s.read(buff, sizeof(buff)) || s.gcount() > 0 ) {
+    data.append(buff, s.gcount());
+  }
+  return parse(data.data(), data.data() + data.size());
+}
+
+// @brief メモリ上のデータを読み込む．
+bool
+DimacsParser::parse(
+  const char* begin,
+  const char* end
+)
+{
+  mHasHeader = false;
+  mDecVarNum = 0;
+  mDecClauseNum = 0;
+  mMaxVar = 0;
+  mClauseNum = 0;
+  mMessageList.clear();
+
+  unique_ptr<Decompressor> decomp;
+  try {
+    decomp = Decompressor::new_obj(begin, end);
+  }
+  catch ( std::invalid_argument& error ) {
+    mMessageList.push_back(string{"Error: "} + error.what());
+    return false;
+  }
+  if ( decomp ) {
+    return parse_compressed(*decomp);
+  }
+  if ( BinaryCnfReader::check_magic(begin, end) ) {
+    return parse_binary(begin, end);
+  }
+
+  SizeType size = end - begin;
+  SizeType chunk_num = std::min(mThreadNum, size / MIN_CHUNK_SIZE);
+  if ( chunk_num <= 1 ) {
+    return parse_single(begin, end);
+  }
+  return parse_multi(begin, end, chunk_num);
+}
+
+// @brief 1つのスレッドで読み込む．
+bool
+DimacsParser::parse_single(
+  const char* begin,
+  const char* end
+)
+{
+  ScanState st;
+  DirectSink sink{mClauseFunc};
+  scan(begin, end, sink, st);
+
+  mHasHeader = st.mHasHeader;
+  mDecVarNum = st.mDecVarNum;
+  mDecClauseNum = st.mDecClauseNum;
+  mMaxVar = st.mMaxVar;
+  mClauseNum = sink.mClauseNum;
+
+  if ( st.mError != string{} ) {
+    add_error(st.mErrorLine, st.mError);
+    return false;
+  }
+  auto lineno = st.mEnd ? st.mLineNum + 1 : last_lineno(begin, end, st.mLineNum);
+  if ( !sink.mLits.empty() ) {
+    // 0 で終わっていない節がある．
+    add_error(lineno, "unexpected end-of-file");
+    return false;
+  }
+  return check_result(lineno);
+}
+
+// @brief 複数のスレッドで読み込む．
+bool
+DimacsParser::parse_multi(
+  const char* begin,
+  const char* end,
+  SizeType chunk_num
+)
+{
+  // 行の先頭でチャンクを区切る．
+  vector<const char*> bound_list;
+  bound_list.reserve(chunk_num + 1);
+  bound_list.push_back(begin);
+  SizeType size = end - begin;
+  for ( SizeType i = 1; i < chunk_num; ++ i ) {
+    auto p = begin + size * i / chunk_num;
+    if ( p < bound_list.back() ) {
+      p = bound_list.back();
+    }
+    auto q = static_cast<const char*>(memchr(p, '\n', end - p));
+    p = q == nullptr ? end : q + 1;
+    bound_list.push_back(p);
+  }
+  bound_list.push_back(end);
+
+  vector<ScanState> st_list(chunk_num);
+  vector<FlatSink> sink_list(chunk_num);
+  {
+    vector<std::thread> thread_list;
+    thread_list.reserve(chunk_num);
+    for ( SizeType i = 0; i < chunk_num; ++ i ) {
+      thread_list.emplace_back([&, i]() {
+	auto b = bound_list[i];
+	auto e = bound_list[i + 1];
+	// 1バイトあたり 0.3 リテラル程度と見積もっておく．
+	sink_list[i].mLits.reserve((e - b) / 3);
+	scan(b, e, sink_list[i], st_list[i]);
+      });
+    }
+    for ( auto& th: thread_list ) {
+      th.join();
+    }
+  }
+
+  // 先頭のチャンクから順に節を渡す．
+  SizeType line_offset = 0;
+  vector<int> lits;
+  for ( SizeType i = 0; i < chunk_num; ++ i ) {
+    auto& st = st_list[i];
+    if ( st.mHasHeader ) {
+      if ( mHasHeader ) {
+	add_error(line_offset + st.mHeaderLine, "duplicated 'p' block");
+	return false;
+      }
+      mHasHeader = true;
+      mDecVarNum = st.mDecVarNum;
+      mDecClauseNum = st.mDecClauseNum;
+    }
+    if ( mMaxVar < st.mMaxVar ) {
+      mMaxVar = st.mMaxVar;
+    }
+    for ( auto l: sink_list[i].mLits ) {
+      if ( l == 0 ) {
+	mClauseFunc(lits);
+	lits.clear();
+	++ mClauseNum;
+      }
+      else {
+	lits.push_back(l);
+      }
+    }
+    // 使い終わった領域はすぐに解放する．
+    vector<int>{}.swap(sink_list[i].mLits);
+
+    if ( st.mError != string{} ) {
+      add_error(line_offset + st.mErrorLine, st.mError);
+      return false;
+    }
+    if ( st.mEnd ) {
+      if ( !lits.empty() ) {
+	add_error(line_offset + st.mLineNum + 1, "unexpected end-of-file");
+	return false;
+      }
+      return check_result(line_offset + st.mLineNum + 1);
+    }
+    line_offset += st.mLineNum;
+  }
+  auto lineno = last_lineno(begin, end, line_offset);
+  if ( !lits.empty() ) {
+    add_error(lineno, "unexpected end-of-file");
+    return false;
+  }
+  return check_result(lineno);
+}
+
+// @brief 圧縮されたデータを展開しながら読み込む．
+bool
+DimacsParser::parse_compressed(
+  Decompressor& decomp
+)
+{
+  // 展開スレッドから字句解析側にブロックを渡すキュー
+  // 各ブロックは必ず行の先頭から始まる．
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::deque<string> queue;
+  // 展開スレッドが終わったら true にするフラグ
+  bool done = false;
+  // 字句解析側が読み込みを終えたら true にするフラグ
+  bool abort = false;
+  // 展開が成功したら true にするフラグ
+  bool decode_ok = true;
+
+  // 先頭部分を展開してバイナリ CNF 形式かどうか調べる．
+  string head(sizeof(BINARY_CNF_MAGIC), '\0');
+  SizeType head_size;
+  decode_ok = decomp.decode(&head[0], head.size(), head_size);
+  head.resize(head_size);
+  if ( decode_ok && BinaryCnfReader::check_magic(head.data(), head.data() + head.size()) ) {
+    // バイナリ形式の場合は全て展開してから読み込む．
+    string data = std::move(head);
+    for ( ; ; ) {
+      auto pos = data.size();
+      data.resize(pos + BLOCK_SIZE);
+      SizeType n;
+      decode_ok = decomp.decode(&data[pos], BLOCK_SIZE, n);
+      data.resize(pos + n);
+      if ( !decode_ok || n == 0 ) {
+	break;
+      }
+    }
+    if ( decode_ok ) {
+      return parse_binary(data.data(), data.data() + data.size());
+    }
+  }
+  if ( !decode_ok ) {
+    mMessageList.push_back(string{"Error: corrupted "} + decomp.name() + " data");
+    return false;
+  }
+
+  std::thread decode_thread{[&]() {
+    // 最後の改行より後ろの部分は次のブロックに回す．
+    string carry = std::move(head);
+    bool ok = true;
+    for ( ; ; ) {
+      string block = std::move(carry);
+      carry = string{};
+      auto pos = block.size();
+      block.resize(pos + BLOCK_SIZE);
+      SizeType n;
+      ok = decomp.decode(&block[pos], BLOCK_SIZE, n);
+      block.resize(pos + n);
+      if ( !ok || n == 0 ) {
+	carry = std::move(block);
+	break;
+      }
+      auto nl = block.rfind('\n');
+      if ( nl == string::npos ) {
+	carry = std::move(block);
+	continue;
+      }
+      carry.assign(block, nl + 1, string::npos);
+      block.resize(nl + 1);
+      std::unique_lock lck{mtx};
+      cv.wait(lck, [&]() { return queue.size() < MAX_QUEUE || abort; });
+      if ( abort ) {
+	return;
+      }
+      queue.push_back(std::move(block));
+      cv.notify_all();
+    }
+    std::unique_lock lck{mtx};
+    if ( ok && !carry.empty() ) {
+      queue.push_back(std::move(carry));
+    }
+    decode_ok = ok;
+    done = true;
+    cv.notify_all();
+  }};
+
+  ScanState st;
+  DirectSink sink{mClauseFunc};
+  bool last_nl = true;
+  for ( ; ; ) {
+    string block;
+    {
+      std::unique_lock lck{mtx};
+      cv.wait(lck, [&]() { return !queue.empty() || done; });
+      if ( queue.empty() ) {
+	break;
+      }
+      block = std::move(queue.front());
+      queue.pop_front();
+      cv.notify_all();
+    }
+    last_nl = block.back() == '\n';
+    scan(block.data(), block.data() + block.size(), sink, st);
+    if ( st.mError != string{} || st.mEnd ) {
+      break;
+    }
+  }
+  {
+    std::unique_lock lck{mtx};
+    abort = true;
+    cv.notify_all();
+  }
+  decode_thread.join();
+
+  mHasHeader = st.mHasHeader;
+  mDecVarNum = st.mDecVarNum;
+  mDecClauseNum = st.mDecClauseNum;
+  mMaxVar = st.mMaxVar;
+  mClauseNum = sink.mClauseNum;
+
+  if ( st.mError != string{} ) {
+    add_error(st.mErrorLine, st.mError);
+    return false;
+  }
+  if ( !st.mEnd && !decode_ok ) {
+    mMessageList.push_back(string{"Error: corrupted "} + decomp.name() + " data");
+    return false;
+  }
+  auto lineno = st.mEnd || !last_nl ? st.mLineNum + 1 : st.mLineNum;
+  if ( !sink.mLits.empty() ) {
+    // 0 で終わっていない節がある．
+    add_error(lineno, "unexpected end-of-file");
+    return false;
+  }
+  return check_result(lineno);
+}
+
+// @brief バイナリ CNF 形式のデータを読み込む．
+bool
+DimacsParser::parse_binary(
+  const char* begin,
+  const char* end
+)
+{
+  BinaryCnfReader reader{begin, end};
+  if ( reader.error() ) {
+    mMessageList.push_back("Error: corrupted binary CNF header");
+    return false;
+  }
+  mHasHeader = true;
+  mDecVarNum = reader.var_num();
+  mDecClauseNum = reader.clause_num();
+  vector<int> lits;
+  while ( reader.read_clause(lits) ) {
+    for ( auto l: lits ) {
+      SizeType v = abs(l);
+      if ( mMaxVar < v ) {
+	mMaxVar = v;
+      }
+    }
+    mClauseFunc(lits);
+    ++ mClauseNum;
+  }
+  if ( reader.error() ) {
+    mMessageList.push_back("Error: corrupted binary CNF data");
+    return false;
+  }
+  return check_result(0);
+}
+
+// @brief エラーメッセージを追加する．
+void
+DimacsParser::add_error(
+  SizeType lineno,
+  const string& msg
+)
+{
+  ostringstream buf;
+  buf << "Error at line " << lineno << ": " << msg;
+  mMessageList.push_back(buf.str());
+}
+
+// @brief 読み込み後のチェックを行う．
+bool
+DimacsParser::check_result(
+  SizeType lineno
+)
+{
+  if ( !mHasHeader ) {
+    add_error(lineno, "unexpected end-of-file");
+    return false;
+  }
+  if ( mDecVarNum < mMaxVar ) {
+    auto msg = "Warning: actual number of variables is more than the declared";
+    mMessageList.push_back(msg);
+  }
+  if ( mDecClauseNum > mClauseNum ) {
+    auto msg = "Warning: actual number of clauses is less than the declared";
+    mMessageList.push_back(msg);
+  }
+  else if ( mDecClauseNum < mClauseNum ) {
+    auto msg = "Warning: actual number of clauses is more than the declared";
+    mMessageList.push_back(msg);
+  }
+  return true;
+}
+
+END_NAMESPACE_YM_SAT
@@ -0,0 +1,197 @@
+
+/// @file DimacsWriter.cc
+/// @brief DimacsWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "DimacsWriter.h"
+#include <charconv>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// 1回に書き出すバッファのサイズ
+const SizeType BUFF_SIZE = 1024 * 1024;
+
+// 1つのスレッドが一度に文字列化する節の数
+const SizeType CHUNK_SIZE = 64 * 1024;
+
+// 整数を追加する．
+inline
+void
+put_int(
+  string& buff,
+  std::int64_t val
+)
+{
+  char tmp[24];
+  auto res = std::to_chars(tmp, tmp + sizeof(tmp), val);
+  buff.append(tmp, res.ptr);
+}
+
+// DIMACS 形式のリテラルに変換する．
+inline
+std::int64_t
+dimacs_lit(
+  int lit
+)
+{
+  return lit;
+}
+
+// DIMACS 形式のリテラルに変換する．
+inline
+std::int64_t
+dimacs_lit(
+  SatLiteral lit
+)
+{
+  std::int64_t val = lit.varid() + 1;
+  return lit.is_negative() ? - val : val;
+}
+
+// 1つの節を文字列化する．
+template<typename Iter>
+inline
+void
+format_clause(
+  string& buff,
+  Iter begin,
+  Iter end
+)
+{
+  for ( auto p = begin; p != end; ++ p ) {
+    put_int(buff, dimacs_lit(*p));
+    buff.push_back(' ');
+  }
+  buff.append("0\n");
+}
+
+END_NONAMESPACE
+
+// @brief DIMACS 形式のリテラルで表された節のリストを出力する．
+void
+DimacsWriter::write(
+  SizeType var_num,
+  const vector<vector<int>>& clause_list
+)
+{
+  write_body(var_num, clause_list.size(),
+	     [&](string& buff, SizeType i) {
+	       auto& clause = clause_list[i];
+	       format_clause(buff, clause.begin(), clause.end());
+	     });
+}
+
+// @brief 平坦なリストで表された節のリストを出力する．
+void
+DimacsWriter::write(
+  SizeType var_num,
+  const vector<SatLiteral>& lit_list,
+  const vector<SizeType>& begin_list
+)
+{
+  write_body(var_num, begin_list.size() - 1,
+	     [&](string& buff, SizeType i) {
+	       format_clause(buff,
+			     lit_list.begin() + begin_list[i],
+			     lit_list.begin() + begin_list[i + 1]);
+	     });
+}
+
+// @brief ヘッダを出力する．
+void
+DimacsWriter::write_header(
+  SizeType var_num,
+  SizeType clause_num
+)
+{
+  mBuff.reserve(BUFF_SIZE + 1024);
+  mBuff.append("p cnf ");
+  put_int(mBuff, var_num);
+  mBuff.push_back(' ');
+  put_int(mBuff, clause_num);
+  mBuff.push_back('\n');
+}
+
+// @brief 節を1つ出力する．
+void
+DimacsWriter::put_clause(
+  const vector<SatLiteral>& lits
+)
+{
+  format_clause(mBuff, lits.begin(), lits.end());
+  if ( mBuff.size() >= BUFF_SIZE ) {
+    flush();
+  }
+}
+
+// @brief バッファの内容を書き出す．
+void
+DimacsWriter::flush()
+{
+  mS.write(mBuff.data(), mBuff.size());
+  mBuff.clear();
+}
+
+// @brief write() の本体
+template<typename Func>
+void
+DimacsWriter::write_body(
+  SizeType var_num,
+  SizeType clause_num,
+  Func func
+)
+{
+  write_header(var_num, clause_num);
+
+  if ( mThreadNum <= 1 || clause_num < CHUNK_SIZE * 2 ) {
+    for ( SizeType i = 0; i < clause_num; ++ i ) {
+      func(mBuff, i);
+      if ( mBuff.size() >= BUFF_SIZE ) {
+	flush();
+      }
+    }
+    flush();
+    return;
+  }
+
+  flush();
+
+  // mThreadNum 個のチャンクをまとめて文字列化してから順に書き出す．
+  vector<string> buff_list(mThreadNum);
+  auto format_chunk = [&](SizeType id, SizeType start) {
+    auto& buff = buff_list[id];
+    buff.clear();
+    auto end = std::min(start + CHUNK_SIZE, clause_num);
+    for ( SizeType i = start; i < end; ++ i ) {
+      func(buff, i);
+    }
+  };
+  for ( SizeType base = 0; base < clause_num; base += CHUNK_SIZE * mThreadNum ) {
+    vector<std::thread> thread_list;
+    thread_list.reserve(mThreadNum - 1);
+    for ( SizeType id = 1; id < mThreadNum; ++ id ) {
+      auto start = base + id * CHUNK_SIZE;
+      if ( start >= clause_num ) {
+	buff_list[id].clear();
+	continue;
+      }
+      thread_list.emplace_back(format_chunk, id, start);
+    }
+    format_chunk(0, base);
+    for ( auto& th: thread_list ) {
+      th.join();
+    }
+    for ( auto& buff: buff_list ) {
+      mS.write(buff.data(), buff.size());
+    }
+  }
+}
+
+END_NAMESPACE_YM_SAT
@@ -22,8 +22,29 @@ SatSolver::add_expr(
   const LitMap& lit_map
 )
 {
-  Expr2Cnf expr2cnf(*this, lit_map);
-  return expr2cnf.make_cnf(expr);
+  // 同じ条件リテラルのもとで変換したことがあれば
+  // その結果を再利用する．
+  auto cond_lits = mConditionalLits;
+  sort(cond_lits.begin(), cond_lits.end());
+  Expr2Cnf* expr2cnf = nullptr;
+  for ( auto& p: mExpr2CnfList ) {
+    if ( p->match(cond_lits) ) {
+      expr2cnf = p.get();
+      break;
+    }
+  }
+  if ( expr2cnf == nullptr ) {
+    mExpr2CnfList.push_back(std::make_unique<Expr2Cnf>(*this, cond_lits));
+    expr2cnf = mExpr2CnfList.back().get();
+  }
+  return expr2cnf->make_cnf(expr, lit_map);
+}
+
+// @brief add_expr() の変換結果をすべて捨てる．
+void
+SatSolver::clear_expr_cache()
+{
+  mExpr2CnfList.clear();
 }
 
 
@@ -31,87 +52,345 @@ SatSolver::add_expr(
 // クラス Expr2Cnf
 //////////////////////////////////////////////////////////////////////
 
+// @brief Expr を充足する条件を追加する．
 vector<SatLiteral>
 Expr2Cnf::make_cnf(
-  const Expr& expr ///< [in] 対象の論理式
+  const Expr& expr,
+  const LitMap& lit_map
+)
+{
+  mLitMap = &lit_map;
+  mFull = mSolver.tseitin_encoding();
+
+  // 作業スタックを用いて帰りがけ順に変換する．
+  // オペランドは逆順に積むので結果は元の順に mLitBuff に積まれる．
+  mLitBuff.clear();
+  mResultBegin.clear();
+  mStack.clear();
+  mStack.push_back({expr, 0, false});
+  while ( !mStack.empty() ) {
+    auto& frame = mStack.back();
+    if ( frame.mExpanded ) {
+      // オペランドは全て変換済み
+      auto expr1 = frame.mExpr;
+      auto result_base = frame.mResultBase;
+      mStack.pop_back();
+      make_node(expr1, result_base);
+      continue;
+    }
+    if ( !frame.mExpr.is_op() ) {
+      auto expr1 = frame.mExpr;
+      mStack.pop_back();
+      push_leaf(expr1);
+      continue;
+    }
+    frame.mExpanded = true;
+    frame.mResultBase = mResultBegin.size();
+    // mStack に要素を追加すると frame は無効になる．
+    auto expr1 = frame.mExpr;
+    for ( SizeType i = expr1.operand_num(); i > 0; -- i ) {
+      mStack.push_back({expr1.operand(i - 1), 0, false});
+    }
+  }
+
+  // 結果のリテラルが論理式を含意するのに必要な節を生成する．
+  mReqStack.assign(mLitBuff.begin(), mLitBuff.end());
+  encode();
+
+  return mLitBuff;
+}
+
+// @brief 定数かリテラルの変換結果を積む．
+void
+Expr2Cnf::push_leaf(
+  const Expr& expr
 )
 {
   if ( expr.is_zero() ) {
     // 充足不能
     throw std::invalid_argument{"expr is zero"};
   }
+  mResultBegin.push_back(mLitBuff.size());
   if ( expr.is_one() ) {
     // 無条件で充足している．
-    return {};
+    return;
   }
   if ( expr.is_literal() ) {
     auto vid = expr.varid();
-    if ( mLitMap.count(vid) == 0 ) {
+    if ( mLitMap->count(vid) == 0 ) {
       throw std::logic_error{"varid is not registered"};
     }
-    auto lit = mLitMap.at(vid);
+    auto lit = mLitMap->at(vid);
     if ( expr.is_nega_literal() ) {
       lit = ~lit;
     }
-    return {lit};
+    mLitBuff.push_back(lit);
+    return;
   }
-  if ( expr.is_and() ) {
-    vector<vector<SatLiteral>> lits_list;
-    lits_list.reserve(expr.operand_num());
-    SizeType n = 0;
-    for ( auto& expr1: expr.operand_list() ) {
-      auto lits1 = make_cnf(expr1);
-      lits_list.push_back(lits1);
-      n += lits1.size();
+  throw std::invalid_argument{"unexpected error"};
+}
+
+// @brief pos 番目の結果を表すリテラルを返す．
+bool
+Expr2Cnf::result_lit(
+  SizeType pos,
+  SatLiteral& lit
+)
+{
+  auto begin = mResultBegin[pos];
+  auto end = result_end(pos);
+  if ( begin == end ) {
+    return false;
+  }
+  if ( begin + 1 == end ) {
+    lit = mLitBuff[begin];
+    return true;
+  }
+  lit = define(And, mLitBuff.data() + begin, end - begin);
+  return true;
+}
+
+// @brief 演算の結果を表すリテラルを返す．
+SatLiteral
+Expr2Cnf::define(
+  OpType op,
+  const SatLiteral* lits,
+  SizeType n
+)
+{
+  mKey.clear();
+  mKey.push_back(op);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    mKey.push_back(lits[i].index());
+  }
+  sort(mKey.begin() + 1, mKey.end());
+  auto p = mExprDict.find(mKey);
+  if ( p != mExprDict.end() ) {
+    ++ mHitNum;
+    return mDefList[p->second].mLit;
+  }
+
+  auto lit = mSolver.new_variable(false);
+  SizeType id = mDefList.size();
+  mDefList.push_back({op, mDefLits.size(), n, lit});
+  mDefLits.insert(mDefLits.end(), lits, lits + n);
+  mExprDict.emplace(mKey, id);
+  mVarDict.emplace(lit.varid(), id);
+  return lit;
+}
+
+// @brief XOR の結果を表すリテラルを返す．
+SatLiteral
+Expr2Cnf::define_xor(
+  const SatLiteral* lits,
+  SizeType n
+)
+{
+  // オペランドの否定は結果の否定にまとめる．
+  bool inv = false;
+  mXorLits.clear();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto lit = lits[i];
+    if ( lit.is_negative() ) {
+      lit = ~lit;
+      inv = !inv;
+    }
+    mXorLits.push_back(lit);
+  }
+  // 同じオペランドの対は打ち消しあう．
+  sort(mXorLits.begin(), mXorLits.end());
+  SizeType wpos = 0;
+  for ( SizeType rpos = 0; rpos < mXorLits.size(); ++ rpos ) {
+    if ( wpos > 0 && mXorLits[wpos - 1] == mXorLits[rpos] ) {
+      -- wpos;
+    }
+    else {
+      mXorLits[wpos] = mXorLits[rpos];
+      ++ wpos;
+    }
+  }
+  mXorLits.erase(mXorLits.begin() + wpos, mXorLits.end());
+
+  SatLiteral lit;
+  if ( mXorLits.empty() ) {
+    // 定数0
+    lit = ~define(And, nullptr, 0);
+  }
+  else {
+    // xor_cut() 個以下ずつのグループに分けて，
+    // グループの XOR を1つのリテラルに置き換えることを繰り返す．
+    SizeType cut = mSolver.xor_cut();
+    while ( mXorLits.size() > cut ) {
+      auto n1 = mXorLits.size();
+      auto ng = (n1 + cut - 1) / cut;
+      SizeType gpos = 0;
+      for ( SizeType g = 0; g < ng; ++ g ) {
+	// グループの大きさはなるべく均等にする．
+	auto begin = n1 * g / ng;
+	auto end = n1 * (g + 1) / ng;
+	if ( begin + 1 == end ) {
+	  mXorLits[gpos] = mXorLits[begin];
+	}
+	else {
+	  mXorLits[gpos] = define(Xor, mXorLits.data() + begin, end - begin);
+	}
+	++ gpos;
+      }
+      mXorLits.erase(mXorLits.begin() + gpos, mXorLits.end());
     }
-    vector<SatLiteral> lits;
-    lits.reserve(n);
-    for ( auto& lits1: lits_list ) {
-      lits.insert(lits.end(), lits1.begin(), lits1.end());
+    if ( mXorLits.size() == 1 ) {
+      lit = mXorLits.front();
     }
-    return lits;
+    else {
+      lit = define(Xor, mXorLits.data(), mXorLits.size());
+    }
+  }
+  return inv ? ~lit : lit;
+}
+
+// @brief オペランドが全て変換済みの演算ノードを変換する．
+void
+Expr2Cnf::make_node(
+  const Expr& expr,
+  SizeType result_base
+)
+{
+  if ( expr.is_and() ) {
+    // オペランドの結果はすでに連続して積まれているので
+    // それらを1つの結果とみなせばよい．
+    mResultBegin.erase(mResultBegin.begin() + result_base + 1, mResultBegin.end());
+    return;
   }
+
+  auto result_num = mResultBegin.size();
+  SatLiteral new_lit;
   if ( expr.is_or() ) {
-    auto new_lit = mSolver.new_variable(false);
-    vector<SatLiteral> lits;
-    lits.reserve(expr.operand_num() + 1);
-    lits.push_back(~new_lit);
-    for ( auto& expr1: expr.operand_list() ) {
-      auto lits1 = make_cnf(expr1);
-      if ( lits1.empty() ) {
-	continue;
+    mTmpLits.clear();
+    for ( auto pos = result_base; pos < result_num; ++ pos ) {
+      SatLiteral lit1;
+      if ( result_lit(pos, lit1) ) {
+	mTmpLits.push_back(lit1);
       }
-      if ( lits1.size() == 1 ) {
-	auto lit1 = lits1.front();
-	lits.push_back(lit1);
+    }
+    if ( mTmpLits.size() == 1 ) {
+      new_lit = mTmpLits.front();
+    }
+    else {
+      new_lit = define(Or, mTmpLits.data(), mTmpLits.size());
+    }
+  }
+  else if ( expr.is_xor() ) {
+    // リテラルのオペランドはそのまま用いる．
+    mTmpLits.clear();
+    for ( auto pos = result_base; pos < result_num; ++ pos ) {
+      SatLiteral lit1;
+      if ( !result_lit(pos, lit1) ) {
+	// 定数1
+	lit1 = define(And, nullptr, 0);
       }
-      else {
-	auto lit1 = mSolver.new_variable(false);
-	for ( auto lit: lits1 ) {
-	  mSolver.add_clause(~lit1, lit);
+      mTmpLits.push_back(lit1);
+    }
+    new_lit = define_xor(mTmpLits.data(), mTmpLits.size());
+  }
+  else {
+    throw std::invalid_argument{"unexpected error"};
+  }
+
+  // オペランドの結果を取り除いて new_lit を積む．
+  mLitBuff.erase(mLitBuff.begin() + mResultBegin[result_base], mLitBuff.end());
+  mResultBegin.erase(mResultBegin.begin() + result_base, mResultBegin.end());
+  mResultBegin.push_back(mLitBuff.size());
+  mLitBuff.push_back(new_lit);
+}
+
+// @brief 要求された節を生成する．
+void
+Expr2Cnf::encode()
+{
+  while ( !mReqStack.empty() ) {
+    auto lit = mReqStack.back();
+    mReqStack.pop_back();
+    auto p = mVarDict.find(lit.varid());
+    if ( p == mVarDict.end() ) {
+      // 入力のリテラル
+      continue;
+    }
+    // encode() の間は mDefList に要素は追加されない．
+    auto& def = mDefList[p->second];
+    if ( (mFull || lit.is_positive()) && !def.mPosDone ) {
+      def.mPosDone = true;
+      make_clauses(def, false);
+    }
+    if ( (mFull || lit.is_negative()) && !def.mNegDone ) {
+      def.mNegDone = true;
+      make_clauses(def, true);
+    }
+  }
+}
+
+// @brief 定義の片方の極性の節を生成する．
+void
+Expr2Cnf::make_clauses(
+  const Def& def,
+  bool inv
+)
+{
+  // 極性を考慮した出力のリテラル
+  auto olit = inv ? ~def.mLit : def.mLit;
+  auto lits = mDefLits.data() + def.mBegin;
+  auto n = def.mNum;
+  if ( def.mOp == Xor ) {
+    // olit が成り立つ時はオペランドの XOR (inv の時は XNOR)が成り立つ．
+    // 偶数個(inv の時は奇数個)のオペランドが 1 となる割り当てを
+    // 1つずつ禁止する節を作る．
+    // XOR のオペランドは両方の極性で用いられる．
+    SizeType np = 1U << n;
+    for ( SizeType p = 0; p < np; ++ p ) {
+      SizeType nb = 0;
+      for ( SizeType i = 0; i < n; ++ i ) {
+	if ( p & (1U << i) ) {
+	  ++ nb;
 	}
-	lits.push_back(lit1);
       }
+      if ( (nb % 2 == 0) == inv ) {
+	continue;
+      }
+      mTmpLits.clear();
+      mTmpLits.push_back(~olit);
+      for ( SizeType i = 0; i < n; ++ i ) {
+	mTmpLits.push_back( (p & (1U << i)) ? ~lits[i] : lits[i] );
+      }
+      mSolver.add_clause(mTmpLits);
     }
-    mSolver.add_clause(lits);
-    return {new_lit};
+    for ( SizeType i = 0; i < n; ++ i ) {
+      mReqStack.push_back(lits[i]);
+      mReqStack.push_back(~lits[i]);
+    }
+    return;
   }
-  if ( expr.is_xor() ) {
-    // EXOR は両極性を必要とするので非常に効率が悪い．
-    auto new_lit = mSolver.new_variable(false);
-    vector<SatLiteral> lits;
-    lits.reserve(expr.operand_num());
-    for ( auto& expr1: expr.operand_list() ) {
-      auto lit1 = mSolver.new_variable(false);
-      auto lits1 = make_cnf(expr1);
-      mSolver.add_andgate(lit1, lits1);
-      lits.push_back(lit1);
+
+  // AND の負の極性と OR の正の極性は1つの節
+  // AND の正の極性と OR の負の極性はオペランドごとの2リテラルの節
+  // となる．負の極性の場合はオペランドも否定する．
+  bool single = (def.mOp == Or) != inv;
+  if ( single ) {
+    mTmpLits.clear();
+    mTmpLits.reserve(n + 1);
+    mTmpLits.push_back(~olit);
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto lit1 = inv ? ~lits[i] : lits[i];
+      mTmpLits.push_back(lit1);
+      mReqStack.push_back(lit1);
+    }
+    mSolver.add_clause(mTmpLits);
+  }
+  else {
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto lit1 = inv ? ~lits[i] : lits[i];
+      mSolver.add_clause(~olit, lit1);
+      mReqStack.push_back(lit1);
     }
-    mSolver.add_xorgate(new_lit, lits);
-    return {new_lit};
   }
-  throw std::invalid_argument{"unexpected error"};
-  return {};
 }
 
 END_NAMESPACE_YM_SAT
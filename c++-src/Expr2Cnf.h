@@ -17,6 +17,23 @@ BEGIN_NAMESPACE_YM_SAT
 //////////////////////////////////////////////////////////////////////
 /// @class Expr2Cnf Expr2Cnf.h "Expr2Cnf.h"
 /// @brief Expr を CNF に変換するための補助クラス
+///
+/// 変換は2段階で行う．
+/// まず，論理式を明示的な作業スタックを用いた帰りがけ順で走査して，
+/// 新しい変数とその定義(演算の種類とオペランドのリテラル)を作る．
+/// 各オペランドの変換結果は mLitBuff 上に順に積まれるので，
+/// AND の結果はオペランドの結果をそのまま連結したものとなり
+/// コピーは生じない．
+/// 次に，結果のリテラルから定義をたどって節を生成する．
+/// 通常は実際に用いられる極性の節のみを生成する(Plaisted-Greenbaum 符号化)
+/// が，SatSolver::tseitin_encoding() が true の場合は各変数の定義の
+/// 両方向の節を生成する(Tseitin 符号化)．
+/// XOR のオペランドはどちらの場合も両方の極性の節を持つ．
+///
+/// 定義は演算の種類とオペランドのリテラルの集合をキーとする辞書に
+/// 記録され，構造的に等しい部分式には同じ変数が再利用される．
+/// キーは SATソルバ上のリテラルで表されるので LitMap に依存しない．
+/// オブジェクトは SatSolver 側で条件リテラルごとに保持される．
 //////////////////////////////////////////////////////////////////////
 class Expr2Cnf
 {
@@ -28,10 +45,10 @@ public:
 
   /// @brief コンストラクタ
   Expr2Cnf(
-    SatSolver& solver,    ///< [in] SATソルバ
-    const LitMap& lit_map ///< [in] 変数とリテラルの対応を表す辞書
+    SatSolver& solver,                  ///< [in] SATソルバ
+    const vector<SatLiteral>& cond_lits ///< [in] 条件リテラルのリスト(ソート済み)
   ) : mSolver{solver},
-      mLitMap{lit_map}
+      mCondLits{cond_lits}
   {
   }
 
@@ -47,9 +64,163 @@ public:
   /// @brief Expr を充足する条件を追加する．
   vector<SatLiteral>
   make_cnf(
+    const Expr& expr,     ///< [in] 対象の論理式
+    const LitMap& lit_map ///< [in] 変数とリテラルの対応を表す辞書
+  );
+
+  /// @brief 生成時の条件リテラルが等しい時 true を返す．
+  bool
+  match(
+    const vector<SatLiteral>& cond_lits ///< [in] 条件リテラルのリスト(ソート済み)
+  ) const
+  {
+    return mCondLits == cond_lits;
+  }
+
+  /// @brief 変換済みの結果を再利用した回数を返す．
+  SizeType
+  hit_num() const
+  {
+    return mHitNum;
+  }
+
+  /// @brief 新たに変数を作った回数を返す．
+  SizeType
+  miss_num() const
+  {
+    return mDefList.size();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 新しい変数を作る演算の種類
+  enum OpType : SizeType {
+    And,
+    Or,
+    Xor  // オペランドは全て正極性で互いに異なる．
+  };
+
+  // 変数の定義
+  struct Def
+  {
+    OpType mOp;            // 演算の種類
+    SizeType mBegin;       // mDefLits 上のオペランドの先頭位置
+    SizeType mNum;         // オペランド数
+    SatLiteral mLit;       // 対応するリテラル
+    bool mPosDone{false};  // 正の極性の節を生成済みの時 true
+    bool mNegDone{false};  // 負の極性の節を生成済みの時 true
+  };
+
+  // 辞書のキー
+  // 先頭の要素が OpType で，残りがソートされたオペランドのリテラルの
+  // インデックスとなる．
+  using Key = vector<SizeType>;
+
+  // Key のハッシュ関数
+  struct KeyHash
+  {
+    SizeType
+    operator()(
+      const Key& key
+    ) const
+    {
+      SizeType h = 0;
+      for ( auto v: key ) {
+	h = h * 1048583 + v;
+      }
+      return h;
+    }
+  };
+
+  // 作業スタックの要素
+  struct Frame
+  {
+    Expr mExpr;           // 対象の論理式
+    SizeType mResultBase; // mResultBegin 上のオペランドの結果の先頭位置
+    bool mExpanded;       // オペランドを展開済みの時 true
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 定数かリテラルの変換結果を積む．
+  void
+  push_leaf(
     const Expr& expr ///< [in] 対象の論理式
   );
 
+  /// @brief オペランドが全て変換済みの演算ノードを変換する．
+  void
+  make_node(
+    const Expr& expr,    ///< [in] 対象の論理式
+    SizeType result_base ///< [in] mResultBegin 上のオペランドの結果の先頭位置
+  );
+
+  /// @brief pos 番目の結果の末尾を返す．
+  SizeType
+  result_end(
+    SizeType pos ///< [in] mResultBegin 上の位置
+  ) const
+  {
+    if ( pos + 1 < mResultBegin.size() ) {
+      return mResultBegin[pos + 1];
+    }
+    return mLitBuff.size();
+  }
+
+  /// @brief pos 番目の結果を表すリテラルを返す．
+  ///
+  /// 結果が複数のリテラルからなる場合には
+  /// それらの AND を表す変数を定義する．
+  /// 結果が空の場合には何もしないで false を返す．
+  bool
+  result_lit(
+    SizeType pos,   ///< [in] mResultBegin 上の位置
+    SatLiteral& lit ///< [out] 結果のリテラル
+  );
+
+  /// @brief 演算の結果を表すリテラルを返す．
+  ///
+  /// 構造的に等しい定義があればそのリテラルを返し，
+  /// なければ新しい変数を定義する．
+  /// 節は生成しない．
+  SatLiteral
+  define(
+    OpType op,              ///< [in] 演算の種類
+    const SatLiteral* lits, ///< [in] オペランドのリテラルの配列
+    SizeType n              ///< [in] リテラル数
+  );
+
+  /// @brief XOR の結果を表すリテラルを返す．
+  ///
+  /// - オペランドの否定は結果の否定にまとめ，同じオペランドの対は
+  ///   打ち消す．
+  /// - オペランド数が SatSolver::xor_cut() を超える場合は
+  ///   xor_cut() 個以下ずつに分けた XOR の木に分解する．
+  SatLiteral
+  define_xor(
+    const SatLiteral* lits, ///< [in] オペランドのリテラルの配列
+    SizeType n              ///< [in] リテラル数
+  );
+
+  /// @brief 要求された節を生成する．
+  void
+  encode();
+
+  /// @brief 定義の片方の極性の節を生成する．
+  void
+  make_clauses(
+    const Def& def, ///< [in] 対象の定義
+    bool inv        ///< [in] 負の極性の時 true
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -59,8 +230,51 @@ private:
   // SATソルバ
   SatSolver& mSolver;
 
+  // 生成時の条件リテラルのリスト(ソート済み)
+  vector<SatLiteral> mCondLits;
+
   // 変数とリテラルの対応を表す辞書
-  const LitMap& mLitMap;
+  // make_cnf() の実行中のみ有効
+  const LitMap* mLitMap{nullptr};
+
+  // 変換済みの結果を再利用した回数
+  SizeType mHitNum{0};
+
+  // 定義のリスト
+  vector<Def> mDefList;
+
+  // 定義のオペランドのリテラルを格納するバッファ
+  vector<SatLiteral> mDefLits;
+
+  // キーから定義番号を求める辞書
+  std::unordered_map<Key, SizeType, KeyHash> mExprDict;
+
+  // 変数番号から定義番号を求める辞書
+  std::unordered_map<SatVarId, SizeType> mVarDict;
+
+  // 辞書を引くための作業領域
+  Key mKey;
+
+  // 変換結果のリテラルを積むバッファ
+  vector<SatLiteral> mLitBuff;
+
+  // mLitBuff 上の各結果の先頭位置を積むスタック
+  vector<SizeType> mResultBegin;
+
+  // 作業スタック
+  vector<Frame> mStack;
+
+  // 節の生成を要求されたリテラルのスタック
+  vector<SatLiteral> mReqStack;
+
+  // 節を作るための作業領域
+  vector<SatLiteral> mTmpLits;
+
+  // XOR を分解するための作業領域
+  vector<SatLiteral> mXorLits;
+
+  // 両方の極性の節を生成する時 true
+  bool mFull{false};
 
 };
 
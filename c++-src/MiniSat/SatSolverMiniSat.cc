@@ -66,15 +66,16 @@ SatSolverMiniSat::new_variable(
 // @brief 節を追加する．
 void
 SatSolverMiniSat::add_clause(
-  const vector<SatLiteral>& lits
+  SizeType n,
+  const SatLiteral* lits
 )
 {
-  vec<Lit> tmp;
-  for ( auto l: lits ) {
-    auto lit = literal2lit(l);
-    tmp.push(lit);
+  mTmpLits.clear();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto lit = literal2lit(lits[i]);
+    mTmpLits.push(lit);
   }
-  mSolver.addClause(tmp);
+  mSolver.addClause(mTmpLits);
 }
 
 // @brief SAT 問題を解く．
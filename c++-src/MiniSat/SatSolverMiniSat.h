@@ -51,10 +51,13 @@ public:
     bool decision ///< [in] 決定変数の時に true とする．
   ) override;
 
+  using SatSolverImpl::add_clause;
+
   /// @brief 節を追加する．
   void
   add_clause(
-    const vector<SatLiteral>& lits ///< [in] リテラルのベクタ
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
   ) override;
 
   /// @brief SAT 問題を解く．
@@ -114,6 +117,9 @@ private:
   // ソルバ本体
   Solver mSolver;
 
+  // add_clause() で用いる作業領域
+  vec<Lit> mTmpLits;
+
 };
 
 END_NAMESPACE_YM_SAT
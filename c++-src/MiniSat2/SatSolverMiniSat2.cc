@@ -68,15 +68,30 @@ SatSolverMiniSat2::new_variable(
 // @brief 節を追加する．
 void
 SatSolverMiniSat2::add_clause(
-  const vector<SatLiteral>& lits
+  SizeType n,
+  const SatLiteral* lits
 )
 {
-  vec<Lit> tmp;
-  for ( auto l: lits ) {
-    auto lit = literal2lit(l);
-    tmp.push(lit);
+  mTmpLits.clear();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto lit = literal2lit(lits[i]);
+    mTmpLits.push(lit);
+  }
+  mSolver.addClause_(mTmpLits);
+}
+
+// @brief 決定変数の値を選ぶ時に優先する極性を設定する．
+bool
+SatSolverMiniSat2::set_phase(
+  SizeType n,
+  const SatLiteral* lits
+)
+{
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto l = lits[i];
+    mSolver.setPolarity(static_cast<Var>(l.varid()), l.is_negative());
   }
-  mSolver.addClause_(tmp);
+  return true;
 }
 
 // @brief SAT 問題を解く．
@@ -93,6 +108,9 @@ SatSolverMiniSat2::solve(
     tmp.push(lit);
   }
 
+  // 以前の stop() の効果を取り消す．
+  mSolver.clearInterrupt();
+
   auto ans = mSolver.solveLimited(tmp);
   if ( ans == l_True ) {
     SizeType n = mSolver.model.size();
@@ -51,10 +51,23 @@ public:
     bool decision ///< [in] 決定変数の時に true とする．
   ) override;
 
+  using SatSolverImpl::add_clause;
+
   /// @brief 節を追加する．
   void
   add_clause(
-    const vector<SatLiteral>& lits ///< [in] リテラルのベクタ
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
+  ) override;
+
+  using SatSolverImpl::set_phase;
+
+  /// @brief 決定変数の値を選ぶ時に優先する極性を設定する．
+  /// @return 常に true を返す．
+  bool
+  set_phase(
+    SizeType n,            ///< [in] リテラル数
+    const SatLiteral* lits ///< [in] リテラルの配列
   ) override;
 
   /// @brief SAT 問題を解く．
@@ -114,6 +127,9 @@ private:
   // ソルバの本体
   Minisat::Solver mSolver;
 
+  // add_clause() で用いる作業領域
+  Minisat::vec<Minisat::Lit> mTmpLits;
+
 };
 
 END_NAMESPACE_YM_SAT
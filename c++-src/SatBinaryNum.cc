@@ -0,0 +1,900 @@
+
+/// @file SatBinaryNum.cc
+/// @brief SatBinaryNum の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatBinaryNum.h"
+#include "ym/SatSolver.h"
+#include "ym/SatModel.h"
+#include <limits>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// SizeType で表せるビット数
+const SizeType SIZE_BITS = std::numeric_limits<SizeType>::digits;
+
+//////////////////////////////////////////////////////////////////////
+// 定数を畳み込みながらビット単位のゲートを作るクラス
+//
+// 入力が定数の場合や，同じリテラル(もしくはその否定)の場合には
+// 新しい変数を作らずに結果のリテラルを返す．
+// 出力の値をモデルから読めるように，作る変数は決定変数とする．
+//////////////////////////////////////////////////////////////////////
+class BvBuilder
+{
+public:
+
+  // コンストラクタ
+  BvBuilder(
+    SatSolver& solver
+  ) : mSolver{solver},
+      mOne{solver.const_true()}
+  {
+  }
+
+  // 定数0を返す．
+  SatLiteral
+  zero() const
+  {
+    return ~mOne;
+  }
+
+  // 定数1を返す．
+  SatLiteral
+  one() const
+  {
+    return mOne;
+  }
+
+  // 定数の時 true を返す．
+  bool
+  is_const(
+    SatLiteral lit
+  ) const
+  {
+    return lit == mOne || lit == ~mOne;
+  }
+
+  // ビットベクタの bit ビット目を返す．
+  //
+  // 範囲外の場合は0を返す．
+  SatLiteral
+  bit(
+    const vector<SatLiteral>& vec,
+    SizeType bit
+  ) const
+  {
+    return bit < vec.size() ? vec[bit] : zero();
+  }
+
+  // AND ゲート
+  SatLiteral
+  and2(
+    SatLiteral a,
+    SatLiteral b
+  )
+  {
+    if ( a == zero() || b == zero() || a == ~b ) {
+      return zero();
+    }
+    if ( a == one() || a == b ) {
+      return b;
+    }
+    if ( b == one() ) {
+      return a;
+    }
+    auto olit = mSolver.new_variable(true);
+    mSolver.add_andgate(olit, a, b);
+    return olit;
+  }
+
+  // OR ゲート
+  SatLiteral
+  or2(
+    SatLiteral a,
+    SatLiteral b
+  )
+  {
+    return ~and2(~a, ~b);
+  }
+
+  // XOR ゲート
+  SatLiteral
+  xor2(
+    SatLiteral a,
+    SatLiteral b
+  )
+  {
+    if ( a == zero() ) {
+      return b;
+    }
+    if ( a == one() ) {
+      return ~b;
+    }
+    if ( b == zero() ) {
+      return a;
+    }
+    if ( b == one() ) {
+      return ~a;
+    }
+    if ( a == b ) {
+      return zero();
+    }
+    if ( a == ~b ) {
+      return one();
+    }
+    auto olit = mSolver.new_variable(true);
+    mSolver.add_xorgate(olit, a, b);
+    return olit;
+  }
+
+  // 3入力の XOR ゲート(全加算器の和)
+  SatLiteral
+  xor3(
+    SatLiteral a,
+    SatLiteral b,
+    SatLiteral c
+  )
+  {
+    // 2入力の XOR が変数を作らずに済む組があればそれを先に計算する．
+    if ( is_const(a) || is_const(b) || a == b || a == ~b ) {
+      return xor2(xor2(a, b), c);
+    }
+    if ( is_const(c) || b == c || b == ~c ) {
+      return xor2(a, xor2(b, c));
+    }
+    if ( a == c || a == ~c ) {
+      return xor2(xor2(a, c), b);
+    }
+    auto olit = mSolver.new_variable(true);
+    mSolver.add_xorgate(olit, a, b, c);
+    return olit;
+  }
+
+  // 多数決ゲート(全加算器の桁上げ)
+  SatLiteral
+  maj3(
+    SatLiteral a,
+    SatLiteral b,
+    SatLiteral c
+  )
+  {
+    if ( a == b || a == c ) {
+      return a;
+    }
+    if ( b == c ) {
+      return b;
+    }
+    if ( a == ~b ) {
+      return c;
+    }
+    if ( a == ~c ) {
+      return b;
+    }
+    if ( b == ~c ) {
+      return a;
+    }
+    if ( is_const(a) ) {
+      return a == one() ? or2(b, c) : and2(b, c);
+    }
+    if ( is_const(b) ) {
+      return b == one() ? or2(a, c) : and2(a, c);
+    }
+    if ( is_const(c) ) {
+      return c == one() ? or2(a, b) : and2(a, b);
+    }
+    auto olit = mSolver.new_variable(true);
+    mSolver.add_clause(~a, ~b,  olit);
+    mSolver.add_clause(~a, ~c,  olit);
+    mSolver.add_clause(~b, ~c,  olit);
+    mSolver.add_clause( a,  b, ~olit);
+    mSolver.add_clause( a,  c, ~olit);
+    mSolver.add_clause( b,  c, ~olit);
+    return olit;
+  }
+
+  // マルチプレクサ(s ? a1 : a0)
+  SatLiteral
+  mux(
+    SatLiteral s,
+    SatLiteral a1,
+    SatLiteral a0
+  )
+  {
+    if ( s == one() || a1 == a0 ) {
+      return a1;
+    }
+    if ( s == zero() ) {
+      return a0;
+    }
+    if ( a1 == ~a0 ) {
+      return xor2(s, a0);
+    }
+    if ( a1 == one() || s == a1 ) {
+      return or2(s, a0);
+    }
+    if ( a1 == zero() || s == ~a1 ) {
+      return and2(~s, a0);
+    }
+    if ( a0 == one() || s == ~a0 ) {
+      return or2(~s, a1);
+    }
+    if ( a0 == zero() || s == a0 ) {
+      return and2(s, a1);
+    }
+    auto olit = mSolver.new_variable(true);
+    mSolver.add_clause(~s, ~a1,  olit);
+    mSolver.add_clause(~s,  a1, ~olit);
+    mSolver.add_clause( s, ~a0,  olit);
+    mSolver.add_clause( s,  a0, ~olit);
+    // 冗長だが a1 == a0 の時に s によらず伝搬させるための節
+    mSolver.add_clause(~a1, ~a0,  olit);
+    mSolver.add_clause( a1,  a0, ~olit);
+    return olit;
+  }
+
+  // 桁上げ伝搬加算器
+  //
+  // 結果は max(a.size(), b.size()) + 1 ビットで，最上位が桁上げとなる．
+  vector<SatLiteral>
+  add(
+    const vector<SatLiteral>& a,
+    const vector<SatLiteral>& b,
+    SatLiteral cin
+  )
+  {
+    SizeType n = std::max(a.size(), b.size());
+    vector<SatLiteral> ans(n + 1);
+    auto c = cin;
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto ai = bit(a, i);
+      auto bi = bit(b, i);
+      ans[i] = xor3(ai, bi, c);
+      c = maj3(ai, bi, c);
+    }
+    ans[n] = c;
+    return ans;
+  }
+
+  // 減算器
+  //
+  // a - b - bin を a + ~b + ~bin で計算する．
+  // 結果は max(a.size(), b.size()) + 1 ビットで，最上位が借りとなる．
+  vector<SatLiteral>
+  sub(
+    const vector<SatLiteral>& a,
+    const vector<SatLiteral>& b,
+    SatLiteral bin
+  )
+  {
+    SizeType n = std::max(a.size(), b.size());
+    vector<SatLiteral> nb(n);
+    for ( SizeType i = 0; i < n; ++ i ) {
+      nb[i] = ~bit(b, i);
+    }
+    auto ans = add(a, nb, ~bin);
+    ans[n] = ~ans[n];
+    return ans;
+  }
+
+  // a < b の時 true となるリテラルを返す．
+  //
+  // a - b の借りだけを桁上げの連鎖で求める．
+  SatLiteral
+  lt(
+    const vector<SatLiteral>& a,
+    const vector<SatLiteral>& b
+  )
+  {
+    SizeType n = std::max(a.size(), b.size());
+    auto c = one();
+    for ( SizeType i = 0; i < n; ++ i ) {
+      c = maj3(bit(a, i), ~bit(b, i), c);
+    }
+    return ~c;
+  }
+
+  // 全てのビットが0の時 true となるリテラルを返す．
+  SatLiteral
+  is_zero(
+    const vector<SatLiteral>& a
+  )
+  {
+    auto ans = one();
+    for ( auto lit: a ) {
+      ans = and2(ans, ~lit);
+    }
+    return ans;
+  }
+
+  // 部分積を1行ずつ加算する乗算器
+  vector<SatLiteral>
+  mul_shift_add(
+    const vector<SatLiteral>& a,
+    const vector<SatLiteral>& b
+  )
+  {
+    SizeType na = a.size();
+    SizeType nb = b.size();
+    vector<SatLiteral> acc(na + nb, zero());
+    for ( SizeType j = 0; j < nb; ++ j ) {
+      // acc の j + na ビット目以上はまだ0なので，
+      // j ビット目から na ビット分だけ足せばよい．
+      auto c = zero();
+      for ( SizeType i = 0; i < na; ++ i ) {
+	auto p = and2(a[i], b[j]);
+	auto& r = acc[i + j];
+	auto s = xor3(r, p, c);
+	c = maj3(r, p, c);
+	r = s;
+      }
+      acc[j + na] = c;
+    }
+    return acc;
+  }
+
+  // 部分積を列ごとに並べる．
+  vector<vector<SatLiteral>>
+  partial_products(
+    const vector<SatLiteral>& a,
+    const vector<SatLiteral>& b
+  )
+  {
+    SizeType na = a.size();
+    SizeType nb = b.size();
+    vector<vector<SatLiteral>> cols(na + nb);
+    for ( SizeType i = 0; i < na; ++ i ) {
+      for ( SizeType j = 0; j < nb; ++ j ) {
+	push(cols, i + j, and2(a[i], b[j]));
+      }
+    }
+    return cols;
+  }
+
+  // Wallace tree を用いた乗算器
+  vector<SatLiteral>
+  mul_wallace(
+    const vector<SatLiteral>& a,
+    const vector<SatLiteral>& b
+  )
+  {
+    auto cols = partial_products(a, b);
+    while ( max_height(cols) > 2 ) {
+      wallace_stage(cols);
+    }
+    return final_add(cols);
+  }
+
+  // Dadda tree を用いた乗算器
+  vector<SatLiteral>
+  mul_dadda(
+    const vector<SatLiteral>& a,
+    const vector<SatLiteral>& b
+  )
+  {
+    auto cols = partial_products(a, b);
+    SizeType nr = cols.size();
+    // 各段の高さの上限 2, 3, 4, 6, 9, ...
+    vector<SizeType> d_list{2};
+    while ( d_list.back() < max_height(cols) ) {
+      d_list.push_back(d_list.back() * 3 / 2);
+    }
+    d_list.pop_back();
+    // 上限が大きい方から順に，上限を超える分だけを圧縮する．
+    for ( auto p = d_list.rbegin(); p != d_list.rend(); ++ p ) {
+      SizeType d = *p;
+      vector<vector<SatLiteral>> new_cols(nr);
+      for ( SizeType k = 0; k < nr; ++ k ) {
+	// 下の列からの桁上げも高さに数える．
+	vector<SatLiteral> pool(cols[k]);
+	pool.insert(pool.end(), new_cols[k].begin(), new_cols[k].end());
+	new_cols[k].clear();
+	SizeType h = pool.size();
+	SizeType idx = 0;
+	while ( h > d && idx + 2 <= pool.size() ) {
+	  if ( h == d + 1 || idx + 3 > pool.size() ) {
+	    compress(new_cols, k, pool[idx], pool[idx + 1], zero());
+	    idx += 2;
+	    h -= 1;
+	  }
+	  else {
+	    compress(new_cols, k, pool[idx], pool[idx + 1], pool[idx + 2]);
+	    idx += 3;
+	    h -= 2;
+	  }
+	}
+	for ( ; idx < pool.size(); ++ idx ) {
+	  push(new_cols, k, pool[idx]);
+	}
+      }
+      cols.swap(new_cols);
+    }
+    // 通常は不要だが，高さが2を超える列が残っていたら圧縮する．
+    while ( max_height(cols) > 2 ) {
+      wallace_stage(cols);
+    }
+    return final_add(cols);
+  }
+
+
+private:
+
+  // Wallace tree の1段分の圧縮を行う．
+  //
+  // 全ての列で3つずつ全加算器で，余った2つを半加算器で圧縮する．
+  void
+  wallace_stage(
+    vector<vector<SatLiteral>>& cols
+  )
+  {
+    SizeType nr = cols.size();
+    vector<vector<SatLiteral>> new_cols(nr);
+    for ( SizeType k = 0; k < nr; ++ k ) {
+      auto& col = cols[k];
+      SizeType h = col.size();
+      SizeType idx = 0;
+      for ( ; idx + 3 <= h; idx += 3 ) {
+	compress(new_cols, k, col[idx], col[idx + 1], col[idx + 2]);
+      }
+      if ( idx + 2 == h ) {
+	compress(new_cols, k, col[idx], col[idx + 1], zero());
+      }
+      else if ( idx + 1 == h ) {
+	push(new_cols, k, col[idx]);
+      }
+    }
+    cols.swap(new_cols);
+  }
+
+  // cols[k] にリテラルを加える．
+  //
+  // 定数0と積の幅を超える位置は無視する．
+  void
+  push(
+    vector<vector<SatLiteral>>& cols,
+    SizeType k,
+    SatLiteral lit
+  )
+  {
+    if ( k < cols.size() && lit != zero() ) {
+      cols[k].push_back(lit);
+    }
+  }
+
+  // 全加算器(c が0なら半加算器)で k 列目の3つを2つに圧縮する．
+  //
+  // 和は k 列目に，桁上げは k + 1 列目に置く．
+  void
+  compress(
+    vector<vector<SatLiteral>>& cols,
+    SizeType k,
+    SatLiteral a,
+    SatLiteral b,
+    SatLiteral c
+  )
+  {
+    push(cols, k, xor3(a, b, c));
+    push(cols, k + 1, maj3(a, b, c));
+  }
+
+  // 列の高さの最大値を返す．
+  static
+  SizeType
+  max_height(
+    const vector<vector<SatLiteral>>& cols
+  )
+  {
+    SizeType h = 0;
+    for ( auto& col: cols ) {
+      h = std::max(h, col.size());
+    }
+    return h;
+  }
+
+  // 高さ2以下になった列を桁上げ伝搬加算器で足す．
+  vector<SatLiteral>
+  final_add(
+    const vector<vector<SatLiteral>>& cols
+  )
+  {
+    SizeType nr = cols.size();
+    vector<SatLiteral> row0(nr);
+    vector<SatLiteral> row1(nr);
+    for ( SizeType k = 0; k < nr; ++ k ) {
+      row0[k] = bit(cols[k], 0);
+      row1[k] = bit(cols[k], 1);
+    }
+    auto ans = add(row0, row1, zero());
+    // 積は nr ビットに収まるので最上位の桁上げは常に0
+    ans.pop_back();
+    return ans;
+  }
+
+
+private:
+
+  // SATソルバ
+  SatSolver& mSolver;
+
+  // 定数1
+  SatLiteral mOne;
+
+};
+
+// 除算と剰余を求める(引き戻し法)．
+//
+// q は a.size() ビット，r は b.size() ビットとなる．
+// b が0の場合，q は全て1となる．
+void
+divmod(
+  BvBuilder& bld,
+  const vector<SatLiteral>& a,
+  const vector<SatLiteral>& b,
+  vector<SatLiteral>& q,
+  vector<SatLiteral>& r
+)
+{
+  SizeType na = a.size();
+  SizeType nb = b.size();
+  q.clear();
+  q.resize(na);
+  r.clear();
+  r.resize(nb, bld.zero());
+  for ( SizeType i = na; i -- > 0; ) {
+    // 部分剰余を1ビット左にずらして a[i] を入れる．
+    vector<SatLiteral> rr(nb + 1);
+    rr[0] = a[i];
+    for ( SizeType k = 0; k < nb; ++ k ) {
+      rr[k + 1] = r[k];
+    }
+    auto d = bld.sub(rr, b, bld.zero());
+    // 借りが出なければ引ける．
+    auto qi = ~d[nb + 1];
+    q[i] = qi;
+    for ( SizeType k = 0; k < nb; ++ k ) {
+      r[k] = bld.mux(qi, d[k], rr[k]);
+    }
+  }
+}
+
+END_NONAMESPACE
+
+// @brief 定数を表すオブジェクトを作る．
+SatBinaryNum
+SatBinaryNum::constant(
+  SatSolver& solver,
+  SizeType bit_num,
+  SizeType val
+)
+{
+  auto one = solver.const_true();
+  vector<SatLiteral> lit_list(bit_num, ~one);
+  for ( SizeType i = 0; i < bit_num && i < SIZE_BITS; ++ i ) {
+    if ( (val >> i) & 1 ) {
+      lit_list[i] = one;
+    }
+  }
+  return SatBinaryNum{&solver, std::move(lit_list)};
+}
+
+// @brief 初期化を行う．
+void
+SatBinaryNum::init(
+  SatSolver& solver,
+  SizeType bit_num
+)
+{
+  mSolver = &solver;
+  mBitNum = bit_num;
+  mVarArray.clear();
+  mVarArray.resize(mBitNum);
+  for ( SizeType i = 0; i < mBitNum; ++ i ) {
+    mVarArray[i] = solver.new_variable(true);
+  }
+}
+
+// @brief 全てのビットが定数の時 true を返す．
+bool
+SatBinaryNum::is_const() const
+{
+  if ( mBitNum == 0 ) {
+    return true;
+  }
+  ASSERT_COND( mSolver != nullptr );
+
+  auto one = mSolver->const_true();
+  for ( auto lit: mVarArray ) {
+    if ( lit != one && lit != ~one ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief 定数の値を返す．
+SizeType
+SatBinaryNum::const_val() const
+{
+  ASSERT_COND( is_const() );
+
+  SizeType ans = 0;
+  for ( SizeType bit = 0; bit < mBitNum && bit < SIZE_BITS; ++ bit ) {
+    if ( mVarArray[bit] == mSolver->const_true() ) {
+      ans |= (static_cast<SizeType>(1) << bit);
+    }
+  }
+  return ans;
+}
+
+// @brief SATの解から値を得る．
+SizeType
+SatBinaryNum::val(
+  const SatModel& model
+) const
+{
+  SizeType ans = 0;
+  for ( SizeType bit = 0; bit < mBitNum && bit < SIZE_BITS; ++ bit ) {
+    auto lit{bit_var(bit)};
+    if ( model[lit] == SatBool3::True ) {
+      ans |= (static_cast<SizeType>(1) << bit);
+    }
+  }
+  return ans;
+}
+
+// @brief ビット幅を変える．
+SatBinaryNum
+SatBinaryNum::resize(
+  SizeType bit_num
+) const
+{
+  ASSERT_COND( mSolver != nullptr );
+
+  BvBuilder bld{*mSolver};
+  vector<SatLiteral> ans(bit_num);
+  for ( SizeType i = 0; i < bit_num; ++ i ) {
+    ans[i] = bld.bit(mVarArray, i);
+  }
+  return SatBinaryNum{mSolver, std::move(ans)};
+}
+
+// @brief 加算を行う．
+SatBinaryNum
+SatBinaryNum::add(
+  const SatBinaryNum& right
+) const
+{
+  auto& solver = _solver(right);
+  return add(right, ~solver.const_true());
+}
+
+// @brief 桁上げ入力付きの加算を行う．
+SatBinaryNum
+SatBinaryNum::add(
+  const SatBinaryNum& right,
+  SatLiteral carry_in
+) const
+{
+  BvBuilder bld{_solver(right)};
+  return SatBinaryNum{mSolver, bld.add(mVarArray, right.mVarArray, carry_in)};
+}
+
+// @brief 減算を行う．
+SatBinaryNum
+SatBinaryNum::sub(
+  const SatBinaryNum& right
+) const
+{
+  auto& solver = _solver(right);
+  return sub(right, ~solver.const_true());
+}
+
+// @brief 借り入力付きの減算を行う．
+SatBinaryNum
+SatBinaryNum::sub(
+  const SatBinaryNum& right,
+  SatLiteral borrow_in
+) const
+{
+  BvBuilder bld{_solver(right)};
+  return SatBinaryNum{mSolver, bld.sub(mVarArray, right.mVarArray, borrow_in)};
+}
+
+// @brief 乗算を行う．
+SatBinaryNum
+SatBinaryNum::mul(
+  const SatBinaryNum& right,
+  SatMulEnc enc
+) const
+{
+  BvBuilder bld{_solver(right)};
+  switch ( enc ) {
+  case SatMulEnc::ShiftAdd:
+    return SatBinaryNum{mSolver, bld.mul_shift_add(mVarArray, right.mVarArray)};
+  case SatMulEnc::Wallace:
+    return SatBinaryNum{mSolver, bld.mul_wallace(mVarArray, right.mVarArray)};
+  case SatMulEnc::Dadda:
+    return SatBinaryNum{mSolver, bld.mul_dadda(mVarArray, right.mVarArray)};
+  }
+  ASSERT_NOT_REACHED;
+  return SatBinaryNum{};
+}
+
+// @brief 除算を行う．
+SatBinaryNum
+SatBinaryNum::div(
+  const SatBinaryNum& right
+) const
+{
+  BvBuilder bld{_solver(right)};
+  vector<SatLiteral> q;
+  vector<SatLiteral> r;
+  divmod(bld, mVarArray, right.mVarArray, q, r);
+  return SatBinaryNum{mSolver, std::move(q)};
+}
+
+// @brief 剰余を求める．
+SatBinaryNum
+SatBinaryNum::mod(
+  const SatBinaryNum& right
+) const
+{
+  BvBuilder bld{_solver(right)};
+  vector<SatLiteral> q;
+  vector<SatLiteral> r;
+  divmod(bld, mVarArray, right.mVarArray, q, r);
+  // 剰余は被除数以下なので bit_num() ビットに収まる．
+  vector<SatLiteral> ans(mBitNum);
+  for ( SizeType i = 0; i < mBitNum; ++ i ) {
+    ans[i] = bld.bit(r, i);
+  }
+  if ( mBitNum > right.mBitNum ) {
+    // 除数が0の場合，部分剰余の上位ビットがあふれるので
+    // 被除数をそのまま選ぶ．
+    auto b_zero = bld.is_zero(right.mVarArray);
+    for ( SizeType i = 0; i < mBitNum; ++ i ) {
+      ans[i] = bld.mux(b_zero, mVarArray[i], ans[i]);
+    }
+  }
+  return SatBinaryNum{mSolver, std::move(ans)};
+}
+
+// @brief 左シフトを行う．
+SatBinaryNum
+SatBinaryNum::shl(
+  SizeType shift
+) const
+{
+  ASSERT_COND( mSolver != nullptr );
+
+  BvBuilder bld{*mSolver};
+  vector<SatLiteral> ans(mBitNum);
+  for ( SizeType i = 0; i < mBitNum; ++ i ) {
+    ans[i] = i >= shift ? mVarArray[i - shift] : bld.zero();
+  }
+  return SatBinaryNum{mSolver, std::move(ans)};
+}
+
+// @brief 可変量の左シフトを行う．
+SatBinaryNum
+SatBinaryNum::shl(
+  const SatBinaryNum& shift
+) const
+{
+  BvBuilder bld{_solver(shift)};
+  auto cur = mVarArray;
+  for ( SizeType j = 0; j < shift.mBitNum; ++ j ) {
+    auto sj = shift.mVarArray[j];
+    if ( j >= SIZE_BITS - 1 || (static_cast<SizeType>(1) << j) >= mBitNum ) {
+      // 全てのビットがあふれる．
+      for ( auto& lit: cur ) {
+	lit = bld.and2(~sj, lit);
+      }
+      continue;
+    }
+    SizeType amt = static_cast<SizeType>(1) << j;
+    vector<SatLiteral> next(mBitNum);
+    for ( SizeType i = 0; i < mBitNum; ++ i ) {
+      auto shifted = i >= amt ? cur[i - amt] : bld.zero();
+      next[i] = bld.mux(sj, shifted, cur[i]);
+    }
+    cur.swap(next);
+  }
+  return SatBinaryNum{mSolver, std::move(cur)};
+}
+
+// @brief 論理右シフトを行う．
+SatBinaryNum
+SatBinaryNum::lshr(
+  SizeType shift
+) const
+{
+  ASSERT_COND( mSolver != nullptr );
+
+  BvBuilder bld{*mSolver};
+  vector<SatLiteral> ans(mBitNum);
+  for ( SizeType i = 0; i < mBitNum; ++ i ) {
+    ans[i] = shift < mBitNum - i ? mVarArray[i + shift] : bld.zero();
+  }
+  return SatBinaryNum{mSolver, std::move(ans)};
+}
+
+// @brief 可変量の論理右シフトを行う．
+SatBinaryNum
+SatBinaryNum::lshr(
+  const SatBinaryNum& shift
+) const
+{
+  BvBuilder bld{_solver(shift)};
+  auto cur = mVarArray;
+  for ( SizeType j = 0; j < shift.mBitNum; ++ j ) {
+    auto sj = shift.mVarArray[j];
+    if ( j >= SIZE_BITS - 1 || (static_cast<SizeType>(1) << j) >= mBitNum ) {
+      // 全てのビットがあふれる．
+      for ( auto& lit: cur ) {
+	lit = bld.and2(~sj, lit);
+      }
+      continue;
+    }
+    SizeType amt = static_cast<SizeType>(1) << j;
+    vector<SatLiteral> next(mBitNum);
+    for ( SizeType i = 0; i < mBitNum; ++ i ) {
+      auto shifted = bld.bit(cur, i + amt);
+      next[i] = bld.mux(sj, shifted, cur[i]);
+    }
+    cur.swap(next);
+  }
+  return SatBinaryNum{mSolver, std::move(cur)};
+}
+
+// @brief 小さい方の値を返す．
+SatBinaryNum
+SatBinaryNum::min(
+  const SatBinaryNum& right
+) const
+{
+  BvBuilder bld{_solver(right)};
+  auto lt = bld.lt(mVarArray, right.mVarArray);
+  SizeType n = std::max(mBitNum, right.mBitNum);
+  vector<SatLiteral> ans(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    ans[i] = bld.mux(lt, bld.bit(mVarArray, i), bld.bit(right.mVarArray, i));
+  }
+  return SatBinaryNum{mSolver, std::move(ans)};
+}
+
+// @brief 大きい方の値を返す．
+SatBinaryNum
+SatBinaryNum::max(
+  const SatBinaryNum& right
+) const
+{
+  BvBuilder bld{_solver(right)};
+  auto lt = bld.lt(mVarArray, right.mVarArray);
+  SizeType n = std::max(mBitNum, right.mBitNum);
+  vector<SatLiteral> ans(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    ans[i] = bld.mux(lt, bld.bit(right.mVarArray, i), bld.bit(mVarArray, i));
+  }
+  return SatBinaryNum{mSolver, std::move(ans)};
+}
+
+// @brief 二項演算のSATソルバを返す．
+SatSolver&
+SatBinaryNum::_solver(
+  const SatBinaryNum& right
+) const
+{
+  ASSERT_COND( mSolver != nullptr );
+  ASSERT_COND( right.mSolver == nullptr || right.mSolver == mSolver );
+
+  return *mSolver;
+}
+
+END_NAMESPACE_YM_SAT
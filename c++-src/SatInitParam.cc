@@ -7,15 +7,16 @@
 /// All rights reserved.
 
 #include "ym/SatInitParam.h"
+#include <mutex>
 
 
 BEGIN_NAMESPACE_YM_SAT
 
 BEGIN_NONAMESPACE
 
-// デフォルトのオプションを取り出す．
+// デフォルトのオプションを読み込む．
 JsonValue
-default_option()
+read_default_option()
 {
   //  1. 環境変数 YMSAT_CONF が設定されている場合，${YMSAT_CONF} の値
   //     を設定用の json ファイルとみなして読み込む．
@@ -65,6 +66,32 @@ default_option()
   return JsonValue::parse(conf_str);
 }
 
+// デフォルトのオプションを取り出す．
+//
+// 生成のたびにファイルを読み直さないように結果をキャッシュしておく．
+// 環境変数 YMSAT_CONF, YMSAT_CONFDIR の値が変わった場合には読み直す．
+JsonValue
+default_option()
+{
+  auto conf = getenv("YMSAT_CONF");
+  auto confdir = getenv("YMSAT_CONFDIR");
+  auto key = string{conf != nullptr ? conf : ""} + "\n"
+    + string{confdir != nullptr ? confdir : ""};
+
+  static std::mutex mtx;
+  static bool cached = false;
+  static string cached_key;
+  static JsonValue cached_value;
+
+  std::lock_guard<std::mutex> lock{mtx};
+  if ( !cached || cached_key != key ) {
+    cached_value = read_default_option();
+    cached_key = key;
+    cached = true;
+  }
+  return cached_value;
+}
+
 END_NONAMESPACE
 
 //////////////////////////////////////////////////////////////////////
@@ -194,6 +221,14 @@ SatInitParam::check_type()
   else if ( t == "ymsat1_old" ) {
     ;
   }
+  else if ( t == "portfolio" ) {
+    // 複数のソルバを並列に走らせる．
+    ;
+  }
+  else if ( t == "cube" ) {
+    // cube-and-conquer 方式の並列ソルバ
+    ;
+  }
   else {
     ostringstream buf;
     buf << "SatInitParam: unknown type '" << t << "', '";
@@ -53,7 +53,8 @@ SatLogger::new_variable(
 // @brief 節を追加する．
 void
 SatLogger::add_clause(
-  const vector<SatLiteral>& lits
+  SizeType,
+  const SatLiteral*
 )
 {
 }
@@ -39,13 +39,17 @@ SatLoggerS::new_variable(SatLiteral lit)
 }
 
 // @brief 節を追加する．
-// @param[in] lits リテラルのベクタ
+// @param[in] n リテラル数
+// @param[in] lits リテラルの配列
 void
-SatLoggerS::add_clause(const vector<SatLiteral>& lits)
+SatLoggerS::add_clause(
+  SizeType n,
+  const SatLiteral* lits
+)
 {
   *mS << "A";
-  for ( auto l: lits ) {
-    put_lit(l);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    put_lit(lits[i]);
   }
   *mS << endl;
 }
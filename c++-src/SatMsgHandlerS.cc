@@ -76,4 +76,18 @@ SatMsgHandlerS::print_footer(const SatStats& stats)
      << "CPU time(ms)      : " << stats.mTime.count() << endl;
 }
 
+// @brief 最適化の途中経過の出力
+void
+SatMsgHandlerS::print_bound(
+  std::int64_t lower,
+  std::int64_t upper
+)
+{
+  mS << "| bound     : "
+     << setw(12) << lower
+     << " <= optimum <= "
+     << setw(12) << upper
+     << " |" << endl;
+}
+
 END_NAMESPACE_YM_SAT
@@ -3,12 +3,13 @@
 /// @brief SatOrderedSet の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2019 Yusuke Matsunaga
+/// Copyright (C) 2019, 2025 Yusuke Matsunaga
 /// All rights reserved.
 
 #include "ym/SatOrderedSet.h"
 #include "ym/SatSolver.h"
 #include "ym/SatModel.h"
+#include <limits>
 
 
 BEGIN_NAMESPACE_YM_SAT
@@ -17,59 +18,152 @@ BEGIN_NAMESPACE_YM_SAT
 SatOrderedSet::SatOrderedSet(
   SatSolver& solver,
   int min,
-  int max
+  int max,
+  bool lazy
 ) : mSolver{solver},
     mMin{min},
     mMax{max}
 {
   ASSERT_COND( min <= max );
 
-  mPriVarArray.clear();
-  mVarArray.clear();
-
   SizeType n = mMax - mMin + 1;
   SizeType n1 = n - 1;
 
+  mVarArray.clear();
+  mVarArray.resize(n, SatLiteral::X);
+  mPriVarArray.clear();
+  mPriVarArray.resize(n1, SatLiteral::X);
+
+  if ( lazy ) {
+    // 変数は必要になった時に作る．
+    return;
+  }
+
   // 2種類の変数ベクタを作る．
   // mPriVarArray は順序符号化
-  if ( n1 > 0 ) {
-    mPriVarArray.resize(n1);
-    for ( SizeType i = 0; i < n1; ++ i ) {
-      mPriVarArray[i] = mSolver.new_variable();
-      // 順序制約を作る．
-      if ( i > 0 ) {
-	auto lit1 = mPriVarArray[i - 1];
-	auto lit2 = mPriVarArray[i + 0];
-	mSolver.add_clause( lit1, ~lit2);
-      }
+  for ( SizeType i = 0; i < n1; ++ i ) {
+    mPriVarArray[i] = mSolver.new_variable(true);
+    // 順序制約を作る．
+    if ( i > 0 ) {
+      auto lit1 = mPriVarArray[i - 1];
+      auto lit2 = mPriVarArray[i + 0];
+      mSolver.add_clause( lit1, ~lit2);
     }
   }
 
   // mVarArray は one-hot 符号化を行う．
-  mVarArray.resize(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    _make_var(mMin + i);
+  }
+}
 
-  if ( n1 > 0 ) {
-    mVarArray[0] = ~mPriVarArray[0];
-    for ( int i = 1; i < n1; ++ i ) {
-      mVarArray[i] = mSolver.new_variable();
-    }
-    mVarArray[n1] = mPriVarArray[n1 - 1];
+// @brief 値に対応する変数のベクタを返す．
+const vector<SatLiteral>&
+SatOrderedSet::vars() const
+{
+  for ( SizeType i = 0; i < mVarArray.size(); ++ i ) {
+    var(mMin + i);
   }
-  else {
-    auto lit = mSolver.new_variable();
-    mVarArray[0] = lit;
-    solver.add_clause(lit);
+  return mVarArray;
+}
+
+// @brief 順序符号化された変数のベクタを返す．
+const vector<SatLiteral>&
+SatOrderedSet::pri_vars() const
+{
+  for ( SizeType i = 0; i < mPriVarArray.size(); ++ i ) {
+    pri_var(mMin + i + 1);
   }
+  return mPriVarArray;
+}
 
-  // 順序制約から one-hot へ符号化を行う．
-  for ( SizeType i = 1; i < n1; ++ i ) {
-    auto lit1 = mPriVarArray[i - 1];
-    auto lit2 = mPriVarArray[i + 0];
-    auto lit = mVarArray[i];
+// @brief 値が val 以上であることを表すリテラルを返す．
+SatLiteral
+SatOrderedSet::ge_lit(
+  int val
+) const
+{
+  if ( val <= mMin ) {
+    return mSolver.const_true();
+  }
+  if ( val > mMax ) {
+    return ~mSolver.const_true();
+  }
+  return pri_var(val);
+}
+
+// @brief pri_var(val) の変数を作る．
+SatLiteral
+SatOrderedSet::_new_pri_var(
+  int val
+) const
+{
+  // 遅延生成される変数の順序制約は条件リテラルによらずに成り立つ．
+  auto cond_lits = mSolver._suspend_conditional_literals();
+
+  auto lit = mSolver.new_variable(true);
+  mPriVarArray[val - mMin - 1] = lit;
+
+  // 作成済みの両隣の変数との間の順序制約を作る．
+  // 両隣どうしの順序制約はそのまま残しても問題ない．
+  auto p = mPriValSet.lower_bound(val);
+  if ( p != mPriValSet.end() ) {
+    auto ulit = mPriVarArray[*p - mMin - 1];
+    mSolver.add_clause( lit, ~ulit);
+  }
+  if ( p != mPriValSet.begin() ) {
+    -- p;
+    auto llit = mPriVarArray[*p - mMin - 1];
+    mSolver.add_clause(llit, ~lit);
+  }
+  mPriValSet.insert(val);
+
+  mSolver._resume_conditional_literals(std::move(cond_lits));
+  return lit;
+}
+
+// @brief var(val) の変数を作る．
+SatLiteral
+SatOrderedSet::_new_var(
+  int val
+) const
+{
+  // 遅延生成される変数の定義は条件リテラルによらずに成り立つ．
+  auto cond_lits = mSolver._suspend_conditional_literals();
+  auto lit = _make_var(val);
+  mSolver._resume_conditional_literals(std::move(cond_lits));
+  return lit;
+}
+
+// @brief var(val) の変数と one-hot 符号化の節を作る．
+SatLiteral
+SatOrderedSet::_make_var(
+  int val
+) const
+{
+  SatLiteral lit;
+  if ( mPriVarArray.empty() ) {
+    // 値は一つしかない．
+    lit = mSolver.new_variable(true);
+    mSolver.add_clause(lit);
+  }
+  else if ( val == mMin ) {
+    lit = ~pri_var(mMin + 1);
+  }
+  else if ( val == mMax ) {
+    lit = pri_var(mMax);
+  }
+  else {
+    // 順序制約から one-hot へ符号化を行う．
+    auto lit1 = pri_var(val);
+    auto lit2 = pri_var(val + 1);
+    lit = mSolver.new_variable(true);
     mSolver.add_clause(~lit,  lit1       );
     mSolver.add_clause(~lit,        ~lit2);
     mSolver.add_clause( lit, ~lit1,  lit2);
   }
+  mVarArray[val - mMin] = lit;
+  return lit;
 }
 
 // @brief SATの解から値を得る．
@@ -78,20 +172,17 @@ SatOrderedSet::val(
   const SatModel& model
 ) const
 {
-  SizeType n = mVarArray.size();
-  if ( n > 1 ) {
-    for ( SizeType i = 0; i < n; ++ i ) {
-      auto lit = mVarArray[i];
-      if ( model[lit] == SatBool3::True ) {
-	return i + mMin;
-      }
+  // true になっている順序符号化の変数のうち最大の値を求める．
+  // 遅延生成の場合，作られていない変数の値は制約に現れないので
+  // その区間の最小値を選べばよい．
+  int ans = mMin;
+  for ( SizeType i = 0; i < mPriVarArray.size(); ++ i ) {
+    auto lit = mPriVarArray[i];
+    if ( lit.is_valid() && model[lit] == SatBool3::True ) {
+      ans = mMin + i + 1;
     }
-    ASSERT_NOT_REACHED;
-    return -1;
-  }
-  else {
-    return mMin;
   }
+  return ans;
 }
 
 // @brief この変数の値が lval 以上になるという制約を作る．
@@ -107,7 +198,7 @@ SatOrderedSet::add_ge_constraint(
     return;
   }
 
-  auto lit = mPriVarArray[lval - mMin - 1];
+  auto lit = pri_var(lval);
   mSolver.add_clause(lit);
 }
 
@@ -124,7 +215,7 @@ SatOrderedSet::add_le_constraint(
     return;
   }
 
-  auto lit = mPriVarArray[uval - mMin];
+  auto lit = pri_var(uval + 1);
   mSolver.add_clause(~lit);
 }
 
@@ -144,9 +235,382 @@ SatOrderedSet::add_dropoff_constraint(
   }
   // この時点で uval == mMax, lval == mMin はない．
 
-  auto lit1 = mPriVarArray[uval - mMin];
-  auto lit2 = mPriVarArray[lval - mMin - 1];
+  auto lit1 = pri_var(uval + 1);
+  auto lit2 = pri_var(lval);
   mSolver.add_clause(~lit1, lit2);
 }
 
+BEGIN_NONAMESPACE
+
+// a / b を負の無限大方向に丸めた値を返す．
+std::int64_t
+floor_div(
+  std::int64_t a,
+  std::int64_t b
+)
+{
+  auto q = a / b;
+  if ( (a % b) != 0 && ((a < 0) != (b < 0)) ) {
+    -- q;
+  }
+  return q;
+}
+
+// a / b を正の無限大方向に丸めた値を返す．
+std::int64_t
+ceil_div(
+  std::int64_t a,
+  std::int64_t b
+)
+{
+  return - floor_div(- a, b);
+}
+
+// 線形制約の項(係数 * 変数)
+struct Term
+{
+  // 係数
+  std::int64_t mCoef;
+
+  // 変数
+  const SatOrderedSet* mVar;
+
+  // 項の最小値
+  std::int64_t
+  min() const
+  {
+    return mCoef > 0 ? mCoef * mVar->min() : mCoef * mVar->max();
+  }
+
+  // 項の最大値
+  std::int64_t
+  max() const
+  {
+    return mCoef > 0 ? mCoef * mVar->max() : mCoef * mVar->min();
+  }
+
+  // 値の数
+  SizeType
+  size() const
+  {
+    return mVar->max() - mVar->min() + 1;
+  }
+
+  // 項の値が d 以上であることを表すリテラルを返す．
+  SatLiteral
+  ge_lit(
+    std::int64_t d
+  ) const
+  {
+    // 変数の範囲外の値は ge_lit()/le_lit() が定数にするので，
+    // int に収まるように範囲の一つ外側に丸めておく．
+    auto clip = [&](std::int64_t v) -> int {
+      v = std::max<std::int64_t>(v, mVar->min() - 1);
+      v = std::min<std::int64_t>(v, mVar->max() + 1);
+      return static_cast<int>(v);
+    };
+    if ( mCoef > 0 ) {
+      return mVar->ge_lit(clip(ceil_div(d, mCoef)));
+    }
+    else {
+      return mVar->le_lit(clip(floor_div(d, mCoef)));
+    }
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+// Σ t_i <= c の support clause を作るクラス
+//
+// Σ d_i = c + 1 となる全ての (d_0, ..., d_{n-1}) について
+// 節 ∨ ~(t_i >= d_i) を作る．d_{n-1} 以外は項の取りうる値を列挙するので，
+// 値の数の最も多い項を最後に置くとよい．
+//////////////////////////////////////////////////////////////////////
+class LinearLeGen
+{
+public:
+
+  // コンストラクタ
+  LinearLeGen(
+    SatSolver& solver,
+    const vector<Term>& term_list,
+    std::int64_t c
+  ) : mSolver{solver},
+      mTermList{term_list},
+      mC{c},
+      mOne{solver.const_true()}
+  {
+    SizeType n = mTermList.size();
+    mSufMax.resize(n + 1, 0);
+    mSufMin.resize(n + 1, 0);
+    for ( SizeType i = n; i -- > 0; ) {
+      mSufMax[i] = mSufMax[i + 1] + mTermList[i].max();
+      mSufMin[i] = mSufMin[i + 1] + mTermList[i].min();
+    }
+  }
+
+  // 節を作る．
+  void
+  gen()
+  {
+    if ( mTermList.empty() ) {
+      if ( mC < 0 ) {
+	mSolver.add_clause(vector<SatLiteral>{});
+      }
+      return;
+    }
+    vector<SatLiteral> clause;
+    gen_sub(0, 0, clause);
+  }
+
+
+private:
+
+  // idx 番目以降の項の d_i を決めて節を作る．
+  void
+  gen_sub(
+    SizeType idx,
+    std::int64_t dsum,
+    vector<SatLiteral>& clause
+  )
+  {
+    if ( dsum + mSufMax[idx] <= mC ) {
+      // 残りの項がどんな値でも成り立つ．
+      return;
+    }
+    auto& term = mTermList[idx];
+    if ( idx == mTermList.size() - 1 ) {
+      push_and_call(clause, ~term.ge_lit(mC + 1 - dsum), [&]() {
+	mSolver.add_clause(clause);
+      });
+      return;
+    }
+    auto step = std::abs(term.mCoef);
+    auto d0 = term.min();
+    // dlow 未満の d では残りの項がどんな値でも成り立つので
+    // リテラルを作らずに飛ばす．
+    auto dlow = mC + 1 - dsum - mSufMax[idx + 1];
+    if ( d0 < dlow ) {
+      d0 += ceil_div(dlow - d0, step) * step;
+    }
+    for ( auto d = d0; d <= term.max(); d += step ) {
+      push_and_call(clause, ~term.ge_lit(d), [&]() {
+	gen_sub(idx + 1, dsum + d, clause);
+      });
+      if ( dsum + d + mSufMin[idx + 1] > mC ) {
+	// これより大きな d の節はこの節に包含される．
+	break;
+      }
+    }
+  }
+
+  // 定数でなければ lit を clause に加えて func を呼ぶ．
+  //
+  // lit が定数1の場合は節が充足されているので何もしない．
+  template<typename Func>
+  void
+  push_and_call(
+    vector<SatLiteral>& clause,
+    SatLiteral lit,
+    Func func
+  )
+  {
+    if ( lit == mOne ) {
+      return;
+    }
+    if ( lit == ~mOne ) {
+      func();
+      return;
+    }
+    clause.push_back(lit);
+    func();
+    clause.pop_back();
+  }
+
+
+private:
+
+  // SATソルバ
+  SatSolver& mSolver;
+
+  // 項のリスト
+  const vector<Term>& mTermList;
+
+  // 右辺の値
+  std::int64_t mC;
+
+  // 定数1
+  SatLiteral mOne;
+
+  // i 番目以降の項の最大値の和
+  vector<std::int64_t> mSufMax;
+
+  // i 番目以降の項の最小値の和
+  vector<std::int64_t> mSufMin;
+
+};
+
+// Σ coef_list[i] * var_list[i] <= c を作る．
+void
+add_linear_le(
+  SatSolver& solver,
+  const vector<std::int64_t>& coef_list,
+  const vector<const SatOrderedSet*>& var_list,
+  std::int64_t c
+)
+{
+  SizeType n = coef_list.size();
+  ASSERT_COND( var_list.size() == n );
+
+  vector<Term> term_list;
+  term_list.reserve(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( coef_list[i] != 0 ) {
+      term_list.push_back(Term{coef_list[i], var_list[i]});
+    }
+  }
+  // 値の数の少ない順に並べる．
+  auto comp = [](const Term& a, const Term& b) {
+    return a.size() < b.size();
+  };
+  std::stable_sort(term_list.begin(), term_list.end(), comp);
+
+  // 4項以上の場合は値の数の少ない2項の部分和 y >= t_0 + t_1 を作って置き換える．
+  // y は最後の制約を作り終えるまで生きていればよい．
+  vector<unique_ptr<SatOrderedSet>> aux_list;
+  while ( term_list.size() > 3 ) {
+    auto& t0 = term_list[0];
+    auto& t1 = term_list[1];
+    auto lo = t0.min() + t1.min();
+    auto hi = t0.max() + t1.max();
+    ASSERT_COND( std::numeric_limits<int>::min() <= lo );
+    ASSERT_COND( hi <= std::numeric_limits<int>::max() );
+    aux_list.push_back(unique_ptr<SatOrderedSet>{
+	new SatOrderedSet{solver, static_cast<int>(lo), static_cast<int>(hi), true}});
+    auto y = aux_list.back().get();
+    vector<Term> sub_list{t0, t1, Term{-1, y}};
+    LinearLeGen{solver, sub_list, 0}.gen();
+    Term ty{1, y};
+    term_list.erase(term_list.begin(), term_list.begin() + 2);
+    auto pos = std::upper_bound(term_list.begin(), term_list.end(), ty, comp);
+    term_list.insert(pos, ty);
+  }
+  LinearLeGen{solver, term_list, c}.gen();
+}
+
+END_NONAMESPACE
+
+// @brief this + y <= c という制約を作る．
+void
+SatOrderedSet::add_sum_le_constraint(
+  const SatOrderedSet& y,
+  int c
+)
+{
+  add_linear_le_constraint({1, 1}, {this, &y}, c);
+}
+
+// @brief this + y >= c という制約を作る．
+void
+SatOrderedSet::add_sum_ge_constraint(
+  const SatOrderedSet& y,
+  int c
+)
+{
+  add_linear_ge_constraint({1, 1}, {this, &y}, c);
+}
+
+// @brief this + y == z という制約を作る．
+void
+SatOrderedSet::add_sum_eq_constraint(
+  const SatOrderedSet& y,
+  const SatOrderedSet& z
+)
+{
+  add_linear_eq_constraint({1, 1, -1}, {this, &y, &z}, 0);
+}
+
+// @brief this - y <= c という制約を作る．
+void
+SatOrderedSet::add_diff_le_constraint(
+  const SatOrderedSet& y,
+  int c
+)
+{
+  add_linear_le_constraint({1, -1}, {this, &y}, c);
+}
+
+// @brief Σ coef_list[i] * var_list[i] <= c という制約を作る．
+void
+SatOrderedSet::add_linear_le_constraint(
+  const vector<int>& coef_list,
+  const vector<const SatOrderedSet*>& var_list,
+  int c
+)
+{
+  ASSERT_COND( !var_list.empty() );
+
+  vector<std::int64_t> coef64_list(coef_list.begin(), coef_list.end());
+  add_linear_le(var_list.front()->mSolver, coef64_list, var_list, c);
+}
+
+// @brief Σ coef_list[i] * var_list[i] >= c という制約を作る．
+void
+SatOrderedSet::add_linear_ge_constraint(
+  const vector<int>& coef_list,
+  const vector<const SatOrderedSet*>& var_list,
+  int c
+)
+{
+  ASSERT_COND( !var_list.empty() );
+
+  // - Σ coef_list[i] * var_list[i] <= - c に変換する．
+  vector<std::int64_t> coef64_list;
+  coef64_list.reserve(coef_list.size());
+  for ( auto coef: coef_list ) {
+    coef64_list.push_back(- static_cast<std::int64_t>(coef));
+  }
+  add_linear_le(var_list.front()->mSolver, coef64_list, var_list,
+		- static_cast<std::int64_t>(c));
+}
+
+// @brief Σ coef_list[i] * var_list[i] == c という制約を作る．
+void
+SatOrderedSet::add_linear_eq_constraint(
+  const vector<int>& coef_list,
+  const vector<const SatOrderedSet*>& var_list,
+  int c
+)
+{
+  add_linear_le_constraint(coef_list, var_list, c);
+  add_linear_ge_constraint(coef_list, var_list, c);
+}
+
+// @brief 全ての変数の値が異なるという制約を作る．
+void
+SatOrderedSet::add_alldiff_constraint(
+  const vector<const SatOrderedSet*>& var_list
+)
+{
+  ASSERT_COND( !var_list.empty() );
+
+  auto& solver = var_list.front()->mSolver;
+  int lo = var_list.front()->min();
+  int hi = var_list.front()->max();
+  for ( auto var: var_list ) {
+    lo = std::min(lo, var->min());
+    hi = std::max(hi, var->max());
+  }
+  for ( std::int64_t val = lo; val <= hi; ++ val ) {
+    vector<SatLiteral> lit_list;
+    for ( auto var: var_list ) {
+      if ( var->min() <= val && val <= var->max() ) {
+	lit_list.push_back(var->var(static_cast<int>(val)));
+      }
+    }
+    if ( lit_list.size() > 1 ) {
+      solver.add_at_most_one(lit_list);
+    }
+  }
+}
+
 END_NAMESPACE_YM_SAT
@@ -10,12 +10,90 @@
 #include "ym/IntervalTimer.h"
 #include "SatSolverImpl.h"
 #include "SatLogger.h"
+#include "DimacsParser.h"
+#include "BinaryCnf.h"
+#include "DimacsWriter.h"
+#include "Aig2Cnf.h"
+#include "Expr2Cnf.h"
 
 
 BEGIN_NAMESPACE_YM_SAT
 
 const SatLiteral SatLiteral::X;
 
+BEGIN_NONAMESPACE
+
+// 名前から個数制約の符号化方法を得る．
+SatCardEnc
+str_to_card_enc(
+  const string& name
+)
+{
+  for ( auto enc: {SatCardEnc::Auto,
+		   SatCardEnc::Counter,
+		   SatCardEnc::SeqCounter,
+		   SatCardEnc::Totalizer,
+		   SatCardEnc::ModTotalizer,
+		   SatCardEnc::CardNetwork} ) {
+    ostringstream buf;
+    buf << enc;
+    if ( buf.str() == name ) {
+      return enc;
+    }
+  }
+  ostringstream buf;
+  buf << name << ": unknown card_encoding";
+  throw std::invalid_argument{buf.str()};
+}
+
+// 名前から at-most-one 制約の符号化方法を得る．
+SatAmoEnc
+str_to_amo_enc(
+  const string& name
+)
+{
+  for ( auto enc: {SatAmoEnc::Auto,
+		   SatAmoEnc::Pairwise,
+		   SatAmoEnc::Halving,
+		   SatAmoEnc::Ladder,
+		   SatAmoEnc::Commander,
+		   SatAmoEnc::Product,
+		   SatAmoEnc::Bimander} ) {
+    ostringstream buf;
+    buf << enc;
+    if ( buf.str() == name ) {
+      return enc;
+    }
+  }
+  ostringstream buf;
+  buf << name << ": unknown amo_encoding";
+  throw std::invalid_argument{buf.str()};
+}
+
+// 名前から擬似ブール制約の展開方法を得る．
+SatPbEnc
+str_to_pb_enc(
+  const string& name
+)
+{
+  for ( auto enc: {SatPbEnc::Auto,
+		   SatPbEnc::Adder,
+		   SatPbEnc::Bdd,
+		   SatPbEnc::GenTotalizer,
+		   SatPbEnc::SortNetwork} ) {
+    ostringstream buf;
+    buf << enc;
+    if ( buf.str() == name ) {
+      return enc;
+    }
+  }
+  ostringstream buf;
+  buf << name << ": unknown pb_encoding";
+  throw std::invalid_argument{buf.str()};
+}
+
+END_NONAMESPACE
+
 //////////////////////////////////////////////////////////////////////
 // SatSolver
 //////////////////////////////////////////////////////////////////////
@@ -23,9 +101,35 @@ const SatLiteral SatLiteral::X;
 // @brief コンストラクタ
 SatSolver::SatSolver(
   const SatInitParam& init_param
-) : mImpl{SatSolverImpl::new_impl(init_param)},
+) : mType{init_param},
+    mImpl{SatSolverImpl::new_impl(init_param)},
     mLogger{SatLogger::new_impl(init_param.js_obj())}
 {
+  auto& js_obj = init_param.js_obj();
+  if ( js_obj.has_key("lean") && js_obj["lean"].get_bool() ) {
+    mKeepClauses = false;
+  }
+  if ( js_obj.has_key("tseitin_encoding") && js_obj["tseitin_encoding"].get_bool() ) {
+    mTseitinEncoding = true;
+  }
+  if ( js_obj.has_key("xor_cut") ) {
+    set_xor_cut(js_obj["xor_cut"].get_int());
+  }
+  if ( js_obj.has_key("native_xor") && !js_obj["native_xor"].get_bool() ) {
+    mNativeXor = false;
+  }
+  if ( js_obj.has_key("native_pb") && !js_obj["native_pb"].get_bool() ) {
+    mNativePb = false;
+  }
+  if ( js_obj.has_key("card_encoding") ) {
+    mCardEnc = str_to_card_enc(js_obj["card_encoding"].get_string());
+  }
+  if ( js_obj.has_key("amo_encoding") ) {
+    mAmoEnc = str_to_amo_enc(js_obj["amo_encoding"].get_string());
+  }
+  if ( js_obj.has_key("pb_encoding") ) {
+    mPbEnc = str_to_pb_enc(js_obj["pb_encoding"].get_string());
+  }
 }
 
 // @brief デストラクタ
@@ -35,6 +139,48 @@ SatSolver::~SatSolver()
   // デストラクタは default 定義できない．
 }
 
+// @brief 変数と節をすべて削除して生成直後の状態に戻す．
+void
+SatSolver::reset()
+{
+  if ( !mImpl->reset() ) {
+    mImpl = SatSolverImpl::new_impl(mType);
+    for ( auto msg_handler: mMsgHandlerList ) {
+      mImpl->reg_msg_handler(msg_handler);
+    }
+  }
+  mConditionalLits.clear();
+  mConstTrue = SatLiteral::X;
+  mModel = SatModel{};
+  mConflictLiterals.clear();
+  mVariableNum = 0;
+  mDecisionList.clear();
+  mClauseNum = 0;
+  mLiteralNum = 0;
+  mClauseLits.clear();
+  mClauseBegin.clear();
+  mClauseBegin.push_back(0);
+  mXorNum = 0;
+  mXorLits.clear();
+  mXorBegin.clear();
+  mXorBegin.push_back(0);
+  mXorRhs.clear();
+  mPbNum = 0;
+  mPbLits.clear();
+  mPbWeights.clear();
+  mPbBegin.clear();
+  mPbBegin.push_back(0);
+  mPbBound.clear();
+  mCloneList.clear();
+  mConflictBudget = 0;
+  mPropagationBudget = 0;
+  mHasConflictBudget = false;
+  mHasPropagationBudget = false;
+  mBudgetNum = 0;
+  mAig2CnfList.clear();
+  mExpr2CnfList.clear();
+}
+
 // @brief 変数を追加する．
 SatLiteral
 SatSolver::new_variable(
@@ -46,10 +192,23 @@ SatSolver::new_variable(
   mLogger->new_variable(lit);
 
   ++ mVariableNum;
+  mDecisionList.push_back(decision);
 
   return lit;
 }
 
+// @brief 定数1を表すリテラルを返す．
+SatLiteral
+SatSolver::const_true()
+{
+  if ( !mConstTrue.is_valid() ) {
+    mConstTrue = new_variable(true);
+    // 条件リテラルを付けずに固定する．
+    _add_clause_sub(1, &mConstTrue);
+  }
+  return mConstTrue;
+}
+
 // @brief assumption 付きの SAT 問題を解く．
 SatBool3
 SatSolver::solve(
@@ -88,30 +247,163 @@ SatSolver::sane() const
 SatStats
 SatSolver::get_stats() const
 {
-  return mImpl->get_stats();
+  auto stats = mImpl->get_stats();
+  for ( auto& aig2cnf: mAig2CnfList ) {
+    stats.mAigCacheHit += aig2cnf->hit_num();
+    stats.mAigCacheMiss += aig2cnf->miss_num();
+  }
+  for ( auto& expr2cnf: mExpr2CnfList ) {
+    stats.mExprCacheHit += expr2cnf->hit_num();
+    stats.mExprCacheMiss += expr2cnf->miss_num();
+  }
+  return stats;
 }
 
 // @brief DIMACS 形式で制約節を出力する．
 void
 SatSolver::write_DIMACS(
+  ostream& s,
+  SizeType thread_num
+) const
+{
+  if ( mXorNum > 0 ) {
+    throw std::runtime_error{"write_DIMACS(): XOR constraints cannot be written"};
+  }
+  if ( mPbNum > 0 ) {
+    throw std::runtime_error{"write_DIMACS(): pseudo-Boolean constraints cannot be written"};
+  }
+
+  DimacsWriter writer{s, thread_num};
+  if ( mKeepClauses ) {
+    writer.write(variable_num(), mClauseLits, mClauseBegin);
+    return;
+  }
+
+  // 実装から取り出した節を出力する．
+  // ヘッダに節の数を書く必要があるので2回列挙する．
+  SizeType nc = 0;
+  _enum_impl_clauses("write_DIMACS",
+		     [&](const vector<SatLiteral>&) { ++ nc; });
+  writer.write_header(variable_num(), nc);
+  _enum_impl_clauses("write_DIMACS",
+		     [&](const vector<SatLiteral>& lits) { writer.put_clause(lits); });
+  writer.flush();
+}
+
+// @brief バイナリ CNF 形式で制約節を出力する．
+void
+SatSolver::write_binary_CNF(
   ostream& s
 ) const
 {
-  s << "p cnf " << variable_num() << " " << clause_num() << endl;
-  for ( auto clause: mClauseList ) {
-    for ( auto lit: clause ) {
-      auto var = lit.varid();
-      int idx = var + 1;
-      if ( lit.is_negative() ) {
-	s << " -";
-      }
-      else {
-	s << " ";
+  if ( mXorNum > 0 ) {
+    throw std::runtime_error{"write_binary_CNF(): XOR constraints cannot be written"};
+  }
+  if ( mPbNum > 0 ) {
+    throw std::runtime_error{"write_binary_CNF(): pseudo-Boolean constraints cannot be written"};
+  }
+
+  if ( mKeepClauses ) {
+    BinaryCnfWriter writer{s, variable_num(), clause_num(), literal_num()};
+    for ( SizeType i = 0; i < mClauseNum; ++ i ) {
+      writer.put_clause(mClauseLits.data() + mClauseBegin[i],
+			mClauseLits.data() + mClauseBegin[i + 1]);
+    }
+    return;
+  }
+
+  SizeType nc = 0;
+  SizeType nl = 0;
+  _enum_impl_clauses("write_binary_CNF",
+		     [&](const vector<SatLiteral>& lits) {
+		       ++ nc;
+		       nl += lits.size();
+		     });
+  BinaryCnfWriter writer{s, variable_num(), nc, nl};
+  _enum_impl_clauses("write_binary_CNF",
+		     [&](const vector<SatLiteral>& lits) { writer.put_clause(lits); });
+}
+
+// @brief 省メモリモードの時に実装から節を列挙する．
+void
+SatSolver::_enum_impl_clauses(
+  const char* func_name,
+  const std::function<void(const vector<SatLiteral>&)>& func
+) const
+{
+  if ( !mImpl->enum_clauses(func) ) {
+    ostringstream buf;
+    buf << func_name << "(): clauses are not available in lean mode";
+    throw std::runtime_error{buf.str()};
+  }
+}
+
+BEGIN_NONAMESPACE
+
+// DimacsParser から SatSolver に節を追加する関数を作る．
+DimacsParser::ClauseFunc
+dimacs_clause_func(
+  SatSolver& solver,
+  vector<SatLiteral>& lit_map
+)
+{
+  return [&solver, &lit_map](const vector<int>& lits) {
+    vector<SatLiteral> tmp_lits;
+    tmp_lits.reserve(lits.size());
+    for ( auto l: lits ) {
+      SizeType var = abs(l) - 1;
+      while ( lit_map.size() <= var ) {
+	lit_map.push_back(solver.new_variable(true));
       }
-      s << idx;
+      auto lit = lit_map[var];
+      tmp_lits.push_back(l < 0 ? ~lit : lit);
     }
-    s << " 0" << endl;
+    solver.add_clause(tmp_lits);
+  };
+}
+
+// 読み込みエラーの例外を送出する．
+void
+dimacs_error(
+  const DimacsParser& parser
+)
+{
+  string msg = "read_DIMACS() failed";
+  for ( auto& m: parser.message_list() ) {
+    msg += ": " + m;
+  }
+  throw std::invalid_argument{msg};
+}
+
+END_NONAMESPACE
+
+// @brief DIMACS 形式のファイルを読み込んで制約節を追加する．
+vector<SatLiteral>
+SatSolver::read_DIMACS(
+  const string& filename,
+  SizeType thread_num
+)
+{
+  vector<SatLiteral> lit_map;
+  DimacsParser parser{dimacs_clause_func(*this, lit_map), thread_num};
+  if ( !parser.read(filename) ) {
+    dimacs_error(parser);
   }
+  return lit_map;
+}
+
+// @brief DIMACS 形式のデータをストリームから読み込んで制約節を追加する．
+vector<SatLiteral>
+SatSolver::read_DIMACS(
+  istream& s
+)
+{
+  vector<SatLiteral> lit_map;
+  DimacsParser parser{dimacs_clause_func(*this, lit_map)};
+  if ( !parser.read(s) ) {
+    dimacs_error(parser);
+  }
+  return lit_map;
 }
 
 // @brief トータルの矛盾回数の制限を設定する．
@@ -120,6 +412,10 @@ SatSolver::set_conflict_budget(
   SizeType val
 )
 {
+  // solve_batch() の複製にも反映させるために記録しておく．
+  mConflictBudget = val;
+  mHasConflictBudget = true;
+  ++ mBudgetNum;
   return mImpl->set_conflict_budget(val);
 }
 
@@ -129,6 +425,10 @@ SatSolver::set_propagation_budget(
   SizeType val
 )
 {
+  // solve_batch() の複製にも反映させるために記録しておく．
+  mPropagationBudget = val;
+  mHasPropagationBudget = true;
+  ++ mBudgetNum;
   return mImpl->set_propagation_budget(val);
 }
 
@@ -139,6 +439,7 @@ SatSolver::reg_msg_handler(
 )
 {
   mImpl->reg_msg_handler(msg_handler);
+  mMsgHandlerList.push_back(msg_handler);
 }
 
 // @brief 時間計測機能を制御する
@@ -164,58 +465,87 @@ SatSolver::_set_conditional_literals(
   }
 }
 
-// @brief add_clause() の下請け関数
+// @brief add_clauses() の下請け関数
 void
-SatSolver::_add_clause(
-  const vector<SatLiteral>& lits
+SatSolver::_add_clauses(
+  SizeType nc,
+  const SatLiteral* lits,
+  const SizeType* begin_list
 )
 {
-  vector<SatLiteral> tmp_lits;
-  tmp_lits.reserve(lits.size() + mConditionalLits.size());
-  for ( auto l: mConditionalLits ) {
-    // 条件リテラルは反転する．
-    tmp_lits.push_back(~l);
+  if ( nc == 0 ) {
+    return;
+  }
+  if ( !mConditionalLits.empty() ) {
+    // 条件リテラルを加える必要があるので1つずつ処理する．
+    for ( SizeType i = 0; i < nc; ++ i ) {
+      auto b = begin_list[i];
+      auto e = begin_list[i + 1];
+      _add_clause(e - b, lits + b);
+    }
+    return;
   }
-  for ( auto l: lits ) {
-    tmp_lits.push_back(l);
+
+  auto b0 = begin_list[0];
+  auto e0 = begin_list[nc];
+  mClauseNum += nc;
+  mLiteralNum += e0 - b0;
+  if ( mKeepClauses ) {
+    auto offset = mClauseLits.size() - b0;
+    mClauseLits.insert(mClauseLits.end(), lits + b0, lits + e0);
+    for ( SizeType i = 1; i <= nc; ++ i ) {
+      mClauseBegin.push_back(begin_list[i] + offset);
+    }
   }
 
-  _add_clause_sub(tmp_lits);
+  mImpl->add_clauses(nc, lits, begin_list);
+
+  for ( SizeType i = 0; i < nc; ++ i ) {
+    auto b = begin_list[i];
+    auto e = begin_list[i + 1];
+    mLogger->add_clause(e - b, lits + b);
+  }
 }
 
 // @brief add_clause() の下請け関数
 void
 SatSolver::_add_clause(
   SizeType n,
-  SatLiteral lits[]
+  const SatLiteral* lits
 )
 {
-  vector<SatLiteral> tmp_lits;
-  tmp_lits.reserve(n + mConditionalLits.size());
+  if ( mConditionalLits.empty() ) {
+    _add_clause_sub(n, lits);
+    return;
+  }
+
+  mTmpLits.clear();
   for ( auto l: mConditionalLits ) {
     // 条件リテラルは反転する．
-    tmp_lits.push_back(~l);
-  }
-  for ( int i = 0; i < n; ++ i ) {
-    tmp_lits.push_back(lits[i]);
+    mTmpLits.push_back(~l);
   }
+  mTmpLits.insert(mTmpLits.end(), lits, lits + n);
 
-  _add_clause_sub(tmp_lits);
+  _add_clause_sub(mTmpLits.size(), mTmpLits.data());
 }
 
 // @brief _add_clause() の下請け関数
 void
 SatSolver::_add_clause_sub(
-  const vector<SatLiteral>& lits
+  SizeType n,
+  const SatLiteral* lits
 )
 {
-  mClauseList.push_back(lits);
-
-  mLiteralNum += lits.size();
+  ++ mClauseNum;
+  mLiteralNum += n;
+  if ( mKeepClauses ) {
+    mClauseLits.insert(mClauseLits.end(), lits, lits + n);
+    mClauseBegin.push_back(mClauseLits.size());
+  }
 
-  mImpl->add_clause(lits);
+  mImpl->add_clause(n, lits);
 
-  mLogger->add_clause(lits);
+  mLogger->add_clause(n, lits);
 }
 
 END_NAMESPACE_YM_SAT
@@ -13,6 +13,8 @@
 #include "MiniSat2/SatSolverMiniSat2.h"
 #include "glueminisat-2.2.8/SatSolverGlueMiniSat2.h"
 #include "lingeling/SatSolverLingeling.h"
+#include "parallel/SatSolverPortfolio.h"
+#include "parallel/SatSolverCube.h"
 
 
 BEGIN_NAMESPACE_YM_SAT
@@ -86,6 +88,12 @@ SatSolverImpl::new_impl(
     return unique_ptr<SatSolverImpl>(new nsSat1::YmSat(js_obj));
 #endif
   }
+  if ( type == "portfolio" ) {
+    return unique_ptr<SatSolverImpl>{new SatSolverPortfolio{js_obj}};
+  }
+  if ( type == "cube" ) {
+    return unique_ptr<SatSolverImpl>{new SatSolverCube{js_obj}};
+  }
   ASSERT_NOT_REACHED;
   return unique_ptr<SatSolverImpl>{nullptr};
 }
@@ -95,4 +103,89 @@ SatSolverImpl::~SatSolverImpl()
 {
 }
 
+// @brief 複数の節をまとめて追加する．
+void
+SatSolverImpl::add_clauses(
+  SizeType clause_num,
+  const SatLiteral* lits,
+  const SizeType* begin_list
+)
+{
+  for ( SizeType i = 0; i < clause_num; ++ i ) {
+    auto b = begin_list[i];
+    auto e = begin_list[i + 1];
+    add_clause(e - b, lits + b);
+  }
+}
+
+// @brief XOR 制約を追加する．
+bool
+SatSolverImpl::add_xor_constraint(
+  SizeType,
+  const SatLiteral*,
+  bool
+)
+{
+  return false;
+}
+
+// @brief 擬似ブール制約を追加する．
+bool
+SatSolverImpl::add_pb_constraint(
+  SizeType,
+  const SatLiteral*,
+  const SizeType*,
+  SizeType
+)
+{
+  return false;
+}
+
+// @brief モデルの値割り当てを優先する極性として設定する．
+bool
+SatSolverImpl::set_phase(
+  const SatModel& model
+)
+{
+  vector<SatLiteral> lits;
+  lits.reserve(model.size());
+  for ( SizeType i = 0; i < model.size(); ++ i ) {
+    auto lit = get_lit(i, false);
+    auto val = model[lit];
+    if ( val == SatBool3::True ) {
+      lits.push_back(lit);
+    }
+    else if ( val == SatBool3::False ) {
+      lits.push_back(~lit);
+    }
+  }
+  return set_phase(lits.size(), lits.data());
+}
+
+// @brief 決定変数の値を選ぶ時に優先する極性を設定する．
+bool
+SatSolverImpl::set_phase(
+  SizeType,
+  const SatLiteral*
+)
+{
+  return false;
+}
+
+// @brief 変数と節をすべて削除して生成直後の状態に戻す．
+bool
+SatSolverImpl::reset()
+{
+  return false;
+}
+
+// @brief 制約節を列挙する．
+bool
+SatSolverImpl::enum_clauses(
+  const std::function<void(const vector<SatLiteral>&)>&
+) const
+{
+  return false;
+}
+
 END_NAMESPACE_YM_SAT
@@ -0,0 +1,123 @@
+
+/// @file SatSolverPool.cc
+/// @brief SatSolverPool の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolverPool.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+// クラス SatSolverPool
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SatSolverPool::SatSolverPool(
+  const SatInitParam& init_param,
+  SizeType num_threads
+)
+{
+  if ( num_threads == 0 ) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  if ( num_threads == 0 ) {
+    num_threads = 1;
+  }
+  mSolverList.reserve(num_threads);
+  for ( SizeType i = 0; i < num_threads; ++ i ) {
+    mSolverList.push_back(unique_ptr<SatSolver>{new SatSolver{init_param}});
+  }
+  mDirtyList.resize(num_threads, false);
+}
+
+// @brief デストラクタ
+SatSolverPool::~SatSolverPool()
+{
+}
+
+// @brief task_num 個のタスクを並列に実行する．
+void
+SatSolverPool::run(
+  SizeType task_num,
+  const Task& task
+)
+{
+  if ( task_num == 0 ) {
+    return;
+  }
+
+  // タスクは小さいと仮定しているので，
+  // 共有カウンタへのアクセスを減らすためにまとめて取り出す．
+  SizeType n = std::min(thread_num(), task_num);
+  SizeType chunk_size = std::max<SizeType>(1, task_num / (n * 16));
+  chunk_size = std::min<SizeType>(chunk_size, 64);
+
+  std::atomic<SizeType> next_id{0};
+  std::mutex mtx;
+  std::exception_ptr error;
+
+  auto worker = [&](SizeType tid) {
+    auto& solver = *mSolverList[tid];
+    // vector<bool> の要素を複数のスレッドから書き換えるのは
+    // 安全ではないので作業用の変数を用いる．
+    bool dirty = mDirtyList[tid];
+    for ( ; ; ) {
+      auto start = next_id.fetch_add(chunk_size);
+      if ( start >= task_num ) {
+	break;
+      }
+      auto end = std::min(start + chunk_size, task_num);
+      for ( SizeType id = start; id < end; ++ id ) {
+	if ( dirty ) {
+	  solver.reset();
+	}
+	dirty = true;
+	try {
+	  task(id, solver);
+	}
+	catch ( ... ) {
+	  std::lock_guard<std::mutex> lock{mtx};
+	  if ( !error ) {
+	    error = std::current_exception();
+	  }
+	  // 残りのタスクは打ち切る．
+	  next_id = task_num;
+	  return;
+	}
+      }
+    }
+  };
+
+  if ( n == 1 ) {
+    worker(0);
+  }
+  else {
+    vector<std::thread> thread_list;
+    thread_list.reserve(n - 1);
+    for ( SizeType i = 1; i < n; ++ i ) {
+      thread_list.emplace_back(worker, i);
+    }
+    worker(0);
+    for ( auto& th: thread_list ) {
+      th.join();
+    }
+  }
+
+  for ( SizeType i = 0; i < n; ++ i ) {
+    mDirtyList[i] = true;
+  }
+
+  if ( error ) {
+    std::rethrow_exception(error);
+  }
+}
+
+END_NAMESPACE_YM_SAT
@@ -0,0 +1,373 @@
+
+/// @file SatSolver_amo.cc
+/// @brief SatSolver の実装ファイル(at-most-one 制約の符号化関係)
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "ym/Range.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// Auto の場合に pairwise を用いる入力数の上限
+const SizeType PAIRWISE_LIMIT = 6;
+
+// commander 符号化のグループの大きさ
+const SizeType COMMANDER_GROUP = 3;
+
+// bimander 符号化のグループの大きさ
+const SizeType BIMANDER_GROUP = 2;
+
+// add_not_one() で用いる個数を表すリテラルの組
+struct CountLits
+{
+  SatLiteral mAny; // 1個以上の時 true
+  SatLiteral mTwo; // 2個以上の時 true(入力が1つの時は SatLiteral::X)
+};
+
+// 2つの CountLits をまとめる．
+CountLits
+merge_count(
+  SatSolver& solver,
+  const CountLits& a,
+  const CountLits& b
+)
+{
+  auto any = solver.new_variable(false);
+  solver.add_orgate(any, a.mAny, b.mAny);
+  auto both = solver.new_variable(false);
+  solver.add_andgate(both, a.mAny, b.mAny);
+  if ( !a.mTwo.is_valid() && !b.mTwo.is_valid() ) {
+    return CountLits{any, both};
+  }
+  auto two = solver.new_variable(false);
+  if ( !a.mTwo.is_valid() ) {
+    solver.add_orgate(two, both, b.mTwo);
+  }
+  else if ( !b.mTwo.is_valid() ) {
+    solver.add_orgate(two, both, a.mTwo);
+  }
+  else {
+    solver.add_orgate(two, both, a.mTwo, b.mTwo);
+  }
+  return CountLits{any, two};
+}
+
+// lits[begin:end] の CountLits を二分木状に作る．
+CountLits
+count_tree(
+  SatSolver& solver,
+  const vector<SatLiteral>& lits,
+  SizeType begin,
+  SizeType end
+)
+{
+  if ( end - begin == 1 ) {
+    return CountLits{lits[begin], SatLiteral::X};
+  }
+  auto mid = (begin + end + 1) / 2;
+  auto a = count_tree(solver, lits, begin, mid);
+  auto b = count_tree(solver, lits, mid, end);
+  return merge_count(solver, a, b);
+}
+
+END_NONAMESPACE
+
+// @brief 与えられたリテラルのうち1つしか true にならない条件を追加する．
+void
+SatSolver::add_at_most_one(
+  const vector<SatLiteral>& lit_list,
+  SatAmoEnc enc
+)
+{
+  SizeType n = lit_list.size();
+  if ( n <= 1 ) {
+    // はじめから条件は満たされている．
+    return;
+  }
+  switch ( _amo_encoding(enc, n) ) {
+  case SatAmoEnc::Pairwise:  _add_amo_pairwise(lit_list); break;
+  case SatAmoEnc::Ladder:    _add_amo_ladder(lit_list); break;
+  case SatAmoEnc::Commander: _add_amo_commander(lit_list); break;
+  case SatAmoEnc::Product:   _add_amo_product(lit_list); break;
+  case SatAmoEnc::Bimander:  _add_amo_bimander(lit_list); break;
+  default:                   _add_amo_halving(lit_list); break;
+  }
+}
+
+// @brief 与えられたリテラルのうち厳密に1つが true になる条件を追加する．
+void
+SatSolver::add_exact_one(
+  const vector<SatLiteral>& lit_list,
+  SatAmoEnc enc
+)
+{
+  SizeType n = lit_list.size();
+  if ( n == 0 ) {
+    // 成り立たない．
+    add_clause(vector<SatLiteral>{});
+    return;
+  }
+  if ( n == 1 ) {
+    auto lit = lit_list[0];
+    add_clause(lit);
+    return;
+  }
+  enc = _amo_encoding(enc, n);
+  if ( enc == SatAmoEnc::Halving && n > 4 ) {
+    // 2つに分けたそれぞれの OR のどちらか一方だけが true になる．
+    SizeType n1{(n + 1) / 2};
+    auto olit1 = new_variable(false);
+    _add_at_most_one(lit_list.data(), n1, olit1);
+
+    SizeType n2{n - n1};
+    auto olit2 = new_variable(false);
+    _add_at_most_one(lit_list.data() + n1, n2, olit2);
+
+    add_clause( olit1,  olit2);
+    add_clause(~olit1, ~olit2);
+    return;
+  }
+  add_at_most_one(lit_list, enc);
+  add_clause(lit_list);
+}
+
+// @brief 与えられたリテラルのうちtrueになっている個数が1でない条件を追加する．
+void
+SatSolver::add_not_one(
+  const vector<SatLiteral>& lit_list,
+  SatAmoEnc enc
+)
+{
+  SizeType n = lit_list.size();
+  if ( n == 0 ) {
+    // はじめから条件は満たされている．
+    return;
+  }
+  if ( n == 1 ) {
+    auto lit = lit_list[0];
+    add_clause(~lit);
+    return;
+  }
+  enc = _amo_encoding(enc, n);
+  if ( enc == SatAmoEnc::Pairwise ) {
+    // i 番目のリテラルだけを反転させた節を作る．
+    // 作業領域は使い回して反転したリテラルだけ元に戻す．
+    mGateLits.assign(lit_list.begin(), lit_list.end());
+    for ( SizeType i: Range(n) ) {
+      mGateLits[i] = ~mGateLits[i];
+      _add_clause(n, mGateLits.data());
+      mGateLits[i] = ~mGateLits[i];
+    }
+    return;
+  }
+
+  // 「1個以上なら2個以上」という条件にする．
+  CountLits root;
+  if ( enc == SatAmoEnc::Ladder ) {
+    root = CountLits{lit_list[0], SatLiteral::X};
+    for ( SizeType i = 1; i < n; ++ i ) {
+      root = merge_count(*this, root, CountLits{lit_list[i], SatLiteral::X});
+    }
+  }
+  else {
+    root = count_tree(*this, lit_list, 0, n);
+  }
+  add_clause(~root.mAny, root.mTwo);
+}
+
+// @brief at-most-one 制約の符号化方法を決める．
+SatAmoEnc
+SatSolver::_amo_encoding(
+  SatAmoEnc enc,
+  SizeType n
+) const
+{
+  if ( enc == SatAmoEnc::Auto ) {
+    enc = mAmoEnc;
+  }
+  if ( enc != SatAmoEnc::Auto ) {
+    return enc;
+  }
+  // sat_amo_bench の結果では大きな制約では product 符号化が最速だった．
+  if ( n <= PAIRWISE_LIMIT ) {
+    return SatAmoEnc::Pairwise;
+  }
+  return SatAmoEnc::Product;
+}
+
+// @brief 全ての対に2項節を作って at-most-one 制約を追加する．
+void
+SatSolver::_add_amo_pairwise(
+  const vector<SatLiteral>& lit_list
+)
+{
+  SizeType n = lit_list.size();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto lit1 = lit_list[i];
+    for ( SizeType j = i + 1; j < n; ++ j ) {
+      auto lit2 = lit_list[j];
+      add_clause(~lit1, ~lit2);
+    }
+  }
+}
+
+// @brief 半分に分割する方法で at-most-one 制約を追加する．
+void
+SatSolver::_add_amo_halving(
+  const vector<SatLiteral>& lit_list
+)
+{
+  SizeType n{lit_list.size()};
+  if ( n <= 4 ) {
+    _add_amo_pairwise(lit_list);
+    return;
+  }
+
+  SizeType n1 = (n + 1) / 2;
+  auto olit1 = new_variable(false);
+  _add_at_most_one(lit_list.data(), n1, olit1);
+
+  SizeType n2{n - n1};
+  auto olit2 = new_variable(false);
+  _add_at_most_one(lit_list.data() + n1, n2, olit2);
+
+  add_clause(~olit1, ~olit2);
+}
+
+// @brief 逐次符号化で at-most-one 制約を追加する．
+void
+SatSolver::_add_amo_ladder(
+  const vector<SatLiteral>& lit_list
+)
+{
+  // s_i は lit_0 〜 lit_i のいずれかが true の時 true になる．
+  SizeType n = lit_list.size();
+  auto prev = lit_list[0];
+  for ( SizeType i = 1; i < n; ++ i ) {
+    auto lit = lit_list[i];
+    add_clause(~prev, ~lit);
+    if ( i < n - 1 ) {
+      auto s = new_variable(false);
+      add_clause(~prev, s);
+      add_clause(~lit, s);
+      prev = s;
+    }
+  }
+}
+
+// @brief commander 符号化で at-most-one 制約を追加する．
+void
+SatSolver::_add_amo_commander(
+  const vector<SatLiteral>& lit_list
+)
+{
+  SizeType n = lit_list.size();
+  if ( n <= PAIRWISE_LIMIT ) {
+    _add_amo_pairwise(lit_list);
+    return;
+  }
+
+  // グループごとに pairwise で制約を作り，
+  // グループの OR(commander) に対して再帰的に制約を作る．
+  vector<SatLiteral> cmd_list;
+  cmd_list.reserve((n + COMMANDER_GROUP - 1) / COMMANDER_GROUP);
+  vector<SatLiteral> group;
+  for ( SizeType b = 0; b < n; b += COMMANDER_GROUP ) {
+    auto e = std::min(b + COMMANDER_GROUP, n);
+    if ( e - b == 1 ) {
+      cmd_list.push_back(lit_list[b]);
+      continue;
+    }
+    group.assign(lit_list.begin() + b, lit_list.begin() + e);
+    _add_amo_pairwise(group);
+    auto c = new_variable(false);
+    add_orgate(c, group);
+    cmd_list.push_back(c);
+  }
+  _add_amo_commander(cmd_list);
+}
+
+// @brief product 符号化で at-most-one 制約を追加する．
+void
+SatSolver::_add_amo_product(
+  const vector<SatLiteral>& lit_list
+)
+{
+  SizeType n = lit_list.size();
+  if ( n <= PAIRWISE_LIMIT ) {
+    _add_amo_pairwise(lit_list);
+    return;
+  }
+
+  // 入力を p 行 q 列に並べ，行と列のそれぞれに再帰的に制約を作る．
+  SizeType p = 1;
+  while ( p * p < n ) {
+    ++ p;
+  }
+  SizeType q = (n + p - 1) / p;
+  vector<SatLiteral> row_list(p);
+  for ( auto& lit: row_list ) {
+    lit = new_variable(false);
+  }
+  vector<SatLiteral> col_list(q);
+  for ( auto& lit: col_list ) {
+    lit = new_variable(false);
+  }
+  for ( SizeType i: Range(n) ) {
+    auto lit = lit_list[i];
+    add_clause(~lit, row_list[i / q]);
+    add_clause(~lit, col_list[i % q]);
+  }
+  _add_amo_product(row_list);
+  _add_amo_product(col_list);
+}
+
+// @brief bimander 符号化で at-most-one 制約を追加する．
+void
+SatSolver::_add_amo_bimander(
+  const vector<SatLiteral>& lit_list
+)
+{
+  SizeType n = lit_list.size();
+  SizeType m = (n + BIMANDER_GROUP - 1) / BIMANDER_GROUP;
+  if ( m <= 1 ) {
+    _add_amo_pairwise(lit_list);
+    return;
+  }
+
+  // グループ番号を2進符号化した変数で表す．
+  SizeType nb = 0;
+  while ( (1U << nb) < m ) {
+    ++ nb;
+  }
+  vector<SatLiteral> bit_list(nb);
+  for ( auto& lit: bit_list ) {
+    lit = new_variable(false);
+  }
+  vector<SatLiteral> group;
+  for ( SizeType g: Range(m) ) {
+    auto b = g * BIMANDER_GROUP;
+    auto e = std::min(b + BIMANDER_GROUP, n);
+    group.assign(lit_list.begin() + b, lit_list.begin() + e);
+    _add_amo_pairwise(group);
+    for ( auto lit: group ) {
+      for ( SizeType j: Range(nb) ) {
+	auto blit = bit_list[j];
+	if ( g & (1U << j) ) {
+	  add_clause(~lit, blit);
+	}
+	else {
+	  add_clause(~lit, ~blit);
+	}
+      }
+    }
+  }
+}
+
+END_NAMESPACE_YM_SAT
@@ -0,0 +1,161 @@
+
+/// @file SatSolver_batch.cc
+/// @brief SatSolver の実装ファイル(solve_batch() 関係)
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "SatSolverImpl.h"
+#include "SatLogger.h"
+#include <thread>
+#include <atomic>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+// @brief 複数の assumption の組に対して SAT 問題を解く．
+vector<SatBool3>
+SatSolver::solve_batch(
+  const vector<vector<SatLiteral>>& assumption_sets,
+  vector<SatModel>& model_list,
+  vector<vector<SatLiteral>>& conflicts_list,
+  SizeType num_threads
+)
+{
+  SizeType n = assumption_sets.size();
+  vector<SatBool3> ans_list(n, SatBool3::X);
+  model_list.clear();
+  model_list.resize(n);
+  conflicts_list.clear();
+  conflicts_list.resize(n);
+  if ( n == 0 ) {
+    return ans_list;
+  }
+
+  if ( num_threads == 0 ) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  if ( num_threads > n ) {
+    num_threads = n;
+  }
+  if ( num_threads == 0 ) {
+    num_threads = 1;
+  }
+  if ( !mKeepClauses ) {
+    // 節のコピーがないので複製を作れない．
+    num_threads = 1;
+  }
+
+  // 先頭部分が共通な組が隣り合うように辞書順に並べる．
+  vector<SizeType> order(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+		   [&](SizeType a, SizeType b) {
+		     auto& lits_a = assumption_sets[a];
+		     auto& lits_b = assumption_sets[b];
+		     return std::lexicographical_compare(lits_a.begin(), lits_a.end(),
+							 lits_b.begin(), lits_b.end());
+		   });
+
+  // 隣り合った組をまとめて取り出す単位
+  // 後半の負荷の偏りを抑えるためにスレッド数の8倍程度に分割する．
+  SizeType chunk_size = std::max<SizeType>(1, n / (num_threads * 8));
+
+  // 0番目のスレッドは自分自身の mImpl を用いる．
+  _sync_clones(num_threads - 1);
+
+  std::atomic<SizeType> next_pos{0};
+  auto worker = [&](SatSolverImpl& impl) {
+    for ( ; ; ) {
+      auto start = next_pos.fetch_add(chunk_size);
+      if ( start >= n ) {
+	break;
+      }
+      auto end = std::min(start + chunk_size, n);
+      for ( SizeType pos = start; pos < end; ++ pos ) {
+	auto id = order[pos];
+	auto& conflicts = conflicts_list[id];
+	auto ans = impl.solve(assumption_sets[id], model_list[id], conflicts);
+	if ( ans == SatBool3::False ) {
+	  sort(conflicts.begin(), conflicts.end());
+	}
+	ans_list[id] = ans;
+      }
+    }
+  };
+
+  if ( num_threads == 1 ) {
+    worker(*mImpl);
+  }
+  else {
+    vector<std::thread> thread_list;
+    thread_list.reserve(num_threads - 1);
+    for ( SizeType i = 1; i < num_threads; ++ i ) {
+      auto& impl = *mCloneList[i - 1].mImpl;
+      thread_list.emplace_back([&]() { worker(impl); });
+    }
+    worker(*mImpl);
+    for ( auto& th: thread_list ) {
+      th.join();
+    }
+  }
+
+  // ロガーはスレッドセーフではないので最後にまとめて記録する．
+  for ( SizeType i = 0; i < n; ++ i ) {
+    mLogger->solve(assumption_sets[i]);
+    mLogger->solve_result(ans_list[i]);
+  }
+
+  return ans_list;
+}
+
+// @brief solve_batch() 用の複製を n 個用意する．
+void
+SatSolver::_sync_clones(
+  SizeType n
+)
+{
+  while ( mCloneList.size() < n ) {
+    mCloneList.push_back(Clone{SatSolverImpl::new_impl(mType)});
+  }
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto& clone = mCloneList[i];
+    for ( ; clone.mVarNum < mVariableNum; ++ clone.mVarNum ) {
+      clone.mImpl->new_variable(mDecisionList[clone.mVarNum]);
+    }
+    if ( clone.mClauseNum < mClauseNum ) {
+      clone.mImpl->add_clauses(mClauseNum - clone.mClauseNum,
+			       mClauseLits.data(),
+			       mClauseBegin.data() + clone.mClauseNum);
+      clone.mClauseNum = mClauseNum;
+    }
+    for ( ; clone.mXorNum < mXorNum; ++ clone.mXorNum ) {
+      auto b = mXorBegin[clone.mXorNum];
+      auto e = mXorBegin[clone.mXorNum + 1];
+      clone.mImpl->add_xor_constraint(e - b, mXorLits.data() + b,
+				      mXorRhs[clone.mXorNum]);
+    }
+    for ( ; clone.mPbNum < mPbNum; ++ clone.mPbNum ) {
+      auto b = mPbBegin[clone.mPbNum];
+      auto e = mPbBegin[clone.mPbNum + 1];
+      clone.mImpl->add_pb_constraint(e - b, mPbLits.data() + b,
+				     mPbWeights.data() + b,
+				     mPbBound[clone.mPbNum]);
+    }
+    if ( clone.mBudgetNum < mBudgetNum ) {
+      if ( mHasConflictBudget ) {
+	clone.mImpl->set_conflict_budget(mConflictBudget);
+      }
+      if ( mHasPropagationBudget ) {
+	clone.mImpl->set_propagation_budget(mPropagationBudget);
+      }
+      clone.mBudgetNum = mBudgetNum;
+    }
+  }
+}
+
+END_NAMESPACE_YM_SAT
@@ -0,0 +1,549 @@
+
+/// @file SatSolver_card.cc
+/// @brief SatSolver の実装ファイル(個数制約の符号化関係)
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// Auto の場合に cardinality network に切り替える n * k の閾値
+const SizeType CARD_NETWORK_THRESHOLD = 1 << 20;
+
+END_NONAMESPACE
+
+// @brief 与えられたリテラルのうちk個しか true にならない条件を追加する．
+void
+SatSolver::add_at_most_k(
+  const vector<SatLiteral>& lit_list,
+  SizeType k,
+  SatCardEnc enc
+)
+{
+  SizeType n{lit_list.size()};
+  if ( n <= k ) {
+    // はじめから条件は満たされている．
+    return;
+  }
+  if ( k == 0 ) {
+    // 全て false でなければならない．
+    for ( auto lit: lit_list ) {
+      add_clause(~lit);
+    }
+    return;
+  }
+
+  enc = _card_encoding(enc, n, k);
+  switch ( enc ) {
+  case SatCardEnc::Counter:
+    {
+      auto clits = add_counter(lit_list);
+      add_le(clits, k);
+    }
+    break;
+
+  case SatCardEnc::ModTotalizer:
+    _add_mod_totalizer(lit_list, k);
+    break;
+
+  default:
+    {
+      // k + 1 個以上という出力を false にする．
+      auto olits = _add_unary_counter(lit_list, k + 1, enc, true, false);
+      add_clause(~olits[k]);
+    }
+    break;
+  }
+}
+
+// @brief 与えられたリテラルのうちk個以上は true になる条件を追加する．
+void
+SatSolver::add_at_least_k(
+  const vector<SatLiteral>& lit_list,
+  SizeType k,
+  SatCardEnc enc
+)
+{
+  SizeType n = lit_list.size();
+  if ( k == 0 ) {
+    // はじめから条件は満たされている．
+    return;
+  }
+  if ( n < k ) {
+    // 絶対に成り立たない．
+    add_clause(vector<SatLiteral>{});
+    return;
+  }
+  if ( n == k ) {
+    // 全て true でなければならない．
+    for ( auto lit: lit_list ) {
+      add_clause(lit);
+    }
+    return;
+  }
+
+  enc = _card_encoding(enc, n, k);
+  switch ( enc ) {
+  case SatCardEnc::Counter:
+    {
+      auto clits = add_counter(lit_list);
+      add_ge(clits, k);
+    }
+    break;
+
+  case SatCardEnc::ModTotalizer:
+    {
+      // modulo totalizer は上向きの節しか持たないので
+      // 否定のリテラルのうち n - k 個以下という条件にする．
+      vector<SatLiteral> inv_list;
+      inv_list.reserve(n);
+      for ( auto lit: lit_list ) {
+	inv_list.push_back(~lit);
+      }
+      _add_mod_totalizer(inv_list, n - k);
+    }
+    break;
+
+  default:
+    {
+      // k 個以上という出力を true にする．
+      auto olits = _add_unary_counter(lit_list, k, enc, false, true);
+      add_clause(olits[k - 1]);
+    }
+    break;
+  }
+}
+
+// @brief 与えられたリテラルのうち厳密にk個が true になる条件を追加する．
+void
+SatSolver::add_exact_k(
+  const vector<SatLiteral>& lit_list,
+  SizeType k,
+  SatCardEnc enc
+)
+{
+  SizeType n = lit_list.size();
+  if ( n < k ) {
+    // 絶対に成り立たない．
+    add_clause(vector<SatLiteral>{});
+    return;
+  }
+  if ( k == 0 || k == n ) {
+    // 全て false か全て true でなければならない．
+    for ( auto lit: lit_list ) {
+      add_clause(k == 0 ? ~lit : lit);
+    }
+    return;
+  }
+
+  auto enc1 = _card_encoding(enc, n, k);
+  if ( enc1 == SatCardEnc::Counter || enc1 == SatCardEnc::ModTotalizer ) {
+    add_at_most_k(lit_list, k, enc1);
+    add_at_least_k(lit_list, k, enc1);
+    return;
+  }
+
+  // 上限と下限で同じカウンタを用いる．
+  auto olits = _add_unary_counter(lit_list, k + 1, enc1, true, true);
+  add_clause( olits[k - 1]);
+  add_clause(~olits[k]);
+}
+
+// @brief 個数制約の符号化方法を決める．
+SatCardEnc
+SatSolver::_card_encoding(
+  SatCardEnc enc,
+  SizeType n,
+  SizeType k
+) const
+{
+  if ( enc == SatCardEnc::Auto ) {
+    enc = mCardEnc;
+  }
+  if ( enc != SatCardEnc::Auto ) {
+    return enc;
+  }
+  // sat_card_bench の結果では totalizer がほぼ全ての問題で最速だった．
+  // ただし節数が O(n * k) となるので n * k が大きい場合には
+  // 節数が O(n log^2 n) で済む cardinality network を用いる．
+  if ( n * (k + 1) > CARD_NETWORK_THRESHOLD ) {
+    return SatCardEnc::CardNetwork;
+  }
+  return SatCardEnc::Totalizer;
+}
+
+// @brief add_unary_counter() の下請け関数
+vector<SatLiteral>
+SatSolver::_add_unary_counter(
+  const vector<SatLiteral>& ilits,
+  SizeType m,
+  SatCardEnc enc,
+  bool up,
+  bool down
+)
+{
+  SizeType n = ilits.size();
+  if ( m > n ) {
+    m = n;
+  }
+  if ( m == 0 ) {
+    return {};
+  }
+  switch ( enc ) {
+  case SatCardEnc::SeqCounter:
+    return _add_seq_counter(ilits, m, up, down);
+
+  case SatCardEnc::CardNetwork:
+    return _add_card_network(ilits, m, up, down);
+
+  default:
+    break;
+  }
+  return _add_totalizer(ilits, m, up, down);
+}
+
+// @brief 逐次カウンタを作る．
+vector<SatLiteral>
+SatSolver::_add_seq_counter(
+  const vector<SatLiteral>& ilits,
+  SizeType m,
+  bool up,
+  bool down
+)
+{
+  // prev_list[j] は先頭の i 個のうち j + 1 個以上が true を表す．
+  // cur_list[j] = prev_list[j] | (x_i & prev_list[j - 1])
+  SizeType n = ilits.size();
+  vector<SatLiteral> prev_list{ilits[0]};
+  vector<SatLiteral> cur_list;
+  for ( SizeType i = 1; i < n; ++ i ) {
+    auto x = ilits[i];
+    SizeType np = prev_list.size();
+    SizeType nc = std::min(np + 1, m);
+    cur_list.resize(nc);
+    for ( SizeType j = 0; j < nc; ++ j ) {
+      auto s = new_variable(false);
+      cur_list[j] = s;
+      if ( up ) {
+	if ( j < np ) {
+	  add_clause(~prev_list[j], s);
+	}
+	if ( j == 0 ) {
+	  add_clause(~x, s);
+	}
+	else {
+	  add_clause(~x, ~prev_list[j - 1], s);
+	}
+      }
+      if ( down ) {
+	if ( j < np ) {
+	  add_clause(~s, prev_list[j], x);
+	}
+	else {
+	  add_clause(~s, x);
+	}
+	if ( j > 0 ) {
+	  add_clause(~s, prev_list[j - 1]);
+	}
+      }
+    }
+    prev_list.swap(cur_list);
+  }
+  return prev_list;
+}
+
+// @brief totalizer を作る．
+vector<SatLiteral>
+SatSolver::_add_totalizer(
+  const vector<SatLiteral>& ilits,
+  SizeType m,
+  bool up,
+  bool down
+)
+{
+  // 隣り合う2つのノードを併合していくことで平衡木を作る．
+  // 各ノードは部分木の入力のうち i + 1 個以上が true を表すリテラルを持つ．
+  vector<vector<SatLiteral>> node_list;
+  node_list.reserve(ilits.size());
+  for ( auto lit: ilits ) {
+    node_list.push_back({lit});
+  }
+  vector<SatLiteral> tmp_lits;
+  while ( node_list.size() > 1 ) {
+    SizeType nn = node_list.size();
+    SizeType wpos = 0;
+    for ( SizeType rpos = 0; rpos + 1 < nn; rpos += 2 ) {
+      auto& a_list = node_list[rpos];
+      auto& b_list = node_list[rpos + 1];
+      SizeType na = a_list.size();
+      SizeType nb = b_list.size();
+      SizeType nr = std::min(na + nb, m);
+      vector<SatLiteral> r_list(nr);
+      for ( auto& lit: r_list ) {
+	lit = new_variable(false);
+      }
+      for ( SizeType i = 0; i <= na; ++ i ) {
+	for ( SizeType j = 0; j <= nb; ++ j ) {
+	  if ( up && i + j > 0 && i + j <= nr ) {
+	    // a >= i & b >= j -> r >= i + j
+	    tmp_lits.clear();
+	    if ( i > 0 ) {
+	      tmp_lits.push_back(~a_list[i - 1]);
+	    }
+	    if ( j > 0 ) {
+	      tmp_lits.push_back(~b_list[j - 1]);
+	    }
+	    tmp_lits.push_back(r_list[i + j - 1]);
+	    add_clause(tmp_lits);
+	  }
+	  if ( down && i + j < nr ) {
+	    // r >= i + j + 1 -> a >= i + 1 | b >= j + 1
+	    // a, b が打ち切られている場合はここに来ない．
+	    tmp_lits.clear();
+	    tmp_lits.push_back(~r_list[i + j]);
+	    if ( i < na ) {
+	      tmp_lits.push_back(a_list[i]);
+	    }
+	    if ( j < nb ) {
+	      tmp_lits.push_back(b_list[j]);
+	    }
+	    add_clause(tmp_lits);
+	  }
+	}
+      }
+      node_list[wpos] = std::move(r_list);
+      ++ wpos;
+    }
+    if ( nn % 2 == 1 ) {
+      node_list[wpos] = std::move(node_list[nn - 1]);
+      ++ wpos;
+    }
+    node_list.resize(wpos);
+  }
+  auto olits = std::move(node_list[0]);
+  olits.resize(m);
+  return olits;
+}
+
+// @brief 出力を打ち切ったソーティングネットワークを作る．
+vector<SatLiteral>
+SatSolver::_add_card_network(
+  const vector<SatLiteral>& ilits,
+  SizeType m,
+  bool up,
+  bool down
+)
+{
+  // Batcher の奇偶マージソートの比較器のリストを作る．
+  // 添字の小さい方に大きい値(OR)を，大きい方に小さい値(AND)を出す．
+  struct Comp {
+    SizeType mI;
+    SizeType mJ;
+    bool mNeedMax;
+    bool mNeedMin;
+  };
+  SizeType n = ilits.size();
+  vector<Comp> comp_list;
+  for ( SizeType p = 1; p < n; p <<= 1 ) {
+    for ( SizeType k = p; k >= 1; k >>= 1 ) {
+      for ( SizeType j = k % p; j + k < n; j += k * 2 ) {
+	for ( SizeType i = 0; i < std::min(k, n - j - k); ++ i ) {
+	  if ( (i + j) / (p * 2) == (i + j + k) / (p * 2) ) {
+	    comp_list.push_back(Comp{i + j, i + j + k, false, false});
+	  }
+	}
+      }
+    }
+  }
+
+  // 先頭の m 個の出力に影響する比較器の出力に印を付ける．
+  vector<bool> need_list(n, false);
+  for ( SizeType i = 0; i < m; ++ i ) {
+    need_list[i] = true;
+  }
+  for ( SizeType c = comp_list.size(); c -- > 0; ) {
+    auto& comp = comp_list[c];
+    comp.mNeedMax = need_list[comp.mI];
+    comp.mNeedMin = need_list[comp.mJ];
+    if ( comp.mNeedMax || comp.mNeedMin ) {
+      need_list[comp.mI] = true;
+      need_list[comp.mJ] = true;
+    }
+  }
+
+  // 印の付いた出力だけ節を作る．
+  vector<SatLiteral> wire_list(ilits);
+  for ( auto& comp: comp_list ) {
+    auto a = wire_list[comp.mI];
+    auto b = wire_list[comp.mJ];
+    if ( comp.mNeedMax ) {
+      auto o = new_variable(false);
+      if ( up ) {
+	add_clause(~a, o);
+	add_clause(~b, o);
+      }
+      if ( down ) {
+	add_clause(~o, a, b);
+      }
+      wire_list[comp.mI] = o;
+    }
+    if ( comp.mNeedMin ) {
+      auto o = new_variable(false);
+      if ( up ) {
+	add_clause(~a, ~b, o);
+      }
+      if ( down ) {
+	add_clause(~o, a);
+	add_clause(~o, b);
+      }
+      wire_list[comp.mJ] = o;
+    }
+  }
+  wire_list.resize(m);
+  return wire_list;
+}
+
+// @brief modulo totalizer で k 個以下という条件を追加する．
+void
+SatSolver::_add_mod_totalizer(
+  const vector<SatLiteral>& ilits,
+  SizeType k
+)
+{
+  // 個数を p * 上位 + 下位 (0 <= 下位 < p) で表し，
+  // 上位と下位をそれぞれ単進数で表す．p は √k 程度にとる．
+  // 単位伝搬だけでは違反を検出できない場合があるので
+  // 補助変数も決定変数にする．
+  SizeType p = 2;
+  while ( p * p < k ) {
+    ++ p;
+  }
+  SizeType qk = k / p;
+  SizeType rk = k % p;
+
+  // mLower[i] は下位が i + 1 以上，mUpper[i] は上位が i + 1 以上を表す．
+  struct Node {
+    vector<SatLiteral> mLower;
+    vector<SatLiteral> mUpper;
+  };
+  vector<Node> node_list;
+  node_list.reserve(ilits.size());
+  for ( auto lit: ilits ) {
+    node_list.push_back(Node{{lit}, {}});
+  }
+  vector<SatLiteral> tmp_lits;
+  while ( node_list.size() > 1 ) {
+    SizeType nn = node_list.size();
+    SizeType wpos = 0;
+    for ( SizeType rpos = 0; rpos + 1 < nn; rpos += 2 ) {
+      auto& a = node_list[rpos];
+      auto& b = node_list[rpos + 1];
+      Node r;
+
+      // 下位の和．p 以上になったら桁上げ c を true にする．
+      SizeType la = a.mLower.size();
+      SizeType lb = b.mLower.size();
+      SizeType nl = std::min(la + lb, p - 1);
+      r.mLower.resize(nl);
+      for ( auto& lit: r.mLower ) {
+	lit = new_variable(true);
+      }
+      SatLiteral c;
+      if ( la + lb >= p ) {
+	c = new_variable(true);
+      }
+      for ( SizeType i = 0; i <= la; ++ i ) {
+	for ( SizeType j = 0; j <= lb; ++ j ) {
+	  SizeType s = i + j;
+	  if ( s == 0 ) {
+	    continue;
+	  }
+	  tmp_lits.clear();
+	  if ( i > 0 ) {
+	    tmp_lits.push_back(~a.mLower[i - 1]);
+	  }
+	  if ( j > 0 ) {
+	    tmp_lits.push_back(~b.mLower[j - 1]);
+	  }
+	  SizeType nb = tmp_lits.size();
+	  if ( s < p ) {
+	    if ( c.is_valid() ) {
+	      tmp_lits.push_back(c);
+	    }
+	    tmp_lits.push_back(r.mLower[s - 1]);
+	    add_clause(tmp_lits);
+	  }
+	  else {
+	    tmp_lits.push_back(c);
+	    add_clause(tmp_lits);
+	    if ( s > p ) {
+	      tmp_lits.resize(nb);
+	      tmp_lits.push_back(r.mLower[s - p - 1]);
+	      add_clause(tmp_lits);
+	    }
+	  }
+	}
+      }
+
+      // 上位の和．qk + 1 以上は区別しない．
+      SizeType ua = a.mUpper.size();
+      SizeType ub = b.mUpper.size();
+      SizeType nu = std::min(ua + ub + (c.is_valid() ? 1 : 0), qk + 1);
+      r.mUpper.resize(nu);
+      for ( auto& lit: r.mUpper ) {
+	lit = new_variable(true);
+      }
+      for ( SizeType i = 0; i <= ua; ++ i ) {
+	for ( SizeType j = 0; j <= ub; ++ j ) {
+	  SizeType s = i + j;
+	  tmp_lits.clear();
+	  if ( i > 0 ) {
+	    tmp_lits.push_back(~a.mUpper[i - 1]);
+	  }
+	  if ( j > 0 ) {
+	    tmp_lits.push_back(~b.mUpper[j - 1]);
+	  }
+	  if ( s > 0 && s <= nu ) {
+	    tmp_lits.push_back(r.mUpper[s - 1]);
+	    add_clause(tmp_lits);
+	    tmp_lits.pop_back();
+	  }
+	  if ( c.is_valid() && s < nu ) {
+	    tmp_lits.push_back(~c);
+	    tmp_lits.push_back(r.mUpper[s]);
+	    add_clause(tmp_lits);
+	  }
+	}
+      }
+      node_list[wpos] = std::move(r);
+      ++ wpos;
+    }
+    if ( nn % 2 == 1 ) {
+      node_list[wpos] = std::move(node_list[nn - 1]);
+      ++ wpos;
+    }
+    node_list.resize(wpos);
+  }
+
+  // 上位 > qk または 上位 == qk かつ 下位 > rk を禁止する．
+  auto& root = node_list[0];
+  if ( root.mUpper.size() > qk ) {
+    add_clause(~root.mUpper[qk]);
+  }
+  if ( root.mLower.size() > rk ) {
+    if ( qk == 0 ) {
+      add_clause(~root.mLower[rk]);
+    }
+    else if ( root.mUpper.size() >= qk ) {
+      add_clause(~root.mUpper[qk - 1], ~root.mLower[rk]);
+    }
+  }
+}
+
+END_NAMESPACE_YM_SAT
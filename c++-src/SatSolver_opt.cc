@@ -0,0 +1,290 @@
+
+/// @file SatSolver_opt.cc
+/// @brief SatSolver の実装ファイル(最適化関係)
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "ym/SatBinaryNum.h"
+#include "ym/SatOrderedSet.h"
+#include "ym/SatMsgHandler.h"
+#include "SatSolverImpl.h"
+#include <chrono>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// obj <= v を表すリテラルを返す．
+//
+// obj < v + 1 を表すリテラルは obj - (v + 1) の借りとなる．
+// 定数との減算なので BvBuilder の定数伝搬で比較器程度の節になる．
+SatLiteral
+binary_le_lit(
+  SatSolver& solver,
+  const SatBinaryNum& obj,
+  std::int64_t v
+)
+{
+  SizeType n = obj.bit_num();
+  std::int64_t hi = (static_cast<std::int64_t>(1) << n) - 1;
+  if ( v >= hi ) {
+    return solver.const_true();
+  }
+  auto c = SatBinaryNum::constant(solver, n, v + 1);
+  return obj.sub(c).bit_var(n);
+}
+
+END_NONAMESPACE
+
+// @brief 2進符号化された数値を最小化する．
+SatBool3
+SatSolver::minimize(
+  const SatBinaryNum& obj,
+  SatOptStrategy strategy,
+  SizeType time_limit
+)
+{
+  SizeType n = obj.bit_num();
+  if ( n >= 63 ) {
+    throw std::invalid_argument{"minimize(): obj.bit_num() is too large"};
+  }
+  std::int64_t hi = (static_cast<std::int64_t>(1) << n) - 1;
+
+  auto le_lit = [&](std::int64_t v) -> SatLiteral {
+    return binary_le_lit(*this, obj, v);
+  };
+  auto eval = [&](const SatModel& model) -> std::int64_t {
+    return obj.val(model);
+  };
+  return _minimize(0, hi, le_lit, eval, strategy, time_limit);
+}
+
+// @brief 順序符号化された変数を最小化する．
+SatBool3
+SatSolver::minimize(
+  const SatOrderedSet& obj,
+  SatOptStrategy strategy,
+  SizeType time_limit
+)
+{
+  auto le_lit = [&](std::int64_t v) -> SatLiteral {
+    return obj.le_lit(v);
+  };
+  auto eval = [&](const SatModel& model) -> std::int64_t {
+    return obj.val(model);
+  };
+  return _minimize(obj.min(), obj.max(), le_lit, eval, strategy, time_limit);
+}
+
+// @brief Σ weight_list[i] * lit_list[i] を最小化する．
+SatBool3
+SatSolver::minimize(
+  const vector<int>& weight_list,
+  const vector<SatLiteral>& lit_list,
+  SatOptStrategy strategy,
+  SizeType time_limit
+)
+{
+  SizeType n = lit_list.size();
+  if ( weight_list.size() != n ) {
+    throw std::invalid_argument{"weight_list.size() != lit_list.size()"};
+  }
+
+  std::int64_t lo = 0;
+  std::int64_t hi = 0;
+  for ( auto w: weight_list ) {
+    if ( w < 0 ) {
+      lo += w;
+    }
+    else {
+      hi += w;
+    }
+  }
+
+  // 負の重みの項は w * l = w + (-w) * ~l と書き換えると
+  // 目的関数は lo + Σ |w_i| * l'_i となる．
+  // Σ |w_i| * l'_i は重み付きのビットを加算器の木で足し合わせた
+  // SatBinaryNum として最初の le_lit() で一度だけ符号化し，
+  // 上界はその値と定数の比較結果のリテラルで表す．
+  // _minimize() の中では条件リテラルはクリアされている．
+  SatBinaryNum sum;
+  auto make_sum = [&]() {
+    auto zero = ~const_true();
+    vector<SatBinaryNum> term_list;
+    for ( SizeType i = 0; i < n; ++ i ) {
+      std::int64_t w = weight_list[i];
+      auto lit = lit_list[i];
+      if ( w < 0 ) {
+	w = -w;
+	lit = ~lit;
+      }
+      vector<SatLiteral> bit_list;
+      for ( ; (w >> bit_list.size()) != 0; ) {
+	bool b = (w >> bit_list.size()) & 1;
+	bit_list.push_back(b ? lit : zero);
+      }
+      if ( !bit_list.empty() ) {
+	term_list.push_back(SatBinaryNum{*this, bit_list});
+      }
+    }
+    while ( term_list.size() > 1 ) {
+      vector<SatBinaryNum> next_list;
+      next_list.reserve((term_list.size() + 1) / 2);
+      for ( SizeType i = 0; i + 1 < term_list.size(); i += 2 ) {
+	next_list.push_back(term_list[i].add(term_list[i + 1]));
+      }
+      if ( term_list.size() % 2 == 1 ) {
+	next_list.push_back(term_list.back());
+      }
+      std::swap(term_list, next_list);
+    }
+    sum = term_list.front();
+  };
+  auto le_lit = [&](std::int64_t v) -> SatLiteral {
+    if ( v >= hi ) {
+      return const_true();
+    }
+    if ( v < lo ) {
+      return ~const_true();
+    }
+    // lo <= v < hi なので重みが 0 でない項が存在する．
+    if ( sum.bit_num() == 0 ) {
+      make_sum();
+    }
+    return binary_le_lit(*this, sum, v - lo);
+  };
+  auto eval = [&](const SatModel& model) -> std::int64_t {
+    std::int64_t val = 0;
+    for ( SizeType i = 0; i < n; ++ i ) {
+      if ( model[lit_list[i]] == SatBool3::True ) {
+	val += weight_list[i];
+      }
+    }
+    return val;
+  };
+  return _minimize(lo, hi, le_lit, eval, strategy, time_limit);
+}
+
+// @brief minimize() の下請け関数
+SatBool3
+SatSolver::_minimize(
+  std::int64_t lo,
+  std::int64_t hi,
+  const std::function<SatLiteral(std::int64_t)>& le_lit,
+  const std::function<std::int64_t(const SatModel&)>& eval,
+  SatOptStrategy strategy,
+  SizeType time_limit
+)
+{
+  if ( !sane() ) {
+    // 既に充足不能となっている．
+    mModel = SatModel{};
+    return SatBool3::False;
+  }
+
+  // 上界を表すリテラルを作る時に条件リテラルが付加されないようにする．
+  auto cond_lits = mConditionalLits;
+  mConditionalLits.clear();
+
+  using Clock = std::chrono::steady_clock;
+  auto start = Clock::now();
+  // 残り時間を時間制約として solve() を呼ぶ．
+  auto solve1 = [&](const vector<SatLiteral>& assumptions) -> SatBool3 {
+    SizeType limit = 0;
+    if ( time_limit > 0 ) {
+      // steady_clock なので経過時間は負にならない．
+      auto elapsed = static_cast<SizeType>(std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - start).count());
+      if ( elapsed >= time_limit ) {
+	return SatBool3::X;
+      }
+      limit = time_limit - elapsed;
+    }
+    return solve(assumptions, limit);
+  };
+
+  mOptLowerBound = lo;
+  mOptValue = hi;
+  SatModel best_model;
+  bool found = false;
+  // 下界を表すリテラル
+  SatLiteral lb_lit = SatLiteral::X;
+
+  auto report = [&]() {
+    for ( auto msg_handler: mMsgHandlerList ) {
+      msg_handler->print_bound(mOptLowerBound, mOptValue);
+    }
+  };
+
+  // 目的関数の値が ub 以下という仮定のもとで解く．
+  auto probe = [&](std::int64_t ub) -> SatBool3 {
+    auto ub_lit = le_lit(ub);
+    vector<SatLiteral> assumptions{ub_lit};
+    if ( lb_lit.is_valid() ) {
+      assumptions.push_back(lb_lit);
+    }
+    auto stat = solve1(assumptions);
+    if ( stat == SatBool3::True ) {
+      found = true;
+      mOptValue = eval(mModel);
+      best_model = mModel;
+      // 次の探索ではこの解の値割り当てを優先させる．
+      mImpl->set_phase(mModel);
+      report();
+    }
+    else if ( stat == SatBool3::False ) {
+      mOptLowerBound = ub + 1;
+      lb_lit = ~ub_lit;
+      if ( ub < hi ) {
+	report();
+      }
+    }
+    return stat;
+  };
+
+  SatBool3 ans = SatBool3::X;
+  switch ( strategy ) {
+  case SatOptStrategy::SatUnsat:
+  case SatOptStrategy::Binary:
+    ans = probe(hi);
+    if ( ans != SatBool3::True ) {
+      break;
+    }
+    while ( mOptLowerBound < mOptValue ) {
+      std::int64_t ub = mOptValue - 1;
+      if ( strategy == SatOptStrategy::Binary ) {
+	ub = mOptLowerBound + (mOptValue - 1 - mOptLowerBound) / 2;
+      }
+      if ( probe(ub) == SatBool3::X ) {
+	ans = SatBool3::X;
+	break;
+      }
+    }
+    break;
+
+  case SatOptStrategy::UnsatSat:
+    for ( ; ; ) {
+      auto ub = mOptLowerBound;
+      ans = probe(ub);
+      if ( ans != SatBool3::False || ub >= hi ) {
+	break;
+      }
+    }
+    break;
+  }
+
+  if ( found ) {
+    mModel = std::move(best_model);
+  }
+  else {
+    mModel = SatModel{};
+  }
+  mConditionalLits = cond_lits;
+
+  return ans;
+}
+
+END_NAMESPACE_YM_SAT
@@ -0,0 +1,559 @@
+
+/// @file SatSolver_pb.cc
+/// @brief SatSolver の実装ファイル(擬似ブール制約関係)
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "SatSolverImpl.h"
+#include <limits>
+#include <map>
+#include <numeric>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// Auto の場合に BDD を用いる「リテラル数 x 右辺」の上限
+const SizeType BDD_THRESHOLD = 1 << 20;
+
+// 区間の端を表す十分大きな値
+const std::int64_t PB_INF = std::numeric_limits<std::int64_t>::max() / 4;
+
+// 節に展開する方法を自動で選ぶ．
+SatPbEnc
+pb_auto_encoding(
+  SizeType n,
+  SizeType bound
+)
+{
+  // sat_pb_bench の結果では BDD が最速だった．
+  // 節点数は n * bound で抑えられるので，それが大きすぎる場合には
+  // 節数が O(n log bound) の加算器を用いる．
+  if ( n * bound <= BDD_THRESHOLD ) {
+    return SatPbEnc::Bdd;
+  }
+  return SatPbEnc::Adder;
+}
+
+// Σ weights[i] * lits[i] >= bound を表す BDD を作るクラス
+//
+// Abio et al. の方法で，節点 (i, K) が表す
+// 「Σ_{j >= i} weights[j] * lits[j] >= K」と等価になる K の区間
+// [beta, gamma] を求めて節点を共有する．
+// 根を真にした時に必要な向きの節だけを作る．
+class PbBddEnc
+{
+public:
+
+  // 節点の情報
+  struct Node
+  {
+    std::int64_t mBeta;  // 区間の下限
+    std::int64_t mGamma; // 区間の上限
+    int mConst;          // 定数の場合 0 か 1，そうでなければ -1
+    SatLiteral mLit;     // 節点を表すリテラル
+  };
+
+  // コンストラクタ
+  //
+  // lits と weights は重みの降順に並んでいること．
+  PbBddEnc(
+    SatSolver& solver,
+    const vector<SatLiteral>& lits,
+    const vector<SizeType>& weights
+  ) : mSolver{solver},
+      mLits{lits},
+      mWeights{weights},
+      mSuffixSum(lits.size() + 1, 0),
+      mTable(lits.size())
+  {
+    for ( SizeType i = lits.size(); i -- > 0; ) {
+      mSuffixSum[i] = mSuffixSum[i + 1] + weights[i];
+    }
+  }
+
+  // 節点 (i, K) を作る．
+  Node
+  make_node(
+    SizeType i,
+    std::int64_t k
+  )
+  {
+    if ( k <= 0 ) {
+      return Node{-PB_INF, 0, 1, SatLiteral::X};
+    }
+    if ( k > mSuffixSum[i] ) {
+      return Node{mSuffixSum[i] + 1, PB_INF, 0, SatLiteral::X};
+    }
+    auto& table = mTable[i];
+    auto p = table.upper_bound(k);
+    if ( p != table.begin() ) {
+      -- p;
+      if ( k <= p->second.mGamma ) {
+	return p->second;
+      }
+    }
+
+    std::int64_t w = mWeights[i];
+    auto hi = make_node(i + 1, k - w);
+    auto lo = make_node(i + 1, k);
+    auto beta = std::max(hi.mBeta + w, lo.mBeta);
+    auto gamma = std::min(hi.mGamma + w, lo.mGamma);
+    Node node{beta, gamma, -1, SatLiteral::X};
+    if ( hi.mConst == lo.mConst && hi.mLit == lo.mLit ) {
+      // 2つの子供が同じなら節点を作らない．
+      node.mConst = lo.mConst;
+      node.mLit = lo.mLit;
+    }
+    else {
+      // 0 枝(lo)は 1 枝(hi)を含意するので hi は定数0にならず，
+      // lo は定数1にならない．
+      auto v = mSolver.new_variable(false);
+      if ( hi.mConst == -1 ) {
+	mSolver.add_clause(~v, hi.mLit);
+      }
+      if ( lo.mConst == -1 ) {
+	mSolver.add_clause(~v, mLits[i], lo.mLit);
+      }
+      else {
+	mSolver.add_clause(~v, mLits[i]);
+      }
+      node.mLit = v;
+    }
+    table.emplace(beta, node);
+    return node;
+  }
+
+
+private:
+
+  // ソルバ
+  SatSolver& mSolver;
+
+  // リテラルのリスト
+  const vector<SatLiteral>& mLits;
+
+  // 重みのリスト
+  const vector<SizeType>& mWeights;
+
+  // i 番目以降の重みの和
+  vector<std::int64_t> mSuffixSum;
+
+  // 段ごとの区間の下限をキーにした節点の表
+  vector<std::map<std::int64_t, Node>> mTable;
+
+};
+
+END_NONAMESPACE
+
+// @brief 与えられたリテラルのうち true になる個数が k 以下という制約を追加する．
+void
+SatSolver::add_card_le(
+  const vector<SatLiteral>& lit_list,
+  SizeType k
+)
+{
+  vector<int> weight_list(lit_list.size(), -1);
+  _add_pb_constraint(weight_list, lit_list, - static_cast<std::int64_t>(k),
+		     SatPbEnc::Auto);
+}
+
+// @brief 与えられたリテラルのうち true になる個数が k 以上という制約を追加する．
+void
+SatSolver::add_card_ge(
+  const vector<SatLiteral>& lit_list,
+  SizeType k
+)
+{
+  vector<int> weight_list(lit_list.size(), 1);
+  _add_pb_constraint(weight_list, lit_list, k, SatPbEnc::Auto);
+}
+
+// @brief Σ weight_list[i] * lit_list[i] <= bound という擬似ブール制約を追加する．
+void
+SatSolver::add_pb_le(
+  const vector<int>& weight_list,
+  const vector<SatLiteral>& lit_list,
+  int bound,
+  SatPbEnc enc
+)
+{
+  // 両辺の符号を反転させて >= の形にする．
+  vector<int> weight_list1;
+  weight_list1.reserve(weight_list.size());
+  for ( auto w: weight_list ) {
+    weight_list1.push_back(- w);
+  }
+  _add_pb_constraint(weight_list1, lit_list, - static_cast<std::int64_t>(bound),
+		     enc);
+}
+
+// @brief Σ weight_list[i] * lit_list[i] >= bound という擬似ブール制約を追加する．
+void
+SatSolver::add_pb_ge(
+  const vector<int>& weight_list,
+  const vector<SatLiteral>& lit_list,
+  int bound,
+  SatPbEnc enc
+)
+{
+  _add_pb_constraint(weight_list, lit_list, bound, enc);
+}
+
+// @brief Σ weight_list[i] * lit_list[i] == bound という擬似ブール制約を追加する．
+void
+SatSolver::add_pb_eq(
+  const vector<int>& weight_list,
+  const vector<SatLiteral>& lit_list,
+  int bound,
+  SatPbEnc enc
+)
+{
+  add_pb_ge(weight_list, lit_list, bound, enc);
+  add_pb_le(weight_list, lit_list, bound, enc);
+}
+
+// @brief 擬似ブール制約を正規化して追加する．
+void
+SatSolver::_add_pb_constraint(
+  const vector<int>& weight_list,
+  const vector<SatLiteral>& lit_list,
+  std::int64_t bound,
+  SatPbEnc enc
+)
+{
+  SizeType n = lit_list.size();
+  if ( weight_list.size() != n ) {
+    throw std::invalid_argument{"weight_list.size() != lit_list.size()"};
+  }
+
+  // 変数ごとに肯定のリテラルの係数をまとめる．
+  // w * ~x = w - w * x なので否定のリテラルの重みは右辺に反映させる．
+  vector<SatLiteral> var_list;
+  vector<std::int64_t> coef_list;
+  unordered_map<SizeType, SizeType> pos_map;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto lit = lit_list[i];
+    std::int64_t w = weight_list[i];
+    if ( w == 0 ) {
+      continue;
+    }
+    if ( lit.is_negative() ) {
+      bound -= w;
+      w = - w;
+    }
+    auto p = pos_map.find(lit.varid());
+    if ( p == pos_map.end() ) {
+      pos_map.emplace(lit.varid(), var_list.size());
+      var_list.push_back(lit.make_positive());
+      coef_list.push_back(w);
+    }
+    else {
+      coef_list[p->second] += w;
+    }
+  }
+
+  // 係数が負の変数は否定のリテラルにして重みを正にする．
+  // w * x = w - |w| * ~x (w < 0) なので右辺に |w| を加える．
+  vector<SatLiteral> lits;
+  vector<SizeType> weights;
+  for ( SizeType i = 0; i < var_list.size(); ++ i ) {
+    auto c = coef_list[i];
+    if ( c > 0 ) {
+      lits.push_back(var_list[i]);
+      weights.push_back(c);
+    }
+    else if ( c < 0 ) {
+      lits.push_back(~var_list[i]);
+      weights.push_back(- c);
+      bound -= c;
+    }
+  }
+  if ( bound <= 0 ) {
+    // 常に成り立つ．
+    return;
+  }
+
+  // 右辺を超える重みは右辺と同じにしても意味は変わらない．
+  SizeType nl = lits.size();
+  SizeType sum = 0;
+  for ( auto& w: weights ) {
+    w = std::min<SizeType>(w, bound);
+    sum += w;
+  }
+  if ( static_cast<std::int64_t>(sum) < bound ) {
+    // 全てのリテラルを真にしても満たせない．
+    add_clause(vector<SatLiteral>{});
+    return;
+  }
+
+  // 重みの最大公約数 g で両辺を割る．
+  // 左辺は g の倍数なので右辺は切り上げてよい．
+  SizeType g = 0;
+  for ( auto w: weights ) {
+    g = std::gcd(g, w);
+  }
+  if ( g > 1 ) {
+    for ( auto& w: weights ) {
+      w /= g;
+    }
+    bound = (bound + g - 1) / g;
+  }
+
+  if ( enc == SatPbEnc::Auto ) {
+    enc = mPbEnc;
+  }
+  if ( enc == SatPbEnc::Auto && mNativePb ) {
+    // 条件リテラル c に対しては ~c を右辺と同じ重みで加える．
+    // c が偽ならば制約は常に満たされる．
+    bool ok = true;
+    for ( auto c: mConditionalLits ) {
+      if ( pos_map.count(c.varid()) > 0 ) {
+	// 同じ変数が重複するので節に展開する．
+	ok = false;
+	break;
+      }
+      lits.push_back(~c);
+      weights.push_back(bound);
+    }
+    if ( ok && mImpl->add_pb_constraint(lits.size(), lits.data(),
+					weights.data(), bound) ) {
+      ++ mPbNum;
+      if ( mKeepClauses ) {
+	mPbLits.insert(mPbLits.end(), lits.begin(), lits.end());
+	mPbWeights.insert(mPbWeights.end(), weights.begin(), weights.end());
+	mPbBegin.push_back(mPbLits.size());
+	mPbBound.push_back(bound);
+      }
+      return;
+    }
+    lits.resize(nl);
+    weights.resize(nl);
+  }
+
+  _add_pb_cnf(nl, lits.data(), weights.data(), bound, enc);
+}
+
+// @brief 正規化された擬似ブール制約を節に展開して追加する．
+void
+SatSolver::_add_pb_cnf(
+  SizeType n,
+  const SatLiteral* lits,
+  const SizeType* weights,
+  SizeType bound,
+  SatPbEnc enc
+)
+{
+  bool is_card = true;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( weights[i] != weights[0] ) {
+      is_card = false;
+      break;
+    }
+  }
+  if ( is_card ) {
+    // 重みが全て等しければ基数制約になる．
+    vector<SatLiteral> lit_list(lits, lits + n);
+    auto w = weights[0];
+    add_at_least_k(lit_list, (bound + w - 1) / w);
+    return;
+  }
+
+  if ( enc == SatPbEnc::Auto ) {
+    enc = pb_auto_encoding(n, bound);
+  }
+  switch ( enc ) {
+  case SatPbEnc::Bdd:
+    _add_pb_bdd(n, lits, weights, bound);
+    break;
+
+  case SatPbEnc::GenTotalizer:
+    _add_pb_gen_totalizer(n, lits, weights, bound);
+    break;
+
+  case SatPbEnc::SortNetwork:
+    _add_pb_sort_network(n, lits, weights, bound);
+    break;
+
+  default:
+    _add_pb_adder(n, lits, weights, bound);
+    break;
+  }
+}
+
+// @brief 加算器を用いて擬似ブール制約を節に展開する．
+void
+SatSolver::_add_pb_adder(
+  SizeType n,
+  const SatLiteral* lits,
+  const SizeType* weights,
+  SizeType bound
+)
+{
+  SizeType max_w = 0;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    max_w = std::max(max_w, weights[i]);
+  }
+
+  // 重みのビットごとに真のリテラルの個数を数え，
+  // 上位のビットから順に 2 倍して足していく．
+  SizeType nb = 0;
+  while ( (max_w >> nb) > 0 ) {
+    ++ nb;
+  }
+  auto zero = new_variable(false);
+  add_clause(~zero);
+  vector<SatLiteral> sum_lits;
+  for ( SizeType b = nb; b -- > 0; ) {
+    vector<SatLiteral> blits;
+    for ( SizeType i = 0; i < n; ++ i ) {
+      if ( (weights[i] >> b) & 1 ) {
+	blits.push_back(lits[i]);
+      }
+    }
+    if ( !sum_lits.empty() ) {
+      sum_lits.insert(sum_lits.begin(), zero);
+    }
+    auto clits = add_counter(blits);
+    if ( clits.empty() ) {
+      continue;
+    }
+    if ( sum_lits.empty() ) {
+      sum_lits.swap(clits);
+      continue;
+    }
+    SizeType ns = std::max(sum_lits.size(), clits.size());
+    vector<SatLiteral> slits(ns);
+    for ( auto& slit: slits ) {
+      slit = new_variable(false);
+    }
+    auto olit = new_variable(false);
+    add_adder(sum_lits, clits, zero, slits, olit);
+    slits.push_back(olit);
+    sum_lits.swap(slits);
+  }
+  add_ge(sum_lits, bound);
+}
+
+// @brief BDD を用いて擬似ブール制約を節に展開する．
+void
+SatSolver::_add_pb_bdd(
+  SizeType n,
+  const SatLiteral* lits,
+  const SizeType* weights,
+  SizeType bound
+)
+{
+  // 重みの大きい順に並べると節点数が少なくなる．
+  vector<SizeType> order(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+		   [&](SizeType a, SizeType b) {
+		     return weights[a] > weights[b];
+		   });
+  vector<SatLiteral> lit_list(n);
+  vector<SizeType> weight_list(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    lit_list[i] = lits[order[i]];
+    weight_list[i] = weights[order[i]];
+  }
+
+  PbBddEnc enc{*this, lit_list, weight_list};
+  auto root = enc.make_node(0, bound);
+  if ( root.mConst == 0 ) {
+    add_clause(vector<SatLiteral>{});
+  }
+  else if ( root.mConst == -1 ) {
+    add_clause(root.mLit);
+  }
+}
+
+// @brief generalized totalizer を用いて擬似ブール制約を節に展開する．
+void
+SatSolver::_add_pb_gen_totalizer(
+  SizeType n,
+  const SatLiteral* lits,
+  const SizeType* weights,
+  SizeType bound
+)
+{
+  // Σ w_i * x_i >= bound を Σ w_i * ~x_i <= k (k = Σ w_i - bound) に
+  // 直して，部分和ごとの出力を持つ totalizer を作る．
+  // k を超える部分和は k + 1 にまとめる．
+  SizeType sum = 0;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    sum += weights[i];
+  }
+  SizeType k = sum - bound;
+  using Node = std::map<SizeType, SatLiteral>;
+  vector<Node> node_list;
+  node_list.reserve(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    node_list.push_back(Node{{std::min(weights[i], k + 1), ~lits[i]}});
+  }
+  while ( node_list.size() > 1 ) {
+    vector<Node> next_list;
+    next_list.reserve((node_list.size() + 1) / 2);
+    for ( SizeType i = 0; i + 1 < node_list.size(); i += 2 ) {
+      auto& a = node_list[i];
+      auto& b = node_list[i + 1];
+      Node r;
+      auto get_lit = [&](SizeType v) {
+	v = std::min(v, k + 1);
+	auto p = r.find(v);
+	if ( p != r.end() ) {
+	  return p->second;
+	}
+	auto lit = new_variable(false);
+	r.emplace(v, lit);
+	return lit;
+      };
+      for ( auto& p: a ) {
+	add_clause(~p.second, get_lit(p.first));
+      }
+      for ( auto& q: b ) {
+	add_clause(~q.second, get_lit(q.first));
+      }
+      for ( auto& p: a ) {
+	for ( auto& q: b ) {
+	  add_clause(~p.second, ~q.second, get_lit(p.first + q.first));
+	}
+      }
+      next_list.push_back(std::move(r));
+    }
+    if ( node_list.size() % 2 == 1 ) {
+      next_list.push_back(std::move(node_list.back()));
+    }
+    node_list.swap(next_list);
+  }
+  auto& root = node_list[0];
+  auto p = root.find(k + 1);
+  if ( p != root.end() ) {
+    add_clause(~p->second);
+  }
+}
+
+// @brief ソーティングネットワークを用いて擬似ブール制約を節に展開する．
+void
+SatSolver::_add_pb_sort_network(
+  SizeType n,
+  const SatLiteral* lits,
+  const SizeType* weights,
+  SizeType bound
+)
+{
+  // 各リテラルを重みの数だけ並べて個数制約にする．
+  vector<SatLiteral> lit_list;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    lit_list.insert(lit_list.end(), weights[i], lits[i]);
+  }
+  add_at_least_k(lit_list, bound, SatCardEnc::CardNetwork);
+}
+
+END_NAMESPACE_YM_SAT
@@ -22,15 +22,23 @@ SatSolver::add_andgate(
   const vector<SatLiteral>& lit_list
 )
 {
+  // (ilit + ~olit) を n 個と (~ilit1 + ... + ~ilitn + olit) を
+  // まとめて追加する．
   SizeType n{lit_list.size()};
-  vector<SatLiteral> tmp_lits;
-  tmp_lits.reserve(n + 1);
+  mGateLits.clear();
+  mGateBegin.clear();
+  mGateBegin.push_back(0);
   for ( auto ilit: lit_list ) {
-    add_clause(ilit, ~olit);
-    tmp_lits.push_back(~ilit);
+    mGateLits.push_back(ilit);
+    mGateLits.push_back(~olit);
+    mGateBegin.push_back(mGateLits.size());
   }
-  tmp_lits.push_back(olit);
-  add_clause(tmp_lits);
+  for ( auto ilit: lit_list ) {
+    mGateLits.push_back(~ilit);
+  }
+  mGateLits.push_back(olit);
+  mGateBegin.push_back(mGateLits.size());
+  _add_clauses(n + 1, mGateLits.data(), mGateBegin.data());
 }
 
 // @brief n入力ORゲートの入出力の関係を表す条件を追加する．
@@ -40,46 +48,48 @@ SatSolver::add_orgate(
   const vector<SatLiteral>& lit_list
 )
 {
+  // (~ilit + olit) を n 個と (ilit1 + ... + ilitn + ~olit) を
+  // まとめて追加する．
   SizeType n{lit_list.size()};
-  vector<SatLiteral> tmp_lits;
-  tmp_lits.reserve(n + 1);
+  mGateLits.clear();
+  mGateBegin.clear();
+  mGateBegin.push_back(0);
+  for ( auto ilit: lit_list ) {
+    mGateLits.push_back(~ilit);
+    mGateLits.push_back(olit);
+    mGateBegin.push_back(mGateLits.size());
+  }
   for ( auto ilit: lit_list ) {
-    add_clause(~ilit, olit);
-    tmp_lits.push_back(ilit);
+    mGateLits.push_back(ilit);
   }
-  tmp_lits.push_back(~olit);
-  add_clause(tmp_lits);
+  mGateLits.push_back(~olit);
+  mGateBegin.push_back(mGateLits.size());
+  _add_clauses(n + 1, mGateLits.data(), mGateBegin.data());
 }
 
 // @brief n入力XORゲートの入出力の関係を表す条件を追加する．
 void
 SatSolver::_add_xorgate_sub(
   SatLiteral olit,
-  const vector<SatLiteral>& lit_list,
-  SizeType start,
+  const SatLiteral* lits,
   SizeType num
 )
 {
   ASSERT_COND( num >= 2 );
 
   if ( num == 2 ) {
-    auto lit0 = lit_list[start + 0];
-    auto lit1 = lit_list[start + 1];
-    add_xorgate(olit, lit0, lit1);
+    add_xorgate(olit, lits[0], lits[1]);
   }
   else if ( num == 3 ) {
-    auto lit0 = lit_list[start + 0];
-    auto lit1 = lit_list[start + 1];
-    auto lit2 = lit_list[start + 2];
-    add_xorgate(olit, lit0, lit1, lit2);
+    add_xorgate(olit, lits[0], lits[1], lits[2]);
   }
   else {
     SizeType nl{num / 2};
     SizeType nr{num - nl};
     auto llit = new_variable(false);
-    _add_xorgate_sub(llit, lit_list, start, nl);
+    _add_xorgate_sub(llit, lits, nl);
     auto rlit = new_variable(false);
-    _add_xorgate_sub(rlit, lit_list, start + nl, nr);
+    _add_xorgate_sub(rlit, lits + nl, nr);
     add_xorgate(olit, llit, rlit);
   }
 }
@@ -93,13 +103,17 @@ SatSolver::add_half_adder(
   SatLiteral olit
 )
 {
-  add_clause(~slit,  alit,  blit);
-  add_clause( slit,  alit, ~blit);
-  add_clause( slit, ~alit,  blit);
-  add_clause(~slit, ~alit, ~blit);
-  add_clause(~olit,  alit       );
-  add_clause(~olit,         blit);
-  add_clause( olit, ~alit, ~blit);
+  SatLiteral lits[] = {
+    ~slit,  alit,  blit,
+     slit,  alit, ~blit,
+     slit, ~alit,  blit,
+    ~slit, ~alit, ~blit,
+    ~olit,  alit,
+    ~olit,  blit,
+     olit, ~alit, ~blit
+  };
+  const SizeType begin_list[] = {0, 3, 6, 9, 12, 14, 16, 19};
+  _add_clauses(7, lits, begin_list);
 }
 
 // @brief full_adder の入出力の関係を表す条件を追加する．
@@ -112,20 +126,25 @@ SatSolver::add_full_adder(
   SatLiteral olit
 )
 {
-  add_clause(~slit,  alit,  blit,  ilit);
-  add_clause( slit,  alit,  blit, ~ilit);
-  add_clause( slit,  alit, ~blit,  ilit);
-  add_clause(~slit,  alit, ~blit, ~ilit);
-  add_clause( slit, ~alit,  blit,  ilit);
-  add_clause(~slit, ~alit,  blit, ~ilit);
-  add_clause(~slit, ~alit, ~blit,  ilit);
-  add_clause( slit, ~alit, ~blit, ~ilit);
-  add_clause(~olit,  alit,  blit       );
-  add_clause(~olit,  alit,         ilit);
-  add_clause(~olit,         blit,  ilit);
-  add_clause( olit, ~alit, ~blit       );
-  add_clause( olit, ~alit,        ~ilit);
-  add_clause( olit,        ~blit, ~ilit);
+  SatLiteral lits[] = {
+    ~slit,  alit,  blit,  ilit,
+     slit,  alit,  blit, ~ilit,
+     slit,  alit, ~blit,  ilit,
+    ~slit,  alit, ~blit, ~ilit,
+     slit, ~alit,  blit,  ilit,
+    ~slit, ~alit,  blit, ~ilit,
+    ~slit, ~alit, ~blit,  ilit,
+     slit, ~alit, ~blit, ~ilit,
+    ~olit,  alit,  blit,
+    ~olit,  alit,         ilit,
+    ~olit,         blit,  ilit,
+     olit, ~alit, ~blit,
+     olit, ~alit,        ~ilit,
+     olit,        ~blit, ~ilit
+  };
+  const SizeType begin_list[] = {0, 4, 8, 12, 16, 20, 24, 28, 32,
+				 35, 38, 41, 44, 47, 50};
+  _add_clauses(14, lits, begin_list);
 }
 
 // @brief 多ビットadderの入出力の関係を表す条件を追加する．
@@ -138,9 +157,26 @@ SatSolver::add_adder(
   SatLiteral olit
 )
 {
-  SizeType na{alits.size()};
-  SizeType nb{blits.size()};
-  SizeType ns{slits.size()};
+  _add_adder(alits.data(), alits.size(),
+	     blits.data(), blits.size(),
+	     ilit,
+	     slits.data(), slits.size(),
+	     olit);
+}
+
+// @brief add_adder() の下請け関数
+void
+SatSolver::_add_adder(
+  const SatLiteral* alits,
+  SizeType na,
+  const SatLiteral* blits,
+  SizeType nb,
+  SatLiteral ilit,
+  const SatLiteral* slits,
+  SizeType ns,
+  SatLiteral olit
+)
+{
   ASSERT_COND( na <= ns );
   ASSERT_COND( nb <= ns );
 
@@ -195,13 +231,17 @@ SatSolver::add_adder(
 
 BEGIN_NONAMESPACE
 
+// カウンタの出力の最大ビット数
+// SizeType で表せる個数には十分
+const SizeType MAX_COUNTER_BITS = 64;
+
 SizeType
 get_ln(
   SizeType n
 )
 {
   SizeType n_ln = 0;
-  while ( (1 << n_ln) <= n ) {
+  while ( (SizeType{1} << n_ln) <= n ) {
     ++ n_ln;
   }
   return n_ln;
@@ -217,21 +257,42 @@ SatSolver::add_counter(
 )
 {
   SizeType ni{ilits.size()};
+  if ( ni == 0 ) {
+    return {};
+  }
+  vector<SatLiteral> olits(get_ln(ni));
+  _add_counter(ilits.data(), ni, decision, olits.data());
+  return olits;
+}
+
+// @brief add_counter() の下請け関数
+SizeType
+SatSolver::_add_counter(
+  const SatLiteral* ilits,
+  SizeType ni,
+  bool decision,
+  SatLiteral* olits
+)
+{
   if ( ni == 1 ) {
-    auto olit = ilits[0];
-    return {olit};
+    olits[0] = ilits[0];
+    return 1;
   }
   else if ( ni == 2 ) {
     auto olit0 = new_variable(decision);
     auto olit1 = new_variable(decision);
     add_half_adder(ilits[0], ilits[1], olit0, olit1);
-    return {olit0, olit1};
+    olits[0] = olit0;
+    olits[1] = olit1;
+    return 2;
   }
   else if ( ni == 3 ) {
     auto olit0 = new_variable(decision);
     auto olit1 = new_variable(decision);
     add_full_adder(ilits[0], ilits[1], ilits[2], olit0, olit1);
-    return {olit0, olit1};
+    olits[0] = olit0;
+    olits[1] = olit1;
+    return 2;
   }
   else if ( ni == 4 ) {
     auto olit0 = new_variable(decision);
@@ -246,7 +307,10 @@ SatSolver::add_counter(
     add_half_adder(ilits[2], ilits[3], d0, d1);
     add_half_adder(c0, d0, olit0, e1);
     add_full_adder(c1, d1, e1, olit1, olit2);
-    return {olit0, olit1, olit2};
+    olits[0] = olit0;
+    olits[1] = olit1;
+    olits[2] = olit2;
+    return 3;
   }
   else if ( ni == 5 ) {
     auto olit0 = new_variable(decision);
@@ -259,38 +323,31 @@ SatSolver::add_counter(
     auto e1 = new_variable(decision);
     add_half_adder(ilits[0], ilits[1], c0, c1);
     add_half_adder(ilits[2], ilits[3], d0, d1);
-    vector<SatLiteral> clits{c0, c1};
-    vector<SatLiteral> dlits{d0, d1};
-    vector<SatLiteral> tmp_olits{olit0, olit1};
-    add_adder(clits, dlits, ilits[4], tmp_olits, olit2);
-    return {olit0, olit1, olit2};
+    SatLiteral clits[] = {c0, c1};
+    SatLiteral dlits[] = {d0, d1};
+    olits[0] = olit0;
+    olits[1] = olit1;
+    olits[2] = olit2;
+    _add_adder(clits, 2, dlits, 2, ilits[4], olits, 2, olit2);
+    return 3;
   }
   else {
+    // 部分カウンタの出力はスタック上の固定長の配列に受け取る．
     SizeType ni1{(ni - 1) / 2};
-    vector<SatLiteral> tmp_ilits1(ni1);
-    for ( SizeType i = 0; i < ni1; ++ i ) {
-      tmp_ilits1[i] = ilits[i];
-    }
-    auto tmp_olits1 = add_counter(tmp_ilits1);
+    SatLiteral tmp_olits1[MAX_COUNTER_BITS];
+    auto no1 = _add_counter(ilits, ni1, false, tmp_olits1);
 
     SizeType ni2{ni - ni1 - 1};
-    vector<SatLiteral> tmp_ilits2(ni2);
-    for ( SizeType i = 0; i < ni2; ++ i ) {
-      tmp_ilits2[i] = ilits[i + ni1];
-    }
-    auto tmp_olits2 = add_counter(tmp_ilits2);
+    SatLiteral tmp_olits2[MAX_COUNTER_BITS];
+    auto no2 = _add_counter(ilits + ni1, ni2, false, tmp_olits2);
 
     SizeType no{get_ln(ni)};
-    vector<SatLiteral> olits(no);
     for ( SizeType i = 0; i < no; ++ i ) {
       olits[i] = new_variable(decision);
     }
-    vector<SatLiteral> tmp_olits3(no - 1);
-    for ( SizeType i = 0; i < (no - 1); ++ i ) {
-      tmp_olits3[i] = olits[i];
-    }
-    add_adder(tmp_olits1, tmp_olits2, ilits[ni - 1], tmp_olits3, olits[no - 1]);
-    return olits;
+    _add_adder(tmp_olits1, no1, tmp_olits2, no2, ilits[ni - 1],
+	       olits, no - 1, olits[no - 1]);
+    return no;
   }
 }
 
@@ -0,0 +1,127 @@
+
+/// @file SatSolver_xor.cc
+/// @brief SatSolver の実装ファイル(XOR 制約関係)
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "SatSolverImpl.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// lits[0] ^ ... ^ lits[n - 1] = rhs を表す節を lit_list と begin_list に追加する．
+void
+put_parity_clauses(
+  const SatLiteral* lits,
+  SizeType n,
+  bool rhs,
+  vector<SatLiteral>& lit_list,
+  vector<SizeType>& begin_list
+)
+{
+  SizeType np = 1U << n;
+  for ( SizeType p = 0; p < np; ++ p ) {
+    bool val = false;
+    for ( SizeType i = 0; i < n; ++ i ) {
+      if ( p & (1U << i) ) {
+	val = !val;
+      }
+    }
+    if ( val == rhs ) {
+      continue;
+    }
+    // 制約を満たさない割り当て p を禁止する節
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto lit = lits[i];
+      lit_list.push_back(p & (1U << i) ? ~lit : lit);
+    }
+    begin_list.push_back(lit_list.size());
+  }
+}
+
+END_NONAMESPACE
+
+// @brief add_xor_constraint() の下請け関数
+void
+SatSolver::_add_xor_constraint(
+  SizeType n,
+  const SatLiteral* lits,
+  bool rhs
+)
+{
+  if ( mNativeXor && mConditionalLits.empty() &&
+       mImpl->add_xor_constraint(n, lits, rhs) ) {
+    ++ mXorNum;
+    if ( mKeepClauses ) {
+      mXorLits.insert(mXorLits.end(), lits, lits + n);
+      mXorBegin.push_back(mXorLits.size());
+      mXorRhs.push_back(rhs);
+    }
+    return;
+  }
+
+  _add_xor_cnf(n, lits, rhs);
+}
+
+// @brief XOR 制約を節に展開して追加する．
+void
+SatSolver::_add_xor_cnf(
+  SizeType n,
+  const SatLiteral* lits,
+  bool rhs
+)
+{
+  // 否定のリテラルは右辺に反映させ，同じ変数は2つずつ打ち消し合う．
+  vector<SatLiteral> lit_list;
+  lit_list.reserve(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto lit = lits[i];
+    if ( lit.is_negative() ) {
+      lit = ~lit;
+      rhs = !rhs;
+    }
+    lit_list.push_back(lit);
+  }
+  sort(lit_list.begin(), lit_list.end());
+  SizeType wpos = 0;
+  for ( auto lit: lit_list ) {
+    if ( wpos > 0 && lit_list[wpos - 1] == lit ) {
+      -- wpos;
+      continue;
+    }
+    lit_list[wpos] = lit;
+    ++ wpos;
+  }
+  lit_list.erase(lit_list.begin() + wpos, lit_list.end());
+
+  mGateLits.clear();
+  mGateBegin.clear();
+  mGateBegin.push_back(0);
+
+  // cut + 1 個を超える間は先頭の cut 個を新しい変数に置き換える．
+  // 置き換えた変数は末尾に加えるので平衡した木になる．
+  SizeType cut = xor_cut();
+  SatLiteral tmp_lits[MAX_XOR_CUT + 1];
+  SizeType rpos = 0;
+  while ( lit_list.size() - rpos > cut + 1 ) {
+    for ( SizeType i = 0; i < cut; ++ i ) {
+      tmp_lits[i] = lit_list[rpos + i];
+    }
+    auto olit = new_variable(false);
+    tmp_lits[cut] = olit;
+    put_parity_clauses(tmp_lits, cut + 1, false, mGateLits, mGateBegin);
+    rpos += cut;
+    lit_list.push_back(olit);
+  }
+  put_parity_clauses(lit_list.data() + rpos, lit_list.size() - rpos, rhs,
+		     mGateLits, mGateBegin);
+
+  _add_clauses(mGateBegin.size() - 1, mGateLits.data(), mGateBegin.data());
+}
+
+END_NAMESPACE_YM_SAT
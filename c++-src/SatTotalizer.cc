@@ -0,0 +1,77 @@
+
+/// @file SatTotalizer.cc
+/// @brief SatTotalizer の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatTotalizer.h"
+#include "ym/SatSolver.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+// @brief コンストラクタ
+SatTotalizer::SatTotalizer(
+  SatSolver& solver,
+  const vector<SatLiteral>& lit_list,
+  SizeType ub
+) : mSolver{solver},
+    mInputNum{lit_list.size()}
+{
+  mOutputList = mSolver.add_unary_counter(lit_list, ub + 1, SatCardEnc::Totalizer);
+}
+
+// @brief 個数が k 以下であることを表すリテラルを返す．
+SatLiteral
+SatTotalizer::le_literal(
+  SizeType k
+) const
+{
+  if ( k >= mInputNum ) {
+    return SatLiteral::X;
+  }
+  if ( k >= mOutputList.size() ) {
+    ostringstream buf;
+    buf << "SatTotalizer::le_literal(" << k << "): out of range";
+    throw std::invalid_argument{buf.str()};
+  }
+  return ~mOutputList[k];
+}
+
+// @brief 個数が k 以下になるという制約を作る．
+void
+SatTotalizer::add_le_constraint(
+  SizeType k
+)
+{
+  auto lit = le_literal(k);
+  if ( lit.is_valid() ) {
+    mSolver.add_clause(lit);
+  }
+}
+
+// @brief 個数が k 以上になるという制約を作る．
+void
+SatTotalizer::add_ge_constraint(
+  SizeType k
+)
+{
+  if ( k == 0 ) {
+    return;
+  }
+  if ( k > mInputNum ) {
+    // 絶対に成り立たない．
+    mSolver.add_clause(vector<SatLiteral>{});
+    return;
+  }
+  if ( k > mOutputList.size() ) {
+    ostringstream buf;
+    buf << "SatTotalizer::add_ge_constraint(" << k << "): out of range";
+    throw std::invalid_argument{buf.str()};
+  }
+  mSolver.add_clause(mOutputList[k - 1]);
+}
+
+END_NAMESPACE_YM_SAT
@@ -651,6 +651,12 @@ bool Solver::addClause_(vec<Lit>& ps)
     assert(decisionLevel() == 0);
     if (!ok) return false;
 
+    // Clauses added after equivalent variables are inactivated must use
+    // the representative ones, since the model is built from them.
+    if (lazy_eqv_probing)
+        for (int i = 0; i < ps.size(); i++)
+            ps[i] = equivDelegate(ps[i]);
+
     // Check if clause is satisfied and remove false/duplicate literals:
     sort(ps);
     Lit p; int i, j;
@@ -1784,6 +1790,14 @@ void Solver::removeSatisfied(vec<CRef>& cs)
     cs.shrink(i - j);
 }
 
+// Returns the representative of the equivalent literals of p.
+Lit Solver::equivDelegate(Lit p) const
+{
+    int id = lit2eq_lits[toInt(p)];
+    if (id == NO_EQ_LITS) return p;
+    return id > 0 ? eq_lits[id].delegate() : ~eq_lits[-id].delegate();
+}
+
 // added by nabesima
 bool Solver::rewriteClauses() {
     double cpu_time = cpuTime();
@@ -2222,6 +2236,8 @@ lbool Solver::search(int nof_conflicts)
             while (decisionLevel() < assumptions.size()){
                 // Perform user provided assumption:
                 Lit p = assumptions[decisionLevel()];
+                if (lazy_eqv_probing)
+                    p = equivDelegate(p);
                 if (value(p) == l_True){
                     // Dummy decision level:
                     newDecisionLevel();
@@ -2510,6 +2526,18 @@ lbool Solver::solve_()
 */
     }else if (status == l_False && conflict.size() == 0)
         ok = false;
+    else if (status == l_False && lazy_eqv_probing)
+        // The assumptions are decided through their representatives, so
+        // analyzeFinal() reports the representatives. Map them back to the
+        // assumptions given by the caller.
+        for (int i = 0; i < conflict.size(); i++){
+            for (int j = 0; j < assumptions.size(); j++){
+                if (equivDelegate(assumptions[j]) == ~conflict[i]){
+                    conflict[i] = ~assumptions[j];
+                    break;
+                }
+            }
+        }
 
     cancelUntil(0);
     return status;
@@ -435,6 +435,7 @@ protected:
     void     lazyProbing      (Lit p, Lit new_dom);                                    // Apply lazy probing techniques. added by nabesima
     void     addProbedLit     (Lit p, int type);                                       // Adds a probed literal to the probed literal cache.
     void     putEquivLit      (Lit p, Lit q);                                          // Put two equivalent literals in the table. added by nabesima
+    Lit      equivDelegate    (Lit p) const;                                           // Returns the representative of the equivalent literals of p.
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
     // modified by nabesima
     //void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
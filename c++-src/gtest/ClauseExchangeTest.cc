@@ -0,0 +1,159 @@
+
+/// @file ClauseExchangeTest.cc
+/// @brief ClauseExchange のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ClauseExchange.h"
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+vector<Literal>
+make_lits(
+  const vector<int>& src
+)
+{
+  vector<Literal> lits;
+  for ( auto x: src ) {
+    auto var = static_cast<SatVarId>(x > 0 ? x : -x);
+    lits.push_back(Literal::conv_from_varid(var, x < 0));
+  }
+  return lits;
+}
+
+// 番号 id の節を作る．
+// リテラル数は id によって変わり，変数番号は連続している．
+vector<Literal>
+make_stress_lits(
+  SizeType id
+)
+{
+  SizeType n = 2 + id % (ClauseExchange::MAX_LIT_NUM - 1);
+  auto base = id * 32 + 1;
+  vector<Literal> lits;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto var = static_cast<SatVarId>(base + i);
+    lits.push_back(Literal::conv_from_varid(var, (id + i) % 2));
+  }
+  return lits;
+}
+
+END_NONAMESPACE
+
+TEST(ClauseExchangeTest, push_pull)
+{
+  ClauseExchange exchange;
+
+  auto lits1 = make_lits({1, -2});
+  auto lits2 = make_lits({3, 4, -5});
+  exchange.push_clause(0, lits1);
+  exchange.push_clause(1, lits2);
+
+  // ワーカ1からは自分の節は見えない．
+  std::uint64_t pos1 = 0;
+  vector<vector<Literal>> clause_list1;
+  exchange.pull_clauses(1, pos1, clause_list1);
+  ASSERT_EQ( 1, clause_list1.size() );
+  EXPECT_EQ( lits1, clause_list1[0] );
+  EXPECT_EQ( 2, pos1 );
+
+  // ワーカ2からは両方見える．
+  std::uint64_t pos2 = 0;
+  vector<vector<Literal>> clause_list2;
+  exchange.pull_clauses(2, pos2, clause_list2);
+  ASSERT_EQ( 2, clause_list2.size() );
+  EXPECT_EQ( lits1, clause_list2[0] );
+  EXPECT_EQ( lits2, clause_list2[1] );
+
+  // 2度目は新しいものだけ
+  clause_list2.clear();
+  exchange.pull_clauses(2, pos2, clause_list2);
+  EXPECT_TRUE( clause_list2.empty() );
+}
+
+TEST(ClauseExchangeTest, overflow)
+{
+  // 読み出しが追いつかなかった分は捨てられる．
+  ClauseExchange exchange{8, 4, 4};
+  for ( int i = 1; i <= 10; ++ i ) {
+    exchange.push_clause(0, make_lits({i, i + 1}));
+  }
+  std::uint64_t pos = 0;
+  vector<vector<Literal>> clause_list;
+  exchange.pull_clauses(1, pos, clause_list);
+  ASSERT_EQ( 4, clause_list.size() );
+  EXPECT_EQ( make_lits({7, 8}), clause_list[0] );
+  EXPECT_EQ( make_lits({10, 11}), clause_list[3] );
+}
+
+TEST(ClauseExchangeTest, stress)
+{
+  // 小さなバッファに複数のスレッドから同時に書き込んで
+  // 周回遅れの書き込みを起こす．
+  // 読み出した節が書き込んだ節と一致することを確かめる．
+  ClauseExchange exchange{ClauseExchange::MAX_LIT_NUM, 4, 2};
+  const SizeType writer_num = 8;
+  const SizeType push_num = 50000;
+  std::atomic<SizeType> done{0};
+  vector<std::thread> writer_list;
+  for ( SizeType w = 0; w < writer_num; ++ w ) {
+    writer_list.push_back(std::thread{[&, w]() {
+      for ( SizeType k = 0; k < push_num; ++ k ) {
+	exchange.push_clause(w, make_stress_lits(k * writer_num + w));
+      }
+      ++ done;
+    }});
+  }
+
+  SizeType pull_num = 0;
+  SizeType bad_num = 0;
+  std::uint64_t pos = 0;
+  for ( ; ; ) {
+    bool last = done.load() == writer_num;
+    vector<vector<Literal>> clause_list;
+    exchange.pull_clauses(writer_num, pos, clause_list);
+    for ( auto& lits: clause_list ) {
+      auto id = (lits.front().varid() - 1) / 32;
+      if ( lits != make_stress_lits(id) ) {
+	++ bad_num;
+      }
+    }
+    pull_num += clause_list.size();
+    if ( last ) {
+      break;
+    }
+  }
+  for ( auto& th: writer_list ) {
+    th.join();
+  }
+  EXPECT_GT( pull_num, 0 );
+  EXPECT_EQ( 0, bad_num );
+}
+
+TEST(ClauseExchangeTest, check)
+{
+  ClauseExchange exchange{5, 3};
+  EXPECT_TRUE( exchange.check(1, 1) );
+  EXPECT_TRUE( exchange.check(2, 2) );
+  EXPECT_TRUE( exchange.check(5, 3) );
+  EXPECT_FALSE( exchange.check(6, 3) );
+  EXPECT_FALSE( exchange.check(4, 4) );
+}
+
+TEST(ClauseExchangeTest, hash)
+{
+  auto h1 = ClauseExchange::hash(make_lits({1, -2, 3}));
+  auto h2 = ClauseExchange::hash(make_lits({3, 1, -2}));
+  auto h3 = ClauseExchange::hash(make_lits({1, 2, 3}));
+  EXPECT_EQ( h1, h2 );
+  EXPECT_NE( h1, h3 );
+}
+
+END_NAMESPACE_YM_SAT
@@ -9,10 +9,17 @@
 
 #include "gtest/gtest.h"
 #include "ym/SatDimacs.h"
+#include "ym/SatSolver.h"
+#include "ym/SatModel.h"
+#include "ym/JsonValue.h"
+#include "DimacsParser.h"
+#include <random>
 
 
 BEGIN_NAMESPACE_YM
 
+using nsSat::DimacsParser;
+
 TEST(DimacsTest, null)
 {
   SatDimacs dimacs;
@@ -139,4 +146,354 @@ TEST(DimacsTest, read_dimacs_err4)
   EXPECT_EQ( "Error at line 3: syntax error", msg );
 }
 
+TEST(DimacsTest, read_dimacs_multi_clause)
+{
+  SatDimacs dimacs;
+
+  // 1行に複数の節があっても，節が複数の行にまたがってもよい．
+  const char* data_str =
+    "c comment\n"
+    "p cnf 3 3\n"
+    "1 -2 0 2 3 0\n"
+    "-1\n"
+    "  -3 0\n";
+  istringstream buf{data_str};
+  bool stat = dimacs.read_dimacs(buf);
+  EXPECT_TRUE( stat );
+  EXPECT_TRUE( dimacs.message_list().empty() );
+  ASSERT_EQ( 3, dimacs.clause_num() );
+  EXPECT_EQ( 3, dimacs.variable_num() );
+  EXPECT_EQ( (vector<int>{1, -2}), dimacs.clause_list()[0] );
+  EXPECT_EQ( (vector<int>{2, 3}), dimacs.clause_list()[1] );
+  EXPECT_EQ( (vector<int>{-1, -3}), dimacs.clause_list()[2] );
+}
+
+TEST(DimacsTest, read_dimacs_err5)
+{
+  SatDimacs dimacs;
+
+  // 0 で終わっていない節がある．
+  const char* data_str =
+    "p cnf 3 2\n"
+    "1 2 0\n"
+    "-2 3";
+  istringstream buf{data_str};
+  bool stat = dimacs.read_dimacs(buf);
+  EXPECT_FALSE( stat );
+  auto& msg_list = dimacs.message_list();
+  auto& msg = msg_list.front();
+  EXPECT_EQ( "Error at line 3: unexpected end-of-file", msg );
+}
+
+TEST(DimacsTest, read_dimacs_file)
+{
+  // ファイル名を指定した場合はメモリマップで読み込む．
+  string data_dir{DATA_DIR};
+  string path{data_dir + "/uf20-01.cnf"};
+
+  SatDimacs dimacs1;
+  EXPECT_TRUE( dimacs1.read_dimacs(path) );
+
+  SatDimacs dimacs2;
+  ifstream fin(path);
+  EXPECT_TRUE( dimacs2.read_dimacs(fin) );
+
+  EXPECT_EQ( dimacs2.variable_num(), dimacs1.variable_num() );
+  EXPECT_EQ( dimacs2.clause_list(), dimacs1.clause_list() );
+}
+
+TEST(DimacsTest, read_DIMACS)
+{
+  string data_dir{DATA_DIR};
+  string path{data_dir + "/uf20-01.cnf"};
+
+  SatDimacs dimacs;
+  EXPECT_TRUE( dimacs.read_dimacs(path) );
+
+  SatSolver solver;
+  auto lit_map = solver.read_DIMACS(path);
+  EXPECT_EQ( dimacs.variable_num(), lit_map.size() );
+  EXPECT_EQ( dimacs.clause_num(), solver.clause_num() );
+
+  auto ans = solver.solve();
+  ASSERT_EQ( SatBool3::True, ans );
+  auto& model = solver.model();
+  vector<int> model1(lit_map.size());
+  for ( SizeType i = 0; i < lit_map.size(); ++ i ) {
+    model1[i] = model[lit_map[i]] == SatBool3::True ? 1 : 0;
+  }
+  EXPECT_TRUE( dimacs.eval(model1) );
+}
+
+TEST(DimacsTest, read_DIMACS_err)
+{
+  const char* data_str =
+    "p cnf 10 20\n"
+    "1 2 0\n"
+    "-2 abc 0\n";
+  istringstream buf{data_str};
+  SatSolver solver;
+  EXPECT_THROW( solver.read_DIMACS(buf), std::invalid_argument );
+}
+
+TEST(DimacsTest, parse_multi)
+{
+  // チャンクに分割されるだけの大きさのデータを作る．
+  const SizeType nv = 1000;
+  const SizeType nc = 1000000;
+  std::mt19937 rg;
+  std::uniform_int_distribution<int> var_dist(1, nv);
+  std::uniform_int_distribution<int> pol_dist(0, 1);
+  ostringstream buf;
+  buf << "c random 3-SAT" << endl
+      << "p cnf " << nv << " " << nc << endl;
+  for ( SizeType i = 0; i < nc; ++ i ) {
+    for ( SizeType j = 0; j < 3; ++ j ) {
+      int l = var_dist(rg);
+      if ( pol_dist(rg) ) {
+	l = -l;
+      }
+      buf << l << " ";
+    }
+    buf << "0" << endl;
+  }
+  auto data = buf.str();
+
+  vector<vector<int>> clause_list1;
+  DimacsParser parser1{[&](const vector<int>& lits) {
+    clause_list1.push_back(lits);
+  }};
+  EXPECT_TRUE( parser1.parse(data.data(), data.data() + data.size()) );
+
+  vector<vector<int>> clause_list4;
+  DimacsParser parser4{[&](const vector<int>& lits) {
+    clause_list4.push_back(lits);
+  }, 4};
+  EXPECT_TRUE( parser4.parse(data.data(), data.data() + data.size()) );
+
+  EXPECT_EQ( nc, clause_list1.size() );
+  EXPECT_EQ( clause_list1, clause_list4 );
+  EXPECT_EQ( parser1.max_var(), parser4.max_var() );
+  EXPECT_EQ( parser1.message_list(), parser4.message_list() );
+
+  // 後半のチャンクにエラーを入れる．
+  data += "-2 abc 0\n";
+  DimacsParser parser4e{[&](const vector<int>& lits) { }, 4};
+  EXPECT_FALSE( parser4e.parse(data.data(), data.data() + data.size()) );
+  auto& msg_list = parser4e.message_list();
+  ASSERT_EQ( 1, msg_list.size() );
+  ostringstream ebuf;
+  ebuf << "Error at line " << (nc + 3) << ": syntax error";
+  EXPECT_EQ( ebuf.str(), msg_list.front() );
+}
+
+TEST(DimacsTest, write_dimacs)
+{
+  string data_dir{DATA_DIR};
+  string path{data_dir + "/uf20-01.cnf"};
+
+  SatDimacs dimacs1;
+  ASSERT_TRUE( dimacs1.read_dimacs(path) );
+
+  ostringstream obuf;
+  dimacs1.write_dimacs(obuf);
+  auto data = obuf.str();
+  EXPECT_EQ( "p cnf 20 91\n", data.substr(0, 12) );
+
+  istringstream ibuf{data};
+  SatDimacs dimacs2;
+  EXPECT_TRUE( dimacs2.read_dimacs(ibuf) );
+  EXPECT_TRUE( dimacs2.message_list().empty() );
+  EXPECT_EQ( dimacs1.clause_list(), dimacs2.clause_list() );
+}
+
+TEST(DimacsTest, write_dimacs_multi)
+{
+  // チャンクに分割されるだけの数の節を作る．
+  const SizeType nv = 1000;
+  const SizeType nc = 300000;
+  std::mt19937 rg;
+  std::uniform_int_distribution<int> var_dist(1, nv);
+  std::uniform_int_distribution<int> pol_dist(0, 1);
+  SatDimacs dimacs;
+  for ( SizeType i = 0; i < nc; ++ i ) {
+    vector<int> lits(3);
+    for ( auto& l: lits ) {
+      l = var_dist(rg);
+      if ( pol_dist(rg) ) {
+	l = -l;
+      }
+    }
+    dimacs.add_clause(lits);
+  }
+
+  ostringstream obuf1;
+  dimacs.write_dimacs(obuf1);
+  ostringstream obuf4;
+  dimacs.write_dimacs(obuf4, 4);
+  EXPECT_EQ( obuf1.str(), obuf4.str() );
+
+  istringstream ibuf{obuf4.str()};
+  SatDimacs dimacs2;
+  EXPECT_TRUE( dimacs2.read_dimacs(ibuf) );
+  EXPECT_EQ( dimacs.clause_list(), dimacs2.clause_list() );
+}
+
+TEST(DimacsTest, write_binary)
+{
+  string data_dir{DATA_DIR};
+  string path{data_dir + "/uf20-01.cnf"};
+
+  SatDimacs dimacs1;
+  ASSERT_TRUE( dimacs1.read_dimacs(path) );
+
+  ostringstream obuf;
+  dimacs1.write_binary(obuf);
+  auto data = obuf.str();
+
+  ostringstream tbuf;
+  dimacs1.write_dimacs(tbuf);
+  EXPECT_LT( data.size(), tbuf.str().size() / 2 );
+
+  istringstream ibuf{data};
+  SatDimacs dimacs2;
+  EXPECT_TRUE( dimacs2.read_dimacs(ibuf) );
+  EXPECT_TRUE( dimacs2.message_list().empty() );
+  EXPECT_EQ( dimacs1.variable_num(), dimacs2.variable_num() );
+  EXPECT_EQ( dimacs1.clause_list(), dimacs2.clause_list() );
+
+  // 途中で切れたデータはエラーになる．
+  data.resize(data.size() - 1);
+  istringstream ibuf2{data};
+  SatDimacs dimacs3;
+  EXPECT_FALSE( dimacs3.read_dimacs(ibuf2) );
+  EXPECT_EQ( "Error: corrupted binary CNF data", dimacs3.message_list().front() );
+}
+
+TEST(DimacsTest, write_binary_CNF)
+{
+  string data_dir{DATA_DIR};
+  string path{data_dir + "/uf20-01.cnf"};
+
+  SatSolver solver1;
+  solver1.read_DIMACS(path);
+
+  ostringstream obuf;
+  solver1.write_binary_CNF(obuf);
+
+  istringstream ibuf{obuf.str()};
+  SatSolver solver2;
+  auto lit_map = solver2.read_DIMACS(ibuf);
+  EXPECT_EQ( solver1.variable_num(), lit_map.size() );
+  EXPECT_EQ( solver1.clause_num(), solver2.clause_num() );
+  EXPECT_EQ( solver1.literal_num(), solver2.literal_num() );
+
+  ostringstream obuf1;
+  solver1.write_DIMACS(obuf1);
+  ostringstream obuf2;
+  solver2.write_DIMACS(obuf2);
+  EXPECT_EQ( obuf1.str(), obuf2.str() );
+}
+
+TEST(DimacsTest, write_DIMACS_lean)
+{
+  string data_dir{DATA_DIR};
+  string path{data_dir + "/uf20-01.cnf"};
+
+  SatDimacs dimacs;
+  ASSERT_TRUE( dimacs.read_dimacs(path) );
+
+  // 省メモリモードでは実装から取り出した節を出力する．
+  auto js_obj = JsonValue::parse(R"({"type": "ymsat2", "lean": true})");
+  SatSolver solver1{SatInitParam{js_obj}};
+  auto lit_map1 = solver1.read_DIMACS(path);
+  EXPECT_EQ( dimacs.clause_num(), solver1.clause_num() );
+
+  ostringstream obuf;
+  solver1.write_DIMACS(obuf);
+  istringstream ibuf{obuf.str()};
+  SatSolver solver2;
+  auto lit_map2 = solver2.read_DIMACS(ibuf);
+  auto ans = solver2.solve();
+  ASSERT_EQ( SatBool3::True, ans );
+  auto& model = solver2.model();
+  vector<int> model1(dimacs.variable_num());
+  for ( SizeType i = 0; i < lit_map2.size(); ++ i ) {
+    model1[i] = model[lit_map2[i]] == SatBool3::True ? 1 : 0;
+  }
+  EXPECT_TRUE( dimacs.eval(model1) );
+
+  // solve_batch() は1スレッドで動く．
+  vector<vector<SatLiteral>> assumption_sets{{lit_map1[0]}, {~lit_map1[0]}};
+  vector<SatModel> model_list;
+  vector<vector<SatLiteral>> conflicts_list;
+  auto ans_list = solver1.solve_batch(assumption_sets, model_list, conflicts_list, 2);
+  EXPECT_EQ( 2, ans_list.size() );
+}
+
+TEST(DimacsTest, write_DIMACS_lean_unsupported)
+{
+  auto js_obj = JsonValue::parse(R"({"type": "minisat2", "lean": true})");
+  SatSolver solver{SatInitParam{js_obj}};
+  auto lit1 = solver.new_variable();
+  auto lit2 = solver.new_variable();
+  solver.add_clause(lit1, lit2);
+  EXPECT_EQ( 1, solver.clause_num() );
+  EXPECT_EQ( 2, solver.literal_num() );
+  ostringstream obuf;
+  EXPECT_THROW( solver.write_DIMACS(obuf), std::runtime_error );
+}
+
+BEGIN_NONAMESPACE
+
+// 圧縮されたファイルが元のファイルと同じ内容になるか調べる．
+void
+check_compressed(
+  const string& ext
+)
+{
+  string data_dir{DATA_DIR};
+  string path{data_dir + "/uf20-01.cnf"};
+
+  SatDimacs dimacs1;
+  ASSERT_TRUE( dimacs1.read_dimacs(path) );
+
+  SatDimacs dimacs2;
+  EXPECT_TRUE( dimacs2.read_dimacs(path + ext) );
+  EXPECT_EQ( dimacs1.message_list(), dimacs2.message_list() );
+  EXPECT_EQ( dimacs1.variable_num(), dimacs2.variable_num() );
+  EXPECT_EQ( dimacs1.clause_list(), dimacs2.clause_list() );
+
+  // 途中で切れたデータはエラーになる．
+  ifstream fin{path + ext, std::ios::binary};
+  string data{std::istreambuf_iterator<char>{fin}, std::istreambuf_iterator<char>{}};
+  data.resize(data.size() / 2);
+  DimacsParser parser{[](const vector<int>& lits) { }};
+  EXPECT_FALSE( parser.parse(data.data(), data.data() + data.size()) );
+  EXPECT_FALSE( parser.message_list().empty() );
+}
+
+END_NONAMESPACE
+
+#if defined(YM_SAT_HAVE_ZLIB)
+TEST(DimacsTest, read_dimacs_gz)
+{
+  check_compressed(".gz");
+}
+#endif
+
+#if defined(YM_SAT_HAVE_BZIP2)
+TEST(DimacsTest, read_dimacs_bz2)
+{
+  check_compressed(".bz2");
+}
+#endif
+
+#if defined(YM_SAT_HAVE_LZMA)
+TEST(DimacsTest, read_dimacs_xz)
+{
+  check_compressed(".xz");
+}
+#endif
+
 END_NAMESPACE_YM
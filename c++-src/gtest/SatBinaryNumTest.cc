@@ -0,0 +1,344 @@
+
+/// @file SatBinaryNumTest.cc
+/// @brief SatBinaryNumTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "gtest/gtest.h"
+#include "ym/SatSolver.h"
+#include "ym/SatModel.h"
+#include "ym/SatBinaryNum.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+class SatBinaryNumTest :
+  public ::testing::TestWithParam<string>
+{
+public:
+
+  /// @brief 二項演算の型
+  using BinOp = std::function<SatBinaryNum(const SatBinaryNum&, const SatBinaryNum&)>;
+
+  /// @brief 期待値を計算する関数の型
+  using ExpFunc = std::function<SizeType(SizeType, SizeType)>;
+
+  /// @brief コンストラクタ
+  SatBinaryNumTest();
+
+  /// @brief デストラクタ
+  ~SatBinaryNumTest();
+
+  /// @brief 二項演算のチェックを行う．
+  ///
+  /// a_bits, b_bits ビットの全ての値の組み合わせについて
+  /// 演算結果の値が exp_func の値と等しいことを確かめる．
+  void
+  check_binop(
+    SizeType a_bits,
+    SizeType b_bits,
+    SizeType r_bits,
+    BinOp op,
+    ExpFunc exp_func
+  );
+
+  /// @brief n ビットのマスクを返す．
+  static
+  SizeType
+  mask(
+    SizeType n
+  )
+  {
+    return (static_cast<SizeType>(1) << n) - 1;
+  }
+
+  /// @brief 値を表す assumptions を加える．
+  static
+  void
+  add_assumptions(
+    const SatBinaryNum& num,
+    SizeType val,
+    vector<SatLiteral>& assumptions
+  )
+  {
+    for ( SizeType i = 0; i < num.bit_num(); ++ i ) {
+      auto lit = num.bit_var(i);
+      assumptions.push_back((val >> i) & 1 ? lit : ~lit);
+    }
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  // SATソルバ
+  SatSolver mSolver;
+
+};
+
+// @brief コンストラクタ
+SatBinaryNumTest::SatBinaryNumTest() :
+  mSolver(GetParam())
+{
+}
+
+// @brief デストラクタ
+SatBinaryNumTest::~SatBinaryNumTest()
+{
+}
+
+// @brief 二項演算のチェックを行う．
+void
+SatBinaryNumTest::check_binop(
+  SizeType a_bits,
+  SizeType b_bits,
+  SizeType r_bits,
+  BinOp op,
+  ExpFunc exp_func
+)
+{
+  SatBinaryNum a{mSolver, a_bits};
+  SatBinaryNum b{mSolver, b_bits};
+  auto r = op(a, b);
+  ASSERT_EQ( r_bits, r.bit_num() );
+  for ( SizeType a_val = 0; a_val < (1 << a_bits); ++ a_val ) {
+    for ( SizeType b_val = 0; b_val < (1 << b_bits); ++ b_val ) {
+      vector<SatLiteral> assumptions;
+      add_assumptions(a, a_val, assumptions);
+      add_assumptions(b, b_val, assumptions);
+      ASSERT_EQ( SatBool3::True, mSolver.solve(assumptions) );
+      EXPECT_EQ( exp_func(a_val, b_val), r.val(mSolver.model()) )
+	<< "a = " << a_val << ", b = " << b_val;
+    }
+  }
+
+  // 定数どうしの演算は畳み込まれる．
+  auto nc0 = mSolver.clause_num();
+  auto nv0 = mSolver.variable_num();
+  for ( SizeType a_val = 0; a_val < (1 << a_bits); ++ a_val ) {
+    for ( SizeType b_val = 0; b_val < (1 << b_bits); ++ b_val ) {
+      auto ac = SatBinaryNum::constant(mSolver, a_bits, a_val);
+      auto bc = SatBinaryNum::constant(mSolver, b_bits, b_val);
+      auto rc = op(ac, bc);
+      ASSERT_TRUE( rc.is_const() );
+      EXPECT_EQ( exp_func(a_val, b_val), rc.const_val() )
+	<< "a = " << a_val << ", b = " << b_val;
+    }
+  }
+  EXPECT_EQ( nc0, mSolver.clause_num() );
+  EXPECT_EQ( nv0, mSolver.variable_num() );
+}
+
+TEST_P(SatBinaryNumTest, add)
+{
+  check_binop(3, 3, 4,
+	      [](const SatBinaryNum& a, const SatBinaryNum& b) {
+		return a.add(b);
+	      },
+	      [](SizeType a, SizeType b) { return a + b; });
+}
+
+TEST_P(SatBinaryNumTest, add_carry)
+{
+  SatBinaryNum a{mSolver, 3};
+  SatBinaryNum b{mSolver, 2};
+  auto cin = mSolver.new_variable(true);
+  auto r = a.add(b, cin);
+  ASSERT_EQ( 4, r.bit_num() );
+  for ( SizeType a_val = 0; a_val < 8; ++ a_val ) {
+    for ( SizeType b_val = 0; b_val < 4; ++ b_val ) {
+      for ( SizeType c_val = 0; c_val < 2; ++ c_val ) {
+	vector<SatLiteral> assumptions;
+	add_assumptions(a, a_val, assumptions);
+	add_assumptions(b, b_val, assumptions);
+	assumptions.push_back(c_val ? cin : ~cin);
+	ASSERT_EQ( SatBool3::True, mSolver.solve(assumptions) );
+	EXPECT_EQ( a_val + b_val + c_val, r.val(mSolver.model()) );
+      }
+    }
+  }
+}
+
+TEST_P(SatBinaryNumTest, sub)
+{
+  // 下位3ビットが差，最上位ビットが借り
+  check_binop(3, 2, 4,
+	      [](const SatBinaryNum& a, const SatBinaryNum& b) {
+		return a.sub(b);
+	      },
+	      [](SizeType a, SizeType b) { return (a - b) & mask(4); });
+}
+
+TEST_P(SatBinaryNumTest, sub_borrow)
+{
+  SatBinaryNum a{mSolver, 2};
+  SatBinaryNum b{mSolver, 3};
+  auto bin = mSolver.new_variable(true);
+  auto r = a.sub(b, bin);
+  ASSERT_EQ( 4, r.bit_num() );
+  for ( SizeType a_val = 0; a_val < 4; ++ a_val ) {
+    for ( SizeType b_val = 0; b_val < 8; ++ b_val ) {
+      for ( SizeType c_val = 0; c_val < 2; ++ c_val ) {
+	vector<SatLiteral> assumptions;
+	add_assumptions(a, a_val, assumptions);
+	add_assumptions(b, b_val, assumptions);
+	assumptions.push_back(c_val ? bin : ~bin);
+	ASSERT_EQ( SatBool3::True, mSolver.solve(assumptions) );
+	EXPECT_EQ( (a_val - b_val - c_val) & mask(4), r.val(mSolver.model()) );
+      }
+    }
+  }
+}
+
+TEST_P(SatBinaryNumTest, mul_shift_add)
+{
+  check_binop(3, 4, 7,
+	      [](const SatBinaryNum& a, const SatBinaryNum& b) {
+		return a.mul(b, SatMulEnc::ShiftAdd);
+	      },
+	      [](SizeType a, SizeType b) { return a * b; });
+}
+
+TEST_P(SatBinaryNumTest, mul_wallace)
+{
+  check_binop(3, 4, 7,
+	      [](const SatBinaryNum& a, const SatBinaryNum& b) {
+		return a.mul(b, SatMulEnc::Wallace);
+	      },
+	      [](SizeType a, SizeType b) { return a * b; });
+}
+
+TEST_P(SatBinaryNumTest, mul_dadda)
+{
+  check_binop(4, 3, 7,
+	      [](const SatBinaryNum& a, const SatBinaryNum& b) {
+		return a.mul(b, SatMulEnc::Dadda);
+	      },
+	      [](SizeType a, SizeType b) { return a * b; });
+}
+
+TEST_P(SatBinaryNumTest, div)
+{
+  for ( auto p: vector<std::pair<SizeType, SizeType>>{{3, 3}, {4, 2}, {2, 3}} ) {
+    SizeType na = p.first;
+    check_binop(na, p.second, na,
+		[](const SatBinaryNum& a, const SatBinaryNum& b) {
+		  return a.div(b);
+		},
+		[na](SizeType a, SizeType b) { return b == 0 ? mask(na) : a / b; });
+  }
+}
+
+TEST_P(SatBinaryNumTest, mod)
+{
+  for ( auto p: vector<std::pair<SizeType, SizeType>>{{3, 3}, {4, 2}, {2, 3}} ) {
+    SizeType na = p.first;
+    check_binop(na, p.second, na,
+		[](const SatBinaryNum& a, const SatBinaryNum& b) {
+		  return a.mod(b);
+		},
+		[](SizeType a, SizeType b) { return b == 0 ? a : a % b; });
+  }
+}
+
+TEST_P(SatBinaryNumTest, shl)
+{
+  check_binop(5, 3, 5,
+	      [](const SatBinaryNum& a, const SatBinaryNum& b) {
+		return a.shl(b);
+	      },
+	      [](SizeType a, SizeType b) { return (a << b) & mask(5); });
+}
+
+TEST_P(SatBinaryNumTest, lshr)
+{
+  check_binop(5, 3, 5,
+	      [](const SatBinaryNum& a, const SatBinaryNum& b) {
+		return a.lshr(b);
+	      },
+	      [](SizeType a, SizeType b) { return a >> b; });
+}
+
+TEST_P(SatBinaryNumTest, shift_const)
+{
+  SatBinaryNum a{mSolver, 4};
+  auto nc0 = mSolver.clause_num();
+  for ( SizeType s = 0; s < 6; ++ s ) {
+    auto r1 = a.shl(s);
+    auto r2 = a.lshr(s);
+    for ( SizeType a_val = 0; a_val < 16; ++ a_val ) {
+      vector<SatLiteral> assumptions;
+      add_assumptions(a, a_val, assumptions);
+      ASSERT_EQ( SatBool3::True, mSolver.solve(assumptions) );
+      EXPECT_EQ( (a_val << s) & mask(4), r1.val(mSolver.model()) );
+      EXPECT_EQ( a_val >> s, r2.val(mSolver.model()) );
+    }
+  }
+  // 定数シフトは配線だけで済む．
+  EXPECT_EQ( nc0 + 1, mSolver.clause_num() );
+}
+
+TEST_P(SatBinaryNumTest, min)
+{
+  check_binop(3, 2, 3,
+	      [](const SatBinaryNum& a, const SatBinaryNum& b) {
+		return a.min(b);
+	      },
+	      [](SizeType a, SizeType b) { return std::min(a, b); });
+}
+
+TEST_P(SatBinaryNumTest, max)
+{
+  check_binop(2, 3, 3,
+	      [](const SatBinaryNum& a, const SatBinaryNum& b) {
+		return a.max(b);
+	      },
+	      [](SizeType a, SizeType b) { return std::max(a, b); });
+}
+
+TEST_P(SatBinaryNumTest, mul_const)
+{
+  // 定数との乗算は1のビットの部分積だけになる．
+  SatBinaryNum a{mSolver, 8};
+  auto c = SatBinaryNum::constant(mSolver, 8, 5);
+  auto nv0 = mSolver.variable_num();
+  auto r = a.mul(c);
+  auto nv1 = mSolver.variable_num();
+  SatBinaryNum b{mSolver, 8};
+  auto nv2 = mSolver.variable_num();
+  a.mul(b);
+  auto nv3 = mSolver.variable_num();
+  EXPECT_LT( nv1 - nv0, (nv3 - nv2) / 4 );
+  for ( SizeType a_val: {0, 1, 7, 100, 255} ) {
+    vector<SatLiteral> assumptions;
+    add_assumptions(a, a_val, assumptions);
+    ASSERT_EQ( SatBool3::True, mSolver.solve(assumptions) );
+    EXPECT_EQ( a_val * 5, r.val(mSolver.model()) );
+  }
+}
+
+TEST_P(SatBinaryNumTest, factor)
+{
+  // 決定変数なので assumptions なしで値が決まる．
+  SatBinaryNum a{mSolver, 6};
+  SatBinaryNum b{mSolver, 6};
+  auto r = a.mul(b);
+  mSolver.add_eq(r.bit_vars(), 143);
+  mSolver.add_gt(a.bit_vars(), 1);
+  mSolver.add_gt(b.bit_vars(), 1);
+  ASSERT_EQ( SatBool3::True, mSolver.solve() );
+  auto& model = mSolver.model();
+  EXPECT_EQ( 143, a.val(model) * b.val(model) );
+  EXPECT_EQ( 143, r.val(model) );
+}
+
+INSTANTIATE_TEST_SUITE_P(SatSolverTest,
+			 SatBinaryNumTest,
+			 ::testing::Values("lingeling", "glueminisat2", "minisat2", "minisat",
+					   "ymsat1", "ymsat2", "ymsat1_old"));
+
+END_NAMESPACE_YM_SAT
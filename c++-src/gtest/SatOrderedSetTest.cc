@@ -3,7 +3,7 @@
 /// @brief SatOrderedSetTest の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2019, 2022 Yusuke Matsunaga
+/// Copyright (C) 2019, 2022, 2025 Yusuke Matsunaga
 /// All rights reserved.
 
 #include "gtest/gtest.h"
@@ -36,6 +36,64 @@ public:
 
 };
 
+BEGIN_NONAMESPACE
+
+// 制約の判定を行う関数の型
+using Pred = std::function<bool(const vector<int>&)>;
+
+// 全ての値の組み合わせについて solve() の結果と pred の値を比較する．
+void
+check_all(
+  SatSolver& solver,
+  const vector<const SatOrderedSet*>& var_list,
+  Pred pred
+)
+{
+  SizeType n = var_list.size();
+  vector<int> val_list(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    val_list[i] = var_list[i]->min();
+  }
+  for ( ; ; ) {
+    vector<SatLiteral> assumptions;
+    for ( SizeType i = 0; i < n; ++ i ) {
+      assumptions.push_back(var_list[i]->var(val_list[i]));
+    }
+    auto exp_ans = pred(val_list) ? SatBool3::True : SatBool3::False;
+    auto ans = solver.solve(assumptions);
+    EXPECT_EQ( exp_ans, ans );
+    if ( ans == SatBool3::True ) {
+      // モデルから得た値も一致する．
+      for ( SizeType i = 0; i < n; ++ i ) {
+	EXPECT_EQ( val_list[i], var_list[i]->val(solver.model()) );
+      }
+    }
+    // 次の組み合わせ
+    SizeType i = 0;
+    for ( ; i < n; ++ i ) {
+      if ( val_list[i] < var_list[i]->max() ) {
+	++ val_list[i];
+	break;
+      }
+      val_list[i] = var_list[i]->min();
+    }
+    if ( i == n ) {
+      break;
+    }
+  }
+
+  // assumption なしで解いた場合もモデルが制約を満たす．
+  if ( solver.solve() == SatBool3::True ) {
+    vector<int> model_vals(n);
+    for ( SizeType i = 0; i < n; ++ i ) {
+      model_vals[i] = var_list[i]->val(solver.model());
+    }
+    EXPECT_TRUE( pred(model_vals) );
+  }
+}
+
+END_NONAMESPACE
+
 // @brief コンストラクタ
 SatOrderedSetTest::SatOrderedSetTest() :
   mSolver(GetParam())
@@ -237,6 +295,184 @@ TEST_P(SatOrderedSetTest, droppoff1)
   }
 }
 
+TEST_P(SatOrderedSetTest, sum_le)
+{
+  for ( bool lazy: {false, true} ) {
+    SatSolver solver{GetParam()};
+    SatOrderedSet x(solver, 0, 4, lazy);
+    SatOrderedSet y(solver, 1, 5, lazy);
+    x.add_sum_le_constraint(y, 6);
+    check_all(solver, {&x, &y},
+	      [](const vector<int>& v) { return v[0] + v[1] <= 6; });
+  }
+}
+
+TEST_P(SatOrderedSetTest, sum_ge)
+{
+  for ( bool lazy: {false, true} ) {
+    SatSolver solver{GetParam()};
+    SatOrderedSet x(solver, -2, 3, lazy);
+    SatOrderedSet y(solver, 0, 4, lazy);
+    x.add_sum_ge_constraint(y, 3);
+    check_all(solver, {&x, &y},
+	      [](const vector<int>& v) { return v[0] + v[1] >= 3; });
+  }
+}
+
+TEST_P(SatOrderedSetTest, sum_eq)
+{
+  for ( bool lazy: {false, true} ) {
+    SatSolver solver{GetParam()};
+    SatOrderedSet x(solver, 0, 3, lazy);
+    SatOrderedSet y(solver, 1, 4, lazy);
+    SatOrderedSet z(solver, 2, 5, lazy);
+    x.add_sum_eq_constraint(y, z);
+    check_all(solver, {&x, &y, &z},
+	      [](const vector<int>& v) { return v[0] + v[1] == v[2]; });
+  }
+}
+
+TEST_P(SatOrderedSetTest, diff_le)
+{
+  for ( bool lazy: {false, true} ) {
+    SatSolver solver{GetParam()};
+    SatOrderedSet x(solver, -2, 3, lazy);
+    SatOrderedSet y(solver, 0, 4, lazy);
+    x.add_diff_le_constraint(y, -1);
+    check_all(solver, {&x, &y},
+	      [](const vector<int>& v) { return v[0] - v[1] <= -1; });
+  }
+}
+
+TEST_P(SatOrderedSetTest, linear_le)
+{
+  // 4項なので部分和の変数が導入される．
+  for ( bool lazy: {false, true} ) {
+    SatSolver solver{GetParam()};
+    SatOrderedSet x0(solver, 0, 3, lazy);
+    SatOrderedSet x1(solver, -1, 2, lazy);
+    SatOrderedSet x2(solver, 0, 2, lazy);
+    SatOrderedSet x3(solver, 1, 4, lazy);
+    vector<int> coef_list{2, -3, 1, 2};
+    SatOrderedSet::add_linear_le_constraint(coef_list, {&x0, &x1, &x2, &x3}, 7);
+    check_all(solver, {&x0, &x1, &x2, &x3},
+	      [&](const vector<int>& v) {
+		int sum = 0;
+		for ( SizeType i = 0; i < 4; ++ i ) {
+		  sum += coef_list[i] * v[i];
+		}
+		return sum <= 7;
+	      });
+  }
+}
+
+TEST_P(SatOrderedSetTest, linear_ge)
+{
+  for ( bool lazy: {false, true} ) {
+    SatSolver solver{GetParam()};
+    SatOrderedSet x0(solver, 0, 3, lazy);
+    SatOrderedSet x1(solver, 0, 3, lazy);
+    SatOrderedSet x2(solver, -2, 1, lazy);
+    vector<int> coef_list{3, -2, 2};
+    SatOrderedSet::add_linear_ge_constraint(coef_list, {&x0, &x1, &x2}, 2);
+    check_all(solver, {&x0, &x1, &x2},
+	      [&](const vector<int>& v) {
+		int sum = 0;
+		for ( SizeType i = 0; i < 3; ++ i ) {
+		  sum += coef_list[i] * v[i];
+		}
+		return sum >= 2;
+	      });
+  }
+}
+
+TEST_P(SatOrderedSetTest, linear_eq)
+{
+  for ( bool lazy: {false, true} ) {
+    SatSolver solver{GetParam()};
+    SatOrderedSet x0(solver, 0, 2, lazy);
+    SatOrderedSet x1(solver, 0, 3, lazy);
+    SatOrderedSet x2(solver, 0, 2, lazy);
+    SatOrderedSet x3(solver, 0, 3, lazy);
+    SatOrderedSet x4(solver, 0, 2, lazy);
+    vector<int> coef_list{1, 2, 3, -1, 2};
+    SatOrderedSet::add_linear_eq_constraint(coef_list, {&x0, &x1, &x2, &x3, &x4}, 6);
+    check_all(solver, {&x0, &x1, &x2, &x3, &x4},
+	      [&](const vector<int>& v) {
+		int sum = 0;
+		for ( SizeType i = 0; i < 5; ++ i ) {
+		  sum += coef_list[i] * v[i];
+		}
+		return sum == 6;
+	      });
+  }
+}
+
+TEST_P(SatOrderedSetTest, alldiff)
+{
+  for ( bool lazy: {false, true} ) {
+    SatSolver solver{GetParam()};
+    SatOrderedSet x(solver, 0, 2, lazy);
+    SatOrderedSet y(solver, 0, 2, lazy);
+    SatOrderedSet z(solver, 1, 3, lazy);
+    SatOrderedSet::add_alldiff_constraint({&x, &y, &z});
+    check_all(solver, {&x, &y, &z},
+	      [](const vector<int>& v) {
+		return v[0] != v[1] && v[0] != v[2] && v[1] != v[2];
+	      });
+  }
+}
+
+TEST_P(SatOrderedSetTest, lazy)
+{
+  // 定義域の広い変数でも制約に現れる値の変数しか作られない．
+  SatOrderedSet x(mSolver, 0, 1000000, true);
+  SatOrderedSet y(mSolver, 0, 10, true);
+  SatOrderedSet z(mSolver, 0, 10, true);
+  x.add_ge_constraint(500000);
+  // x == 500000 + y + z
+  SatOrderedSet::add_linear_eq_constraint({1, -1, -1}, {&x, &y, &z}, 500000);
+  y.add_sum_ge_constraint(z, 15);
+  EXPECT_GT( 200, mSolver.variable_num() );
+  ASSERT_EQ( SatBool3::True, mSolver.solve() );
+  auto& model = mSolver.model();
+  auto xval = x.val(model);
+  auto yval = y.val(model);
+  auto zval = z.val(model);
+  EXPECT_EQ( 500000 + yval + zval, xval );
+  EXPECT_LE( 15, yval + zval );
+
+  // 後から作った変数とも矛盾しない．
+  x.add_le_constraint(500017);
+  ASSERT_EQ( SatBool3::True, mSolver.solve() );
+  EXPECT_GE( 500017, x.val(mSolver.model()) );
+  EXPECT_EQ( SatBool3::False, mSolver.solve({x.var(500014)}) );
+  EXPECT_EQ( SatBool3::False, mSolver.solve({x.var(500016), y.var(3)}) );
+  EXPECT_EQ( SatBool3::True, mSolver.solve({x.var(500016), y.var(8)}) );
+}
+
+TEST_P(SatOrderedSetTest, lazy_conditional)
+{
+  // 遅延生成で作られる順序制約には条件リテラルは付加されない．
+  SatOrderedSet x(mSolver, 0, 10, true);
+  auto c = mSolver.new_variable(true);
+  x.add_ge_constraint(5);
+
+  mSolver.set_conditional_literals(c);
+  // ここで作られる x.ge_lit(3) と x.var(6) の定義は c によらない．
+  x.add_le_constraint(2);
+  auto lit6 = x.var(6);
+  mSolver.clear_conditional_literals();
+
+  EXPECT_EQ( SatBool3::False, mSolver.solve({c}) );
+  ASSERT_EQ( SatBool3::True, mSolver.solve({~c}) );
+  EXPECT_LE( 5, x.val(mSolver.model()) );
+  EXPECT_EQ( SatBool3::False, mSolver.solve({~c, ~x.ge_lit(3)}) );
+  EXPECT_EQ( SatBool3::False, mSolver.solve({~c, lit6, x.ge_lit(8)}) );
+  ASSERT_EQ( SatBool3::True, mSolver.solve({~c, lit6}) );
+  EXPECT_EQ( 6, x.val(mSolver.model()) );
+}
+
 INSTANTIATE_TEST_SUITE_P(SatSolverTest,
 			 SatOrderedSetTest,
 			 ::testing::Values("lingeling", "glueminisat2", "minisat2", "minisat",
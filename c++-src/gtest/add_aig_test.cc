@@ -301,4 +301,101 @@ TEST_F(SatSolverTest, cnf_size2)
   cout << cnf_size << endl;
 }
 
+TEST_F(SatSolverTest, add_aig_cache)
+{
+  auto aig_lit0 = mMgr.input(0);
+  auto aig_lit1 = mMgr.input(1);
+  auto aig_lit2 = mMgr.input(2);
+  auto aig1 = aig_lit0 | aig_lit1;
+  auto aig2 = aig1 & aig_lit2;
+  auto lit0 = mSolver.new_variable(true);
+  auto lit1 = mSolver.new_variable(true);
+  auto lit2 = mSolver.new_variable(true);
+  auto lit_map = std::unordered_map<SizeType, SatLiteral>{
+    {aig_lit0.input_id(), lit0},
+    {aig_lit1.input_id(), lit1},
+    {aig_lit2.input_id(), lit2}
+  };
+
+  auto lits1 = mSolver.add_aig(aig1, lit_map);
+  auto var_num1 = mSolver.variable_num();
+  auto clause_num1 = mSolver.clause_num();
+  EXPECT_EQ( 0, mSolver.get_stats().mAigCacheHit );
+
+  // 別の呼び出しでも aig1 の変換結果は再利用される．
+  auto lits2 = mSolver.add_aig(aig2, lit_map);
+  EXPECT_EQ( var_num1, mSolver.variable_num() );
+  EXPECT_EQ( clause_num1, mSolver.clause_num() );
+  ASSERT_EQ( 2, lits2.size() );
+  EXPECT_EQ( lits1.front(), lits2[0] );
+  EXPECT_EQ( lit2, lits2[1] );
+  EXPECT_LT( 0, mSolver.get_stats().mAigCacheHit );
+
+  // 条件リテラルが異なる場合には再利用しない．
+  auto clit = mSolver.new_variable(true);
+  mSolver.set_conditional_literals(clit);
+  auto lits3 = mSolver.add_aig(aig1, lit_map);
+  mSolver.clear_conditional_literals();
+  ASSERT_EQ( 1, lits3.size() );
+  EXPECT_NE( lits1.front(), lits3.front() );
+
+  // キャッシュをクリアしたら作り直す．
+  mSolver.clear_aig_cache();
+  auto lits4 = mSolver.add_aig(aig1, lit_map);
+  ASSERT_EQ( 1, lits4.size() );
+  EXPECT_NE( lits1.front(), lits4.front() );
+}
+
+TEST_F(SatSolverTest, cnf_size_pg)
+{
+  // AIG の作成
+  auto aig_lit0 = mMgr.input(0);
+  auto aig_lit1 = mMgr.input(1);
+  auto aig_lit2 = mMgr.input(2);
+  auto aig_lit3 = mMgr.input(3);
+  auto aig = (aig_lit0 & aig_lit1) | (aig_lit2 & aig_lit3);
+
+  // リテラルマップの作成
+  auto lit0 = mSolver.new_variable(true);
+  auto lit1 = mSolver.new_variable(true);
+  auto lit2 = mSolver.new_variable(true);
+  auto lit3 = mSolver.new_variable(true);
+  auto lit_map = std::unordered_map<SizeType, SatLiteral>{
+    {aig_lit0.input_id(), lit0},
+    {aig_lit1.input_id(), lit1},
+    {aig_lit2.input_id(), lit2},
+    {aig_lit3.input_id(), lit3}
+  };
+
+  auto lits = mSolver.add_aig(aig, lit_map);
+  ASSERT_EQ( 1, lits.size() );
+
+  // 出力の OR: 1節(3リテラル)
+  // 2つの AND: 4節(8リテラル)
+  auto cnf_size = mSolver.cnf_size();
+  EXPECT_EQ( 5, cnf_size.clause_num );
+  EXPECT_EQ( 11, cnf_size.literal_num );
+
+  for ( SizeType b = 0; b < 16; ++ b ) {
+    vector<SatLiteral> assumptions{lits.front()};
+    assumptions.push_back( (b & 1) ? lit0 : ~lit0 );
+    assumptions.push_back( (b & 2) ? lit1 : ~lit1 );
+    assumptions.push_back( (b & 4) ? lit2 : ~lit2 );
+    assumptions.push_back( (b & 8) ? lit3 : ~lit3 );
+    auto res = mSolver.solve(assumptions);
+    auto exp_res = ( (b & 3) == 3 || (b & 12) == 12 ) ?
+      SatBool3::True : SatBool3::False;
+    EXPECT_EQ( exp_res, res );
+  }
+
+  // ~aig は2つの AND の否定の AND なので，
+  // 2つの AND の負の極性の節のみが追加される．
+  // 2節(6リテラル)
+  auto lits2 = mSolver.add_aig(~aig, lit_map);
+  ASSERT_EQ( 2, lits2.size() );
+  auto cnf_size2 = mSolver.cnf_size();
+  EXPECT_EQ( 7, cnf_size2.clause_num );
+  EXPECT_EQ( 17, cnf_size2.literal_num );
+}
+
 END_NAMESPACE_YM
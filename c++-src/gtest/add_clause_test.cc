@@ -701,6 +701,74 @@ TEST_P(SatTestFixture, add_clause_with_cond5n_1)
   mSolver.clear_conditional_literals();
 }
 
+TEST_P(SatTestFixture, add_clauses)
+{
+  SatLiteral lit1(mVarList[0]);
+  SatLiteral lit2(mVarList[1]);
+  SatLiteral lit3(mVarList[2]);
+
+  vector<SatLiteral> lit_list{ lit1,  lit2,
+			      ~lit1,  lit3,
+			      ~lit2, ~lit3};
+  vector<SizeType> begin_list{0, 2, 4, 6};
+  mSolver.add_clauses(lit_list, begin_list);
+
+  EXPECT_EQ( 3, mSolver.clause_num() );
+  EXPECT_EQ( 6, mSolver.literal_num() );
+
+  vector<int> vals(
+    {
+     // lit3 lit2 lit1 ans
+     //   0    0    0    0
+     //   0    0    1    0
+     //   0    1    0    1
+     //   0    1    1    0
+     //   1    0    0    0
+     //   1    0    1    1
+     //   1    1    0    0
+     //   1    1    1    0
+     0, 0, 1, 0, 0, 1, 0, 0
+    }
+  );
+
+  check(3, vals);
+}
+
+TEST_P(SatTestFixture, add_clauses_with_cond1)
+{
+  SatLiteral clit1(mCondVarList[0]);
+  mSolver.set_conditional_literals(clit1);
+
+  SatLiteral lit1(mVarList[0]);
+  SatLiteral lit2(mVarList[1]);
+  SatLiteral lit3(mVarList[2]);
+
+  vector<SatLiteral> lit_list{ lit1,  lit2,
+			      ~lit1,  lit3,
+			      ~lit2, ~lit3};
+  vector<SizeType> begin_list{0, 2, 4, 6};
+  mSolver.add_clauses(lit_list, begin_list);
+
+  vector<int> vals(
+    {
+     // lit3 lit2 lit1 ans
+     //   0    0    0    0
+     //   0    0    1    0
+     //   0    1    0    1
+     //   0    1    1    0
+     //   1    0    0    0
+     //   1    0    1    1
+     //   1    1    0    0
+     //   1    1    1    0
+     0, 0, 1, 0, 0, 1, 0, 0
+    }
+  );
+
+  check_with_cond1(3, vals);
+
+  mSolver.clear_conditional_literals();
+}
+
 INSTANTIATE_TEST_SUITE_P(SatSolverTest,
 			 SatTestFixture,
 			 ::testing::Values("lingeling", "glueminisat2", "minisat2", "minisat",
@@ -212,4 +212,265 @@ TEST_F(SatSolverTest, add_expr_andor1)
   }
 }
 
+TEST_F(SatSolverTest, add_expr_cache)
+{
+  auto expr_lit0 = Expr::literal(0);
+  auto expr_lit1 = Expr::literal(1);
+  auto expr_lit2 = Expr::literal(2);
+  auto expr_lit3 = Expr::literal(3);
+  auto sub = expr_lit0 | expr_lit1;
+  auto expr = (sub & expr_lit2) | (sub & expr_lit3);
+  auto lit0 = mSolver.new_variable(true);
+  auto lit1 = mSolver.new_variable(true);
+  auto lit2 = mSolver.new_variable(true);
+  auto lit3 = mSolver.new_variable(true);
+  auto lit_map = std::unordered_map<SizeType, SatLiteral>{
+    {0, lit0},
+    {1, lit1},
+    {2, lit2},
+    {3, lit3}
+  };
+
+  auto lits1 = mSolver.add_expr(expr, lit_map);
+  ASSERT_EQ( 1, lits1.size() );
+
+  // sub は1度だけ符号化される．
+  // sub: 1節(3リテラル)
+  // (sub & lit2), (sub & lit3): 4節(8リテラル)
+  // 全体: 1節(3リテラル)
+  auto cnf_size = mSolver.cnf_size();
+  EXPECT_EQ( 6, cnf_size.clause_num );
+  EXPECT_EQ( 14, cnf_size.literal_num );
+  EXPECT_LT( 0, mSolver.get_stats().mExprCacheHit );
+
+  // 別の呼び出しでも変換結果は再利用される．
+  auto var_num1 = mSolver.variable_num();
+  auto lits2 = mSolver.add_expr(expr, lit_map);
+  ASSERT_EQ( 1, lits2.size() );
+  EXPECT_EQ( lits1.front(), lits2.front() );
+  auto lits3 = mSolver.add_expr(expr_lit1 | expr_lit0, lit_map);
+  ASSERT_EQ( 1, lits3.size() );
+  EXPECT_EQ( var_num1, mSolver.variable_num() );
+  EXPECT_EQ( cnf_size, mSolver.cnf_size() );
+
+  // 条件リテラルが異なる場合には再利用しない．
+  auto clit = mSolver.new_variable(true);
+  mSolver.set_conditional_literals(clit);
+  auto lits4 = mSolver.add_expr(expr, lit_map);
+  mSolver.clear_conditional_literals();
+  ASSERT_EQ( 1, lits4.size() );
+  EXPECT_NE( lits1.front(), lits4.front() );
+
+  // 再利用した結果も正しく振る舞う．
+  for ( SizeType b = 0; b < 16; ++ b ) {
+    vector<SatLiteral> assumptions{lits2.front()};
+    assumptions.push_back( (b & 1) ? lit0 : ~lit0 );
+    assumptions.push_back( (b & 2) ? lit1 : ~lit1 );
+    assumptions.push_back( (b & 4) ? lit2 : ~lit2 );
+    assumptions.push_back( (b & 8) ? lit3 : ~lit3 );
+    auto res = mSolver.solve(assumptions);
+    auto exp_res = ( (b & 3) != 0 && (b & 12) != 0 ) ?
+      SatBool3::True : SatBool3::False;
+    EXPECT_EQ( exp_res, res );
+  }
+}
+
+TEST_F(SatSolverTest, add_expr_pg)
+{
+  auto expr_lit0 = Expr::literal(0);
+  auto expr_lit1 = Expr::literal(1);
+  auto expr_lit2 = Expr::literal(2);
+  auto expr_lit3 = Expr::literal(3);
+  auto sub = expr_lit0 | expr_lit1;
+  auto expr = (sub & expr_lit2) | (sub & expr_lit3);
+  auto lit0 = mSolver.new_variable(true);
+  auto lit1 = mSolver.new_variable(true);
+  auto lit2 = mSolver.new_variable(true);
+  auto lit3 = mSolver.new_variable(true);
+  auto lit_map = std::unordered_map<SizeType, SatLiteral>{
+    {0, lit0},
+    {1, lit1},
+    {2, lit2},
+    {3, lit3}
+  };
+
+  auto lits = mSolver.add_expr(expr, lit_map);
+  ASSERT_EQ( 1, lits.size() );
+
+  // 正の極性の節のみが生成される．
+  // sub: 1節(3リテラル)
+  // (sub & lit2), (sub & lit3): 4節(8リテラル)
+  // 全体: 1節(3リテラル)
+  auto cnf_size = mSolver.cnf_size();
+  EXPECT_EQ( 6, cnf_size.clause_num );
+  EXPECT_EQ( 14, cnf_size.literal_num );
+
+  // XOR のオペランドとして用いられると sub の負の極性の節が追加される．
+  // sub の負の極性: 2節(4リテラル)
+  // XOR の正の極性: 2節(6リテラル)
+  auto lits2 = mSolver.add_expr(sub ^ expr_lit2, lit_map);
+  ASSERT_EQ( 1, lits2.size() );
+  auto cnf_size2 = mSolver.cnf_size();
+  EXPECT_EQ( 10, cnf_size2.clause_num );
+  EXPECT_EQ( 24, cnf_size2.literal_num );
+
+  for ( SizeType b = 0; b < 16; ++ b ) {
+    vector<SatLiteral> assumptions{lits.front()};
+    assumptions.push_back( (b & 1) ? lit0 : ~lit0 );
+    assumptions.push_back( (b & 2) ? lit1 : ~lit1 );
+    assumptions.push_back( (b & 4) ? lit2 : ~lit2 );
+    assumptions.push_back( (b & 8) ? lit3 : ~lit3 );
+    auto res = mSolver.solve(assumptions);
+    auto exp_res = ( (b & 3) != 0 && (b & 12) != 0 ) ?
+      SatBool3::True : SatBool3::False;
+    EXPECT_EQ( exp_res, res );
+  }
+}
+
+TEST_F(SatSolverTest, add_expr_xor2)
+{
+  // XOR のオペランドは両方の極性で用いられる．
+  auto expr_lit0 = Expr::literal(0);
+  auto expr_lit1 = Expr::literal(1);
+  auto expr_lit2 = Expr::literal(2);
+  auto expr = (expr_lit0 | expr_lit1) ^ expr_lit2;
+  auto lit0 = mSolver.new_variable(true);
+  auto lit1 = mSolver.new_variable(true);
+  auto lit2 = mSolver.new_variable(true);
+  auto lit_map = std::unordered_map<SizeType, SatLiteral>{
+    {0, lit0},
+    {1, lit1},
+    {2, lit2}
+  };
+
+  auto lits = mSolver.add_expr(expr, lit_map);
+  ASSERT_EQ( 1, lits.size() );
+  auto lit_o = lits.front();
+
+  for ( SizeType b = 0; b < 8; ++ b ) {
+    vector<SatLiteral> assumptions{lit_o};
+    assumptions.push_back( (b & 1) ? lit0 : ~lit0 );
+    assumptions.push_back( (b & 2) ? lit1 : ~lit1 );
+    assumptions.push_back( (b & 4) ? lit2 : ~lit2 );
+    auto res = mSolver.solve(assumptions);
+    bool v = ((b & 3) != 0) != ((b & 4) != 0);
+    auto exp_res = v ? SatBool3::True : SatBool3::False;
+    EXPECT_EQ( exp_res, res );
+  }
+}
+
+TEST_F(SatSolverTest, add_expr_xor_cut)
+{
+  const SizeType n = 8;
+  vector<Expr> opr_list;
+  vector<SatLiteral> lit_list;
+  auto lit_map = std::unordered_map<SizeType, SatLiteral>{};
+  for ( SizeType i = 0; i < n; ++ i ) {
+    opr_list.push_back(Expr::literal(i));
+    auto lit = mSolver.new_variable(true);
+    lit_list.push_back(lit);
+    lit_map.emplace(i, lit);
+  }
+  auto expr = Expr::xor_op(opr_list);
+
+  // cut ごとの節数とリテラル数
+  // 2: 2入力 x 7
+  // 3: 2入力 x 1, 3入力 x 3
+  // 4: 2入力 x 1, 4入力 x 2
+  // 根の XOR は正の極性の節のみとなる．
+  const SizeType exp_clause_num[] = {26, 24, 34};
+  const SizeType exp_literal_num[] = {78, 92, 166};
+  for ( SizeType cut = 2; cut <= 4; ++ cut ) {
+    mSolver.clear_expr_cache();
+    mSolver.set_xor_cut(cut);
+    auto size0 = mSolver.cnf_size();
+    auto lits = mSolver.add_expr(expr, lit_map);
+    ASSERT_EQ( 1, lits.size() );
+    auto size = mSolver.cnf_size() - size0;
+    EXPECT_EQ( exp_clause_num[cut - 2], size.clause_num );
+    EXPECT_EQ( exp_literal_num[cut - 2], size.literal_num );
+
+    auto lit_o = lits.front();
+    for ( SizeType b = 0; b < (1U << n); ++ b ) {
+      vector<SatLiteral> assumptions{lit_o};
+      bool v = false;
+      for ( SizeType i = 0; i < n; ++ i ) {
+	if ( b & (1U << i) ) {
+	  assumptions.push_back(lit_list[i]);
+	  v = !v;
+	}
+	else {
+	  assumptions.push_back(~lit_list[i]);
+	}
+      }
+      auto res = mSolver.solve(assumptions);
+      auto exp_res = v ? SatBool3::True : SatBool3::False;
+      EXPECT_EQ( exp_res, res );
+    }
+  }
+}
+
+TEST_F(SatSolverTest, add_expr_xor_cancel)
+{
+  // 同じオペランドは打ち消しあう．
+  auto expr_lit0 = Expr::literal(0);
+  auto expr_lit1 = Expr::literal(1);
+  auto expr = Expr::xor_op({expr_lit0, expr_lit1, expr_lit0});
+  auto lit0 = mSolver.new_variable(true);
+  auto lit1 = mSolver.new_variable(true);
+  auto lit_map = std::unordered_map<SizeType, SatLiteral>{
+    {0, lit0},
+    {1, lit1}
+  };
+
+  auto lits = mSolver.add_expr(expr, lit_map);
+  ASSERT_EQ( 1, lits.size() );
+  EXPECT_EQ( lit1, lits.front() );
+  EXPECT_EQ( 0, mSolver.clause_num() );
+}
+
+TEST_F(SatSolverTest, add_expr_tseitin)
+{
+  auto expr_lit0 = Expr::literal(0);
+  auto expr_lit1 = Expr::literal(1);
+  auto expr_lit2 = Expr::literal(2);
+  auto expr_lit3 = Expr::literal(3);
+  auto sub = expr_lit0 | expr_lit1;
+  auto expr = (sub & expr_lit2) | (sub & expr_lit3);
+  auto lit0 = mSolver.new_variable(true);
+  auto lit1 = mSolver.new_variable(true);
+  auto lit2 = mSolver.new_variable(true);
+  auto lit3 = mSolver.new_variable(true);
+  auto lit_map = std::unordered_map<SizeType, SatLiteral>{
+    {0, lit0},
+    {1, lit1},
+    {2, lit2},
+    {3, lit3}
+  };
+
+  mSolver.set_tseitin_encoding(true);
+  auto lits = mSolver.add_expr(expr, lit_map);
+  ASSERT_EQ( 1, lits.size() );
+  auto lit_o = lits.front();
+
+  // sub, (sub & lit2), (sub & lit3), 全体がそれぞれ
+  // 3節(7リテラル)となる．
+  auto cnf_size = mSolver.cnf_size();
+  EXPECT_EQ( 12, cnf_size.clause_num );
+  EXPECT_EQ( 28, cnf_size.literal_num );
+
+  // 結果のリテラルは論理式と等価になる．
+  for ( SizeType b = 0; b < 16; ++ b ) {
+    vector<SatLiteral> assumptions;
+    assumptions.push_back( (b & 1) ? lit0 : ~lit0 );
+    assumptions.push_back( (b & 2) ? lit1 : ~lit1 );
+    assumptions.push_back( (b & 4) ? lit2 : ~lit2 );
+    assumptions.push_back( (b & 8) ? lit3 : ~lit3 );
+    bool v = (b & 3) != 0 && (b & 12) != 0;
+    assumptions.push_back( v ? ~lit_o : lit_o );
+    auto res = mSolver.solve(assumptions);
+    EXPECT_EQ( SatBool3::False, res );
+  }
+}
+
 END_NAMESPACE_YM
@@ -0,0 +1,178 @@
+
+/// @file amo_encoding_test.cc
+/// @brief at-most-one 制約の符号化方法(SatAmoEnc)のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "gtest/gtest.h"
+#include "ym/SatSolver.h"
+#include "ym/Range.h"
+
+
+BEGIN_NAMESPACE_YM
+
+class AmoEncodingTest :
+  public ::testing::TestWithParam<SatAmoEnc>
+{
+public:
+
+  /// @brief 制約を追加する関数の型
+  using AddFunc = std::function<void(SatSolver&, const vector<SatLiteral>&, SatAmoEnc)>;
+
+  /// @brief 制約のチェックを行う．
+  ///
+  /// n 入力の全ての割り当てについて eval(個数) と solve() の結果を比較する．
+  void
+  check(
+    int n,
+    AddFunc add_func,
+    std::function<bool(int)> eval
+  )
+  {
+    SatSolver solver{"ymsat2"};
+    vector<SatLiteral> lit_list(n);
+    for ( auto& lit: lit_list ) {
+      lit = solver.new_variable(true);
+    }
+    add_func(solver, lit_list, GetParam());
+    int np = 1 << n;
+    for ( int p: Range(np) ) {
+      vector<SatLiteral> assumptions;
+      int c = 0;
+      for ( int i: Range(n) ) {
+	auto lit = lit_list[i];
+	if ( p & (1 << i) ) {
+	  ++ c;
+	}
+	else {
+	  lit = ~lit;
+	}
+	assumptions.push_back(lit);
+      }
+      auto exp_ans = eval(c) ? SatBool3::True : SatBool3::False;
+      EXPECT_EQ( exp_ans, solver.solve(assumptions) )
+	<< GetParam() << ": n = " << n << ", p = " << p;
+    }
+  }
+
+  /// @brief add_at_most_one() のチェックを行う．
+  void
+  check_at_most_one(
+    int n
+  )
+  {
+    check(n,
+	  [](SatSolver& solver, const vector<SatLiteral>& lits, SatAmoEnc enc) {
+	    solver.add_at_most_one(lits, enc);
+	  },
+	  [](int c) { return c <= 1; });
+  }
+
+  /// @brief add_exact_one() のチェックを行う．
+  void
+  check_exact_one(
+    int n
+  )
+  {
+    check(n,
+	  [](SatSolver& solver, const vector<SatLiteral>& lits, SatAmoEnc enc) {
+	    solver.add_exact_one(lits, enc);
+	  },
+	  [](int c) { return c == 1; });
+  }
+
+  /// @brief add_not_one() のチェックを行う．
+  void
+  check_not_one(
+    int n
+  )
+  {
+    check(n,
+	  [](SatSolver& solver, const vector<SatLiteral>& lits, SatAmoEnc enc) {
+	    solver.add_not_one(lits, enc);
+	  },
+	  [](int c) { return c != 1; });
+  }
+
+};
+
+TEST_P(AmoEncodingTest, at_most_one)
+{
+  for ( int n = 1; n <= 13; ++ n ) {
+    check_at_most_one(n);
+  }
+}
+
+TEST_P(AmoEncodingTest, exact_one)
+{
+  for ( int n = 1; n <= 13; ++ n ) {
+    check_exact_one(n);
+  }
+}
+
+TEST_P(AmoEncodingTest, not_one)
+{
+  for ( int n = 1; n <= 13; ++ n ) {
+    check_not_one(n);
+  }
+}
+
+TEST_P(AmoEncodingTest, propagation)
+{
+  // 1つの入力を true にすると残りは単位伝搬だけで false になる．
+  const int n = 50;
+  SatSolver solver{"ymsat2"};
+  vector<SatLiteral> lit_list(n);
+  for ( auto& lit: lit_list ) {
+    lit = solver.new_variable(true);
+  }
+  solver.add_at_most_one(lit_list, GetParam());
+  for ( int i: {0, 17, 49} ) {
+    for ( int j: Range(n) ) {
+      if ( j == i ) {
+	continue;
+      }
+      EXPECT_EQ( SatBool3::False, solver.solve({lit_list[i], lit_list[j]}) )
+	<< "i = " << i << ", j = " << j;
+    }
+  }
+  auto stats = solver.get_stats();
+  EXPECT_EQ( 0, stats.mConflictNum );
+}
+
+TEST_P(AmoEncodingTest, amo_encoding_option)
+{
+  // add_at_most_one() の既定の符号化方法を切り替える．
+  SatSolver solver{"ymsat2"};
+  solver.set_amo_encoding(GetParam());
+  EXPECT_EQ( GetParam(), solver.amo_encoding() );
+  const int n = 9;
+  vector<SatLiteral> lit_list(n);
+  for ( auto& lit: lit_list ) {
+    lit = solver.new_variable(true);
+  }
+  solver.add_exact_one(lit_list);
+  ASSERT_EQ( SatBool3::True, solver.solve() );
+  auto& model = solver.model();
+  int c = 0;
+  for ( auto lit: lit_list ) {
+    if ( model[lit] == SatBool3::True ) {
+      ++ c;
+    }
+  }
+  EXPECT_EQ( 1, c );
+}
+
+INSTANTIATE_TEST_SUITE_P(SatSolverTest,
+			 AmoEncodingTest,
+			 ::testing::Values(SatAmoEnc::Auto,
+					   SatAmoEnc::Pairwise,
+					   SatAmoEnc::Halving,
+					   SatAmoEnc::Ladder,
+					   SatAmoEnc::Commander,
+					   SatAmoEnc::Product,
+					   SatAmoEnc::Bimander));
+
+END_NAMESPACE_YM
@@ -0,0 +1,185 @@
+
+/// @file batch_test.cc
+/// @brief SatSolver::solve_batch() のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "gtest/gtest.h"
+#include "SatTestFixture.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 下位4ビットのパリティを返す．
+bool
+parity4(
+  SizeType p
+)
+{
+  bool ans = false;
+  for ( SizeType i = 0; i < 4; ++ i ) {
+    if ( p & (1 << i) ) {
+      ans = !ans;
+    }
+  }
+  return ans;
+}
+
+// 鳩の巣原理(np 羽, nh 巣)の節を作る．
+// x[i][j] は i 番目の鳩が j 番目の巣に入ることを表す．
+vector<vector<SatLiteral>>
+pigeon_hole(
+  SatSolver& solver,
+  SizeType np,
+  SizeType nh
+)
+{
+  vector<vector<SatLiteral>> x(np, vector<SatLiteral>(nh));
+  for ( SizeType i = 0; i < np; ++ i ) {
+    for ( SizeType j = 0; j < nh; ++ j ) {
+      x[i][j] = solver.new_variable(true);
+    }
+    solver.add_clause(x[i]);
+  }
+  for ( SizeType j = 0; j < nh; ++ j ) {
+    for ( SizeType i1 = 0; i1 < np; ++ i1 ) {
+      for ( SizeType i2 = i1 + 1; i2 < np; ++ i2 ) {
+	solver.add_clause(~x[i1][j], ~x[i2][j]);
+      }
+    }
+  }
+  return x;
+}
+
+END_NONAMESPACE
+
+TEST_P(SatTestFixture, solve_batch)
+{
+  // o1 = x0 ^ x1 ^ x2 ^ x3, o2 = x4 & x5, o3 = o1 | o2
+  auto o1 = mVarList[10];
+  auto o2 = mVarList[11];
+  auto o3 = mVarList[12];
+  mSolver.add_xorgate(o1, {mVarList[0], mVarList[1], mVarList[2], mVarList[3]});
+  mSolver.add_andgate(o2, mVarList[4], mVarList[5]);
+  mSolver.add_orgate(o3, o1, o2);
+
+  vector<vector<SatLiteral>> assumption_sets;
+  for ( SizeType p = 0; p < (1 << 6); ++ p ) {
+    vector<SatLiteral> assumptions;
+    for ( SizeType i = 0; i < 6; ++ i ) {
+      auto lit = mVarList[i];
+      if ( (p & (1 << i)) == 0 ) {
+	lit = ~lit;
+      }
+      assumptions.push_back(lit);
+    }
+    assumptions.push_back(~o3);
+    assumption_sets.push_back(assumptions);
+  }
+
+  vector<SatModel> model_list;
+  vector<vector<SatLiteral>> conflicts_list;
+  auto ans_list = mSolver.solve_batch(assumption_sets, model_list, conflicts_list, 4);
+  ASSERT_EQ( assumption_sets.size(), ans_list.size() );
+  ASSERT_EQ( assumption_sets.size(), model_list.size() );
+  ASSERT_EQ( assumption_sets.size(), conflicts_list.size() );
+  for ( SizeType p = 0; p < assumption_sets.size(); ++ p ) {
+    auto& assumptions = assumption_sets[p];
+    // x0 から x3 の1の数が偶数で x4 & x5 が 0 のときだけ o3 = 0 となる．
+    bool x0123 = parity4(p);
+    bool x45 = (p & 48) == 48;
+    auto exp_ans = (x0123 || x45) ? SatBool3::False : SatBool3::True;
+    EXPECT_EQ( exp_ans, ans_list[p] );
+    if ( ans_list[p] == SatBool3::True ) {
+      for ( auto lit: assumptions ) {
+	EXPECT_EQ( SatBool3::True, model_list[p][lit] );
+      }
+    }
+    else if ( ans_list[p] == SatBool3::False ) {
+      // 矛盾の原因は assumption の否定になっている．
+      for ( auto lit: conflicts_list[p] ) {
+	auto found = false;
+	for ( auto lit1: assumptions ) {
+	  if ( lit == ~lit1 ) {
+	    found = true;
+	  }
+	}
+	EXPECT_TRUE( found );
+      }
+    }
+    // 通常の solve() と同じ結果になる．
+    auto ans1 = mSolver.solve(assumptions);
+    EXPECT_EQ( ans_list[p], ans1 );
+  }
+
+  // 節を追加した後でも続けて使える．
+  mSolver.add_clause(~o1);
+  auto ans_list2 = mSolver.solve_batch(assumption_sets, model_list, conflicts_list, 4);
+  for ( SizeType p = 0; p < assumption_sets.size(); ++ p ) {
+    bool x0123 = parity4(p);
+    auto exp_ans = x0123 ? SatBool3::False : ans_list[p];
+    EXPECT_EQ( exp_ans, ans_list2[p] );
+  }
+}
+
+TEST_P(SatTestFixture, solve_batch_budget)
+{
+  // 鳩の巣原理(8羽, 7巣)
+  const SizeType np = 8;
+  auto x = pigeon_hole(mSolver, np, 7);
+
+  mSolver.set_conflict_budget(10);
+  if ( mSolver.solve() != SatBool3::X ) {
+    // 制限値が無効なソルバ
+    GTEST_SKIP();
+  }
+
+  // 制限値は複製にも設定される．
+  mSolver.set_conflict_budget(10);
+  vector<vector<SatLiteral>> assumption_sets;
+  for ( SizeType i = 0; i < np; ++ i ) {
+    assumption_sets.push_back({x[i][0]});
+  }
+  vector<SatModel> model_list;
+  vector<vector<SatLiteral>> conflicts_list;
+  auto ans_list = mSolver.solve_batch(assumption_sets, model_list, conflicts_list, 4);
+  ASSERT_EQ( assumption_sets.size(), ans_list.size() );
+  for ( auto ans: ans_list ) {
+    EXPECT_EQ( SatBool3::X, ans );
+  }
+}
+
+TEST_P(SatTestFixture, solve_batch_budget_reset)
+{
+  // reset() で制限値は解除され，solve() と solve_batch() の結果は一致する．
+  mSolver.set_conflict_budget(10);
+  mSolver.set_propagation_budget(100);
+  mSolver.reset();
+
+  const SizeType np = 7;
+  auto x = pigeon_hole(mSolver, np, 6);
+  EXPECT_EQ( SatBool3::False, mSolver.solve() );
+
+  vector<vector<SatLiteral>> assumption_sets;
+  for ( SizeType i = 0; i < np; ++ i ) {
+    assumption_sets.push_back({x[i][0]});
+  }
+  vector<SatModel> model_list;
+  vector<vector<SatLiteral>> conflicts_list;
+  auto ans_list = mSolver.solve_batch(assumption_sets, model_list, conflicts_list, 4);
+  ASSERT_EQ( assumption_sets.size(), ans_list.size() );
+  for ( auto ans: ans_list ) {
+    EXPECT_EQ( SatBool3::False, ans );
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(SatSolverTest,
+			 SatTestFixture,
+			 ::testing::Values("minisat", "minisat2", "glueminisat2",
+					   "ymsat1", "ymsat2", "lingeling"));
+
+END_NAMESPACE_YM
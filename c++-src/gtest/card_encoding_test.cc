@@ -0,0 +1,279 @@
+
+/// @file card_encoding_test.cc
+/// @brief 個数制約の符号化方法(SatCardEnc)のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "gtest/gtest.h"
+#include "ym/SatSolver.h"
+#include "ym/SatTotalizer.h"
+#include "ym/SatModel.h"
+#include "ym/Range.h"
+
+
+BEGIN_NAMESPACE_YM
+
+class CardEncodingTest :
+  public ::testing::TestWithParam<SatCardEnc>
+{
+public:
+
+  /// @brief 制約を追加する関数の型
+  using AddFunc = std::function<void(SatSolver&, const vector<SatLiteral>&, SizeType, SatCardEnc)>;
+
+  /// @brief 個数制約のチェックを行う．
+  ///
+  /// n 入力の全ての割り当てについて eval(個数) と solve() の結果を比較する．
+  void
+  check(
+    int n,
+    int k,
+    AddFunc add_func,
+    std::function<bool(int)> eval
+  )
+  {
+    SatSolver solver{"ymsat2"};
+    vector<SatLiteral> lit_list(n);
+    for ( auto& lit: lit_list ) {
+      lit = solver.new_variable(true);
+    }
+    add_func(solver, lit_list, k, GetParam());
+    int np = 1 << n;
+    for ( int p: Range(np) ) {
+      vector<SatLiteral> assumptions;
+      int c = 0;
+      for ( int i: Range(n) ) {
+	auto lit = lit_list[i];
+	if ( p & (1 << i) ) {
+	  ++ c;
+	}
+	else {
+	  lit = ~lit;
+	}
+	assumptions.push_back(lit);
+      }
+      auto exp_ans = eval(c) ? SatBool3::True : SatBool3::False;
+      EXPECT_EQ( exp_ans, solver.solve(assumptions) )
+	<< GetParam() << ": n = " << n << ", k = " << k << ", p = " << p;
+    }
+  }
+
+  /// @brief add_at_most_k() のチェックを行う．
+  void
+  check_at_most(
+    int n
+  )
+  {
+    for ( int k: Range(n + 1) ) {
+      check(n, k,
+	    [](SatSolver& solver, const vector<SatLiteral>& lits, SizeType k, SatCardEnc enc) {
+	      solver.add_at_most_k(lits, k, enc);
+	    },
+	    [=](int c) { return c <= k; });
+    }
+  }
+
+  /// @brief add_at_least_k() のチェックを行う．
+  void
+  check_at_least(
+    int n
+  )
+  {
+    for ( int k: Range(n + 1) ) {
+      check(n, k,
+	    [](SatSolver& solver, const vector<SatLiteral>& lits, SizeType k, SatCardEnc enc) {
+	      solver.add_at_least_k(lits, k, enc);
+	    },
+	    [=](int c) { return c >= k; });
+    }
+  }
+
+  /// @brief add_exact_k() のチェックを行う．
+  void
+  check_exact(
+    int n
+  )
+  {
+    for ( int k: Range(n + 1) ) {
+      check(n, k,
+	    [](SatSolver& solver, const vector<SatLiteral>& lits, SizeType k, SatCardEnc enc) {
+	      solver.add_exact_k(lits, k, enc);
+	    },
+	    [=](int c) { return c == k; });
+    }
+  }
+
+};
+
+TEST_P(CardEncodingTest, at_most5)
+{
+  check_at_most(5);
+}
+
+TEST_P(CardEncodingTest, at_most9)
+{
+  check_at_most(9);
+}
+
+TEST_P(CardEncodingTest, at_least5)
+{
+  check_at_least(5);
+}
+
+TEST_P(CardEncodingTest, at_least9)
+{
+  check_at_least(9);
+}
+
+TEST_P(CardEncodingTest, exact5)
+{
+  check_exact(5);
+}
+
+TEST_P(CardEncodingTest, exact9)
+{
+  check_exact(9);
+}
+
+TEST_P(CardEncodingTest, unary_counter)
+{
+  // 出力は個数と等価になる．
+  const int n = 7;
+  const int m = 4;
+  SatSolver solver{"ymsat2"};
+  vector<SatLiteral> lit_list(n);
+  for ( auto& lit: lit_list ) {
+    lit = solver.new_variable(true);
+  }
+  auto olits = solver.add_unary_counter(lit_list, m, GetParam());
+  ASSERT_EQ( m, olits.size() );
+  for ( int p: Range(1 << n) ) {
+    vector<SatLiteral> assumptions;
+    int c = 0;
+    for ( int i: Range(n) ) {
+      auto lit = lit_list[i];
+      if ( p & (1 << i) ) {
+	++ c;
+      }
+      else {
+	lit = ~lit;
+      }
+      assumptions.push_back(lit);
+    }
+    // 出力を逆の値にすると充足不能になる．
+    for ( int j: Range(m) ) {
+      auto olit = olits[j];
+      assumptions.push_back(c >= j + 1 ? ~olit : olit);
+      EXPECT_EQ( SatBool3::False, solver.solve(assumptions) )
+	<< "p = " << p << ", j = " << j;
+      assumptions.pop_back();
+    }
+  }
+}
+
+TEST_P(CardEncodingTest, card_encoding_option)
+{
+  // add_at_most_k() の既定の符号化方法を切り替える．
+  const int n = 6;
+  const int k = 2;
+  SatSolver solver{"ymsat2"};
+  solver.set_card_encoding(GetParam());
+  EXPECT_EQ( GetParam(), solver.card_encoding() );
+  vector<SatLiteral> lit_list(n);
+  for ( auto& lit: lit_list ) {
+    lit = solver.new_variable(true);
+  }
+  solver.add_at_most_k(lit_list, k);
+  for ( int p: Range(1 << n) ) {
+    vector<SatLiteral> assumptions;
+    int c = 0;
+    for ( int i: Range(n) ) {
+      auto lit = lit_list[i];
+      if ( p & (1 << i) ) {
+	++ c;
+      }
+      else {
+	lit = ~lit;
+      }
+      assumptions.push_back(lit);
+    }
+    auto exp_ans = c <= k ? SatBool3::True : SatBool3::False;
+    EXPECT_EQ( exp_ans, solver.solve(assumptions) );
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(SatSolverTest,
+			 CardEncodingTest,
+			 ::testing::Values(SatCardEnc::Auto,
+					   SatCardEnc::Counter,
+					   SatCardEnc::SeqCounter,
+					   SatCardEnc::Totalizer,
+					   SatCardEnc::ModTotalizer,
+					   SatCardEnc::CardNetwork));
+
+TEST(SatTotalizerTest, tighten)
+{
+  // 上限を下げながら解き直すと，上限が入力の下限を下回った時点で
+  // 充足不能になる．
+  const int n = 10;
+  SatSolver solver{"ymsat2"};
+  vector<SatLiteral> lit_list(n);
+  for ( auto& lit: lit_list ) {
+    lit = solver.new_variable(true);
+  }
+  // 先頭の 4 つは true でなければならない．
+  for ( int i: Range(4) ) {
+    solver.add_clause(lit_list[i]);
+  }
+  SatTotalizer tot{solver, lit_list, 6};
+  EXPECT_EQ( n, tot.input_num() );
+  EXPECT_EQ( 7, tot.outputs().size() );
+  for ( int k = 6; k >= 0; -- k ) {
+    // 節を追加する前に仮定として試す．
+    auto lit = tot.le_literal(k);
+    auto exp_ans = k >= 4 ? SatBool3::True : SatBool3::False;
+    EXPECT_EQ( exp_ans, solver.solve({lit}) ) << "k = " << k;
+    if ( k < 4 ) {
+      break;
+    }
+    tot.add_le_constraint(k);
+    ASSERT_EQ( SatBool3::True, solver.solve() );
+    auto& model = solver.model();
+    int c = 0;
+    for ( auto lit: lit_list ) {
+      if ( model[lit] == SatBool3::True ) {
+	++ c;
+      }
+    }
+    EXPECT_LE( c, k );
+  }
+  EXPECT_FALSE( tot.le_literal(n).is_valid() );
+  EXPECT_THROW( tot.le_literal(7), std::invalid_argument );
+}
+
+TEST(SatTotalizerTest, ge)
+{
+  const int n = 8;
+  SatSolver solver{"ymsat2"};
+  vector<SatLiteral> lit_list(n);
+  for ( auto& lit: lit_list ) {
+    lit = solver.new_variable(true);
+  }
+  SatTotalizer tot{solver, lit_list, 5};
+  tot.add_ge_constraint(3);
+  tot.add_le_constraint(3);
+  ASSERT_EQ( SatBool3::True, solver.solve() );
+  auto& model = solver.model();
+  int c = 0;
+  for ( auto lit: lit_list ) {
+    if ( model[lit] == SatBool3::True ) {
+      ++ c;
+    }
+  }
+  EXPECT_EQ( 3, c );
+  EXPECT_THROW( tot.add_ge_constraint(7), std::invalid_argument );
+}
+
+END_NAMESPACE_YM
@@ -36,6 +36,6 @@ TEST_P(SatTestFixture, conflict_test1)
 INSTANTIATE_TEST_SUITE_P(SatSolverTest,
 			 SatTestFixture,
 			 ::testing::Values("glueminisat2", "minisat2",
-					   "ymsat1", "ymsat2"));
+					   "ymsat1", "ymsat2", "portfolio", "cube"));
 
 END_NAMESPACE_YM
@@ -0,0 +1,99 @@
+
+/// @file eqv_test.cc
+/// @brief 等価な変数を含む問題のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "gtest/gtest.h"
+#include "SatTestFixture.h"
+#include "ym/SatModel.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+TEST_P(SatTestFixture, eqv_incremental)
+{
+  // 等価な変数を多く含む問題で，途中で節を追加しながら繰り返し解く．
+  // 等価変数の置き換えを行うソルバ(glueminisat)でも，
+  // モデルは後から追加した節を含めて全ての節を満たし，
+  // 矛盾の原因は与えた assumption で表される．
+  const SizeType n = 60;
+  vector<SatLiteral> x_list(n);
+  vector<SatLiteral> y_list(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    x_list[i] = mSolver.new_variable(true);
+    y_list[i] = mSolver.new_variable(true);
+    mSolver.add_clause(~x_list[i],  y_list[i]);
+    mSolver.add_clause( x_list[i], ~y_list[i]);
+  }
+  std::mt19937 rg{1};
+  std::uniform_int_distribution<SizeType> var_dist(0, n - 1);
+  std::uniform_int_distribution<int> bit_dist(0, 1);
+  auto random_lit = [&]() {
+    auto& lit_list = bit_dist(rg) ? x_list : y_list;
+    auto lit = lit_list[var_dist(rg)];
+    return bit_dist(rg) ? ~lit : lit;
+  };
+  vector<vector<SatLiteral>> clause_list;
+  auto add_random_clause = [&]() {
+    vector<SatLiteral> lits{random_lit(), random_lit(), random_lit()};
+    mSolver.add_clause(lits);
+    clause_list.push_back(lits);
+  };
+  for ( SizeType i = 0; i < 200; ++ i ) {
+    add_random_clause();
+  }
+
+  for ( SizeType k = 0; k < 300; ++ k ) {
+    if ( k % 10 == 0 ) {
+      add_random_clause();
+    }
+    vector<SatLiteral> assumptions;
+    for ( SizeType j = 0; j < 6; ++ j ) {
+      assumptions.push_back(random_lit());
+    }
+    auto r = mSolver.solve(assumptions);
+    if ( r == SatBool3::True ) {
+      auto& model = mSolver.model();
+      for ( auto lit: assumptions ) {
+	EXPECT_EQ( SatBool3::True, model[lit] );
+      }
+      for ( auto& lits: clause_list ) {
+	bool sat = false;
+	for ( auto lit: lits ) {
+	  if ( model[lit] == SatBool3::True ) {
+	    sat = true;
+	  }
+	}
+	EXPECT_TRUE( sat );
+      }
+    }
+    else if ( r == SatBool3::False ) {
+      auto conf_lits = mSolver.conflict_literals();
+      vector<SatLiteral> assumptions2;
+      for ( auto lit: conf_lits ) {
+	// 矛盾の原因は assumption の否定になっている．
+	bool found = false;
+	for ( auto lit1: assumptions ) {
+	  if ( lit == ~lit1 ) {
+	    found = true;
+	  }
+	}
+	EXPECT_TRUE( found );
+	assumptions2.push_back(~lit);
+      }
+      // 矛盾の原因だけでも充足不能となる．
+      EXPECT_EQ( SatBool3::False, mSolver.solve(assumptions2) );
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(SatSolverTest,
+			 SatTestFixture,
+			 ::testing::Values("glueminisat2", "minisat2",
+					   "ymsat1", "ymsat2"));
+
+END_NAMESPACE_YM
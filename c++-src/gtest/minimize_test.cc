@@ -0,0 +1,321 @@
+
+/// @file minimize_test.cc
+/// @brief SatSolver::minimize() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "gtest/gtest.h"
+#include "ym/SatSolver.h"
+#include "ym/SatModel.h"
+#include "ym/SatBinaryNum.h"
+#include "ym/SatOrderedSet.h"
+#include "ym/SatMsgHandler.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// print_bound() の呼び出しを記録するメッセージハンドラ
+class BoundRecorder :
+  public SatMsgHandler
+{
+public:
+
+  /// @brief デストラクタ
+  ~BoundRecorder() = default;
+
+  void
+  print_header() override
+  {
+  }
+
+  void
+  print_message(const SatStats& stats) override
+  {
+  }
+
+  void
+  print_footer(const SatStats& stats) override
+  {
+  }
+
+  void
+  print_bound(
+    std::int64_t lower,
+    std::int64_t upper
+  ) override
+  {
+    mBoundList.push_back({lower, upper});
+  }
+
+  // 記録された (下界, 上界) のリスト
+  vector<std::pair<std::int64_t, std::int64_t>> mBoundList;
+
+};
+
+END_NONAMESPACE
+
+class MinimizeTest :
+  public ::testing::TestWithParam<std::tuple<string, SatOptStrategy>>
+{
+public:
+
+  /// @brief コンストラクタ
+  MinimizeTest() :
+    mSolver{std::get<0>(GetParam())},
+    mStrategy{std::get<1>(GetParam())}
+  {
+  }
+
+  /// @brief 節のリストを満たす割り当ての Σ weight_list[i] * x_i の最小値を求める．
+  /// @return 解がない場合は false を返す．
+  static
+  bool
+  brute_force(
+    SizeType ni,
+    const vector<vector<int>>& clause_list,
+    const vector<int>& weight_list,
+    std::int64_t& opt_val
+  )
+  {
+    bool found = false;
+    for ( SizeType p = 0; p < (1U << ni); ++ p ) {
+      bool sat = true;
+      for ( auto& clause: clause_list ) {
+	bool csat = false;
+	for ( auto l: clause ) {
+	  auto var = std::abs(l) - 1;
+	  bool val = (p >> var) & 1;
+	  if ( val == (l > 0) ) {
+	    csat = true;
+	    break;
+	  }
+	}
+	if ( !csat ) {
+	  sat = false;
+	  break;
+	}
+      }
+      if ( !sat ) {
+	continue;
+      }
+      std::int64_t val = 0;
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	if ( (p >> i) & 1 ) {
+	  val += weight_list[i];
+	}
+      }
+      if ( !found || val < opt_val ) {
+	opt_val = val;
+      }
+      found = true;
+    }
+    return found;
+  }
+
+  // SATソルバ
+  SatSolver mSolver;
+
+  // 探索方法
+  SatOptStrategy mStrategy;
+
+};
+
+TEST_P(MinimizeTest, binary_num)
+{
+  // x * y >= 20 のもとで x + y を最小化する．
+  SatBinaryNum x{mSolver, 4};
+  SatBinaryNum y{mSolver, 4};
+  auto p = x.mul(y);
+  mSolver.add_ge(p.bit_vars(), 20);
+  auto obj = x.add(y);
+
+  auto ans = mSolver.minimize(obj, mStrategy);
+  ASSERT_EQ( SatBool3::True, ans );
+  EXPECT_EQ( 9, mSolver.opt_value() );
+  EXPECT_EQ( 9, mSolver.opt_lower_bound() );
+  auto& model = mSolver.model();
+  auto xv = x.val(model);
+  auto yv = y.val(model);
+  EXPECT_GE( xv * yv, 20 );
+  EXPECT_EQ( 9, xv + yv );
+}
+
+TEST_P(MinimizeTest, ordered_set)
+{
+  // 2x + 3y >= 17 のもとで z = x + y を最小化する．
+  SatOrderedSet x{mSolver, 0, 10};
+  SatOrderedSet y{mSolver, 0, 10};
+  SatOrderedSet z{mSolver, 0, 20};
+  x.add_sum_eq_constraint(y, z);
+  SatOrderedSet::add_linear_ge_constraint({2, 3}, {&x, &y}, 17);
+
+  auto ans = mSolver.minimize(z, mStrategy);
+  ASSERT_EQ( SatBool3::True, ans );
+  EXPECT_EQ( 6, mSolver.opt_value() );
+  auto& model = mSolver.model();
+  auto xv = x.val(model);
+  auto yv = y.val(model);
+  EXPECT_GE( 2 * xv + 3 * yv, 17 );
+  EXPECT_EQ( 6, z.val(model) );
+  EXPECT_EQ( 6, xv + yv );
+}
+
+TEST_P(MinimizeTest, pb_random)
+{
+  SizeType ni = 10;
+  std::mt19937 rg{12345};
+  std::uniform_int_distribution<int> var_dist(1, ni);
+  std::uniform_int_distribution<int> sign_dist(0, 1);
+  std::uniform_int_distribution<int> weight_dist(-5, 20);
+  for ( SizeType c = 0; c < 5; ++ c ) {
+    mSolver.reset();
+    vector<SatLiteral> lit_list(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      lit_list[i] = mSolver.new_variable(true);
+    }
+    vector<vector<int>> clause_list;
+    for ( SizeType j = 0; j < 30; ++ j ) {
+      vector<int> clause;
+      vector<SatLiteral> lits;
+      for ( SizeType k = 0; k < 3; ++ k ) {
+	int v = var_dist(rg);
+	bool inv = sign_dist(rg);
+	clause.push_back(inv ? -v : v);
+	auto lit = lit_list[v - 1];
+	lits.push_back(inv ? ~lit : lit);
+      }
+      clause_list.push_back(clause);
+      mSolver.add_clause(lits);
+    }
+    vector<int> weight_list(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      weight_list[i] = weight_dist(rg);
+    }
+
+    std::int64_t exp_val;
+    bool exp_found = brute_force(ni, clause_list, weight_list, exp_val);
+    auto ans = mSolver.minimize(weight_list, lit_list, mStrategy);
+    if ( exp_found ) {
+      ASSERT_EQ( SatBool3::True, ans );
+      EXPECT_EQ( exp_val, mSolver.opt_value() );
+      auto& model = mSolver.model();
+      std::int64_t val = 0;
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	if ( model[lit_list[i]] == SatBool3::True ) {
+	  val += weight_list[i];
+	}
+      }
+      EXPECT_EQ( exp_val, val );
+    }
+    else {
+      EXPECT_EQ( SatBool3::False, ans );
+      EXPECT_EQ( 0, mSolver.model().size() );
+    }
+  }
+}
+
+TEST_P(MinimizeTest, pb_large_weight)
+{
+  // 重みの大きな項と負の重みの項を含む場合
+  // UnsatSat は下界を1ずつ上げるので対象外とする．
+  if ( mStrategy == SatOptStrategy::UnsatSat ) {
+    GTEST_SKIP();
+  }
+  SizeType ni = 4;
+  vector<SatLiteral> lit_list(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    lit_list[i] = mSolver.new_variable(true);
+  }
+  vector<vector<int>> clause_list{{1, 2}, {-2, 3}, {-1, 4}, {3, 4}};
+  for ( auto& clause: clause_list ) {
+    vector<SatLiteral> lits;
+    for ( auto l: clause ) {
+      auto lit = lit_list[std::abs(l) - 1];
+      lits.push_back(l > 0 ? lit : ~lit);
+    }
+    mSolver.add_clause(lits);
+  }
+  vector<int> weight_list{1000000000, -999999999, 1000000000, -7};
+
+  std::int64_t exp_val;
+  ASSERT_TRUE( brute_force(ni, clause_list, weight_list, exp_val) );
+  auto ans = mSolver.minimize(weight_list, lit_list, mStrategy);
+  ASSERT_EQ( SatBool3::True, ans );
+  EXPECT_EQ( exp_val, mSolver.opt_value() );
+}
+
+TEST_P(MinimizeTest, infeasible)
+{
+  SatOrderedSet x{mSolver, 0, 10};
+  x.add_ge_constraint(5);
+  x.add_le_constraint(3);
+
+  auto ans = mSolver.minimize(x, mStrategy);
+  EXPECT_EQ( SatBool3::False, ans );
+  EXPECT_EQ( 0, mSolver.model().size() );
+}
+
+TEST_P(MinimizeTest, incremental)
+{
+  // minimize() は制約を変えないので後から制約を加えて再度解ける．
+  SatOrderedSet x{mSolver, 0, 10};
+  x.add_ge_constraint(2);
+
+  auto ans1 = mSolver.minimize(x, mStrategy);
+  ASSERT_EQ( SatBool3::True, ans1 );
+  EXPECT_EQ( 2, mSolver.opt_value() );
+
+  x.add_dropoff_constraint(3, 7);
+  auto ans2 = mSolver.solve({x.ge_lit(8)});
+  EXPECT_EQ( SatBool3::True, ans2 );
+
+  auto ans3 = mSolver.minimize(x, mStrategy);
+  ASSERT_EQ( SatBool3::True, ans3 );
+  EXPECT_EQ( 2, mSolver.opt_value() );
+}
+
+TEST_P(MinimizeTest, msg_handler)
+{
+  SatOrderedSet x{mSolver, 0, 20};
+  SatOrderedSet y{mSolver, 0, 20};
+  x.add_sum_ge_constraint(y, 13);
+  SatOrderedSet::add_linear_le_constraint({1, -1}, {&x, &y}, 1);
+  SatOrderedSet::add_linear_le_constraint({-1, 1}, {&x, &y}, 1);
+
+  BoundRecorder recorder;
+  mSolver.reg_msg_handler(&recorder);
+
+  // x + y >= 13, |x - y| <= 1 のもとで x を最小化する．
+  auto ans = mSolver.minimize(x, mStrategy);
+  ASSERT_EQ( SatBool3::True, ans );
+  EXPECT_EQ( 6, mSolver.opt_value() );
+
+  auto& bound_list = recorder.mBoundList;
+  ASSERT_FALSE( bound_list.empty() );
+  for ( SizeType i = 0; i < bound_list.size(); ++ i ) {
+    auto lower = bound_list[i].first;
+    auto upper = bound_list[i].second;
+    EXPECT_LE( lower, upper );
+    if ( i > 0 ) {
+      EXPECT_LE( bound_list[i - 1].first, lower );
+      EXPECT_GE( bound_list[i - 1].second, upper );
+    }
+  }
+  EXPECT_EQ( 6, bound_list.back().first );
+  EXPECT_EQ( 6, bound_list.back().second );
+}
+
+INSTANTIATE_TEST_SUITE_P(SatSolverTest,
+			 MinimizeTest,
+			 ::testing::Combine(::testing::Values("lingeling", "glueminisat2", "minisat2", "minisat",
+							      "ymsat1", "ymsat2", "ymsat1_old"),
+					    ::testing::Values(SatOptStrategy::SatUnsat,
+							      SatOptStrategy::UnsatSat,
+							      SatOptStrategy::Binary)));
+
+END_NAMESPACE_YM_SAT
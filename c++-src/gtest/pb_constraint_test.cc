@@ -0,0 +1,383 @@
+
+/// @file pb_constraint_test.cc
+/// @brief add_card_le()/add_pb_ge() 等のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "gtest/gtest.h"
+#include "SatTestFixture.h"
+#include "ym/SatModel.h"
+#include "ym/Range.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+class PbConstraintTest :
+  public SatTestFixture
+{
+public:
+
+  /// @brief コンストラクタ
+  PbConstraintTest() : SatTestFixture() { }
+
+  /// @brief デストラクタ
+  ~PbConstraintTest() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief add_card_le() のチェックを行う．
+  void
+  check_card_le(
+    int ni,
+    int k
+  );
+
+  /// @brief add_card_ge() のチェックを行う．
+  void
+  check_card_ge(
+    int ni,
+    int k
+  );
+
+  /// @brief add_pb_le()/add_pb_ge() のチェックを行う．
+  ///
+  /// weight_list の要素が負の場合は否定のリテラルを用いる．
+  void
+  check_pb(
+    const vector<int>& weight_list,
+    const vector<bool>& inv_list,
+    int bound,
+    bool le
+  );
+
+  /// @brief ランダムな擬似ブール制約と節の組み合わせのチェックを行う．
+  ///
+  /// 擬似ブール制約を節に展開した場合と結果を比較し，
+  /// 充足した場合には全ての制約を満たしているか調べる．
+  void
+  check_random(
+    bool card
+  );
+
+};
+
+// @brief add_card_le() のチェックを行う．
+void
+PbConstraintTest::check_card_le(
+  int ni,
+  int k
+)
+{
+  vector<SatLiteral> lits(mVarList.begin(), mVarList.begin() + ni);
+  mSolver.add_card_le(lits, k);
+
+  int np = 1 << ni;
+  vector<int> vals(np);
+  for ( int p: Range(np) ) {
+    int c = 0;
+    for ( int i: Range(ni) ) {
+      if ( p & (1 << i) ) {
+	++ c;
+      }
+    }
+    vals[p] = c <= k;
+  }
+  check(ni, vals);
+}
+
+// @brief add_card_ge() のチェックを行う．
+void
+PbConstraintTest::check_card_ge(
+  int ni,
+  int k
+)
+{
+  vector<SatLiteral> lits(mVarList.begin(), mVarList.begin() + ni);
+  mSolver.add_card_ge(lits, k);
+
+  int np = 1 << ni;
+  vector<int> vals(np);
+  for ( int p: Range(np) ) {
+    int c = 0;
+    for ( int i: Range(ni) ) {
+      if ( p & (1 << i) ) {
+	++ c;
+      }
+    }
+    vals[p] = c >= k;
+  }
+  check(ni, vals);
+}
+
+// @brief add_pb_le()/add_pb_ge() のチェックを行う．
+void
+PbConstraintTest::check_pb(
+  const vector<int>& weight_list,
+  const vector<bool>& inv_list,
+  int bound,
+  bool le
+)
+{
+  int ni = weight_list.size();
+  vector<SatLiteral> lits(ni);
+  for ( int i: Range(ni) ) {
+    lits[i] = inv_list[i] ? ~mVarList[i] : mVarList[i];
+  }
+  if ( le ) {
+    mSolver.add_pb_le(weight_list, lits, bound);
+  }
+  else {
+    mSolver.add_pb_ge(weight_list, lits, bound);
+  }
+
+  int np = 1 << ni;
+  vector<int> vals(np);
+  for ( int p: Range(np) ) {
+    int sum = 0;
+    for ( int i: Range(ni) ) {
+      bool val = static_cast<bool>(p & (1 << i)) ^ inv_list[i];
+      if ( val ) {
+	sum += weight_list[i];
+      }
+    }
+    vals[p] = le ? sum <= bound : sum >= bound;
+  }
+  check(ni, vals);
+}
+
+// @brief ランダムな擬似ブール制約と節の組み合わせのチェックを行う．
+void
+PbConstraintTest::check_random(
+  bool card
+)
+{
+  const int nv = 30;
+  const int npb = 12;
+  const int nc = 80;
+  std::mt19937 rg;
+  std::uniform_int_distribution<int> var_dist(0, nv - 1);
+  std::uniform_int_distribution<int> size_dist(2, 8);
+  std::uniform_int_distribution<int> weight_dist(-5, 5);
+  std::uniform_int_distribution<int> bool_dist(0, 1);
+  for ( int c: Range(20) ) {
+    SatSolver solver1{GetParam()};
+    SatSolver solver2{GetParam()};
+    solver2.set_native_pb(false);
+    vector<SatLiteral> var_list1(nv);
+    vector<SatLiteral> var_list2(nv);
+    for ( int i: Range(nv) ) {
+      var_list1[i] = solver1.new_variable(true);
+      var_list2[i] = solver2.new_variable(true);
+    }
+    vector<vector<int>> pb_list(npb);
+    vector<vector<int>> weight_list(npb);
+    vector<int> bound_list(npb);
+    for ( int i: Range(npb) ) {
+      int n = size_dist(rg);
+      vector<SatLiteral> lits1;
+      vector<SatLiteral> lits2;
+      int wsum = 0;
+      for ( int j: Range(n) ) {
+	int var = var_dist(rg);
+	bool inv = bool_dist(rg);
+	int w = card ? 1 : weight_dist(rg);
+	pb_list[i].push_back(inv ? - var - 1 : var + 1);
+	weight_list[i].push_back(w);
+	lits1.push_back(inv ? ~var_list1[var] : var_list1[var]);
+	lits2.push_back(inv ? ~var_list2[var] : var_list2[var]);
+	wsum += std::abs(w);
+      }
+      std::uniform_int_distribution<int> bound_dist(- wsum / 2, wsum / 2);
+      int bound = card ? n / 2 : bound_dist(rg);
+      bound_list[i] = bound;
+      // 矛盾が判明した後は制約を追加できない．
+      if ( solver1.sane() ) {
+	solver1.add_pb_le(weight_list[i], lits1, bound);
+      }
+      if ( solver2.sane() ) {
+	solver2.add_pb_le(weight_list[i], lits2, bound);
+      }
+    }
+    vector<vector<int>> clause_list(nc);
+    for ( int i: Range(nc) ) {
+      vector<SatLiteral> lits1;
+      vector<SatLiteral> lits2;
+      for ( int j: Range(3) ) {
+	int var = var_dist(rg);
+	bool inv = bool_dist(rg);
+	clause_list[i].push_back(inv ? - var - 1 : var + 1);
+	lits1.push_back(inv ? ~var_list1[var] : var_list1[var]);
+	lits2.push_back(inv ? ~var_list2[var] : var_list2[var]);
+      }
+      if ( solver1.sane() ) {
+	solver1.add_clause(lits1);
+      }
+      if ( solver2.sane() ) {
+	solver2.add_clause(lits2);
+      }
+    }
+    auto ans1 = solver1.solve();
+    auto ans2 = solver2.solve();
+    EXPECT_EQ( ans2, ans1 ) << "c = " << c;
+    if ( ans1 != SatBool3::True ) {
+      continue;
+    }
+    auto& model = solver1.model();
+    auto lit_val = [&](int l) {
+      auto lit = var_list1[abs(l) - 1];
+      return (model[lit] == SatBool3::True) == (l > 0);
+    };
+    for ( int i: Range(npb) ) {
+      int sum = 0;
+      for ( int j: Range(pb_list[i].size()) ) {
+	if ( lit_val(pb_list[i][j]) ) {
+	  sum += weight_list[i][j];
+	}
+      }
+      EXPECT_LE( sum, bound_list[i] ) << "c = " << c << ", pb #" << i;
+    }
+    for ( int i: Range(nc) ) {
+      bool val = false;
+      for ( auto l: clause_list[i] ) {
+	if ( lit_val(l) ) {
+	  val = true;
+	}
+      }
+      EXPECT_TRUE( val ) << "c = " << c << ", clause #" << i;
+    }
+  }
+}
+
+TEST_P(PbConstraintTest, card_le5_0)
+{
+  check_card_le(5, 0);
+}
+
+TEST_P(PbConstraintTest, card_le5_1)
+{
+  check_card_le(5, 1);
+}
+
+TEST_P(PbConstraintTest, card_le5_3)
+{
+  check_card_le(5, 3);
+}
+
+TEST_P(PbConstraintTest, card_le8_4)
+{
+  check_card_le(8, 4);
+}
+
+TEST_P(PbConstraintTest, card_ge5_1)
+{
+  check_card_ge(5, 1);
+}
+
+TEST_P(PbConstraintTest, card_ge5_5)
+{
+  check_card_ge(5, 5);
+}
+
+TEST_P(PbConstraintTest, card_ge8_3)
+{
+  check_card_ge(8, 3);
+}
+
+TEST_P(PbConstraintTest, card_ge8_3_cnf)
+{
+  mSolver.set_native_pb(false);
+  check_card_ge(8, 3);
+}
+
+TEST_P(PbConstraintTest, pb_ge1)
+{
+  check_pb({3, 2, 2, 1, 1}, {false, false, false, false, false}, 5, false);
+}
+
+TEST_P(PbConstraintTest, pb_le1)
+{
+  check_pb({3, 2, 2, 1, 1}, {false, false, false, false, false}, 4, true);
+}
+
+TEST_P(PbConstraintTest, pb_ge2)
+{
+  check_pb({5, -3, 2, -1, 4, 1}, {false, true, false, false, true, false}, 2, false);
+}
+
+TEST_P(PbConstraintTest, pb_le2)
+{
+  check_pb({5, -3, 2, -1, 4, 1}, {false, true, false, false, true, false}, 3, true);
+}
+
+TEST_P(PbConstraintTest, pb_ge2_cnf)
+{
+  mSolver.set_native_pb(false);
+  check_pb({5, -3, 2, -1, 4, 1}, {false, true, false, false, true, false}, 2, false);
+}
+
+TEST_P(PbConstraintTest, pb_dup)
+{
+  // 2 x0 + x1 + 3 ~x0 >= 3 は x1 - x0 >= 0 と等しい．
+  auto x0 = mVarList[0];
+  auto x1 = mVarList[1];
+  mSolver.add_pb_ge({2, 1, 3}, {x0, x1, ~x0}, 3);
+
+  vector<int> vals(4);
+  for ( int p: Range(4) ) {
+    int v0 = p & 1;
+    int v1 = (p >> 1) & 1;
+    vals[p] = v1 >= v0;
+  }
+  check(2, vals);
+}
+
+TEST_P(PbConstraintTest, pb_unsat)
+{
+  vector<SatLiteral> lits(mVarList.begin(), mVarList.begin() + 4);
+  mSolver.add_pb_ge({1, 2, 3, 4}, lits, 11);
+  EXPECT_EQ( SatBool3::False, mSolver.solve() );
+}
+
+TEST_P(PbConstraintTest, pb_cond)
+{
+  mSolver.set_conditional_literals(mCondVarList[0]);
+  vector<SatLiteral> lits(mVarList.begin(), mVarList.begin() + 4);
+  mSolver.add_pb_ge({4, 3, 2, 1}, lits, 5);
+  mSolver.clear_conditional_literals();
+
+  vector<int> vals(16);
+  for ( int p: Range(16) ) {
+    int sum = 0;
+    for ( int i: Range(4) ) {
+      if ( p & (1 << i) ) {
+	sum += 4 - i;
+      }
+    }
+    vals[p] = sum >= 5;
+  }
+  check_with_cond1(4, vals);
+}
+
+TEST_P(PbConstraintTest, card_random)
+{
+  check_random(true);
+}
+
+TEST_P(PbConstraintTest, pb_random)
+{
+  check_random(false);
+}
+
+INSTANTIATE_TEST_SUITE_P(SatSolverTest,
+			 PbConstraintTest,
+			 ::testing::Values("lingeling", "glueminisat2", "minisat2", "minisat",
+					   "ymsat1", "ymsat2", "ymsat1_old"));
+
+END_NAMESPACE_YM
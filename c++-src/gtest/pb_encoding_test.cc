@@ -0,0 +1,201 @@
+
+/// @file pb_encoding_test.cc
+/// @brief 擬似ブール制約の展開方法(SatPbEnc)のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "gtest/gtest.h"
+#include "ym/SatSolver.h"
+#include "ym/Range.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+class PbEncodingTest :
+  public ::testing::TestWithParam<SatPbEnc>
+{
+public:
+
+  /// @brief 比較の種類
+  enum Op {
+    LE, ///< <=
+    GE, ///< >=
+    EQ  ///< ==
+  };
+
+  /// @brief 擬似ブール制約のチェックを行う．
+  ///
+  /// 否定のリテラルを用いる入力は inv_list で指定する．
+  /// 全ての割り当てについて重み付きの和と solve() の結果を比較する．
+  void
+  check(
+    const vector<int>& weight_list,
+    const vector<bool>& inv_list,
+    int bound,
+    Op op
+  )
+  {
+    SatSolver solver{"ymsat2"};
+    // Auto の場合も節に展開させる．
+    solver.set_native_pb(false);
+    int n = weight_list.size();
+    vector<SatLiteral> var_list(n);
+    for ( auto& var: var_list ) {
+      var = solver.new_variable(true);
+    }
+    vector<SatLiteral> lit_list(n);
+    for ( int i: Range(n) ) {
+      lit_list[i] = inv_list[i] ? ~var_list[i] : var_list[i];
+    }
+    switch ( op ) {
+    case LE: solver.add_pb_le(weight_list, lit_list, bound, GetParam()); break;
+    case GE: solver.add_pb_ge(weight_list, lit_list, bound, GetParam()); break;
+    case EQ: solver.add_pb_eq(weight_list, lit_list, bound, GetParam()); break;
+    }
+    int np = 1 << n;
+    for ( int p: Range(np) ) {
+      vector<SatLiteral> assumptions;
+      int sum = 0;
+      for ( int i: Range(n) ) {
+	bool val = static_cast<bool>(p & (1 << i));
+	assumptions.push_back(val ? var_list[i] : ~var_list[i]);
+	if ( val ^ inv_list[i] ) {
+	  sum += weight_list[i];
+	}
+      }
+      bool exp_val = false;
+      switch ( op ) {
+      case LE: exp_val = sum <= bound; break;
+      case GE: exp_val = sum >= bound; break;
+      case EQ: exp_val = sum == bound; break;
+      }
+      auto exp_ans = exp_val ? SatBool3::True : SatBool3::False;
+      EXPECT_EQ( exp_ans, solver.solve(assumptions) )
+	<< GetParam() << ": bound = " << bound << ", p = " << p;
+    }
+  }
+
+  /// @brief ランダムな重みで全ての比較と右辺をチェックする．
+  void
+  check_random(
+    int n,
+    int wmin,
+    int wmax
+  )
+  {
+    std::mt19937 rg;
+    std::uniform_int_distribution<int> weight_dist(wmin, wmax);
+    std::uniform_int_distribution<int> bool_dist(0, 1);
+    for ( int c: Range(3) ) {
+      vector<int> weight_list(n);
+      vector<bool> inv_list(n);
+      int wsum = 0;
+      for ( int i: Range(n) ) {
+	weight_list[i] = weight_dist(rg);
+	inv_list[i] = bool_dist(rg);
+	wsum += std::abs(weight_list[i]);
+      }
+      std::uniform_int_distribution<int> bound_dist(- wsum / 2, wsum);
+      for ( int b: Range(4) ) {
+	int bound = bound_dist(rg);
+	check(weight_list, inv_list, bound, LE);
+	check(weight_list, inv_list, bound, GE);
+	check(weight_list, inv_list, bound, EQ);
+      }
+    }
+  }
+
+};
+
+TEST_P(PbEncodingTest, ge1)
+{
+  check({3, 2, 2, 1, 1}, {false, false, false, false, false}, 5, GE);
+}
+
+TEST_P(PbEncodingTest, le1)
+{
+  check({3, 2, 2, 1, 1}, {false, false, false, false, false}, 4, LE);
+}
+
+TEST_P(PbEncodingTest, eq1)
+{
+  check({3, 2, 2, 1, 1}, {false, false, false, false, false}, 4, EQ);
+}
+
+TEST_P(PbEncodingTest, eq2)
+{
+  check({5, -3, 2, -1, 4, 1}, {false, true, false, false, true, false}, 3, EQ);
+}
+
+TEST_P(PbEncodingTest, gcd)
+{
+  // 4 x0 + 6 x1 + 10 x2 + 6 x3 >= 7 は 2 x0 + 3 x1 + 5 x2 + 3 x3 >= 4 になる．
+  check({4, 6, 10, 6}, {false, false, false, false}, 7, GE);
+  check({4, 6, 10, 6}, {false, false, false, false}, 10, EQ);
+}
+
+TEST_P(PbEncodingTest, random_positive)
+{
+  check_random(8, 1, 9);
+}
+
+TEST_P(PbEncodingTest, random_signed)
+{
+  check_random(8, -7, 7);
+}
+
+TEST_P(PbEncodingTest, unsat)
+{
+  SatSolver solver{"ymsat2"};
+  solver.set_native_pb(false);
+  vector<SatLiteral> lit_list(4);
+  for ( auto& lit: lit_list ) {
+    lit = solver.new_variable(true);
+  }
+  solver.add_pb_eq({2, 4, 6, 8}, lit_list, 7, GetParam());
+  EXPECT_EQ( SatBool3::False, solver.solve() );
+}
+
+TEST_P(PbEncodingTest, pb_encoding_option)
+{
+  // add_pb_le() の既定の展開方法を切り替える．
+  SatSolver solver{"ymsat2"};
+  solver.set_pb_encoding(GetParam());
+  EXPECT_EQ( GetParam(), solver.pb_encoding() );
+  const int n = 6;
+  vector<SatLiteral> lit_list(n);
+  for ( auto& lit: lit_list ) {
+    lit = solver.new_variable(true);
+  }
+  vector<int> weight_list{1, 2, 3, 4, 5, 6};
+  solver.add_pb_eq(weight_list, lit_list, 10);
+  // Auto 以外を指定した場合は節に展開される．
+  if ( GetParam() == SatPbEnc::Auto ) {
+    EXPECT_EQ( 0, solver.clause_num() );
+  }
+  else {
+    EXPECT_NE( 0, solver.clause_num() );
+  }
+  ASSERT_EQ( SatBool3::True, solver.solve() );
+  auto& model = solver.model();
+  int sum = 0;
+  for ( int i: Range(n) ) {
+    if ( model[lit_list[i]] == SatBool3::True ) {
+      sum += weight_list[i];
+    }
+  }
+  EXPECT_EQ( 10, sum );
+}
+
+INSTANTIATE_TEST_SUITE_P(SatSolverTest,
+			 PbEncodingTest,
+			 ::testing::Values(SatPbEnc::Auto,
+					   SatPbEnc::Adder,
+					   SatPbEnc::Bdd,
+					   SatPbEnc::GenTotalizer,
+					   SatPbEnc::SortNetwork));
+
+END_NAMESPACE_YM
@@ -0,0 +1,195 @@
+
+/// @file pool_test.cc
+/// @brief SatSolver::reset() と SatSolverPool のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/SatSolver.h"
+#include "ym/SatSolverPool.h"
+#include "ym/SatMsgHandler.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// id 番目のランダムな 3-SAT 問題を作って解く．
+SatBool3
+solve_random(
+  SizeType id,
+  SatSolver& solver
+)
+{
+  const SizeType nv = 20;
+  const SizeType nc = 86;
+  std::mt19937 rg{static_cast<std::mt19937::result_type>(id)};
+  std::uniform_int_distribution<int> var_dist(0, nv - 1);
+  std::uniform_int_distribution<int> pol_dist(0, 1);
+  vector<SatLiteral> lits(nv);
+  for ( SizeType i = 0; i < nv; ++ i ) {
+    lits[i] = solver.new_variable(true);
+  }
+  vector<vector<SatLiteral>> clause_list;
+  for ( SizeType i = 0; i < nc; ++ i ) {
+    vector<SatLiteral> tmp_lits;
+    for ( SizeType j = 0; j < 3; ++ j ) {
+      tmp_lits.push_back(lits[var_dist(rg)] * pol_dist(rg));
+    }
+    solver.add_clause(tmp_lits);
+    clause_list.push_back(tmp_lits);
+  }
+  auto ans = solver.solve();
+  if ( ans == SatBool3::True ) {
+    // 得られた解が全ての節を充足しているか調べる．
+    auto& model = solver.model();
+    for ( auto& tmp_lits: clause_list ) {
+      bool sat = false;
+      for ( auto lit: tmp_lits ) {
+	if ( model[lit] == SatBool3::True ) {
+	  sat = true;
+	}
+      }
+      if ( !sat ) {
+	return SatBool3::X;
+      }
+    }
+  }
+  return ans;
+}
+
+// 呼び出された回数を数えるメッセージハンドラ
+class CountHandler :
+  public SatMsgHandler
+{
+public:
+
+  /// @brief デストラクタ
+  ~CountHandler() = default;
+
+  void
+  print_header() override
+  {
+    ++ mCount;
+  }
+
+  void
+  print_message(const SatStats& stats) override
+  {
+    ++ mCount;
+  }
+
+  void
+  print_footer(const SatStats& stats) override
+  {
+    ++ mCount;
+  }
+
+  // 呼び出された回数
+  SizeType mCount{0};
+
+};
+
+END_NONAMESPACE
+
+class SatSolverResetTest :
+  public ::testing::TestWithParam<string>
+{
+};
+
+TEST_P(SatSolverResetTest, reset)
+{
+  SatSolver solver{SatInitParam{GetParam()}};
+
+  for ( SizeType id = 0; id < 50; ++ id ) {
+    if ( id > 0 ) {
+      solver.reset();
+    }
+    EXPECT_EQ( 0, solver.variable_num() );
+    EXPECT_EQ( 0, solver.clause_num() );
+
+    SatSolver solver1{SatInitParam{GetParam()}};
+    auto exp_ans = solve_random(id, solver1);
+    auto ans = solve_random(id, solver);
+    EXPECT_EQ( exp_ans, ans );
+    EXPECT_NE( SatBool3::X, ans );
+  }
+
+  // 矛盾した状態からも元に戻る．
+  solver.reset();
+  auto lit = solver.new_variable(true);
+  solver.add_clause(lit);
+  solver.add_clause(~lit);
+  EXPECT_EQ( SatBool3::False, solver.solve() );
+  solver.reset();
+  lit = solver.new_variable(true);
+  solver.add_clause(lit);
+  EXPECT_EQ( SatBool3::True, solver.solve() );
+  EXPECT_EQ( SatBool3::True, solver.model()[lit] );
+}
+
+TEST_P(SatSolverResetTest, msg_handler)
+{
+  // reset() で実装が作り直されても登録したメッセージハンドラは有効
+  SatSolver solver{SatInitParam{GetParam()}};
+  CountHandler handler;
+  solver.reg_msg_handler(&handler);
+
+  solve_random(0, solver);
+  auto count1 = handler.mCount;
+  if ( count1 == 0 ) {
+    // メッセージハンドラを用いない実装
+    GTEST_SKIP();
+  }
+
+  solver.reset();
+  solve_random(1, solver);
+  EXPECT_LT( count1, handler.mCount );
+}
+
+INSTANTIATE_TEST_SUITE_P(SatSolverTest,
+			 SatSolverResetTest,
+			 ::testing::Values("minisat2", "glueminisat2",
+					   "ymsat1", "ymsat2", "portfolio", "cube"));
+
+TEST(SatSolverPoolTest, run)
+{
+  SatSolverPool pool{SatInitParam{"ymsat2"}, 4};
+  EXPECT_EQ( 4, pool.thread_num() );
+
+  SizeType n = 1000;
+  vector<SatBool3> ans_list(n, SatBool3::X);
+  pool.run(n, [&](SizeType id, SatSolver& solver) {
+    ans_list[id] = solve_random(id, solver);
+  });
+
+  for ( SizeType id = 0; id < n; ++ id ) {
+    SatSolver solver{SatInitParam{"minisat2"}};
+    auto exp_ans = solve_random(id, solver);
+    EXPECT_EQ( exp_ans, ans_list[id] );
+  }
+
+  // 続けて使える．
+  vector<SatBool3> ans_list2(n, SatBool3::X);
+  pool.run(n, [&](SizeType id, SatSolver& solver) {
+    EXPECT_EQ( 0, solver.variable_num() );
+    ans_list2[id] = solve_random(id, solver);
+  });
+  EXPECT_EQ( ans_list, ans_list2 );
+}
+
+TEST(SatSolverPoolTest, exception)
+{
+  SatSolverPool pool{SatInitParam{"ymsat2"}, 2};
+
+  EXPECT_THROW( pool.run(100, [&](SizeType id, SatSolver& solver) {
+    if ( id == 10 ) {
+      throw std::runtime_error{"error"};
+    }
+  }), std::runtime_error );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,187 @@
+
+/// @file portfolio_test.cc
+/// @brief ポートフォリオ型ソルバのテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/SatSolver.h"
+#include "ym/SatStats.h"
+#include "ym/JsonValue.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 鳩の巣問題を作る．
+vector<SatLiteral>
+make_php(
+  SatSolver& solver,
+  SizeType nh,
+  SizeType np
+)
+{
+  vector<SatLiteral> var_array(nh * np);
+  for ( SizeType i = 0; i < np; ++ i ) {
+    for ( SizeType j = 0; j < nh; ++ j ) {
+      var_array[i * nh + j] = solver.new_variable(true);
+    }
+  }
+  for ( SizeType i = 0; i < np; ++ i ) {
+    vector<SatLiteral> tmp_lits(nh);
+    for ( SizeType j = 0; j < nh; ++ j ) {
+      tmp_lits[j] = var_array[i * nh + j];
+    }
+    solver.add_clause(tmp_lits);
+  }
+  for ( SizeType j = 0; j < nh; ++ j ) {
+    for ( SizeType i1 = 0; i1 < np - 1; ++ i1 ) {
+      for ( SizeType i2 = i1 + 1; i2 < np; ++ i2 ) {
+	solver.add_clause(~var_array[i1 * nh + j], ~var_array[i2 * nh + j]);
+      }
+    }
+  }
+  return var_array;
+}
+
+END_NONAMESPACE
+
+TEST(PortfolioTest, sat)
+{
+  SatSolver solver{SatInitParam{"portfolio"}};
+
+  SizeType nh = 6;
+  auto var_array = make_php(solver, nh, nh);
+  auto res = solver.solve();
+  ASSERT_EQ( SatBool3::True, res );
+
+  // 得られた解が制約を満たしているか調べる．
+  auto& model = solver.model();
+  for ( SizeType j = 0; j < nh; ++ j ) {
+    SizeType n = 0;
+    for ( SizeType i = 0; i < nh; ++ i ) {
+      if ( model[var_array[i * nh + j]] == SatBool3::True ) {
+	++ n;
+      }
+    }
+    EXPECT_EQ( 1, n );
+  }
+
+  auto stats = solver.get_stats();
+  EXPECT_LE( 0, stats.mWinner );
+  EXPECT_GT( 4, stats.mWinner );
+  EXPECT_EQ( nh * nh, stats.mVarNum );
+}
+
+TEST(PortfolioTest, unsat)
+{
+  SatSolver solver{SatInitParam{"portfolio"}};
+
+  make_php(solver, 6, 7);
+  auto res = solver.solve();
+  EXPECT_EQ( SatBool3::False, res );
+
+  auto stats = solver.get_stats();
+  EXPECT_LE( 0, stats.mWinner );
+}
+
+TEST(PortfolioTest, members)
+{
+  auto js_obj = JsonValue::parse("{"
+				 "  'type': 'portfolio',"
+				 "  'members': [ 'minisat2', { 'type': 'ymsat1' } ]"
+				 "}");
+  SatSolver solver{SatInitParam{js_obj}};
+
+  auto lit1 = solver.new_variable(true);
+  auto lit2 = solver.new_variable(true);
+  solver.add_clause(lit1, lit2);
+  solver.add_clause(~lit1, lit2);
+
+  auto res1 = solver.solve({~lit2});
+  EXPECT_EQ( SatBool3::False, res1 );
+  auto& conf_lits = solver.conflict_literals();
+  ASSERT_EQ( 1, conf_lits.size() );
+  EXPECT_EQ( lit2, conf_lits[0] );
+
+  // 一度解いた後でも続けて使える．
+  auto res2 = solver.solve({lit2});
+  EXPECT_EQ( SatBool3::True, res2 );
+  EXPECT_EQ( SatBool3::True, solver.model()[lit2] );
+
+  auto stats = solver.get_stats();
+  EXPECT_LE( 0, stats.mWinner );
+  EXPECT_GT( 2, stats.mWinner );
+}
+
+TEST(PortfolioTest, share)
+{
+  auto js_obj = JsonValue::parse("{"
+				 "  'type': 'portfolio',"
+				 "  'members': [ 'ymsat2', 'ymsat1' ],"
+				 "  'share': { 'size_limit': 10, 'lbd_limit': 6 }"
+				 "}");
+  SatSolver solver{SatInitParam{js_obj}};
+
+  make_php(solver, 7, 8);
+  auto res = solver.solve();
+  EXPECT_EQ( SatBool3::False, res );
+
+  auto stats = solver.get_stats();
+  EXPECT_LT( 0, stats.mExportNum );
+  EXPECT_LE( stats.mImportNum, stats.mExportNum );
+}
+
+TEST(PortfolioTest, share_random)
+{
+  // 学習節を共有しても結果が変わらないことを確かめる．
+  auto js_obj = JsonValue::parse("{"
+				 "  'type': 'portfolio',"
+				 "  'members': [ 'ymsat2', 'ymsat1', 'ymsat' ]"
+				 "}");
+  std::mt19937 rg{1};
+  SizeType nv = 60;
+  SizeType nc = 256;
+  std::uniform_int_distribution<int> var_dist(0, nv - 1);
+  std::uniform_int_distribution<int> pol_dist(0, 1);
+  for ( SizeType c = 0; c < 20; ++ c ) {
+    SatSolver solver1{SatInitParam{js_obj}};
+    SatSolver solver2{SatInitParam{"minisat2"}};
+    vector<SatLiteral> lits1(nv);
+    vector<SatLiteral> lits2(nv);
+    for ( SizeType i = 0; i < nv; ++ i ) {
+      lits1[i] = solver1.new_variable(true);
+      lits2[i] = solver2.new_variable(true);
+    }
+    for ( SizeType i = 0; i < nc; ++ i ) {
+      vector<SatLiteral> tmp1;
+      vector<SatLiteral> tmp2;
+      for ( SizeType j = 0; j < 3; ++ j ) {
+	auto v = var_dist(rg);
+	bool inv = pol_dist(rg);
+	tmp1.push_back(inv ? ~lits1[v] : lits1[v]);
+	tmp2.push_back(inv ? ~lits2[v] : lits2[v]);
+      }
+      solver1.add_clause(tmp1);
+      solver2.add_clause(tmp2);
+    }
+    auto res1 = solver1.solve();
+    auto res2 = solver2.solve();
+    EXPECT_EQ( res2, res1 );
+  }
+}
+
+TEST(PortfolioTest, bad_members)
+{
+  auto js_obj = JsonValue::parse("{"
+				 "  'type': 'portfolio',"
+				 "  'members': [ 'minisat2', 'foo' ]"
+				 "}");
+  EXPECT_THROW( SatSolver solver{SatInitParam{js_obj}}, std::invalid_argument );
+}
+
+END_NAMESPACE_YM
@@ -98,6 +98,7 @@ TEST_P(TimerTest, test2)
 INSTANTIATE_TEST_SUITE_P(SatSolverTest,
 			 TimerTest,
 			 ::testing::Values("minisat", "minisat2", "glueminisat2",
-					   "ymsat1", "ymsat2", "ymsat1_old"));
+					   "ymsat1", "ymsat2", "ymsat1_old",
+					   "portfolio", "cube"));
 
 END_NAMESPACE_YM
@@ -0,0 +1,328 @@
+
+/// @file xor_constraint_test.cc
+/// @brief add_xor_constraint() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "gtest/gtest.h"
+#include "SatTestFixture.h"
+#include "ym/SatModel.h"
+#include "ym/Range.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+class XorConstraintTest :
+  public SatTestFixture
+{
+public:
+
+  /// @brief コンストラクタ
+  XorConstraintTest() : SatTestFixture() { }
+
+  /// @brief デストラクタ
+  ~XorConstraintTest() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ni 変数の XOR 制約のチェックを行う．
+  void
+  check_xor(
+    int ni,
+    bool rhs
+  );
+
+  /// @brief ランダムな XOR 制約と節の組み合わせのチェックを行う．
+  ///
+  /// XOR 制約を節に展開した場合と結果を比較し，
+  /// 充足した場合には全ての制約を満たしているか調べる．
+  void
+  check_random(
+    bool cond
+  );
+
+};
+
+// @brief ni 変数の XOR 制約のチェックを行う．
+void
+XorConstraintTest::check_xor(
+  int ni,
+  bool rhs
+)
+{
+  vector<SatLiteral> lits(mVarList.begin(), mVarList.begin() + ni);
+  mSolver.add_xor_constraint(lits, rhs);
+
+  int np = 1 << ni;
+  vector<int> vals(np);
+  for ( int p: Range(np) ) {
+    bool val = false;
+    for ( int i: Range(ni) ) {
+      if ( p & (1 << i) ) {
+	val = !val;
+      }
+    }
+    vals[p] = val == rhs;
+  }
+  check(ni, vals);
+}
+
+// @brief ランダムな XOR 制約と節の組み合わせのチェックを行う．
+void
+XorConstraintTest::check_random(
+  bool cond
+)
+{
+  const int nv = 40;
+  const int nx = 20;
+  const int nc = 90;
+  std::mt19937 rg;
+  std::uniform_int_distribution<int> var_dist(0, nv - 1);
+  std::uniform_int_distribution<int> size_dist(2, 6);
+  std::uniform_int_distribution<int> bool_dist(0, 1);
+  for ( int c: Range(20) ) {
+    SatSolver solver1{GetParam()};
+    SatSolver solver2{GetParam()};
+    solver2.set_native_xor(false);
+    vector<SatLiteral> var_list1(nv);
+    vector<SatLiteral> var_list2(nv);
+    for ( int i: Range(nv) ) {
+      var_list1[i] = solver1.new_variable(true);
+      var_list2[i] = solver2.new_variable(true);
+    }
+    SatLiteral cond1;
+    SatLiteral cond2;
+    if ( cond ) {
+      cond1 = solver1.new_variable(true);
+      cond2 = solver2.new_variable(true);
+      solver1.set_conditional_literals(cond1);
+      solver2.set_conditional_literals(cond2);
+    }
+    vector<vector<int>> xor_list(nx);
+    vector<bool> rhs_list(nx);
+    for ( int i: Range(nx) ) {
+      int n = size_dist(rg);
+      vector<SatLiteral> lits1;
+      vector<SatLiteral> lits2;
+      for ( int j: Range(n) ) {
+	int var = var_dist(rg);
+	bool inv = bool_dist(rg);
+	xor_list[i].push_back(inv ? - var - 1 : var + 1);
+	lits1.push_back(inv ? ~var_list1[var] : var_list1[var]);
+	lits2.push_back(inv ? ~var_list2[var] : var_list2[var]);
+      }
+      bool rhs = bool_dist(rg);
+      rhs_list[i] = rhs;
+      // 矛盾が判明した後は制約を追加できない．
+      if ( solver1.sane() ) {
+	solver1.add_xor_constraint(lits1, rhs);
+      }
+      if ( solver2.sane() ) {
+	solver2.add_xor_constraint(lits2, rhs);
+      }
+    }
+    vector<vector<int>> clause_list(nc);
+    for ( int i: Range(nc) ) {
+      vector<SatLiteral> lits1;
+      vector<SatLiteral> lits2;
+      for ( int j: Range(3) ) {
+	int var = var_dist(rg);
+	bool inv = bool_dist(rg);
+	clause_list[i].push_back(inv ? - var - 1 : var + 1);
+	lits1.push_back(inv ? ~var_list1[var] : var_list1[var]);
+	lits2.push_back(inv ? ~var_list2[var] : var_list2[var]);
+      }
+      if ( solver1.sane() ) {
+	solver1.add_clause(lits1);
+      }
+      if ( solver2.sane() ) {
+	solver2.add_clause(lits2);
+      }
+    }
+    vector<SatLiteral> assumptions1;
+    vector<SatLiteral> assumptions2;
+    if ( cond ) {
+      assumptions1.push_back(cond1);
+      assumptions2.push_back(cond2);
+    }
+    auto ans1 = solver1.solve(assumptions1);
+    auto ans2 = solver2.solve(assumptions2);
+    EXPECT_EQ( ans2, ans1 ) << "c = " << c;
+    if ( ans1 != SatBool3::True ) {
+      continue;
+    }
+    auto& model = solver1.model();
+    auto lit_val = [&](int l) {
+      auto lit = var_list1[abs(l) - 1];
+      return (model[lit] == SatBool3::True) == (l > 0);
+    };
+    for ( int i: Range(nx) ) {
+      bool val = false;
+      for ( auto l: xor_list[i] ) {
+	if ( lit_val(l) ) {
+	  val = !val;
+	}
+      }
+      EXPECT_EQ( rhs_list[i], val ) << "c = " << c << ", xor #" << i;
+    }
+    for ( int i: Range(nc) ) {
+      bool val = false;
+      for ( auto l: clause_list[i] ) {
+	if ( lit_val(l) ) {
+	  val = true;
+	}
+      }
+      EXPECT_TRUE( val ) << "c = " << c << ", clause #" << i;
+    }
+  }
+}
+
+TEST_P(XorConstraintTest, xor1_1)
+{
+  check_xor(1, true);
+}
+
+TEST_P(XorConstraintTest, xor1_0)
+{
+  check_xor(1, false);
+}
+
+TEST_P(XorConstraintTest, xor2_1)
+{
+  check_xor(2, true);
+}
+
+TEST_P(XorConstraintTest, xor2_0)
+{
+  check_xor(2, false);
+}
+
+TEST_P(XorConstraintTest, xor5_1)
+{
+  check_xor(5, true);
+}
+
+TEST_P(XorConstraintTest, xor5_0)
+{
+  check_xor(5, false);
+}
+
+TEST_P(XorConstraintTest, xor9_1)
+{
+  check_xor(9, true);
+}
+
+TEST_P(XorConstraintTest, xor9_cut4)
+{
+  mSolver.set_xor_cut(4);
+  mSolver.set_native_xor(false);
+  check_xor(9, false);
+}
+
+TEST_P(XorConstraintTest, xor_inv)
+{
+  // ~x0 ^ x1 ^ x2 ^ x1 ^ ~x3 = 1 は x0 ^ x2 ^ x3 = 1 と等しい．
+  auto x0 = mVarList[0];
+  auto x1 = mVarList[1];
+  auto x2 = mVarList[2];
+  auto x3 = mVarList[3];
+  mSolver.add_xor_constraint({~x0, x1, x2, x1, ~x3}, true);
+
+  vector<int> vals(16);
+  for ( int p: Range(16) ) {
+    bool val = static_cast<bool>(p & 1) ^ static_cast<bool>(p & 4) ^ static_cast<bool>(p & 8);
+    vals[p] = val;
+  }
+  check(4, vals);
+}
+
+TEST_P(XorConstraintTest, xor_system)
+{
+  // 複数の XOR 制約の連立
+  const int ni = 8;
+  vector<vector<int>> xor_list{
+    {0, 1, 2},
+    {1, 2, 3, 4},
+    {0, 4, 5},
+    {2, 5, 6, 7},
+    {0, 3, 7}
+  };
+  vector<bool> rhs_list{true, false, true, true, false};
+  for ( int i: Range(xor_list.size()) ) {
+    vector<SatLiteral> lits;
+    for ( auto var: xor_list[i] ) {
+      lits.push_back(mVarList[var]);
+    }
+    mSolver.add_xor_constraint(lits, rhs_list[i]);
+  }
+
+  int np = 1 << ni;
+  vector<int> vals(np);
+  for ( int p: Range(np) ) {
+    int ans = 1;
+    for ( int i: Range(xor_list.size()) ) {
+      bool val = false;
+      for ( auto var: xor_list[i] ) {
+	if ( p & (1 << var) ) {
+	  val = !val;
+	}
+      }
+      if ( val != rhs_list[i] ) {
+	ans = 0;
+	break;
+      }
+    }
+    vals[p] = ans;
+  }
+  check(ni, vals);
+}
+
+TEST_P(XorConstraintTest, xor_unsat)
+{
+  // 3つ目の制約は最初の2つの XOR と矛盾する．
+  auto x0 = mVarList[0];
+  auto x1 = mVarList[1];
+  auto x2 = mVarList[2];
+  mSolver.add_xor_constraint({x0, x1}, true);
+  mSolver.add_xor_constraint({x1, x2}, true);
+  mSolver.add_xor_constraint({x0, x2}, true);
+  EXPECT_EQ( SatBool3::False, mSolver.solve() );
+}
+
+TEST_P(XorConstraintTest, xor_cond)
+{
+  mSolver.set_conditional_literals(mCondVarList[0]);
+  vector<SatLiteral> lits(mVarList.begin(), mVarList.begin() + 4);
+  mSolver.add_xor_constraint(lits, true);
+  mSolver.clear_conditional_literals();
+
+  vector<int> vals(16);
+  for ( int p: Range(16) ) {
+    vals[p] = (p & 1) ^ ((p >> 1) & 1) ^ ((p >> 2) & 1) ^ ((p >> 3) & 1);
+  }
+  check_with_cond1(4, vals);
+}
+
+TEST_P(XorConstraintTest, xor_random)
+{
+  check_random(false);
+}
+
+TEST_P(XorConstraintTest, xor_random_cond)
+{
+  check_random(true);
+}
+
+INSTANTIATE_TEST_SUITE_P(SatSolverTest,
+			 XorConstraintTest,
+			 ::testing::Values("lingeling", "glueminisat2", "minisat2", "minisat",
+					   "ymsat1", "ymsat2", "ymsat1_old"));
+
+END_NAMESPACE_YM
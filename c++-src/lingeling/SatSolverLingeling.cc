@@ -27,6 +27,16 @@ translate(
   return l.is_negative() ? -v : v;
 }
 
+// lingeling から定期的に呼ばれる中断判定関数
+int
+term_func(
+  void* state
+)
+{
+  auto go_on = reinterpret_cast<std::atomic<bool>*>(state);
+  return *go_on ? 0 : 1;
+}
+
 END_NONAMESPACE
 
 //////////////////////////////////////////////////////////////////////
@@ -39,6 +49,7 @@ SatSolverLingeling::SatSolverLingeling(
 ) : mSolver{lglinit()},
     mNumVars{0}
 {
+  lglseterm(mSolver, term_func, reinterpret_cast<void*>(&mGoOn));
 }
 
 // @brief デストラクタ
@@ -73,16 +84,30 @@ SatSolverLingeling::new_variable(
 // @brief 節を追加する．
 void
 SatSolverLingeling::add_clause(
-  const vector<SatLiteral>& lits
+  SizeType n,
+  const SatLiteral* lits
 )
 {
-  for ( auto l: lits ) {
-    int x = translate(l);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    int x = translate(lits[i]);
     lgladd(mSolver, x);
   }
   lgladd(mSolver, 0);
 }
 
+// @brief 決定変数の値を選ぶ時に優先する極性を設定する．
+bool
+SatSolverLingeling::set_phase(
+  SizeType n,
+  const SatLiteral* lits
+)
+{
+  for ( SizeType i = 0; i < n; ++ i ) {
+    lglsetphase(mSolver, translate(lits[i]));
+  }
+  return true;
+}
+
 // @brief SAT 問題を解く．
 SatBool3
 SatSolverLingeling::solve(
@@ -97,6 +122,7 @@ SatSolverLingeling::solve(
   }
 
   lglsetopt(mSolver, "dlim", -1); // 何やってるか不明
+  mGoOn = true;
   int result = lglsat(mSolver);
   if ( result == LGL_SATISFIABLE ) {
     model.resize(mNumVars);
@@ -116,9 +142,11 @@ SatSolverLingeling::solve(
     }
     return SatBool3::True;
   }
-  else {
+  if ( result == LGL_UNSATISFIABLE ) {
     return SatBool3::False;
   }
+  // 中断された．
+  return SatBool3::X;
 }
 
 // @brief 探索を中止する．
@@ -127,7 +155,7 @@ SatSolverLingeling::solve(
 void
 SatSolverLingeling::stop()
 {
-  // not implemented
+  mGoOn = false;
 }
 
 // @brief トータルの矛盾回数の制限を設定する．
@@ -11,6 +11,7 @@
 #include "SatSolverImpl.h"
 #include "lglib.h"
 #include "ym/json.h"
+#include <atomic>
 
 
 BEGIN_NAMESPACE_YM_SAT
@@ -51,10 +52,23 @@ public:
     bool decision ///< [in] 決定変数の時に true とする．
   ) override;
 
+  using SatSolverImpl::add_clause;
+
   /// @brief 節を追加する．
   void
   add_clause(
-    const vector<SatLiteral>& lits ///< [in] リテラルのベクタ
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
+  ) override;
+
+  using SatSolverImpl::set_phase;
+
+  /// @brief 決定変数の値を選ぶ時に優先する極性を設定する．
+  /// @return 常に true を返す．
+  bool
+  set_phase(
+    SizeType n,            ///< [in] リテラル数
+    const SatLiteral* lits ///< [in] リテラルの配列
   ) override;
 
   /// @brief SAT 問題を解く．
@@ -117,6 +131,9 @@ private:
   // 変数の数
   SizeType mNumVars;
 
+  // 実行中フラグ
+  std::atomic<bool> mGoOn{false};
+
 };
 
 END_NAMESPACE_YM_SAT
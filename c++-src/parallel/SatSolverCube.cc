@@ -0,0 +1,576 @@
+
+/// @file SatSolverCube.cc
+/// @brief SatSolverCube の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "SatSolverCube.h"
+#include "SatCore.h"
+#include "ClauseExchange.h"
+#include "ym/SatInitParam.h"
+#include "ym/SatStats.h"
+#include "ym/SatModel.h"
+#include "ym/JsonValue.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// ワーカごとのキューブのキュー
+struct CubeQueue
+{
+  // 排他制御用の mutex
+  std::mutex mMutex;
+
+  // キューブのリスト
+  // 持ち主は末尾から，他のワーカは先頭から取り出す．
+  std::deque<vector<SatLiteral>> mCubeList;
+};
+
+// ワーカの番号 id のキューからキューブを取り出す．
+// 空の場合には他のワーカのキューから盗む．
+bool
+get_cube(
+  vector<CubeQueue>& queue_list,
+  SizeType id,
+  vector<SatLiteral>& cube
+)
+{
+  {
+    auto& queue = queue_list[id];
+    std::lock_guard<std::mutex> lock{queue.mMutex};
+    if ( !queue.mCubeList.empty() ) {
+      cube = std::move(queue.mCubeList.back());
+      queue.mCubeList.pop_back();
+      return true;
+    }
+  }
+  SizeType n = queue_list.size();
+  for ( SizeType i = 1; i < n; ++ i ) {
+    auto& queue = queue_list[(id + i) % n];
+    std::lock_guard<std::mutex> lock{queue.mMutex};
+    if ( !queue.mCubeList.empty() ) {
+      cube = std::move(queue.mCubeList.front());
+      queue.mCubeList.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// SatSolverCube
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SatSolverCube::SatSolverCube(
+  const JsonValue& js_obj
+)
+{
+  JsonValue worker_obj{"ymsat2"};
+  if ( js_obj.has_key("worker") ) {
+    worker_obj = js_obj["worker"];
+  }
+
+  SizeType thread_num = std::thread::hardware_concurrency();
+  if ( js_obj.has_key("threads") ) {
+    auto val = js_obj["threads"].get_int();
+    if ( val <= 0 ) {
+      throw std::invalid_argument{"SatSolverCube: 'threads' should be positive"};
+    }
+    thread_num = val;
+  }
+  if ( thread_num == 0 ) {
+    thread_num = 1;
+  }
+
+  // デフォルトではスレッド数の8倍程度のキューブを作る．
+  mDepth = 3;
+  for ( SizeType n = 1; n < thread_num; n <<= 1 ) {
+    ++ mDepth;
+  }
+  if ( js_obj.has_key("depth") ) {
+    auto val = js_obj["depth"].get_int();
+    if ( val < 0 ) {
+      throw std::invalid_argument{"SatSolverCube: 'depth' should be non-negative"};
+    }
+    mDepth = val;
+  }
+
+  mCandNum = 32;
+  if ( js_obj.has_key("candidates") ) {
+    auto val = js_obj["candidates"].get_int();
+    if ( val <= 0 ) {
+      throw std::invalid_argument{"SatSolverCube: 'candidates' should be positive"};
+    }
+    mCandNum = val;
+  }
+
+  mWorkerList.reserve(thread_num);
+  mCoreList.reserve(thread_num);
+  for ( SizeType i = 0; i < thread_num; ++ i ) {
+    auto impl = SatSolverImpl::new_impl(SatInitParam{worker_obj});
+    auto core = dynamic_cast<SatCore*>(impl.get());
+    if ( core == nullptr ) {
+      throw std::invalid_argument{"SatSolverCube: 'worker' should be a ymsat type"};
+    }
+    mCoreList.push_back(core);
+    mWorkerList.push_back(std::move(impl));
+  }
+
+  bool share = true;
+  if ( js_obj.has_key("share") ) {
+    share = js_obj["share"].get_bool();
+  }
+  if ( share && thread_num > 1 ) {
+    // 学習節に加えて否定されたキューブもこのバッファで配る．
+    mExchange = unique_ptr<ClauseExchange>{new ClauseExchange{}};
+    for ( SizeType i = 0; i < thread_num; ++ i ) {
+      mCoreList[i]->set_clause_exchange(mExchange.get(), i);
+    }
+  }
+}
+
+// @brief デストラクタ
+SatSolverCube::~SatSolverCube()
+{
+}
+
+// @brief 正しい状態のときに true を返す．
+bool
+SatSolverCube::sane() const
+{
+  return mWorkerList.front()->sane();
+}
+
+// @brief 変数を追加する．
+SatLiteral
+SatSolverCube::new_variable(
+  bool decision
+)
+{
+  auto lit = mWorkerList.front()->new_variable(decision);
+  for ( SizeType i = 1; i < mWorkerList.size(); ++ i ) {
+    auto lit1 = mWorkerList[i]->new_variable(decision);
+    ASSERT_COND( lit1 == lit );
+  }
+  mOccurrence.push_back(0);
+  if ( decision ) {
+    mVarOrder.push_back(lit.varid());
+  }
+  return lit;
+}
+
+// @brief 節を追加する．
+void
+SatSolverCube::add_clause(
+  SizeType n,
+  const SatLiteral* lits
+)
+{
+  for ( auto& worker: mWorkerList ) {
+    worker->add_clause(n, lits);
+  }
+  for ( SizeType i = 0; i < n; ++ i ) {
+    ++ mOccurrence[lits[i].varid()];
+  }
+}
+
+// @brief SAT 問題を解く．
+SatBool3
+SatSolverCube::solve(
+  const vector<SatLiteral>& assumptions,
+  SatModel& model,
+  vector<SatLiteral>& conflicts
+)
+{
+  mGoOn = true;
+  mWinner = -1;
+
+  SizeType n = mWorkerList.size();
+  auto& core0 = *mCoreList.front();
+  if ( n == 1 || mDepth == 0 || !core0.sane() ) {
+    // 分割するまでもない．
+    auto ans = mWorkerList.front()->solve(assumptions, model, conflicts);
+    if ( ans != SatBool3::X ) {
+      mWinner = 0;
+    }
+    return ans;
+  }
+
+  // 出現回数の多い変数から先読みを行う．
+  std::stable_sort(mVarOrder.begin(), mVarOrder.end(),
+		   [&](SatVarId a, SatVarId b) {
+		     return mOccurrence[a] > mOccurrence[b];
+		   });
+
+  // assumption を割り当てた状態からキューブを作る．
+  vector<Literal> cube;
+  cube.reserve(assumptions.size() + mDepth);
+  bool ok = true;
+  SizeType level_num = 0;
+  for ( auto l: assumptions ) {
+    auto lit = Literal{l};
+    ++ level_num;
+    if ( !core0.try_assign(lit) ) {
+      ok = false;
+      break;
+    }
+    cube.push_back(lit);
+  }
+  vector<vector<Literal>> cube_list;
+  vector<vector<Literal>> refuted_list;
+  if ( ok ) {
+    make_cubes(core0, cube, mDepth, cube_list, refuted_list);
+  }
+  for ( SizeType i = 0; i < level_num; ++ i ) {
+    core0.cancel_assign();
+  }
+  if ( !ok ) {
+    // assumption 自体が矛盾している場合は通常の solve() に任せる．
+    auto ans = mWorkerList.front()->solve(assumptions, model, conflicts);
+    if ( ans != SatBool3::X ) {
+      mWinner = 0;
+    }
+    return ans;
+  }
+
+  // 否定されたキューブを節として配る．
+  if ( mExchange != nullptr ) {
+    for ( auto& lit_list: refuted_list ) {
+      vector<Literal> tmp_lits;
+      tmp_lits.reserve(lit_list.size());
+      for ( auto lit: lit_list ) {
+	tmp_lits.push_back(~lit);
+      }
+      mExchange->push_clause(n, tmp_lits);
+    }
+  }
+
+  // 否定された assumption の集合
+  // 先読みで否定されたキューブがある場合は全ての assumption を含める．
+  vector<bool> conflict_mark(assumptions.size(), !refuted_list.empty());
+  std::unordered_map<SizeType, SizeType> assumption_map;
+  for ( SizeType i = 0; i < assumptions.size(); ++ i ) {
+    auto lit = Literal{assumptions[i]};
+    assumption_map.emplace((~lit).index(), i);
+  }
+
+  if ( cube_list.empty() ) {
+    // 先読みだけで充足不能が判明した．
+    conflicts.clear();
+    for ( auto lit: assumptions ) {
+      conflicts.push_back(~lit);
+    }
+    return SatBool3::False;
+  }
+
+  // キューブを各ワーカのキューに配る．
+  vector<CubeQueue> queue_list(n);
+  for ( SizeType i = 0; i < cube_list.size(); ++ i ) {
+    auto& src = cube_list[i];
+    vector<SatLiteral> cube1;
+    cube1.reserve(src.size());
+    for ( auto lit: src ) {
+      cube1.push_back(to_satlit(lit));
+    }
+    queue_list[i % n].mCubeList.push_back(std::move(cube1));
+  }
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  vector<bool> done_list(n, false);
+  SizeType done_num = 0;
+  // 結果が確定したら True か False になる．
+  auto result = SatBool3::X;
+  // 途中で打ち切られたキューブがあったら true になる．
+  bool aborted = false;
+  int winner = -1;
+  SatModel model1;
+
+  vector<std::thread> thread_list;
+  thread_list.reserve(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    thread_list.emplace_back([&, i]() {
+      auto& worker = *mWorkerList[i];
+      vector<SatLiteral> cube1;
+      SatModel tmp_model;
+      vector<SatLiteral> tmp_conflicts;
+      vector<Literal> tmp_lits;
+      while ( mGoOn && get_cube(queue_list, i, cube1) ) {
+	tmp_conflicts.clear();
+	auto ans = worker.solve(cube1, tmp_model, tmp_conflicts);
+	std::lock_guard<std::mutex> lock{mtx};
+	if ( result != SatBool3::X ) {
+	  break;
+	}
+	if ( ans == SatBool3::True ) {
+	  result = SatBool3::True;
+	  winner = i;
+	  model1 = std::move(tmp_model);
+	  break;
+	}
+	if ( ans == SatBool3::X ) {
+	  aborted = true;
+	  break;
+	}
+	// このキューブは充足不能
+	if ( tmp_conflicts.empty() ) {
+	  // assumption なしで充足不能
+	  result = SatBool3::False;
+	  winner = i;
+	  for ( SizeType j = 0; j < conflict_mark.size(); ++ j ) {
+	    conflict_mark[j] = false;
+	  }
+	  break;
+	}
+	tmp_lits.clear();
+	for ( auto l: tmp_conflicts ) {
+	  auto lit = Literal{l};
+	  tmp_lits.push_back(lit);
+	  if ( assumption_map.count(lit.index()) > 0 ) {
+	    conflict_mark[assumption_map.at(lit.index())] = true;
+	  }
+	}
+	if ( mExchange != nullptr ) {
+	  // 他のワーカが同じ部分空間を探さないように配る．
+	  mExchange->push_clause(n, tmp_lits);
+	}
+      }
+      std::lock_guard<std::mutex> lock{mtx};
+      done_list[i] = true;
+      ++ done_num;
+      cv.notify_all();
+    });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock{mtx};
+    // 結果が確定するか全員が終わるまで待つ．
+    // stop() はロックを取らないので一定間隔でフラグを見る．
+    while ( result == SatBool3::X && !aborted && done_num < n && mGoOn ) {
+      cv.wait_for(lock, std::chrono::milliseconds{10});
+    }
+    // 残りのワーカを止める．
+    // solve() に入る前のワーカに出した stop() は無視されるので
+    // 全員が終わるまで繰り返す．
+    mGoOn = false;
+    while ( done_num < n ) {
+      for ( SizeType i = 0; i < n; ++ i ) {
+	if ( !done_list[i] ) {
+	  mWorkerList[i]->stop();
+	}
+      }
+      cv.wait_for(lock, std::chrono::milliseconds{1});
+    }
+  }
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+
+  if ( result == SatBool3::X ) {
+    if ( aborted ) {
+      return SatBool3::X;
+    }
+    for ( auto& queue: queue_list ) {
+      if ( !queue.mCubeList.empty() ) {
+	// 中断された．
+	return SatBool3::X;
+      }
+    }
+    // 全てのキューブが充足不能だった．
+    result = SatBool3::False;
+  }
+
+  mWinner = winner;
+  if ( result == SatBool3::True ) {
+    model = std::move(model1);
+  }
+  else {
+    conflicts.clear();
+    for ( SizeType i = 0; i < assumptions.size(); ++ i ) {
+      if ( conflict_mark[i] ) {
+	conflicts.push_back(~assumptions[i]);
+      }
+    }
+  }
+  return result;
+}
+
+// @brief 先読みによってキューブを作る．
+void
+SatSolverCube::make_cubes(
+  SatCore& core,
+  vector<Literal>& cube,
+  SizeType depth,
+  vector<vector<Literal>>& cube_list,
+  vector<vector<Literal>>& refuted_list
+)
+{
+  if ( depth == 0 || !mGoOn ) {
+    cube_list.push_back(cube);
+    return;
+  }
+
+  // 先読みで失敗したリテラル(failed literal)の否定は
+  // 分岐せずにキューブに加える．
+  SizeType fixed_num = 0;
+  auto best_lit = Literal::X;
+  bool refuted = false;
+  for ( bool changed = true; changed; ) {
+    changed = false;
+    best_lit = Literal::X;
+    SizeType best_score = 0;
+    SizeType cand_num = 0;
+    for ( auto var: mVarOrder ) {
+      if ( cand_num >= mCandNum ) {
+	break;
+      }
+      auto plit = Literal::conv_from_varid(var, false);
+      if ( core.eval(plit) != SatBool3::X ) {
+	continue;
+      }
+      ++ cand_num;
+      auto base = core.last_assign();
+      bool pok = core.try_assign(plit);
+      auto np = core.last_assign() - base;
+      core.cancel_assign();
+      auto nlit = ~plit;
+      bool nok = core.try_assign(nlit);
+      auto nn = core.last_assign() - base;
+      core.cancel_assign();
+      if ( !pok && !nok ) {
+	refuted = true;
+	break;
+      }
+      if ( !pok || !nok ) {
+	auto lit = pok ? plit : nlit;
+	core.try_assign(lit);
+	cube.push_back(lit);
+	++ fixed_num;
+	changed = true;
+	break;
+      }
+      // 両方の含意の数が多い変数を選ぶ．
+      SizeType score = (np + 1) * (nn + 1);
+      if ( best_score < score ) {
+	best_score = score;
+	best_lit = np >= nn ? plit : nlit;
+      }
+    }
+  }
+
+  if ( refuted ) {
+    refuted_list.push_back(cube);
+  }
+  else if ( best_lit == Literal::X ) {
+    // 分岐する変数がない．
+    cube_list.push_back(cube);
+  }
+  else {
+    for ( auto lit: {best_lit, ~best_lit} ) {
+      cube.push_back(lit);
+      if ( core.try_assign(lit) ) {
+	make_cubes(core, cube, depth - 1, cube_list, refuted_list);
+      }
+      else {
+	refuted_list.push_back(cube);
+      }
+      core.cancel_assign();
+      cube.pop_back();
+    }
+  }
+
+  for ( SizeType i = 0; i < fixed_num; ++ i ) {
+    core.cancel_assign();
+    cube.pop_back();
+  }
+}
+
+// @brief 探索を中止する．
+void
+SatSolverCube::stop()
+{
+  mGoOn = false;
+  for ( auto& worker: mWorkerList ) {
+    worker->stop();
+  }
+}
+
+// @brief トータルの矛盾回数の制限を設定する．
+SizeType
+SatSolverCube::set_conflict_budget(
+  SizeType val
+)
+{
+  SizeType old_val = 0;
+  for ( auto& worker: mWorkerList ) {
+    old_val = worker->set_conflict_budget(val);
+  }
+  return old_val;
+}
+
+// @brief トータルの implication 回数の制限を設定する．
+SizeType
+SatSolverCube::set_propagation_budget(
+  SizeType val
+)
+{
+  SizeType old_val = 0;
+  for ( auto& worker: mWorkerList ) {
+    old_val = worker->set_propagation_budget(val);
+  }
+  return old_val;
+}
+
+// @brief 現在の内部状態を得る．
+SatStats
+SatSolverCube::get_stats() const
+{
+  SatStats sum_stats;
+  SatStats max_stats;
+  for ( auto& worker: mWorkerList ) {
+    auto stats1 = worker->get_stats();
+    sum_stats += stats1;
+    max_stats.max_assign(stats1);
+  }
+  // 問題の大きさはワーカ間で共通なので和をとらない．
+  sum_stats.mVarNum = max_stats.mVarNum;
+  sum_stats.mConstrClauseNum = max_stats.mConstrClauseNum;
+  sum_stats.mConstrLitNum = max_stats.mConstrLitNum;
+  sum_stats.mWinner = mWinner;
+  return sum_stats;
+}
+
+// @brief solve() 中のリスタートのたびに呼び出されるメッセージハンドラの登録
+void
+SatSolverCube::reg_msg_handler(
+  SatMsgHandler* msg_handler
+)
+{
+  mWorkerList.front()->reg_msg_handler(msg_handler);
+}
+
+// @brief 時間計測機能を制御する
+void
+SatSolverCube::timer_on(
+  bool enable
+)
+{
+  for ( auto& worker: mWorkerList ) {
+    worker->timer_on(enable);
+  }
+}
+
+END_NAMESPACE_YM_SAT
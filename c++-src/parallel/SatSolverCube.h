@@ -0,0 +1,193 @@
+#ifndef SATSOLVERCUBE_H
+#define SATSOLVERCUBE_H
+
+/// @file SatSolverCube.h
+/// @brief SatSolverCube のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "SatSolverImpl.h"
+#include "Literal.h"
+#include "ym/json.h"
+#include <atomic>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+class SatCore;
+class ClauseExchange;
+
+//////////////////////////////////////////////////////////////////////
+/// @class SatSolverCube SatSolverCube.h "SatSolverCube.h"
+/// @brief cube-and-conquer 方式の並列 SAT ソルバ
+///
+/// "threads" 個の ymsat 系ソルバ(ワーカ)に同一の変数と節を与えておき，
+/// solve() では以下の処理を行う．
+/// 1. 先頭のワーカを用いた先読み(lookahead)で問題を "depth" 段の
+///    キューブ(リテラルの積)に分割する．
+/// 2. キューブを各ワーカのキューに配り，各ワーカは自分のキューが
+///    空になったら他のワーカのキューから盗んで(work stealing)
+///    assumption 付きの solve() で解く．
+/// 3. 充足するキューブが見つかったらその時点で終了する．
+///    否定されたキューブは学習節として他のワーカと共有する．
+///
+/// ワーカの種類は "worker" で指定する(デフォルトは ymsat2)．
+//////////////////////////////////////////////////////////////////////
+class SatSolverCube :
+  public SatSolverImpl
+{
+public:
+
+  /// @brief コンストラクタ
+  SatSolverCube(
+    const JsonValue& js_obj ///< [in] 初期化パラメータ
+  );
+
+  /// @brief デストラクタ
+  ~SatSolverCube();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // SatSolver で定義されている仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 正しい状態のときに true を返す．
+  bool
+  sane() const override;
+
+  /// @brief 変数を追加する．
+  /// @return 新しい変数番号を返す．
+  ///
+  /// 変数番号は 0 から始まる．
+  SatLiteral
+  new_variable(
+    bool decision ///< [in] 決定変数の時に true とする．
+  ) override;
+
+  using SatSolverImpl::add_clause;
+
+  /// @brief 節を追加する．
+  void
+  add_clause(
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
+  ) override;
+
+  /// @brief SAT 問題を解く．
+  /// @retval SatBool3::True 充足した．
+  /// @retval SatBool3::False 充足不能が判明した．
+  /// @retval SatBool3::X わからなかった．
+  /// @note i 番めの変数の割り当て結果は model[i] に入る．
+  SatBool3
+  solve(
+    const vector<SatLiteral>& assumptions, ///< [in] あらかじめ仮定する変数の値割り当てリスト
+    SatModel& model,                       ///< [out] 充足するときの値の割り当てを格納する配列．
+    vector<SatLiteral>& conflicts          ///< [out] 充足不能の場合に原因となっている仮定を入れる配列．
+  ) override;
+
+  /// @brief 探索を中止する．
+  ///
+  /// 割り込みハンドラや別スレッドから非同期に呼ばれることを仮定している．
+  void
+  stop() override;
+
+  /// @brief 現在の内部状態を得る．
+  SatStats
+  get_stats() const override;
+
+  /// @brief トータルの矛盾回数の制限を設定する．
+  /// @return 以前の設定値を返す．
+  SizeType
+  set_conflict_budget(
+    SizeType val ///< [in] 設定する値
+  ) override;
+
+  /// @brief トータルの implication 回数の制限を設定する．
+  /// @return 以前の設定値を返す．
+  SizeType
+  set_propagation_budget(
+    SizeType val ///< [in] 設定する値
+  ) override;
+
+  /// @brief solve() 中のリスタートのたびに呼び出されるメッセージハンドラの登録
+  void
+  reg_msg_handler(
+    SatMsgHandler* msg_handler ///< [in] 登録するメッセージハンドラ
+  ) override;
+
+  /// @brief 時間計測機能を制御する
+  void
+  timer_on(
+    bool enable
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 先読みによってキューブを作る．
+  ///
+  /// cube には現在のパス(assumption を含む)が入っている．
+  void
+  make_cubes(
+    SatCore& core,                         ///< [in] 先読みに用いるソルバ
+    vector<Literal>& cube,                 ///< [inout] 現在のキューブ
+    SizeType depth,                        ///< [in] 残りの分割の深さ
+    vector<vector<Literal>>& cube_list,    ///< [out] 生成されたキューブのリスト
+    vector<vector<Literal>>& refuted_list  ///< [out] 先読みで否定されたキューブのリスト
+  );
+
+  /// @brief Literal を SatLiteral に変換する．
+  static
+  SatLiteral
+  to_satlit(
+    Literal lit
+  )
+  {
+    return get_lit(lit.varid(), lit.is_negative());
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ワーカのリスト
+  vector<unique_ptr<SatSolverImpl>> mWorkerList;
+
+  // ワーカを SatCore として見たもの
+  vector<SatCore*> mCoreList;
+
+  // 学習節の共有用のバッファ
+  unique_ptr<ClauseExchange> mExchange;
+
+  // キューブの深さ
+  SizeType mDepth;
+
+  // 1つの分岐で先読みを行う変数の数
+  SizeType mCandNum;
+
+  // 変数ごとの出現回数
+  vector<SizeType> mOccurrence;
+
+  // 出現回数の多い順に並べた変数のリスト
+  // make_cubes() の中で用いる．
+  vector<SatVarId> mVarOrder;
+
+  // 直前の solve() で充足解を見つけたワーカの番号
+  int mWinner{-1};
+
+  // 実行中フラグ
+  std::atomic<bool> mGoOn{false};
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // SATSOLVERCUBE_H
@@ -0,0 +1,318 @@
+
+/// @file SatSolverPortfolio.cc
+/// @brief SatSolverPortfolio の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "SatSolverPortfolio.h"
+#include "SatCore.h"
+#include "ClauseExchange.h"
+#include "ym/SatInitParam.h"
+#include "ym/SatStats.h"
+#include "ym/SatModel.h"
+#include "ym/JsonValue.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+// SatSolverPortfolio
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SatSolverPortfolio::SatSolverPortfolio(
+  const JsonValue& js_obj
+)
+{
+  vector<JsonValue> member_list;
+  if ( js_obj.has_key("members") ) {
+    auto members_obj = js_obj["members"];
+    if ( !members_obj.is_array() ) {
+      throw std::invalid_argument{"SatSolverPortfolio: 'members' should be an array"};
+    }
+    for ( SizeType i = 0; i < members_obj.size(); ++ i ) {
+      member_list.push_back(members_obj.at(i));
+    }
+  }
+  else {
+    member_list = {
+      JsonValue{"ymsat2"},
+      JsonValue{"ymsat1"},
+      JsonValue{"minisat2"},
+      JsonValue{"glueminisat2"}
+    };
+  }
+  if ( member_list.empty() ) {
+    throw std::invalid_argument{"SatSolverPortfolio: 'members' is empty"};
+  }
+  mMemberList.reserve(member_list.size());
+  for ( auto& member_obj: member_list ) {
+    auto impl = SatSolverImpl::new_impl(SatInitParam{member_obj});
+    mMemberList.push_back(std::move(impl));
+  }
+
+  // 学習節の共有の設定
+  bool share = true;
+  SizeType size_limit = 8;
+  SizeType lbd_limit = 4;
+  SizeType capacity = 4096;
+  if ( js_obj.has_key("share") ) {
+    auto share_obj = js_obj["share"];
+    if ( share_obj.is_bool() ) {
+      share = share_obj.get_bool();
+    }
+    else if ( share_obj.is_object() ) {
+      if ( share_obj.has_key("size_limit") ) {
+	size_limit = share_obj["size_limit"].get_int();
+      }
+      if ( share_obj.has_key("lbd_limit") ) {
+	lbd_limit = share_obj["lbd_limit"].get_int();
+      }
+      if ( share_obj.has_key("capacity") ) {
+	capacity = share_obj["capacity"].get_int();
+      }
+    }
+    else {
+      throw std::invalid_argument{"SatSolverPortfolio: 'share' should be a bool or an object"};
+    }
+  }
+  if ( share ) {
+    // 共有できるのは SatCore 同士だけ
+    vector<SatCore*> core_list;
+    for ( auto& member: mMemberList ) {
+      auto core = dynamic_cast<SatCore*>(member.get());
+      if ( core != nullptr ) {
+	core_list.push_back(core);
+      }
+    }
+    if ( core_list.size() >= 2 ) {
+      mExchange = unique_ptr<ClauseExchange>{new ClauseExchange{size_limit, lbd_limit, capacity}};
+      for ( SizeType i = 0; i < core_list.size(); ++ i ) {
+	core_list[i]->set_clause_exchange(mExchange.get(), i);
+      }
+    }
+  }
+}
+
+// @brief デストラクタ
+SatSolverPortfolio::~SatSolverPortfolio()
+{
+}
+
+// @brief 正しい状態のときに true を返す．
+bool
+SatSolverPortfolio::sane() const
+{
+  for ( auto& member: mMemberList ) {
+    if ( !member->sane() ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief 変数を追加する．
+SatLiteral
+SatSolverPortfolio::new_variable(
+  bool decision
+)
+{
+  auto lit = mMemberList.front()->new_variable(decision);
+  for ( SizeType i = 1; i < mMemberList.size(); ++ i ) {
+    auto lit1 = mMemberList[i]->new_variable(decision);
+    ASSERT_COND( lit1 == lit );
+  }
+  return lit;
+}
+
+// @brief 節を追加する．
+void
+SatSolverPortfolio::add_clause(
+  SizeType n,
+  const SatLiteral* lits
+)
+{
+  for ( auto& member: mMemberList ) {
+    member->add_clause(n, lits);
+  }
+}
+
+// @brief 複数の節をまとめて追加する．
+void
+SatSolverPortfolio::add_clauses(
+  SizeType clause_num,
+  const SatLiteral* lits,
+  const SizeType* begin_list
+)
+{
+  for ( auto& member: mMemberList ) {
+    member->add_clauses(clause_num, lits, begin_list);
+  }
+}
+
+// @brief SAT 問題を解く．
+SatBool3
+SatSolverPortfolio::solve(
+  const vector<SatLiteral>& assumptions,
+  SatModel& model,
+  vector<SatLiteral>& conflicts
+)
+{
+  mGoOn = true;
+  mWinner = -1;
+
+  SizeType n = mMemberList.size();
+  if ( n == 1 ) {
+    // スレッドを起こすまでもない．
+    auto ans = mMemberList.front()->solve(assumptions, model, conflicts);
+    if ( ans != SatBool3::X ) {
+      mWinner = 0;
+    }
+    return ans;
+  }
+
+  // 各スレッドの結果
+  vector<SatBool3> ans_list(n, SatBool3::X);
+  vector<SatModel> model_list(n);
+  vector<vector<SatLiteral>> conflicts_list(n);
+  vector<bool> done_list(n, false);
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  SizeType done_num = 0;
+  int winner = -1;
+
+  vector<std::thread> thread_list;
+  thread_list.reserve(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    thread_list.emplace_back([&, i]() {
+      auto ans = mMemberList[i]->solve(assumptions, model_list[i], conflicts_list[i]);
+      std::lock_guard<std::mutex> lock{mtx};
+      ans_list[i] = ans;
+      done_list[i] = true;
+      ++ done_num;
+      if ( ans != SatBool3::X && winner == -1 ) {
+	winner = i;
+      }
+      cv.notify_all();
+    });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock{mtx};
+    // 最初の答えが出るまで待つ．
+    // stop() はロックを取らないので一定間隔でフラグを見る．
+    while ( winner == -1 && done_num < n && mGoOn ) {
+      cv.wait_for(lock, std::chrono::milliseconds{10});
+    }
+    // 残りのメンバを止める．
+    // solve() に入る前のメンバに出した stop() は無視されるので
+    // 全員が終わるまで繰り返す．
+    while ( done_num < n ) {
+      for ( SizeType i = 0; i < n; ++ i ) {
+	if ( !done_list[i] ) {
+	  mMemberList[i]->stop();
+	}
+      }
+      cv.wait_for(lock, std::chrono::milliseconds{1});
+    }
+  }
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+
+  mWinner = winner;
+  if ( winner == -1 ) {
+    return SatBool3::X;
+  }
+  auto ans = ans_list[winner];
+  if ( ans == SatBool3::True ) {
+    model = std::move(model_list[winner]);
+  }
+  else {
+    conflicts = std::move(conflicts_list[winner]);
+  }
+  return ans;
+}
+
+// @brief 探索を中止する．
+void
+SatSolverPortfolio::stop()
+{
+  mGoOn = false;
+  for ( auto& member: mMemberList ) {
+    member->stop();
+  }
+}
+
+// @brief トータルの矛盾回数の制限を設定する．
+SizeType
+SatSolverPortfolio::set_conflict_budget(
+  SizeType val
+)
+{
+  SizeType old_val = 0;
+  for ( auto& member: mMemberList ) {
+    old_val = member->set_conflict_budget(val);
+  }
+  return old_val;
+}
+
+// @brief トータルの implication 回数の制限を設定する．
+SizeType
+SatSolverPortfolio::set_propagation_budget(
+  SizeType val
+)
+{
+  SizeType old_val = 0;
+  for ( auto& member: mMemberList ) {
+    old_val = member->set_propagation_budget(val);
+  }
+  return old_val;
+}
+
+// @brief 現在の内部状態を得る．
+SatStats
+SatSolverPortfolio::get_stats() const
+{
+  SatStats sum_stats;
+  SatStats max_stats;
+  for ( auto& member: mMemberList ) {
+    auto stats1 = member->get_stats();
+    sum_stats += stats1;
+    max_stats.max_assign(stats1);
+  }
+  // 問題の大きさはメンバ間で共通なので和をとらない．
+  sum_stats.mVarNum = max_stats.mVarNum;
+  sum_stats.mConstrClauseNum = max_stats.mConstrClauseNum;
+  sum_stats.mConstrLitNum = max_stats.mConstrLitNum;
+  sum_stats.mWinner = mWinner;
+  return sum_stats;
+}
+
+// @brief solve() 中のリスタートのたびに呼び出されるメッセージハンドラの登録
+void
+SatSolverPortfolio::reg_msg_handler(
+  SatMsgHandler* msg_handler
+)
+{
+  mMemberList.front()->reg_msg_handler(msg_handler);
+}
+
+// @brief 時間計測機能を制御する
+void
+SatSolverPortfolio::timer_on(
+  bool enable
+)
+{
+  for ( auto& member: mMemberList ) {
+    member->timer_on(enable);
+  }
+}
+
+END_NAMESPACE_YM_SAT
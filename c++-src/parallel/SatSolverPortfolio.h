@@ -0,0 +1,161 @@
+#ifndef SATSOLVERPORTFOLIO_H
+#define SATSOLVERPORTFOLIO_H
+
+/// @file SatSolverPortfolio.h
+/// @brief SatSolverPortfolio のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "SatSolverImpl.h"
+#include "ym/json.h"
+#include <atomic>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+class ClauseExchange;
+
+//////////////////////////////////////////////////////////////////////
+/// @class SatSolverPortfolio SatSolverPortfolio.h "SatSolverPortfolio.h"
+/// @brief 複数の SAT ソルバを並列に走らせるポートフォリオ型のソルバ
+///
+/// 初期化パラメータの "members" に指定された個々のソルバに同一の
+/// 変数と節を与え，solve() ではそれぞれを別スレッドで実行する．
+/// 最初に確定した答え(True/False)を返したソルバの結果を採用し，
+/// 残りのソルバは stop() で中断させる．
+/// "members" の要素はタイプを表す文字列か SatInitParam と同形式の
+/// オブジェクトで，省略時は ymsat2, ymsat1, minisat2, glueminisat2
+/// の4つを用いる．
+///
+/// "share" が true (デフォルト)の場合，ymsat 系のメンバ間で
+/// 学習節の共有を行う．"share" にオブジェクトを与えた場合は
+/// "size_limit", "lbd_limit", "capacity" で共有の条件を指定できる．
+//////////////////////////////////////////////////////////////////////
+class SatSolverPortfolio :
+  public SatSolverImpl
+{
+public:
+
+  /// @brief コンストラクタ
+  SatSolverPortfolio(
+    const JsonValue& js_obj ///< [in] 初期化パラメータ
+  );
+
+  /// @brief デストラクタ
+  ~SatSolverPortfolio();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // SatSolver で定義されている仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 正しい状態のときに true を返す．
+  bool
+  sane() const override;
+
+  /// @brief 変数を追加する．
+  /// @return 新しい変数番号を返す．
+  ///
+  /// 変数番号は 0 から始まる．
+  SatLiteral
+  new_variable(
+    bool decision ///< [in] 決定変数の時に true とする．
+  ) override;
+
+  using SatSolverImpl::add_clause;
+
+  /// @brief 節を追加する．
+  void
+  add_clause(
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
+  ) override;
+
+  /// @brief 複数の節をまとめて追加する．
+  void
+  add_clauses(
+    SizeType clause_num,       ///< [in] 節の数
+    const SatLiteral* lits,    ///< [in] 全ての節のリテラルの配列
+    const SizeType* begin_list ///< [in] 各節の開始位置の配列
+  ) override;
+
+  /// @brief SAT 問題を解く．
+  /// @retval SatBool3::True 充足した．
+  /// @retval SatBool3::False 充足不能が判明した．
+  /// @retval SatBool3::X わからなかった．
+  /// @note i 番めの変数の割り当て結果は model[i] に入る．
+  SatBool3
+  solve(
+    const vector<SatLiteral>& assumptions, ///< [in] あらかじめ仮定する変数の値割り当てリスト
+    SatModel& model,                       ///< [out] 充足するときの値の割り当てを格納する配列．
+    vector<SatLiteral>& conflicts          ///< [out] 充足不能の場合に原因となっている仮定を入れる配列．
+  ) override;
+
+  /// @brief 探索を中止する．
+  ///
+  /// 割り込みハンドラや別スレッドから非同期に呼ばれることを仮定している．
+  void
+  stop() override;
+
+  /// @brief 現在の内部状態を得る．
+  ///
+  /// 探索量に関する値は全メンバの和，問題の大きさに関する値は
+  /// 最大値となる．mWinner には直前の solve() で採用された
+  /// メンバの番号が入る．
+  SatStats
+  get_stats() const override;
+
+  /// @brief トータルの矛盾回数の制限を設定する．
+  /// @return 以前の設定値を返す．
+  SizeType
+  set_conflict_budget(
+    SizeType val ///< [in] 設定する値
+  ) override;
+
+  /// @brief トータルの implication 回数の制限を設定する．
+  /// @return 以前の設定値を返す．
+  SizeType
+  set_propagation_budget(
+    SizeType val ///< [in] 設定する値
+  ) override;
+
+  /// @brief solve() 中のリスタートのたびに呼び出されるメッセージハンドラの登録
+  ///
+  /// 出力が混ざらないように先頭のメンバにのみ登録する．
+  void
+  reg_msg_handler(
+    SatMsgHandler* msg_handler ///< [in] 登録するメッセージハンドラ
+  ) override;
+
+  /// @brief 時間計測機能を制御する
+  void
+  timer_on(
+    bool enable
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // メンバのソルバのリスト
+  vector<unique_ptr<SatSolverImpl>> mMemberList;
+
+  // 学習節の共有用のバッファ
+  unique_ptr<ClauseExchange> mExchange;
+
+  // 直前の solve() で採用されたメンバの番号
+  int mWinner{-1};
+
+  // 実行中フラグ
+  std::atomic<bool> mGoOn{false};
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // SATSOLVERPORTFOLIO_H
@@ -0,0 +1,138 @@
+
+/// @file ClauseExchange.cc
+/// @brief ClauseExchange の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ClauseExchange.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+// クラス ClauseExchange
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+ClauseExchange::ClauseExchange(
+  SizeType size_limit,
+  SizeType lbd_limit,
+  SizeType capacity
+) : mSizeLimit{std::min(size_limit, MAX_LIT_NUM)},
+    mLbdLimit{lbd_limit}
+{
+  SizeType size = 1;
+  while ( size < capacity ) {
+    size <<= 1;
+  }
+  mMask = size - 1;
+  mSlots = unique_ptr<Slot[]>{new Slot[size]};
+}
+
+// @brief 節を書き込む．
+void
+ClauseExchange::push_clause(
+  SizeType producer_id,
+  const vector<Literal>& lit_list
+)
+{
+  SizeType n = lit_list.size();
+  if ( n == 0 || n > MAX_LIT_NUM ) {
+    return;
+  }
+
+  auto pos = mWritePos.fetch_add(1, std::memory_order_relaxed);
+  auto& slot = mSlots[pos & mMask];
+  // スロットを確保する．
+  // 他の書き込み中か，すでに新しい節が書き込まれている場合には
+  // 周回遅れになっているのでこの節は捨てる．
+  auto seq = slot.mSeq.load(std::memory_order_relaxed);
+  do {
+    if ( seq == BUSY || seq > pos ) {
+      return;
+    }
+  } while ( !slot.mSeq.compare_exchange_weak(seq, BUSY,
+					     std::memory_order_acquire,
+					     std::memory_order_relaxed) );
+  std::atomic_thread_fence(std::memory_order_release);
+  auto header = static_cast<std::uint32_t>((producer_id << 8) | n);
+  slot.mHeader.store(header, std::memory_order_relaxed);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto index = static_cast<std::uint32_t>(lit_list[i].index());
+    slot.mLits[i].store(index, std::memory_order_relaxed);
+  }
+  slot.mSeq.store(pos + 1, std::memory_order_release);
+}
+
+// @brief 新しく書き込まれた節を読み出す．
+void
+ClauseExchange::pull_clauses(
+  SizeType consumer_id,
+  std::uint64_t& read_pos,
+  vector<vector<Literal>>& clause_list
+) const
+{
+  auto write_pos = mWritePos.load(std::memory_order_acquire);
+  auto capacity = mMask + 1;
+  if ( write_pos > read_pos + capacity ) {
+    // 読み出しが追いつかなかった分は捨てる．
+    read_pos = write_pos - capacity;
+  }
+
+  vector<Literal> lit_list;
+  lit_list.reserve(MAX_LIT_NUM);
+  for ( ; read_pos < write_pos; ++ read_pos ) {
+    auto& slot = mSlots[read_pos & mMask];
+    auto seq1 = slot.mSeq.load(std::memory_order_acquire);
+    if ( seq1 != read_pos + 1 ) {
+      if ( seq1 == BUSY || seq1 < read_pos + 1 ) {
+	// まだ書き込みが終わっていない．
+	// 次回はここから読む．
+	break;
+      }
+      // すでに上書きされている．
+      continue;
+    }
+    auto header = slot.mHeader.load(std::memory_order_relaxed);
+    SizeType n = header & 0xFFU;
+    SizeType producer_id = header >> 8;
+    lit_list.clear();
+    for ( SizeType i = 0; i < n && i < MAX_LIT_NUM; ++ i ) {
+      auto index = slot.mLits[i].load(std::memory_order_relaxed);
+      lit_list.push_back(Literal::index2literal(index));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    auto seq2 = slot.mSeq.load(std::memory_order_relaxed);
+    if ( seq2 != seq1 ) {
+      // 読んでいる間に上書きされた．
+      continue;
+    }
+    if ( producer_id == consumer_id ) {
+      continue;
+    }
+    clause_list.push_back(lit_list);
+  }
+}
+
+// @brief リテラルのリストのハッシュ値を求める．
+std::uint64_t
+ClauseExchange::hash(
+  const vector<Literal>& lit_list
+)
+{
+  // 順序に依存しないように各リテラルのハッシュの和と積をとる．
+  std::uint64_t sum = 0;
+  std::uint64_t prod = 1;
+  for ( auto lit: lit_list ) {
+    std::uint64_t x = lit.index() + 1;
+    x *= 0x9E3779B97F4A7C15ULL;
+    x ^= x >> 29;
+    sum += x;
+    prod *= (x | 1);
+  }
+  return sum ^ (prod * 0xC2B2AE3D27D4EB4FULL) ^ lit_list.size();
+}
+
+END_NAMESPACE_YM_SAT
@@ -11,6 +11,7 @@
 #include "Analyzer.h"
 #include "Selecter.h"
 #include "Clause.h"
+#include "ClauseExchange.h"
 #include "ym/SatStats.h"
 #include "ym/SatModel.h"
 #include "ym/SatMsgHandler.h"
@@ -23,6 +24,13 @@ BEGIN_NAMESPACE_YM_SAT
 
 const Literal Literal::X;
 
+BEGIN_NONAMESPACE
+
+// Gauss-Jordan 消去後の行を含意に用いる時の変数の数の上限
+const SizeType XOR_ROW_LIMIT = 2;
+
+END_NONAMESPACE
+
 //////////////////////////////////////////////////////////////////////
 // SatCore
 //////////////////////////////////////////////////////////////////////
@@ -42,6 +50,9 @@ SatCore::SatCore(
 
   // place-holder なので中身はダミー
   mTmpBinClause = Clause::new_clause({Literal::X, Literal::X});
+
+  // 印として用いるだけなので中身はダミー
+  mPbReason = Reason{Clause::new_clause({Literal::X, Literal::X})};
 }
 
 // @brief デストラクタ
@@ -53,7 +64,13 @@ SatCore::~SatCore()
   for ( auto c: mLearntClauseList ) {
     Clause::delete_clause(c);
   }
+  for ( auto& clause_list: mTmpReasonList ) {
+    for ( auto c: clause_list ) {
+      Clause::delete_clause(c);
+    }
+  }
   Clause::delete_clause(mTmpBinClause);
+  Clause::delete_clause(mPbReason.clause());
 }
 
 // @brief 変数を追加する．
@@ -87,6 +104,7 @@ SatCore::alloc_var()
     expand_var();
     for ( SizeType var: Range(mOldVarNum, mVarNum) ) {
       mVal[var] = conv_from_Bool3(SatBool3::X) | (conv_from_Bool3(SatBool3::X) << 2);
+      mPhase[var] = SatBool3::X;
       if ( is_decision_variable(var) ) {
 	mVarHeap.add_var(var);
       }
@@ -95,14 +113,93 @@ SatCore::alloc_var()
   }
 }
 
+// @brief 変数と節をすべて削除して生成直後の状態に戻す．
+bool
+SatCore::reset()
+{
+  if ( decision_level() > 0 ) {
+    backtrack(0);
+  }
+
+  for ( auto c: mConstrClauseList ) {
+    Clause::delete_clause(c);
+  }
+  for ( auto c: mLearntClauseList ) {
+    Clause::delete_clause(c);
+  }
+  mConstrClauseList.clear();
+  mConstrBinList.clear();
+  mConstrUnitList.clear();
+  mLearntClauseList.clear();
+  mConstrClauseNum = 0;
+  mConstrLitNum = 0;
+  mLearntBinNum = 0;
+  mLearntLitNum = 0;
+
+  // 決定レベル 0 で作られた理由の節が残っている．
+  for ( auto& clause_list: mTmpReasonList ) {
+    for ( auto c: clause_list ) {
+      Clause::delete_clause(c);
+    }
+  }
+  mTmpReasonList.clear();
+  mXorMatrix.clear();
+  mXorDirty = false;
+  mXorConstrList.clear();
+  mXorRowList.clear();
+  mXorWatchList.clear();
+  mPbConstrList.clear();
+  mPbWatchList.clear();
+  mPbReasonList.clear();
+
+  // 使用していた部分の watcher list だけクリアすればよい．
+  for ( SizeType i = 0; i < mOldVarNum * 2; ++ i ) {
+    mWatcherList[i].clear();
+  }
+  mDvarArray.clear();
+  mDvarNum = 0;
+  mVarNum = 0;
+  mOldVarNum = 0;
+  mAssignList.clear();
+  mVarHeap.reset();
+
+  mSane = true;
+  mAssumptions.clear();
+  mConflicts.clear();
+  mClauseBump = 1.0;
+  mClauseDecay = 1.0;
+  mSweep_assigns = -1;
+  mSweep_props = 0;
+
+  mRestartNum = 0;
+  mConflictNum = 0;
+  mDecisionNum = 0;
+  mPropagationNum = 0;
+  mConflictLimit = 0;
+  mLearntLimit = 0;
+  mConflictBudget = 0;
+  mPropagationBudget = 0;
+  mAccTime = Duration{0};
+
+  mExchange = nullptr;
+  mWorkerId = 0;
+  mExchangeReadPos = 0;
+  mSharedHashSet.clear();
+  mImportNum = 0;
+  mExportNum = 0;
+
+  return true;
+}
+
 // 変数に関する配列を拡張する．
 void
 SatCore::expand_var()
 {
   // 新しいサイズを計算する．
+  // 小さな問題を大量に解く場合のために初期サイズは小さめにしておく．
   auto size = mVal.size();
   if ( size == 0 ) {
-    size = 1024;
+    size = 64;
   }
   while ( size < mVarNum ) {
     size <<= 1;
@@ -110,6 +207,7 @@ SatCore::expand_var()
 
   // 新しい配列を確保する．
   mVal.resize(size);
+  mPhase.resize(size, SatBool3::X);
   mDecisionLevel.resize(size);
   mReason.resize(size, Reason::None);
   mWatcherList.resize(size * 2);
@@ -117,10 +215,55 @@ SatCore::expand_var()
   mAssignList.reserve(size);
 }
 
+// @brief 制約節を列挙する．
+bool
+SatCore::enum_clauses(
+  const std::function<void(const vector<SatLiteral>&)>& func
+) const
+{
+  vector<SatLiteral> tmp_lits;
+  if ( !mSane ) {
+    // 充足不能なら空節を出力する．
+    func(tmp_lits);
+    return true;
+  }
+
+  auto conv = [](Literal lit) {
+    return get_lit(lit.varid(), lit.is_negative());
+  };
+
+  // 割り当てリストの先頭部分が決定レベル 0 の割り当て
+  for ( SizeType pos = 0; pos < mAssignList.size(); ++ pos ) {
+    auto lit = mAssignList.get(pos);
+    if ( decision_level(lit.varid()) > 0 ) {
+      break;
+    }
+    tmp_lits.clear();
+    tmp_lits.push_back(conv(lit));
+    func(tmp_lits);
+  }
+  for ( auto& bin: mConstrBinList ) {
+    tmp_lits.clear();
+    tmp_lits.push_back(conv(bin.mLit0));
+    tmp_lits.push_back(conv(bin.mLit1));
+    func(tmp_lits);
+  }
+  for ( auto c: mConstrClauseList ) {
+    tmp_lits.clear();
+    SizeType nl = c->lit_num();
+    for ( SizeType i = 0; i < nl; ++ i ) {
+      tmp_lits.push_back(conv(c->lit(i)));
+    }
+    func(tmp_lits);
+  }
+  return true;
+}
+
 // @brief 節を追加する．
 void
 SatCore::add_clause(
-  const vector<SatLiteral>& lits
+  SizeType n,
+  const SatLiteral* lits
 )
 {
   if ( decision_level() != 0 ) {
@@ -133,10 +276,11 @@ SatCore::add_clause(
   }
 
   // lits の内容を変更するので作業用のコピーを作る．
-  vector<Literal> tmp_lits;
-  tmp_lits.reserve(lits.size());
-  for ( auto lit: lits ) {
-    auto l = Literal{lit};
+  // 節ごとの確保を避けるためにメンバの領域を使い回す．
+  auto& tmp_lits = mTmpLits;
+  tmp_lits.clear();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto l = Literal{lits[i]};
     tmp_lits.push_back(l);
   }
 
@@ -350,6 +494,213 @@ SatCore::add_learnt_clause(
   assign(l0, reason);
 }
 
+// @brief XOR 制約を追加する．
+bool
+SatCore::add_xor_constraint(
+  SizeType n,
+  const SatLiteral* lits,
+  bool rhs
+)
+{
+  if ( decision_level() != 0 ) {
+    // エラー
+    throw std::runtime_error{"decision_level() != 0"};
+  }
+
+  if ( !sane() ) {
+    throw std::runtime_error{"mSane == false"};
+  }
+
+  // 変数用のデータ構造の確保
+  alloc_var();
+
+  // 否定のリテラルと値の確定している変数は右辺に反映させる．
+  auto& var_list = mXorVars;
+  var_list.clear();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto l = Literal{lits[i]};
+    auto var = l.varid();
+    if ( var >= mVarNum ) {
+      ostringstream buf;
+      buf << "literal(" << l << "): out of range";
+      throw std::runtime_error{buf.str()};
+    }
+    if ( l.is_negative() ) {
+      rhs = !rhs;
+    }
+    auto v = eval(var);
+    if ( v == SatBool3::True ) {
+      rhs = !rhs;
+    }
+    else if ( v == SatBool3::X ) {
+      var_list.push_back(var);
+    }
+  }
+
+  // 同じ変数は2つずつ打ち消し合う．
+  sort(var_list.begin(), var_list.end());
+  SizeType nv = var_list.size();
+  SizeType wpos = 0;
+  for ( SizeType rpos = 0; rpos < nv; ++ rpos ) {
+    auto var = var_list[rpos];
+    if ( wpos > 0 && var_list[wpos - 1] == var ) {
+      -- wpos;
+      continue;
+    }
+    var_list[wpos] = var;
+    ++ wpos;
+  }
+  var_list.erase(var_list.begin() + wpos, var_list.end());
+
+  if ( mXorMatrix.add_row(var_list, rhs) ) {
+    // 含意には元の(疎な)制約を用いる．
+    // 監視の設定は xor_setup() でまとめて行う．
+    mXorConstrList.push_back(XorRow{var_list, rhs});
+    mXorDirty = true;
+  }
+  else {
+    // 0 = 1 が導かれた．
+    mSane = false;
+  }
+  return true;
+}
+
+// @brief 擬似ブール制約を追加する．
+bool
+SatCore::add_pb_constraint(
+  SizeType n,
+  const SatLiteral* lits,
+  const SizeType* weights,
+  SizeType bound
+)
+{
+  if ( decision_level() != 0 ) {
+    // エラー
+    throw std::runtime_error{"decision_level() != 0"};
+  }
+
+  if ( !sane() ) {
+    throw std::runtime_error{"mSane == false"};
+  }
+
+  // 変数用のデータ構造の確保
+  alloc_var();
+
+  // 値の確定しているリテラルを取り除く．
+  // 真のリテラルはその重みを右辺から差し引く．
+  PbConstr constr;
+  auto& lit_list = constr.mLitList;
+  auto& weight_list = constr.mWeightList;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto l = Literal{lits[i]};
+    if ( l.varid() >= mVarNum ) {
+      ostringstream buf;
+      buf << "literal(" << l << "): out of range";
+      throw std::runtime_error{buf.str()};
+    }
+    auto w = weights[i];
+    if ( w == 0 ) {
+      continue;
+    }
+    auto v = eval(l);
+    if ( v == SatBool3::True ) {
+      bound = bound > w ? bound - w : 0;
+    }
+    else if ( v == SatBool3::X ) {
+      lit_list.push_back(l);
+      weight_list.push_back(w);
+    }
+  }
+  if ( bound == 0 ) {
+    // 常に成り立つ．
+    return true;
+  }
+
+  // 右辺を超える重みは右辺と同じにしても意味は変わらない．
+  SizeType nl = lit_list.size();
+  SizeType sum = 0;
+  bool is_card = true;
+  for ( SizeType i = 0; i < nl; ++ i ) {
+    auto& w = weight_list[i];
+    w = std::min(w, bound);
+    sum += w;
+    if ( w != weight_list[0] ) {
+      is_card = false;
+    }
+  }
+  if ( sum < bound ) {
+    // 全てのリテラルを真にしても満たせない．
+    mSane = false;
+    return true;
+  }
+  if ( is_card ) {
+    // 重みを 1 にして右辺を切り上げる．
+    auto w = weight_list[0];
+    bound = (bound + w - 1) / w;
+    sum = nl;
+    weight_list.clear();
+  }
+  if ( sum == bound ) {
+    // 全てのリテラルが真でなければならない．
+    for ( auto l: lit_list ) {
+      assign(l);
+    }
+  }
+  else {
+    if ( mPbWatchList.size() < mVarNum * 2 ) {
+      mPbWatchList.resize(mVarNum * 2);
+      mPbReasonList.resize(mVarNum);
+    }
+
+    SizeType id = mPbConstrList.size();
+    constr.mBound = bound;
+    if ( is_card ) {
+      // 先頭の bound + 1 個を監視する．
+      for ( SizeType i = 0; i <= bound; ++ i ) {
+	mPbWatchList[(~lit_list[i]).index()].push_back(PbWatch{id, 1});
+      }
+    }
+    else {
+      // 重みの降順に並べて全てのリテラルを監視する．
+      vector<SizeType> order_list(nl);
+      for ( SizeType i = 0; i < nl; ++ i ) {
+	order_list[i] = i;
+      }
+      std::stable_sort(order_list.begin(), order_list.end(),
+		       [&](SizeType a, SizeType b) {
+			 return weight_list[a] > weight_list[b];
+		       });
+      vector<Literal> lit_list1(nl);
+      vector<SizeType> weight_list1(nl);
+      for ( SizeType i = 0; i < nl; ++ i ) {
+	lit_list1[i] = lit_list[order_list[i]];
+	weight_list1[i] = weight_list[order_list[i]];
+      }
+      lit_list.swap(lit_list1);
+      weight_list.swap(weight_list1);
+      for ( SizeType i = 0; i < nl; ++ i ) {
+	auto w = weight_list[i];
+	mPbWatchList[(~lit_list[i]).index()].push_back(PbWatch{id, w});
+      }
+      // 余裕より重いリテラルは真でなければならない．
+      constr.mSlack = sum - bound;
+      for ( SizeType i = 0; i < nl; ++ i ) {
+	if ( static_cast<std::int64_t>(weight_list[i]) <= constr.mSlack ) {
+	  break;
+	}
+	assign(lit_list[i]);
+      }
+    }
+    mPbConstrList.push_back(std::move(constr));
+  }
+
+  // 今の割当に基づく含意を行う．
+  if ( implication() != Reason::None ) {
+    mSane = false;
+  }
+  return true;
+}
+
 // CNF を簡単化する．
 void
 SatCore::reduce_CNF()
@@ -491,6 +842,22 @@ SatCore::delete_clause(
   Clause::delete_clause(clause);
 }
 
+// @brief 決定変数の値を選ぶ時に優先する極性を設定する．
+bool
+SatCore::set_phase(
+  SizeType n,
+  const SatLiteral* lits
+)
+{
+  alloc_var();
+
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto l = lits[i];
+    mPhase[l.varid()] = l.is_negative() ? SatBool3::False : SatBool3::True;
+  }
+  return true;
+}
+
 // @brief SAT 問題を解く．
 SatBool3
 SatCore::solve(
@@ -540,6 +907,9 @@ SatCore::solve(
 
   ASSERT_COND( decision_level() == 0 );
 
+  // XOR 制約の監視を設定する．
+  xor_setup();
+
   // 自明な簡単化を行う．
   reduce_CNF();
   if ( !sane() ) {
@@ -655,6 +1025,11 @@ SatCore::search()
 {
   ++ mRestartNum;
 
+  if ( mExchange != nullptr && !import_shared_clauses() ) {
+    // 取り込んだ節だけで矛盾した．
+    return SatBool3::False;
+  }
+
   // 今回の矛盾の回数
   SizeType cur_confl_num = 0;
   for ( ; ; ) {
@@ -688,6 +1063,11 @@ SatCore::search()
       }
 #endif
 
+      if ( mExchange != nullptr ) {
+	// LBD の計算のためにバックトラックの前に行う．
+	export_learnt_clause(learnt_lits);
+      }
+
       // バックトラック
       backtrack(bt_level);
 
@@ -773,6 +1153,153 @@ SatCore::search()
   return SatBool3::X;
 }
 
+// @brief リテラルを仮に割り当てて含意を行う．
+bool
+SatCore::try_assign(
+  Literal lit
+)
+{
+  alloc_var();
+
+  if ( decision_level() == 0 && sane() ) {
+    // add_clause() で割り当てられた単位節の含意を済ませておく．
+    if ( xor_setup() && implication() != Reason::None ) {
+      mSane = false;
+    }
+  }
+
+  set_marker();
+  if ( !sane() ) {
+    return false;
+  }
+  auto val = eval(lit);
+  if ( val == SatBool3::False ) {
+    return false;
+  }
+  if ( val == SatBool3::True ) {
+    return true;
+  }
+  assign(lit);
+  auto conflict = implication();
+  return conflict == Reason::None;
+}
+
+// @brief 学習節を共有バッファに書き出す．
+void
+SatCore::export_learnt_clause(
+  const vector<Literal>& lits
+)
+{
+  SizeType n = lits.size();
+  if ( n > mExchange->size_limit() && n > 2 ) {
+    return;
+  }
+
+  // LBD (含まれる decision level の種類数)を求める．
+  // 対象の節は小さいので単純な線形探索で十分
+  SizeType lbd = 0;
+  int level_list[ClauseExchange::MAX_LIT_NUM];
+  for ( auto lit: lits ) {
+    int level = decision_level(lit.varid());
+    bool found = false;
+    for ( SizeType i = 0; i < lbd; ++ i ) {
+      if ( level_list[i] == level ) {
+	found = true;
+	break;
+      }
+    }
+    if ( !found ) {
+      level_list[lbd] = level;
+      ++ lbd;
+    }
+  }
+  if ( !mExchange->check(n, lbd) ) {
+    return;
+  }
+
+  auto h = ClauseExchange::hash(lits);
+  if ( !mSharedHashSet.emplace(h).second ) {
+    // 共有済み
+    return;
+  }
+  mExchange->push_clause(mWorkerId, lits);
+  ++ mExportNum;
+}
+
+// @brief 他のワーカが書き出した節を取り込む．
+bool
+SatCore::import_shared_clauses()
+{
+  ASSERT_COND( decision_level() == 0 );
+
+  vector<vector<Literal>> clause_list;
+  mExchange->pull_clauses(mWorkerId, mExchangeReadPos, clause_list);
+
+  // ハッシュ表が大きくなりすぎたらリセットする．
+  if ( mSharedHashSet.size() > (1U << 20) ) {
+    mSharedHashSet.clear();
+  }
+
+  vector<Literal> tmp_lits;
+  for ( auto& lits: clause_list ) {
+    if ( lits.size() > mExchange->size_limit() && lits.size() > 2 ) {
+      continue;
+    }
+    auto h = ClauseExchange::hash(lits);
+    if ( !mSharedHashSet.emplace(h).second ) {
+      // 取り込み済み
+      continue;
+    }
+
+    // トップレベルで確定している値に基づいて簡単化する．
+    tmp_lits.clear();
+    bool skip = false;
+    for ( auto lit: lits ) {
+      if ( lit.varid() >= mVarNum ) {
+	// 自分の知らない変数を含んでいる．
+	skip = true;
+	break;
+      }
+      auto v = eval(lit);
+      if ( v == SatBool3::True ) {
+	// すでに充足している．
+	skip = true;
+	break;
+      }
+      if ( v == SatBool3::X ) {
+	tmp_lits.push_back(lit);
+      }
+    }
+    if ( skip ) {
+      continue;
+    }
+
+    ++ mImportNum;
+    SizeType n = tmp_lits.size();
+    if ( n == 0 ) {
+      return false;
+    }
+    mLearntLitNum += n;
+    auto l0 = tmp_lits[0];
+    if ( n == 1 ) {
+      assign(l0);
+    }
+    else if ( n == 2 ) {
+      auto l1 = tmp_lits[1];
+      add_watcher(~l0, Watcher(l1));
+      add_watcher(~l1, Watcher(l0));
+      ++ mLearntBinNum;
+    }
+    else {
+      auto clause = Clause::new_clause(tmp_lits, true);
+      mLearntClauseList.push_back(clause);
+      add_watcher(~l0, Watcher(clause));
+      add_watcher(~tmp_lits[1], Watcher(clause));
+    }
+  }
+  return true;
+}
+
 // @brief 矛盾の原因を求める．
 void
 SatCore::analyze_final(
@@ -940,6 +1467,21 @@ SatCore::implication()
       }
     }
     wlist.move_elem(rpos, wnum, wpos);
+
+    if ( l.varid() < mXorWatchList.size() ) {
+      // XOR 制約は変数の値が決まった時点で調べる．
+      conflict = xor_implication(l.varid());
+      if ( conflict != Reason::None ) {
+	goto exit;
+      }
+    }
+
+    if ( l.index() < mPbWatchList.size() ) {
+      conflict = pb_implication(l);
+      if ( conflict != Reason::None ) {
+	goto exit;
+      }
+    }
   }
 
 exit:
@@ -949,6 +1491,389 @@ exit:
   return conflict;
 }
 
+// @brief XOR 制約の監視を設定し直す．
+bool
+SatCore::xor_setup()
+{
+  if ( !mXorDirty || !sane() ) {
+    return sane();
+  }
+  mXorDirty = false;
+
+  ASSERT_COND( decision_level() == 0 );
+
+  for ( auto& wlist: mXorWatchList ) {
+    wlist.clear();
+  }
+  mXorWatchList.resize(mVarNum);
+  mXorRowList.clear();
+
+  // 値の確定している変数を右辺に反映させてから監視を設定する．
+  // 矛盾が生じたら false を返す．
+  auto add_row = [&](const vector<SatVarId>& src_list, bool rhs, SizeType limit) {
+    vector<SatVarId> var_list;
+    var_list.reserve(src_list.size());
+    for ( auto var: src_list ) {
+      auto v = eval(var);
+      if ( v == SatBool3::True ) {
+	rhs = !rhs;
+      }
+      else if ( v == SatBool3::X ) {
+	var_list.push_back(var);
+      }
+    }
+    if ( var_list.empty() ) {
+      return !rhs;
+    }
+    if ( var_list.size() == 1 ) {
+      // 単位節と同じ
+      assign(Literal::conv_from_varid(var_list[0], !rhs));
+      return true;
+    }
+    if ( var_list.size() > limit ) {
+      return true;
+    }
+    SizeType id = mXorRowList.size();
+    mXorWatchList[var_list[0]].push_back(id);
+    mXorWatchList[var_list[1]].push_back(id);
+    mXorRowList.push_back(XorRow{std::move(var_list), rhs});
+    return true;
+  };
+
+  // 消去後の行からは単位節と短い制約だけを取り出す．
+  SizeType nr = mXorMatrix.row_num();
+  for ( SizeType i = 0; i < nr; ++ i ) {
+    mXorMatrix.row_vars(i, mXorVars);
+    if ( !add_row(mXorVars, mXorMatrix.rhs(i), XOR_ROW_LIMIT) ) {
+      mSane = false;
+      return false;
+    }
+  }
+  for ( auto& row: mXorConstrList ) {
+    if ( !add_row(row.mVarList, row.mRhs, mVarNum) ) {
+      mSane = false;
+      return false;
+    }
+  }
+
+  if ( implication() != Reason::None ) {
+    mSane = false;
+    return false;
+  }
+  return true;
+}
+
+// @brief XOR 制約に基づいて implication を行う．
+Reason
+SatCore::xor_implication(
+  SatVarId var
+)
+{
+  auto& wlist = mXorWatchList[var];
+  SizeType n = wlist.size();
+  SizeType wpos = 0;
+  for ( SizeType rpos = 0; rpos < n; ++ rpos ) {
+    auto id = wlist[rpos];
+    auto& row = mXorRowList[id];
+    auto& var_list = row.mVarList;
+    // var を 1番めの監視変数にする．
+    if ( var_list[0] == var ) {
+      std::swap(var_list[0], var_list[1]);
+    }
+
+    // var の代わりに監視する未割り当ての変数を探す．
+    SizeType nv = var_list.size();
+    bool found = false;
+    for ( SizeType i = 2; i < nv; ++ i ) {
+      if ( eval(var_list[i]) == SatBool3::X ) {
+	std::swap(var_list[1], var_list[i]);
+	mXorWatchList[var_list[1]].push_back(id);
+	found = true;
+	break;
+      }
+    }
+    if ( found ) {
+      continue;
+    }
+    wlist[wpos] = id;
+    ++ wpos;
+
+    // var_list[0] 以外の変数は全て値が確定している．
+    bool val = row.mRhs;
+    for ( SizeType i = 1; i < nv; ++ i ) {
+      if ( eval(var_list[i]) == SatBool3::True ) {
+	val = !val;
+      }
+    }
+    auto val0 = eval(var_list[0]);
+    if ( val0 == SatBool3::X ) {
+      auto lit = Literal::conv_from_varid(var_list[0], !val);
+#if YMSAT_DEBUG & DEBUG_ASSIGN
+      DOUT << "\tassign " << lit << " @" << decision_level()
+	   << " from XOR constraint" << endl;
+#endif
+      assign(lit, Reason{new_xor_reason(var_list, lit)});
+    }
+    else if ( (val0 == SatBool3::True) != val ) {
+      // 矛盾がおこった．
+#if YMSAT_DEBUG & DEBUG_ASSIGN
+      DOUT << "\t--> conflict(#" << mConflictNum
+	   << ") with XOR constraint" << endl;
+#endif
+      auto conflict = Reason{new_xor_reason(var_list, Literal::X)};
+      for ( ++ rpos; rpos < n; ++ rpos ) {
+	wlist[wpos] = wlist[rpos];
+	++ wpos;
+      }
+      wlist.erase(wlist.begin() + wpos, wlist.end());
+      return conflict;
+    }
+  }
+  wlist.erase(wlist.begin() + wpos, wlist.end());
+  return Reason::None;
+}
+
+// @brief XOR 制約から含意(もしくは矛盾)の理由を表す節を作る．
+Clause*
+SatCore::new_xor_reason(
+  const vector<SatVarId>& var_list,
+  Literal lit
+)
+{
+  auto& tmp_lits = mXorLits;
+  tmp_lits.clear();
+  if ( lit != Literal::X ) {
+    // 含意されたリテラルは先頭に置く．
+    tmp_lits.push_back(lit);
+  }
+  for ( auto var: var_list ) {
+    if ( lit != Literal::X && var == lit.varid() ) {
+      continue;
+    }
+    bool inv = eval(var) == SatBool3::True;
+    tmp_lits.push_back(Literal::conv_from_varid(var, inv));
+  }
+  auto clause = Clause::new_clause(tmp_lits);
+  add_tmp_reason(decision_level(), clause);
+  return clause;
+}
+
+// @brief 擬似ブール制約に基づいて implication を行う．
+Reason
+SatCore::pb_implication(
+  Literal lit
+)
+{
+  auto nlit = ~lit;
+  auto& wlist = mPbWatchList[lit.index()];
+
+  // 先に全ての制約の余裕を更新しておく．
+  // 途中で矛盾が起きても pb_unassign() で正しく元に戻せる．
+  for ( auto& w: wlist ) {
+    auto& constr = mPbConstrList[w.mId];
+    if ( !constr.is_card() ) {
+      constr.mSlack -= w.mWeight;
+      constr.mFalseList.push_back(nlit);
+    }
+  }
+
+  SizeType n = wlist.size();
+  SizeType wpos = 0;
+  for ( SizeType rpos = 0; rpos < n; ++ rpos ) {
+    auto w = wlist[rpos];
+    auto conflict = Reason::None;
+    if ( mPbConstrList[w.mId].is_card() ) {
+      bool keep;
+      conflict = card_implication(w.mId, nlit, keep);
+      if ( keep ) {
+	wlist[wpos] = w;
+	++ wpos;
+      }
+    }
+    else {
+      wlist[wpos] = w;
+      ++ wpos;
+      conflict = slack_implication(w.mId);
+    }
+    if ( conflict != Reason::None ) {
+      for ( ++ rpos; rpos < n; ++ rpos ) {
+	wlist[wpos] = wlist[rpos];
+	++ wpos;
+      }
+      wlist.erase(wlist.begin() + wpos, wlist.end());
+      return conflict;
+    }
+  }
+  wlist.erase(wlist.begin() + wpos, wlist.end());
+  return Reason::None;
+}
+
+// @brief 基数制約の監視しているリテラルが偽になった時の処理を行う．
+Reason
+SatCore::card_implication(
+  SizeType id,
+  Literal nlit,
+  bool& keep
+)
+{
+  auto& constr = mPbConstrList[id];
+  auto& lit_list = constr.mLitList;
+  SizeType n = lit_list.size();
+  SizeType nw = constr.mBound + 1;
+
+  SizeType pos = 0;
+  while ( lit_list[pos] != nlit ) {
+    ++ pos;
+  }
+  ASSERT_COND( pos < nw );
+
+  // 代わりに監視する偽でないリテラルを探す．
+  for ( SizeType i = nw; i < n; ++ i ) {
+    auto l = lit_list[i];
+    if ( eval(l) != SatBool3::False ) {
+      std::swap(lit_list[pos], lit_list[i]);
+      mPbWatchList[(~l).index()].push_back(PbWatch{id, 1});
+      keep = false;
+      return Reason::None;
+    }
+  }
+  keep = true;
+
+  // 残りの監視リテラルは全て真でなければならない．
+  for ( SizeType i = 0; i < nw; ++ i ) {
+    if ( i != pos && eval(lit_list[i]) == SatBool3::False ) {
+      // 矛盾がおこった．
+#if YMSAT_DEBUG & DEBUG_ASSIGN
+      DOUT << "\t--> conflict(#" << mConflictNum
+	   << ") with cardinality constraint" << endl;
+#endif
+      return Reason{new_pb_conflict(id)};
+    }
+  }
+  for ( SizeType i = 0; i < nw; ++ i ) {
+    auto l = lit_list[i];
+    if ( eval(l) == SatBool3::X ) {
+#if YMSAT_DEBUG & DEBUG_ASSIGN
+      DOUT << "\tassign " << l << " @" << decision_level()
+	   << " from cardinality constraint" << endl;
+#endif
+      mPbReasonList[l.varid()] = PbReason{id, 0};
+      assign(l, mPbReason);
+    }
+  }
+  return Reason::None;
+}
+
+// @brief 擬似ブール制約の余裕に基づいて implication を行う．
+Reason
+SatCore::slack_implication(
+  SizeType id
+)
+{
+  auto& constr = mPbConstrList[id];
+  auto slack = constr.mSlack;
+  if ( slack < 0 ) {
+    // 矛盾がおこった．
+#if YMSAT_DEBUG & DEBUG_ASSIGN
+    DOUT << "\t--> conflict(#" << mConflictNum
+	 << ") with pseudo-Boolean constraint" << endl;
+#endif
+    return Reason{new_pb_conflict(id)};
+  }
+
+  // 余裕より重い未割り当てのリテラルは真でなければならない．
+  // 重みの降順に並んでいるので余裕以下になったら終わる．
+  auto& lit_list = constr.mLitList;
+  auto& weight_list = constr.mWeightList;
+  SizeType n = lit_list.size();
+  SizeType nf = constr.mFalseList.size();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( static_cast<std::int64_t>(weight_list[i]) <= slack ) {
+      break;
+    }
+    auto l = lit_list[i];
+    if ( eval(l) == SatBool3::X ) {
+#if YMSAT_DEBUG & DEBUG_ASSIGN
+      DOUT << "\tassign " << l << " @" << decision_level()
+	   << " from pseudo-Boolean constraint" << endl;
+#endif
+      mPbReasonList[l.varid()] = PbReason{id, nf};
+      assign(l, mPbReason);
+    }
+  }
+  return Reason::None;
+}
+
+// @brief 擬似ブール制約の矛盾の理由を表す節を作る．
+Clause*
+SatCore::new_pb_conflict(
+  SizeType id
+)
+{
+  auto& tmp_lits = mPbLits;
+  tmp_lits.clear();
+  for ( auto l: mPbConstrList[id].mLitList ) {
+    if ( eval(l) == SatBool3::False ) {
+      tmp_lits.push_back(l);
+    }
+  }
+  auto clause = Clause::new_clause(tmp_lits);
+  add_tmp_reason(decision_level(), clause);
+  return clause;
+}
+
+// @brief 擬似ブール制約による含意の理由を表す節を作る．
+Reason
+SatCore::new_pb_reason(
+  SatVarId var
+)
+{
+  auto& info = mPbReasonList[var];
+  auto& constr = mPbConstrList[info.mId];
+  auto& tmp_lits = mPbLits;
+  tmp_lits.clear();
+  // 含意されたリテラルは先頭に置く．
+  tmp_lits.push_back(Literal::conv_from_varid(var, eval(var) == SatBool3::False));
+  if ( constr.is_card() ) {
+    // 含意の後に偽になるリテラルはないので，
+    // 現在偽のリテラルを集めればよい．
+    for ( auto l: constr.mLitList ) {
+      if ( eval(l) == SatBool3::False ) {
+	tmp_lits.push_back(l);
+      }
+    }
+  }
+  else {
+    // 含意の時点で余裕に反映されていたリテラル
+    for ( SizeType i = 0; i < info.mFalseNum; ++ i ) {
+      tmp_lits.push_back(constr.mFalseList[i]);
+    }
+  }
+  auto clause = Clause::new_clause(tmp_lits);
+  add_tmp_reason(decision_level(var), clause);
+  auto r = Reason{clause};
+  mReason[var] = r;
+  return r;
+}
+
+// @brief バックトラックで取り消された割り当てを擬似ブール制約に反映させる．
+void
+SatCore::pb_unassign(
+  Literal lit
+)
+{
+  // lit が余裕に反映されていれば mFalseList の末尾に ~lit がある．
+  auto nlit = ~lit;
+  for ( auto& w: mPbWatchList[lit.index()] ) {
+    auto& constr = mPbConstrList[w.mId];
+    if ( !constr.is_card() &&
+	 !constr.mFalseList.empty() && constr.mFalseList.back() == nlit ) {
+      constr.mFalseList.pop_back();
+      constr.mSlack += w.mWeight;
+    }
+  }
+}
+
 // @brief watch literal を更新する．
 Literal
 SatCore::find_watch_literal(
@@ -988,9 +1913,23 @@ SatCore::backtrack(
 #endif
 
   if ( level < decision_level() ) {
+    // 取り消される割り当ての理由として作った節を削除する．
+    // 擬似ブール制約の理由の節は後から作られるので決定レベルごとに分けてある．
+    SizeType end = std::min(mTmpReasonList.size(),
+			    static_cast<SizeType>(decision_level() + 1));
+    for ( SizeType l = level + 1; l < end; ++ l ) {
+      for ( auto c: mTmpReasonList[l] ) {
+	Clause::delete_clause(c);
+      }
+      mTmpReasonList[l].clear();
+    }
+
     mAssignList.backtrack(level);
     while ( mAssignList.has_elem() ) {
       auto p = mAssignList.get_prev();
+      if ( p.index() < mPbWatchList.size() ) {
+	pb_unassign(p);
+      }
       auto varid = p.varid();
       mVal[varid] = (mVal[varid] << 2) | conv_from_Bool3(SatBool3::X);
       push(varid);
@@ -1076,6 +2015,8 @@ SatCore::get_stats() const
   stats.mConflictLimit = conflict_limit();
   stats.mLearntLimit = learnt_limit();
   stats.mTime = mAccTime;
+  stats.mImportNum = mImportNum;
+  stats.mExportNum = mExportNum;
   return stats;
 }
 
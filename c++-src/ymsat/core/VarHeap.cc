@@ -17,10 +17,9 @@ BEGIN_NAMESPACE_YM_SAT
 
 // @brief コンストラクタ
 VarHeap::VarHeap(
-) : mHeapPos(1024),
-    mActivity(1024),
-    mHeap(1024)
+)
 {
+  // 小さな問題を大量に解く場合のために最初は領域を確保しない．
 }
 
 // @brief デストラクタ
@@ -36,6 +35,9 @@ VarHeap::alloc_var(
 {
   SizeType size = mActivity.size();
   if ( size < req_size ) {
+    if ( size == 0 ) {
+      size = 1;
+    }
     while ( size < req_size ) {
       size <<= 1;
     }
@@ -45,6 +47,17 @@ VarHeap::alloc_var(
   }
 }
 
+// @brief 初期状態に戻す．
+void
+VarHeap::reset()
+{
+  mVarBump = 1.0;
+  mHeapNum = 0;
+  for ( SizeType i = 0; i < mHeapPos.size(); ++ i ) {
+    mHeapPos[i] = -1;
+  }
+}
+
 // @brief 変数のアクティビティを初期化する．
 void
 VarHeap::reset_activity()
@@ -0,0 +1,124 @@
+
+/// @file XorMatrix.cc
+/// @brief XorMatrix の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "XorMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+// クラス XorMatrix
+//////////////////////////////////////////////////////////////////////
+
+// @brief 内容をクリアする．
+void
+XorMatrix::clear()
+{
+  mColumnMap.clear();
+  mVarList.clear();
+  mWordNum = 0;
+  mRowList.clear();
+}
+
+// @brief 行を追加する．
+bool
+XorMatrix::add_row(
+  const vector<SatVarId>& var_list,
+  bool rhs
+)
+{
+  // 先に列を割り当ててワード数を確定させる．
+  for ( auto var: var_list ) {
+    column(var);
+  }
+
+  auto& bits = mTmpBits;
+  bits.clear();
+  bits.resize(mWordNum, 0ULL);
+  for ( auto var: var_list ) {
+    auto col = mColumnMap.at(var);
+    bits[col / 64] |= (1ULL << (col % 64));
+  }
+
+  // 既存の行のピボット列を消去する．
+  // 各行のピボット列は他の行には現れないので1回走査すればよい．
+  for ( auto& row: mRowList ) {
+    if ( get_bit(bits, row.mPivot) ) {
+      xor_bits(bits, row.mBits);
+      rhs ^= row.mRhs;
+    }
+  }
+
+  // 残った最初の列をピボットにする．
+  SizeType pivot = mVarList.size();
+  for ( SizeType i = 0; i < mWordNum; ++ i ) {
+    auto w = bits[i];
+    if ( w != 0ULL ) {
+      pivot = i * 64 + __builtin_ctzll(w);
+      break;
+    }
+  }
+  if ( pivot == mVarList.size() ) {
+    // 0 = rhs になった．
+    return !rhs;
+  }
+
+  // 他の行からピボット列を消去する．
+  for ( auto& row: mRowList ) {
+    if ( get_bit(row.mBits, pivot) ) {
+      xor_bits(row.mBits, bits);
+      row.mRhs ^= rhs;
+    }
+  }
+  mRowList.push_back(Row{bits, pivot, rhs});
+  return true;
+}
+
+// @brief 行に含まれる変数のリストを得る．
+void
+XorMatrix::row_vars(
+  SizeType pos,
+  vector<SatVarId>& var_list
+) const
+{
+  var_list.clear();
+  auto& bits = mRowList[pos].mBits;
+  for ( SizeType i = 0; i < mWordNum; ++ i ) {
+    auto w = bits[i];
+    while ( w != 0ULL ) {
+      auto b = __builtin_ctzll(w);
+      var_list.push_back(mVarList[i * 64 + b]);
+      w &= w - 1;
+    }
+  }
+}
+
+// @brief 変数に対応する列番号を返す．
+SizeType
+XorMatrix::column(
+  SatVarId var
+)
+{
+  auto p = mColumnMap.find(var);
+  if ( p != mColumnMap.end() ) {
+    return p->second;
+  }
+  SizeType col = mVarList.size();
+  mColumnMap.emplace(var, col);
+  mVarList.push_back(var);
+  SizeType nw = (col + 64) / 64;
+  if ( nw > mWordNum ) {
+    mWordNum = nw;
+    for ( auto& row: mRowList ) {
+      row.mBits.resize(mWordNum, 0ULL);
+    }
+  }
+  return col;
+}
+
+END_NAMESPACE_YM_SAT
@@ -79,6 +79,19 @@ public:
   }
 
 
+  /// @brief 内容をクリアする．
+  ///
+  /// 確保した領域はそのまま残す．
+  void
+  clear()
+  {
+    mList.clear();
+    mHead = 0;
+    mMarker.clear();
+    set_marker();
+  }
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // 割り当ての追加/取り出しに関する関数
@@ -0,0 +1,165 @@
+#ifndef CLAUSEEXCHANGE_H
+#define CLAUSEEXCHANGE_H
+
+/// @file ClauseExchange.h
+/// @brief ClauseExchange のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+#include "Literal.h"
+#include <atomic>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class ClauseExchange ClauseExchange.h "ClauseExchange.h"
+/// @brief 並列に動く SatCore 間で学習節を交換するためのバッファ
+///
+/// 固定長のリングバッファで，書き込み位置の確保のみを
+/// fetch_add で行うロックフリーな実装となっている．
+/// 各スロットはシーケンス番号で保護されており(seqlock)，
+/// 読み出し中に上書きされた節は読み捨てられる．
+/// 書き込み側はシーケンス番号を CAS で BUSY にしてスロットを確保する．
+/// 周回遅れになった書き込みはスロットを確保できずに捨てられるので，
+/// 1つのスロットに同時に書き込むことはない．
+/// 読み出し側は各自で読み出し位置を保持する．
+/// 読み出しが追いつかずに上書きされた節は失われるが，
+/// 学習節は捨てても正しさには影響しない．
+//////////////////////////////////////////////////////////////////////
+class ClauseExchange
+{
+public:
+
+  /// @brief 1つの節に格納できるリテラル数の最大値
+  static constexpr SizeType MAX_LIT_NUM = 30;
+
+public:
+
+  /// @brief コンストラクタ
+  ClauseExchange(
+    SizeType size_limit = 8, ///< [in] 共有する節のリテラル数の上限
+    SizeType lbd_limit = 4,  ///< [in] 共有する節の LBD の上限
+    SizeType capacity = 4096 ///< [in] バッファのサイズ(2のべき乗に切り上げられる)
+  );
+
+  /// @brief デストラクタ
+  ~ClauseExchange() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 共有する節のリテラル数の上限を返す．
+  SizeType
+  size_limit() const
+  {
+    return mSizeLimit;
+  }
+
+  /// @brief 共有する節の LBD の上限を返す．
+  SizeType
+  lbd_limit() const
+  {
+    return mLbdLimit;
+  }
+
+  /// @brief 節が共有の対象となる時 true を返す．
+  ///
+  /// 単位節と二項節は LBD によらず対象となる．
+  bool
+  check(
+    SizeType lit_num, ///< [in] リテラル数
+    SizeType lbd      ///< [in] LBD
+  ) const
+  {
+    if ( lit_num <= 2 ) {
+      return true;
+    }
+    return lit_num <= mSizeLimit && lbd <= mLbdLimit;
+  }
+
+  /// @brief 節を書き込む．
+  ///
+  /// 他のスレッドから同時に呼ばれても構わない．
+  /// 周回遅れになってスロットを確保できなかった場合は何もしない．
+  void
+  push_clause(
+    SizeType producer_id,           ///< [in] 書き込んだワーカの番号
+    const vector<Literal>& lit_list ///< [in] リテラルのリスト
+  );
+
+  /// @brief 新しく書き込まれた節を読み出す．
+  ///
+  /// consumer_id が書き込んだ節は読み飛ばす．
+  /// read_pos は読み出し側が保持し，次の呼び出しに引き継ぐ．
+  void
+  pull_clauses(
+    SizeType consumer_id,                   ///< [in] 読み出すワーカの番号
+    std::uint64_t& read_pos,                ///< [inout] 読み出し位置
+    vector<vector<Literal>>& clause_list    ///< [out] 読み出した節のリスト
+  ) const;
+
+  /// @brief リテラルのリストのハッシュ値を求める．
+  ///
+  /// リテラルの順番には依存しない．
+  static
+  std::uint64_t
+  hash(
+    const vector<Literal>& lit_list ///< [in] リテラルのリスト
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 節を格納するスロット
+  struct Slot
+  {
+    // シーケンス番号
+    // 0 は未使用，BUSY は書き込み中，それ以外は書き込み位置 + 1
+    std::atomic<std::uint64_t> mSeq{0};
+
+    // 書き込んだワーカの番号とリテラル数
+    std::atomic<std::uint32_t> mHeader{0};
+
+    // リテラル(Literal::index())の配列
+    std::atomic<std::uint32_t> mLits[MAX_LIT_NUM];
+  };
+
+  /// @brief 書き込み中を表すシーケンス番号
+  static constexpr std::uint64_t BUSY = static_cast<std::uint64_t>(-1);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // リテラル数の上限
+  SizeType mSizeLimit;
+
+  // LBD の上限
+  SizeType mLbdLimit;
+
+  // スロット番号を得るためのマスク
+  std::uint64_t mMask;
+
+  // スロットの配列
+  unique_ptr<Slot[]> mSlots;
+
+  // 次の書き込み位置
+  std::atomic<std::uint64_t> mWritePos{0};
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // CLAUSEEXCHANGE_H
@@ -16,6 +16,7 @@
 #include "AssignList.h"
 #include "Watcher.h"
 #include "VarHeap.h"
+#include "XorMatrix.h"
 #include <chrono>
 #include "ym/json.h"
 
@@ -25,6 +26,7 @@ BEGIN_NAMESPACE_YM_SAT
 class Controller;
 class Analyzer;
 class Selecter;
+class ClauseExchange;
 
 //////////////////////////////////////////////////////////////////////
 /// @class SatCore SatCore.h "SatCore.h"
@@ -163,16 +165,38 @@ public:
   void
   alloc_var();
 
+  /// @brief 変数と節をすべて削除して生成直後の状態に戻す．
+  /// @return 常に true を返す．
+  ///
+  /// 変数用の配列や watcher list の領域は解放せずに再利用する．
+  /// 学習節の共有の設定は解除される．
+  bool
+  reset() override;
+
+  /// @brief 制約節を列挙する．
+  /// @return 常に true を返す．
+  ///
+  /// 決定レベル 0 で値の確定している変数は単位節として出力し，
+  /// その後に二項節と一般の節を出力する．
+  /// 節を追加する時点で偽となっていたリテラルは取り除かれている．
+  bool
+  enum_clauses(
+    const std::function<void(const vector<SatLiteral>&)>& func ///< [in] 節を受け取る関数
+  ) const override;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
   // 節の追加に関する関数
   //////////////////////////////////////////////////////////////////////
 
+  using SatSolverImpl::add_clause;
+
   /// @brief 節を追加する．
   void
   add_clause(
-    const vector<SatLiteral>& lits ///< [in] リテラルのベクタ
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
   ) override;
 
   /// @brief 学習節を追加する．
@@ -181,6 +205,70 @@ public:
     const vector<Literal>& lits ///< [in] 追加するリテラルのリスト
   );
 
+  /// @brief XOR 制約を追加する．
+  /// @return 常に true を返す．
+  ///
+  /// 制約は XorMatrix 上で Gauss-Jordan 消去され，消去後の各行を
+  /// 2つの変数を監視する XOR 制約として含意に用いる．
+  bool
+  add_xor_constraint(
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits, ///< [in] リテラルの配列
+    bool rhs                ///< [in] 右辺の値
+  ) override;
+
+  /// @brief 消去後の XOR 制約の数を得る．
+  SizeType
+  xor_num() const
+  {
+    return mXorMatrix.row_num();
+  }
+
+  /// @brief 擬似ブール制約を追加する．
+  /// @return 常に true を返す．
+  ///
+  /// 重みが全て等しい制約は基数制約として bound + 1 個のリテラルを
+  /// 監視し，それ以外は偽になったリテラルの重みを余裕(slack)から
+  /// 差し引いて含意を行う．
+  /// 含意の理由を表す節は矛盾の解析で必要になった時に作られる．
+  bool
+  add_pb_constraint(
+    SizeType n,              ///< [in] リテラル数
+    const SatLiteral* lits,  ///< [in] リテラルの配列
+    const SizeType* weights, ///< [in] 重みの配列
+    SizeType bound           ///< [in] 右辺の値
+  ) override;
+
+  /// @brief 擬似ブール制約(基数制約を含む)の数を得る．
+  SizeType
+  pb_num() const
+  {
+    return mPbConstrList.size();
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 学習節の共有に関する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 学習節を共有するためのバッファを設定する．
+  ///
+  /// 学習節のうち exchange->check() を満たすものを書き出し，
+  /// リスタートのたびに他のワーカが書き出した節を取り込む．
+  /// nullptr を与えると共有を行わない．
+  void
+  set_clause_exchange(
+    ClauseExchange* exchange, ///< [in] 共有用のバッファ
+    SizeType worker_id        ///< [in] 自分のワーカ番号
+  )
+  {
+    mExchange = exchange;
+    mWorkerId = worker_id;
+    mExchangeReadPos = 0;
+    mSharedHashSet.clear();
+  }
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -281,6 +369,17 @@ public:
     return conv_to_Bool3(x);
   }
 
+  /// @brief set_phase() で設定された極性を得る．
+  ///
+  /// 設定されていない場合は SatBool3::X を返す．
+  SatBool3
+  phase(
+    SatVarId var ///< [in] 変数番号
+  ) const
+  {
+    return mPhase[var];
+  }
+
   /// @brief 値の割当てを行う．
   void
   assign(
@@ -351,11 +450,47 @@ public:
   }
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 先読み(lookahead)用の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief リテラルを仮に割り当てて含意を行う．
+  /// @return 矛盾が生じたら false を返す．
+  ///
+  /// 新しい decision level で割り当てを行うので
+  /// 結果は矛盾の有無にかかわらず cancel_assign() で取り消す．
+  /// 割り当てられたリテラル数は last_assign() の差で分かる．
+  bool
+  try_assign(
+    Literal lit ///< [in] 割り当てるリテラル
+  );
+
+  /// @brief 直前の try_assign() を取り消す．
+  void
+  cancel_assign()
+  {
+    backtrack(decision_level() - 1);
+  }
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // 探索に関する関数
   //////////////////////////////////////////////////////////////////////
 
+  using SatSolverImpl::set_phase;
+
+  /// @brief 決定変数の値を選ぶ時に優先する極性を設定する．
+  /// @return 常に true を返す．
+  ///
+  /// 設定された極性は phase cache よりも優先される．
+  bool
+  set_phase(
+    SizeType n,            ///< [in] リテラル数
+    const SatLiteral* lits ///< [in] リテラルの配列
+  ) override;
+
   /// @brief SAT 問題を解く．
   /// @retval SatBool3::True 充足した．
   /// @retval SatBool3::False 充足不能が判明した．
@@ -368,12 +503,18 @@ public:
   ) override;
 
   /// @brief 変数の割り当て理由を返す．
+  ///
+  /// 擬似ブール制約による含意の場合にはここで理由の節を作る．
   Reason
   reason(
     SatVarId var ///< [in] 変数番号
-  ) const
+  )
   {
-    return mReason[var];
+    auto r = mReason[var];
+    if ( r == mPbReason ) {
+      r = new_pb_reason(var);
+    }
+    return r;
   }
 
   /// @brief 停止する．
@@ -601,6 +742,21 @@ private:
   SatBool3
   search();
 
+  /// @brief 学習節を共有バッファに書き出す．
+  ///
+  /// バックトラックする前に呼ぶ必要がある．
+  void
+  export_learnt_clause(
+    const vector<Literal>& lits ///< [in] 学習節のリテラルのリスト
+  );
+
+  /// @brief 他のワーカが書き出した節を取り込む．
+  /// @return トップレベルで矛盾が生じたら false を返す．
+  ///
+  /// decision level が 0 の時に呼ぶ必要がある．
+  bool
+  import_shared_clauses();
+
   /// @brief 矛盾の原因を求める．
   ///
   /// 結果は mConflicts に格納する．
@@ -624,6 +780,99 @@ private:
   Reason
   implication();
 
+  /// @brief XOR 制約の監視を設定し直す．
+  /// @return 矛盾が生じたら false を返す．
+  ///
+  /// add_xor_constraint() で行列が変更されている時だけ処理を行う．
+  /// decision level が 0 の時に呼ぶ必要がある．
+  bool
+  xor_setup();
+
+  /// @brief XOR 制約に基づいて implication を行う．
+  /// @return 矛盾が生じたら矛盾の原因を返す．
+  ///
+  /// var を監視している XOR 制約を調べる．
+  Reason
+  xor_implication(
+    SatVarId var ///< [in] 値が割り当てられた変数
+  );
+
+  /// @brief XOR 制約から含意(もしくは矛盾)の理由を表す節を作る．
+  ///
+  /// lit 以外の変数は現在の値で偽となるリテラルにする．
+  /// lit が Literal::X の場合には全ての変数が偽のリテラルとなる．
+  /// 作られた節はその decision level からバックトラックする時に削除される．
+  Clause*
+  new_xor_reason(
+    const vector<SatVarId>& var_list, ///< [in] 変数のリスト
+    Literal lit                       ///< [in] 含意されたリテラル
+  );
+
+  /// @brief 擬似ブール制約に基づいて implication を行う．
+  /// @return 矛盾が生じたら矛盾の原因を返す．
+  ///
+  /// ~lit を含む擬似ブール制約を調べる．
+  Reason
+  pb_implication(
+    Literal lit ///< [in] 値が真になったリテラル
+  );
+
+  /// @brief 基数制約の監視しているリテラルが偽になった時の処理を行う．
+  /// @return 矛盾が生じたら矛盾の原因を返す．
+  ///
+  /// 代わりの監視リテラルが見つかった場合には keep に false を入れる．
+  Reason
+  card_implication(
+    SizeType id,  ///< [in] 制約番号
+    Literal nlit, ///< [in] 偽になったリテラル
+    bool& keep    ///< [out] nlit の監視を続ける時 true を入れる．
+  );
+
+  /// @brief 擬似ブール制約の余裕に基づいて implication を行う．
+  /// @return 矛盾が生じたら矛盾の原因を返す．
+  Reason
+  slack_implication(
+    SizeType id ///< [in] 制約番号
+  );
+
+  /// @brief 擬似ブール制約の矛盾の理由を表す節を作る．
+  ///
+  /// 制約中の偽のリテラルを全て含む．
+  Clause*
+  new_pb_conflict(
+    SizeType id ///< [in] 制約番号
+  );
+
+  /// @brief 擬似ブール制約による含意の理由を表す節を作る．
+  ///
+  /// 作られた節は mReason[var] に設定される．
+  Reason
+  new_pb_reason(
+    SatVarId var ///< [in] 含意された変数
+  );
+
+  /// @brief 理由の節を登録する．
+  ///
+  /// 登録された節は level からバックトラックする時に削除される．
+  void
+  add_tmp_reason(
+    int level,     ///< [in] 決定レベル
+    Clause* clause ///< [in] 節
+  )
+  {
+    SizeType index = level;
+    if ( mTmpReasonList.size() <= index ) {
+      mTmpReasonList.resize(index + 1);
+    }
+    mTmpReasonList[index].push_back(clause);
+  }
+
+  /// @brief バックトラックで取り消された割り当てを擬似ブール制約に反映させる．
+  void
+  pb_unassign(
+    Literal lit ///< [in] 取り消されたリテラル
+  );
+
   /// @brief watch literal を更新する．
   Literal
   find_watch_literal(
@@ -672,7 +921,7 @@ private:
     // そこで最初のリテラルの変数の割り当て理由が自分自身か
     // どうかを調べれば clause が割り当て理由として用いられて
     // いるかわかる．
-    return reason(clause->wl0().varid()) == Reason{clause};
+    return mReason[clause->wl0().varid()] == Reason{clause};
   }
 
   /// @brief 変数に関する配列を拡張する．
@@ -807,6 +1056,70 @@ private:
     Literal mLit1;
   };
 
+  /// @brief 含意に用いる XOR 制約を表す構造体
+  ///
+  /// 変数のリストの先頭の2つが監視している変数となる．
+  struct XorRow
+  {
+    // 変数のリスト
+    vector<SatVarId> mVarList;
+
+    // 右辺の値
+    bool mRhs;
+  };
+
+  /// @brief 擬似ブール制約を表す構造体
+  ///
+  /// Σ mWeightList[i] * mLitList[i] >= mBound を表す．
+  struct PbConstr
+  {
+    // リテラルのリスト
+    // 基数制約の場合は先頭の mBound + 1 個が監視しているリテラルとなる．
+    // それ以外の場合は重みの降順に並んでいる．
+    vector<Literal> mLitList;
+
+    // 重みのリスト(基数制約の場合は空)
+    vector<SizeType> mWeightList;
+
+    // 右辺の値
+    SizeType mBound;
+
+    // 偽でないリテラルの重みの和から mBound を引いた値
+    // 基数制約の場合は用いない．
+    std::int64_t mSlack{0};
+
+    // mSlack に反映させた偽のリテラルのリスト(反映させた順)
+    // 基数制約の場合は用いない．
+    vector<Literal> mFalseList;
+
+    /// @brief 基数制約の時 true を返す．
+    bool
+    is_card() const
+    {
+      return mWeightList.empty();
+    }
+  };
+
+  /// @brief 擬似ブール制約の監視を表す構造体
+  struct PbWatch
+  {
+    // 制約番号
+    SizeType mId;
+
+    // リテラルの重み
+    SizeType mWeight;
+  };
+
+  /// @brief 擬似ブール制約による含意の情報を表す構造体
+  struct PbReason
+  {
+    // 制約番号
+    SizeType mId;
+
+    // 含意の時点の mFalseList の要素数
+    SizeType mFalseNum;
+  };
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -873,6 +1186,9 @@ private:
   // 値の配列
   vector<std::uint8_t> mVal;
 
+  // set_phase() で設定された極性の配列
+  vector<SatBool3> mPhase;
+
   // 値が割り当てられたときのレベルの配列
   vector<int> mDecisionLevel;
 
@@ -899,9 +1215,53 @@ private:
   // 矛盾の解析時にテンポラリに使用される節
   Clause* mTmpBinClause{nullptr};
 
+  // add_clause() で用いる作業領域
+  vector<Literal> mTmpLits;
+
   // 変数のヒープ木
   VarHeap mVarHeap;
 
+  // XOR 制約の行列
+  XorMatrix mXorMatrix;
+
+  // mXorMatrix が変更されて監視の設定し直しが必要な時 true にするフラグ
+  bool mXorDirty{false};
+
+  // 追加された XOR 制約のリスト
+  vector<XorRow> mXorConstrList;
+
+  // 含意に用いる XOR 制約のリスト
+  vector<XorRow> mXorRowList;
+
+  // 変数ごとにその変数を監視している XOR 制約の番号のリスト
+  vector<vector<SizeType>> mXorWatchList;
+
+  // XOR 制約や擬似ブール制約から作った理由の節のリスト
+  // 決定レベルごとに分けて持つ．
+  vector<vector<Clause*>> mTmpReasonList;
+
+  // XOR 制約で用いる作業領域
+  vector<SatVarId> mXorVars;
+
+  // new_xor_reason() で用いる作業領域
+  vector<Literal> mXorLits;
+
+  // 擬似ブール制約のリスト
+  vector<PbConstr> mPbConstrList;
+
+  // リテラルごとにそのリテラルが真になった時に調べる擬似ブール制約のリスト
+  vector<vector<PbWatch>> mPbWatchList;
+
+  // 変数ごとの擬似ブール制約による含意の情報
+  vector<PbReason> mPbReasonList;
+
+  // 擬似ブール制約による含意で理由の節がまだ作られていないことを表す印
+  // 中身はダミーの節
+  Reason mPbReason;
+
+  // 擬似ブール制約で用いる作業領域
+  vector<Literal> mPbLits;
+
   // 動作フラグ
   std::atomic<bool> mGoOn{false};
 
@@ -948,6 +1308,24 @@ private:
   // メッセージハンドラのリスト
   vector<SatMsgHandler*> mMsgHandlerList;
 
+  // 学習節の共有用のバッファ
+  ClauseExchange* mExchange{nullptr};
+
+  // 共有時のワーカ番号
+  SizeType mWorkerId{0};
+
+  // 共有バッファの読み出し位置
+  std::uint64_t mExchangeReadPos{0};
+
+  // 共有済みの節のハッシュ値の集合
+  unordered_set<std::uint64_t> mSharedHashSet;
+
+  // 取り込んだ節の数
+  SizeType mImportNum{0};
+
+  // 書き出した節の数
+  SizeType mExportNum{0};
+
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -94,6 +94,12 @@ public:
     mHeapNum = 0;
   }
 
+  /// @brief 初期状態に戻す．
+  ///
+  /// 確保した領域はそのまま残す．
+  void
+  reset();
+
   /// @brief size 個の要素を格納出来るだけの領域を確保する．
   void
   alloc_var(
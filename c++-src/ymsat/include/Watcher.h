@@ -65,7 +65,7 @@ public:
   /// @brief ムーブコンストラクタ
   WatcherList(
     WatcherList&& src
-  ) : mArray{src.mArray}
+  ) noexcept : mArray{std::move(src.mArray)}
   {
   }
 
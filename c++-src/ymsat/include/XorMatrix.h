@@ -0,0 +1,165 @@
+#ifndef YMSAT_XORMATRIX_H
+#define YMSAT_XORMATRIX_H
+
+/// @file XorMatrix.h
+/// @brief XorMatrix のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class XorMatrix XorMatrix.h "XorMatrix.h"
+/// @brief XOR 制約の連立方程式を表す GF(2) 上の行列
+///
+/// 各行は変数の XOR が右辺の値に等しいという制約を表す．
+/// 列は制約に現れた変数ごとに割り当てられ，行は 64 ビットのワードの
+/// 配列で表す．
+/// 行は常に既約行階段形(各行のピボット列は他の行に現れない)に保たれて
+/// おり，add_row() のたびにその行だけを掃き出すことで増分的に
+/// Gauss-Jordan 消去を行う．
+//////////////////////////////////////////////////////////////////////
+class XorMatrix
+{
+public:
+
+  /// @brief コンストラクタ
+  XorMatrix() = default;
+
+  /// @brief デストラクタ
+  ~XorMatrix() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容をクリアする．
+  void
+  clear();
+
+  /// @brief 行を追加する．
+  /// @return 矛盾が生じた時 false を返す．
+  ///
+  /// var_list の変数の XOR が rhs に等しいという制約を追加する．
+  /// var_list には同じ変数が重複して含まれていないこと．
+  /// 既存の行から導かれる制約の場合には行は増えない．
+  bool
+  add_row(
+    const vector<SatVarId>& var_list, ///< [in] 変数のリスト
+    bool rhs                          ///< [in] 右辺の値
+  );
+
+  /// @brief 行数を返す．
+  SizeType
+  row_num() const
+  {
+    return mRowList.size();
+  }
+
+  /// @brief 行に含まれる変数のリストを得る．
+  void
+  row_vars(
+    SizeType pos,               ///< [in] 行番号 ( 0 <= pos < row_num() )
+    vector<SatVarId>& var_list  ///< [out] 変数のリスト
+  ) const;
+
+  /// @brief 行の右辺の値を返す．
+  bool
+  rhs(
+    SizeType pos ///< [in] 行番号 ( 0 <= pos < row_num() )
+  ) const
+  {
+    return mRowList[pos].mRhs;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数に対応する列番号を返す．
+  ///
+  /// なければ新しい列を割り当てる．
+  SizeType
+  column(
+    SatVarId var ///< [in] 変数番号
+  );
+
+  /// @brief ビットを調べる．
+  static
+  bool
+  get_bit(
+    const vector<std::uint64_t>& bits,
+    SizeType col
+  )
+  {
+    return static_cast<bool>((bits[col / 64] >> (col % 64)) & 1ULL);
+  }
+
+  /// @brief dst に src を XOR する．
+  static
+  void
+  xor_bits(
+    vector<std::uint64_t>& dst,
+    const vector<std::uint64_t>& src
+  )
+  {
+    SizeType n = dst.size();
+    for ( SizeType i = 0; i < n; ++ i ) {
+      dst[i] ^= src[i];
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行を表す構造体
+  struct Row
+  {
+    // 列ごとのビットベクタ
+    vector<std::uint64_t> mBits;
+
+    // ピボット列
+    SizeType mPivot;
+
+    // 右辺の値
+    bool mRhs;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 変数番号をキーにして列番号を保持する辞書
+  unordered_map<SatVarId, SizeType> mColumnMap;
+
+  // 列番号ごとの変数番号のリスト
+  vector<SatVarId> mVarList;
+
+  // 1行あたりのワード数
+  SizeType mWordNum{0};
+
+  // 行のリスト
+  vector<Row> mRowList;
+
+  // add_row() で用いる作業領域
+  vector<std::uint64_t> mTmpBits;
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // YMSAT_XORMATRIX_H
@@ -38,6 +38,14 @@ SelBase::next_decision()
   }
 
   bool inv = false;
+  {
+    auto val = mCore.phase(vid);
+    if ( val != SatBool3::X ) {
+      // set_phase() で設定された極性を選ぶ
+      inv = val == SatBool3::False;
+      goto end;
+    }
+  }
   if ( mPhaseCache ) {
     auto val = mCore.prev_val(vid);
     if ( val != SatBool3::X ) {
@@ -0,0 +1,51 @@
+#ifndef YM_SATAMOENC_H
+#define YM_SATAMOENC_H
+
+/// @file ym/SatAmoEnc.h
+/// @brief SatAmoEnc の定義ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+
+
+BEGIN_NAMESPACE_YM
+
+/// @brief at-most-one 制約(add_at_most_one() など)の符号化方法
+/// @ingroup SatGroup
+enum class SatAmoEnc : std::uint8_t {
+  Auto,      ///< 入力数から自動で選ぶ
+  Pairwise,  ///< 全ての対に2項節を作る
+  Halving,   ///< 半分に分割して再帰的に OR を作る
+  Ladder,    ///< 逐次(ladder)符号化(Sinz)
+  Commander, ///< commander 符号化(Klieber and Kwon)
+  Product,   ///< product 符号化(Chen)
+  Bimander   ///< bimander 符号化(Nguyen and Mai)
+};
+
+/// @brief SatAmoEnc の内容を出力するストリーム演算子
+/// @ingroup SatGroup
+inline
+ostream&
+operator<<(
+  ostream& s,
+  SatAmoEnc val
+)
+{
+  switch ( val ) {
+  case SatAmoEnc::Auto:      s << "auto"; break;
+  case SatAmoEnc::Pairwise:  s << "pairwise"; break;
+  case SatAmoEnc::Halving:   s << "halving"; break;
+  case SatAmoEnc::Ladder:    s << "ladder"; break;
+  case SatAmoEnc::Commander: s << "commander"; break;
+  case SatAmoEnc::Product:   s << "product"; break;
+  case SatAmoEnc::Bimander:  s << "bimander"; break;
+  }
+  return s;
+}
+
+END_NAMESPACE_YM
+
+#endif // YM_SATAMOENC_H
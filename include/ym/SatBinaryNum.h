@@ -5,11 +5,12 @@
 /// @brief SatBinaryNum のヘッダファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2019, 2022 Yusuke Matsunaga
+/// Copyright (C) 2019, 2022, 2025 Yusuke Matsunaga
 /// All rights reserved.
 
 #include "ym/sat.h"
 #include "ym/SatLiteral.h"
+#include "ym/SatMulEnc.h"
 
 
 BEGIN_NAMESPACE_YM_SAT
@@ -17,6 +18,13 @@ BEGIN_NAMESPACE_YM_SAT
 //////////////////////////////////////////////////////////////////////
 /// @class SatBinaryNum SatBinaryNum.h "SatBinaryNum.h"
 /// @brief 2進符号化を用いて数値を表すクラス
+///
+/// * 符号なしの整数を表す．bit_var(0) が最下位ビットとなる．
+/// * add() などの演算は結果を表す新しい SatBinaryNum を返す．
+///   結果の各ビットは入力のビットから一意に決まるゲートの出力となる．
+/// * 値の決まっているビットは SatSolver::const_true() とその否定で表す．
+///   演算はビット単位で定数を畳み込むので，定数との演算では
+///   不要な節は作られない．
 //////////////////////////////////////////////////////////////////////
 class SatBinaryNum
 {
@@ -26,6 +34,8 @@ public:
   SatBinaryNum() = default;
 
   /// @brief コンストラクタ
+  ///
+  /// 各ビットには新しい決定変数を割り当てる．
   SatBinaryNum(
     SatSolver& solver, ///< [in] SATソルバ
     SizeType bit_num   ///< [in] ビット幅
@@ -34,6 +44,25 @@ public:
     init(solver, bit_num);
   }
 
+  /// @brief 既存のリテラルを用いるコンストラクタ
+  SatBinaryNum(
+    SatSolver& solver,                 ///< [in] SATソルバ
+    const vector<SatLiteral>& lit_list ///< [in] 各ビットのリテラルのリスト(下位から)
+  ) : mSolver{&solver},
+      mBitNum{lit_list.size()},
+      mVarArray{lit_list}
+  {
+  }
+
+  /// @brief 定数を表すオブジェクトを作る．
+  static
+  SatBinaryNum
+  constant(
+    SatSolver& solver, ///< [in] SATソルバ
+    SizeType bit_num,  ///< [in] ビット幅
+    SizeType val       ///< [in] 値
+  );
+
   /// @brief デストラクタ
   ~SatBinaryNum() = default;
 
@@ -44,19 +73,13 @@ public:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 初期化を行う．
+  ///
+  /// 各ビットには新しい決定変数を割り当てる．
   void
   init(
     SatSolver& solver, ///< [in] SATソルバ
     SizeType bit_num   ///< [in] ビット幅
-  )
-  {
-    mBitNum = bit_num;
-    mVarArray.clear();
-    mVarArray.resize(mBitNum);
-    for ( SizeType i = 0; i < mBitNum; ++ i ) {
-      mVarArray[i] = solver.new_variable();
-    }
-  }
+  );
 
   /// @brief ビット数を返す．
   SizeType
@@ -83,28 +106,188 @@ public:
     return mVarArray;
   }
 
+  /// @brief 全てのビットが定数の時 true を返す．
+  bool
+  is_const() const;
+
+  /// @brief 定数の値を返す．
+  ///
+  /// is_const() == true でなければならない．
+  SizeType
+  const_val() const;
+
   /// @brief SATの解から値を得る．
   SizeType
   val(
     const SatModel& model ///< [in] SATの解
-  ) const
+  ) const;
+
+  /// @brief ビット幅を変える．
+  /// @return bit_num ビットの結果を返す．
+  ///
+  /// 広げる場合には上位ビットに0を補い，狭める場合には上位ビットを捨てる．
+  SatBinaryNum
+  resize(
+    SizeType bit_num ///< [in] ビット幅
+  ) const;
+
+  /// @brief 加算を行う．
+  /// @return 和を返す．
+  ///
+  /// 結果のビット幅は max(bit_num(), right.bit_num()) + 1 で，
+  /// 最上位ビットが桁上げとなる．
+  SatBinaryNum
+  add(
+    const SatBinaryNum& right ///< [in] 右オペランド
+  ) const;
+
+  /// @brief 桁上げ入力付きの加算を行う．
+  /// @return this + right + carry_in を返す．
+  ///
+  /// 結果のビット幅は max(bit_num(), right.bit_num()) + 1 で，
+  /// 最上位ビットが桁上げとなる．
+  SatBinaryNum
+  add(
+    const SatBinaryNum& right, ///< [in] 右オペランド
+    SatLiteral carry_in        ///< [in] 桁上げ入力
+  ) const;
+
+  /// @brief 減算を行う．
+  /// @return 差を返す．
+  ///
+  /// 結果のビット幅は n + 1 (n = max(bit_num(), right.bit_num())) で，
+  /// 下位 n ビットが 2^n を法とした差，最上位ビットが借り(this < right の時 1)
+  /// となる．
+  SatBinaryNum
+  sub(
+    const SatBinaryNum& right ///< [in] 右オペランド
+  ) const;
+
+  /// @brief 借り入力付きの減算を行う．
+  /// @return this - right - borrow_in を返す．
+  ///
+  /// 結果の形式は sub(right) と同じ．
+  SatBinaryNum
+  sub(
+    const SatBinaryNum& right, ///< [in] 右オペランド
+    SatLiteral borrow_in       ///< [in] 借り入力
+  ) const;
+
+  /// @brief 乗算を行う．
+  /// @return 積を返す．
+  ///
+  /// 結果のビット幅は bit_num() + right.bit_num() で，桁あふれは起きない．
+  SatBinaryNum
+  mul(
+    const SatBinaryNum& right,        ///< [in] 右オペランド
+    SatMulEnc enc = SatMulEnc::Dadda  ///< [in] 乗算器の構成方法
+  ) const;
+
+  /// @brief 除算を行う．
+  /// @return 商を返す．
+  ///
+  /// * 結果のビット幅は bit_num() となる．
+  /// * right が 0 の場合の商は全てのビットが 1 となる．
+  SatBinaryNum
+  div(
+    const SatBinaryNum& right ///< [in] 右オペランド(除数)
+  ) const;
+
+  /// @brief 剰余を求める．
+  /// @return 剰余を返す．
+  ///
+  /// * 結果のビット幅は bit_num() となる．
+  /// * right が 0 の場合の剰余は this となる．
+  SatBinaryNum
+  mod(
+    const SatBinaryNum& right ///< [in] 右オペランド(除数)
+  ) const;
+
+  /// @brief 左シフトを行う．
+  /// @return 結果を返す．
+  ///
+  /// 結果のビット幅は bit_num() で，あふれたビットは捨てられる．
+  SatBinaryNum
+  shl(
+    SizeType shift ///< [in] シフト量
+  ) const;
+
+  /// @brief 可変量の左シフトを行う．
+  /// @return 結果を返す．
+  ///
+  /// * shift の各ビットごとに1段のマルチプレクサを用いるバレルシフタとなる．
+  /// * 結果のビット幅は bit_num() で，あふれたビットは捨てられる．
+  SatBinaryNum
+  shl(
+    const SatBinaryNum& shift ///< [in] シフト量
+  ) const;
+
+  /// @brief 論理右シフトを行う．
+  /// @return 結果を返す．
+  ///
+  /// 結果のビット幅は bit_num() で，上位ビットには0を補う．
+  SatBinaryNum
+  lshr(
+    SizeType shift ///< [in] シフト量
+  ) const;
+
+  /// @brief 可変量の論理右シフトを行う．
+  /// @return 結果を返す．
+  ///
+  /// * shift の各ビットごとに1段のマルチプレクサを用いるバレルシフタとなる．
+  /// * 結果のビット幅は bit_num() で，上位ビットには0を補う．
+  SatBinaryNum
+  lshr(
+    const SatBinaryNum& shift ///< [in] シフト量
+  ) const;
+
+  /// @brief 小さい方の値を返す．
+  ///
+  /// 結果のビット幅は max(bit_num(), right.bit_num()) となる．
+  SatBinaryNum
+  min(
+    const SatBinaryNum& right ///< [in] 右オペランド
+  ) const;
+
+  /// @brief 大きい方の値を返す．
+  ///
+  /// 結果のビット幅は max(bit_num(), right.bit_num()) となる．
+  SatBinaryNum
+  max(
+    const SatBinaryNum& right ///< [in] 右オペランド
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 結果を表すオブジェクトを作るコンストラクタ
+  SatBinaryNum(
+    SatSolver* solver,            ///< [in] SATソルバ
+    vector<SatLiteral>&& lit_list ///< [in] 各ビットのリテラルのリスト
+  ) : mSolver{solver},
+      mBitNum{lit_list.size()},
+      mVarArray{std::move(lit_list)}
   {
-    SizeType ans = 0;
-    for ( SizeType bit = 0; bit < bit_num(); ++ bit ) {
-      auto lit{bit_var(bit)};
-      if ( model[lit] == SatBool3::True ) {
-	ans |= (1 << bit);
-      }
-    }
-    return ans;
   }
 
+  /// @brief 二項演算のSATソルバを返す．
+  SatSolver&
+  _solver(
+    const SatBinaryNum& right ///< [in] 右オペランド
+  ) const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
+  // SATソルバ
+  SatSolver* mSolver{nullptr};
+
   // ビット数
   SizeType mBitNum{0};
 
@@ -0,0 +1,49 @@
+#ifndef YM_SATCARDENC_H
+#define YM_SATCARDENC_H
+
+/// @file ym/SatCardEnc.h
+/// @brief SatCardEnc の定義ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+
+
+BEGIN_NAMESPACE_YM
+
+/// @brief 個数制約(add_at_most_k() など)の符号化方法
+/// @ingroup SatGroup
+enum class SatCardEnc : std::uint8_t {
+  Auto,         ///< 入力数としきい値から自動で選ぶ
+  Counter,      ///< 2進数の 1's counter (add_counter()) と比較器
+  SeqCounter,   ///< 逐次カウンタ(Sinz)
+  Totalizer,    ///< totalizer(Bailleux and Boufkhad)
+  ModTotalizer, ///< modulo totalizer(Ogawa et al.)
+  CardNetwork   ///< 出力を打ち切った奇偶マージソートネットワーク
+};
+
+/// @brief SatCardEnc の内容を出力するストリーム演算子
+/// @ingroup SatGroup
+inline
+ostream&
+operator<<(
+  ostream& s,
+  SatCardEnc val
+)
+{
+  switch ( val ) {
+  case SatCardEnc::Auto:         s << "auto"; break;
+  case SatCardEnc::Counter:      s << "counter"; break;
+  case SatCardEnc::SeqCounter:   s << "seq_counter"; break;
+  case SatCardEnc::Totalizer:    s << "totalizer"; break;
+  case SatCardEnc::ModTotalizer: s << "mod_totalizer"; break;
+  case SatCardEnc::CardNetwork:  s << "card_network"; break;
+  }
+  return s;
+}
+
+END_NAMESPACE_YM
+
+#endif // YM_SATCARDENC_H
@@ -82,8 +82,23 @@ public:
   ) const;
 
   /// @brief 内容を DIMACS 形式で出力する．
+  ///
+  /// 出力はバッファリングしてまとめて書き出す．
+  /// thread_num が 2 以上で節の数が多い場合には
+  /// 複数のスレッドで文字列化を行う．
   void
   write_dimacs(
+    ostream& s,             ///< [in] 出力先のストリーム
+    SizeType thread_num = 1 ///< [in] 文字列化に用いるスレッド数
+  ) const;
+
+  /// @brief 内容をバイナリ CNF 形式で出力する．
+  ///
+  /// 出力したデータは read_dimacs() や SatSolver::read_DIMACS()
+  /// で読み込むことができる．
+  /// s はバイナリモードで開かれている必要がある．
+  void
+  write_binary(
     ostream& s ///< [in] 出力先のストリーム
   ) const;
 
@@ -155,29 +170,21 @@ public:
     const char* filename ///< [in] ファイル名
   )
   {
-    ifstream s{filename};
-    if ( !s ) {
-      return false;
-    }
-
-    return read_dimacs(s);
+    return read_dimacs(string{filename});
   }
 
   /// @brief DIMACS 形式のファイルを読んで SatDimacs に設定する．
   /// @retval true 読み込みが成功した．
   /// @retval false 読み込みが失敗した．
+  ///
+  /// ファイルはメモリマップして読み込む．
+  /// gzip/bzip2/xz で圧縮されたファイルは別スレッドで展開しながら読み込む．
+  /// write_binary() で出力したバイナリ CNF 形式のファイルも読み込める．
+  /// (形式は拡張子ではなくファイルの先頭のマジックナンバーで判定する)
   bool
   read_dimacs(
     const string& filename ///< [in] ファイル名
-  )
-  {
-    ifstream s{filename};
-    if ( !s ) {
-      return false;
-    }
-
-    return read_dimacs(s);
-  }
+  );
 
   /// @brief 直前の read_dimacs() のメッセージを返す．
   const vector<string>&
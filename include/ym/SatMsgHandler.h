@@ -53,6 +53,21 @@ public:
   void
   print_footer(const SatStats& stats) = 0;
 
+  /// @brief 最適化の途中経過の出力
+  ///
+  /// SatSolver::minimize() で目的関数の下界か上界が更新される
+  /// たびに呼ばれる．
+  /// 解が見つかるまでは上界は目的関数の取りうる最大値となる．
+  /// デフォルトの実装は何もしない．
+  virtual
+  void
+  print_bound(
+    std::int64_t, ///< [in] 最適値の下界
+    std::int64_t  ///< [in] 最適値の上界(見つかった解の値)
+  )
+  {
+  }
+
 };
 
 END_NAMESPACE_YM_SAT
@@ -49,6 +49,13 @@ public:
   void
   print_footer(const SatStats& stats) override;
 
+  /// @brief 最適化の途中経過の出力
+  void
+  print_bound(
+    std::int64_t lower, ///< [in] 最適値の下界
+    std::int64_t upper  ///< [in] 最適値の上界(見つかった解の値)
+  ) override;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -0,0 +1,43 @@
+#ifndef YM_SATMULENC_H
+#define YM_SATMULENC_H
+
+/// @file ym/SatMulEnc.h
+/// @brief SatMulEnc の定義ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+
+
+BEGIN_NAMESPACE_YM
+
+/// @brief 乗算器(SatBinaryNum::mul())の構成方法
+/// @ingroup SatGroup
+enum class SatMulEnc : std::uint8_t {
+  ShiftAdd, ///< 部分積を1行ずつ加算する配列型
+  Wallace,  ///< Wallace tree で部分積を圧縮する
+  Dadda     ///< Dadda tree で部分積を圧縮する
+};
+
+/// @brief SatMulEnc の内容を出力するストリーム演算子
+/// @ingroup SatGroup
+inline
+ostream&
+operator<<(
+  ostream& s,
+  SatMulEnc val
+)
+{
+  switch ( val ) {
+  case SatMulEnc::ShiftAdd: s << "shift_add"; break;
+  case SatMulEnc::Wallace:  s << "wallace"; break;
+  case SatMulEnc::Dadda:    s << "dadda"; break;
+  }
+  return s;
+}
+
+END_NAMESPACE_YM
+
+#endif // YM_SATMULENC_H
@@ -0,0 +1,43 @@
+#ifndef YM_SATOPTSTRATEGY_H
+#define YM_SATOPTSTRATEGY_H
+
+/// @file ym/SatOptStrategy.h
+/// @brief SatOptStrategy の定義ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+
+
+BEGIN_NAMESPACE_YM
+
+/// @brief 最適化(SatSolver::minimize())の探索方法
+/// @ingroup SatGroup
+enum class SatOptStrategy : std::uint8_t {
+  SatUnsat, ///< 解の値より小さい上界を順に課して充足不能になるまで繰り返す
+  UnsatSat, ///< 下界から1ずつ上界を緩めて最初に充足した値を最適値とする
+  Binary    ///< 下界と上界の間を二分探索する
+};
+
+/// @brief SatOptStrategy の内容を出力するストリーム演算子
+/// @ingroup SatGroup
+inline
+ostream&
+operator<<(
+  ostream& s,
+  SatOptStrategy val
+)
+{
+  switch ( val ) {
+  case SatOptStrategy::SatUnsat: s << "sat_unsat"; break;
+  case SatOptStrategy::UnsatSat: s << "unsat_sat"; break;
+  case SatOptStrategy::Binary:   s << "binary"; break;
+  }
+  return s;
+}
+
+END_NAMESPACE_YM
+
+#endif // YM_SATOPTSTRATEGY_H
@@ -5,11 +5,12 @@
 /// @brief SatOrderedSet のヘッダファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2019, 2022 Yusuke Matsunaga
+/// Copyright (C) 2019, 2022, 2025 Yusuke Matsunaga
 /// All rights reserved.
 
 #include "ym/sat.h"
 #include "ym/SatLiteral.h"
+#include <set>
 
 
 BEGIN_NAMESPACE_YM_SAT
@@ -21,6 +22,13 @@ BEGIN_NAMESPACE_YM_SAT
 /// * 最小値と最大値の間の整数を値として取る．
 /// * 最小値 <= 最大値であれば負数でも構わない
 /// * 整数の大小関係に基づく順序関係を持つ．
+/// * lazy = true で作った場合，変数は pri_var() や var() などで
+///   必要になった時に作られる．定義域の広い変数で一部の値しか
+///   制約に現れない場合に変数と節の数を減らせる．
+///   変数を作る関数は const だが，その時に順序制約の節も追加される．
+///   この節は変数の定義なので条件リテラルは付加されない．
+/// * 変数間の制約は support clause による符号化(Tamura et al.)を用いる．
+/// * 遅延生成の状態を共有できないのでコピーは禁止する．
 //////////////////////////////////////////////////////////////////////
 class SatOrderedSet
 {
@@ -30,9 +38,26 @@ public:
   SatOrderedSet(
     SatSolver& solver, ///< [in] SATソルバ
     int min,           ///< [in] 最小値
-    int max            ///< [in] 最大値
+    int max,           ///< [in] 最大値
+    bool lazy = false  ///< [in] 変数を必要になった時に作る時 true にする．
   );
 
+  /// @brief コピーコンストラクタは禁止
+  SatOrderedSet(
+    const SatOrderedSet& src
+  ) = delete;
+
+  /// @brief ムーブコンストラクタ
+  SatOrderedSet(
+    SatOrderedSet&& src
+  ) = default;
+
+  /// @brief 代入演算子は禁止
+  SatOrderedSet&
+  operator=(
+    const SatOrderedSet& src
+  ) = delete;
+
   /// @brief デストラクタ
   ~SatOrderedSet() = default;
 
@@ -66,15 +91,18 @@ public:
   {
     ASSERT_COND( mMin <= val && val <= mMax );
 
-    return mVarArray[val - mMin];
+    auto lit = mVarArray[val - mMin];
+    if ( !lit.is_valid() ) {
+      lit = _new_var(val);
+    }
+    return lit;
   }
 
   /// @brief 値に対応する変数のベクタを返す．
+  ///
+  /// lazy = true の場合は全ての変数が作られる．
   const vector<SatLiteral>&
-  vars() const
-  {
-    return mVarArray;
-  }
+  vars() const;
 
   /// @brief 順序符号化された変数を返す．
   ///
@@ -88,14 +116,39 @@ public:
   {
     ASSERT_COND( mMin < val && val <= mMax );
 
-    return mPriVarArray[val - mMin - 1];
+    auto lit = mPriVarArray[val - mMin - 1];
+    if ( !lit.is_valid() ) {
+      lit = _new_pri_var(val);
+    }
+    return lit;
   }
 
   /// @brief 順序符号化された変数のベクタを返す．
+  ///
+  /// lazy = true の場合は全ての変数が作られる．
   const vector<SatLiteral>&
-  pri_vars() const
+  pri_vars() const;
+
+  /// @brief 値が val 以上であることを表すリテラルを返す．
+  ///
+  /// val が範囲外の場合は SatSolver::const_true() (もしくはその否定)を返す．
+  SatLiteral
+  ge_lit(
+    int val ///< [in] 値
+  ) const;
+
+  /// @brief 値が val 以下であることを表すリテラルを返す．
+  ///
+  /// val が範囲外の場合は SatSolver::const_true() (もしくはその否定)を返す．
+  SatLiteral
+  le_lit(
+    int val ///< [in] 値
+  ) const
   {
-    return mPriVarArray;
+    if ( val >= mMax ) {
+      return ge_lit(mMin);
+    }
+    return ~ge_lit(val + 1);
   }
 
   /// @brief この変数の値が lval 以上になるという制約を作る．
@@ -120,6 +173,74 @@ public:
     int lval  ///< [in] 下限値
   );
 
+  /// @brief this + y <= c という制約を作る．
+  void
+  add_sum_le_constraint(
+    const SatOrderedSet& y, ///< [in] 相手の変数
+    int c                   ///< [in] 上限値
+  );
+
+  /// @brief this + y >= c という制約を作る．
+  void
+  add_sum_ge_constraint(
+    const SatOrderedSet& y, ///< [in] 相手の変数
+    int c                   ///< [in] 下限値
+  );
+
+  /// @brief this + y == z という制約を作る．
+  void
+  add_sum_eq_constraint(
+    const SatOrderedSet& y, ///< [in] 相手の変数
+    const SatOrderedSet& z  ///< [in] 和を表す変数
+  );
+
+  /// @brief this - y <= c という制約を作る．
+  void
+  add_diff_le_constraint(
+    const SatOrderedSet& y, ///< [in] 相手の変数
+    int c                   ///< [in] 上限値
+  );
+
+  /// @brief Σ coef_list[i] * var_list[i] <= c という制約を作る．
+  ///
+  /// * 項数が3を超える場合には部分和を表す変数(lazy = true)を
+  ///   導入して3項以下の制約に分解する．
+  /// * 節数は最後の項を除いた各項の値の数の積となる．
+  static
+  void
+  add_linear_le_constraint(
+    const vector<int>& coef_list,                 ///< [in] 係数のリスト
+    const vector<const SatOrderedSet*>& var_list, ///< [in] 変数のリスト
+    int c                                         ///< [in] 上限値
+  );
+
+  /// @brief Σ coef_list[i] * var_list[i] >= c という制約を作る．
+  static
+  void
+  add_linear_ge_constraint(
+    const vector<int>& coef_list,                 ///< [in] 係数のリスト
+    const vector<const SatOrderedSet*>& var_list, ///< [in] 変数のリスト
+    int c                                         ///< [in] 下限値
+  );
+
+  /// @brief Σ coef_list[i] * var_list[i] == c という制約を作る．
+  static
+  void
+  add_linear_eq_constraint(
+    const vector<int>& coef_list,                 ///< [in] 係数のリスト
+    const vector<const SatOrderedSet*>& var_list, ///< [in] 変数のリスト
+    int c                                         ///< [in] 値
+  );
+
+  /// @brief 全ての変数の値が異なるという制約を作る．
+  ///
+  /// 値ごとに var() の at-most-one 制約を作る．
+  static
+  void
+  add_alldiff_constraint(
+    const vector<const SatOrderedSet*>& var_list ///< [in] 変数のリスト
+  );
+
   /// @brief SATの解から値を得る．
   int
   val(
@@ -127,6 +248,32 @@ public:
   ) const;
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief pri_var(val) の変数を作る．
+  SatLiteral
+  _new_pri_var(
+    int val ///< [in] 値 ( min < val <= max )
+  ) const;
+
+  /// @brief var(val) の変数を作る．
+  ///
+  /// 遅延生成用に条件リテラルを無効化して _make_var() を呼ぶ．
+  SatLiteral
+  _new_var(
+    int val ///< [in] 値 ( min <= val <= max )
+  ) const;
+
+  /// @brief var(val) の変数と one-hot 符号化の節を作る．
+  SatLiteral
+  _make_var(
+    int val ///< [in] 値 ( min <= val <= max )
+  ) const;
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -142,10 +289,15 @@ private:
   int mMax;
 
   // 変数(実際にはリテラル)の配列
-  vector<SatLiteral> mVarArray;
+  // 遅延生成の場合，まだ作られていない要素は SatLiteral::X となる．
+  mutable vector<SatLiteral> mVarArray;
 
   // 順序符号化された裏の変数
-  vector<SatLiteral> mPriVarArray;
+  // 遅延生成の場合，まだ作られていない要素は SatLiteral::X となる．
+  mutable vector<SatLiteral> mPriVarArray;
+
+  // 遅延生成で作られた順序符号化の変数の値のリスト
+  mutable std::set<int> mPriValSet;
 
 };
 
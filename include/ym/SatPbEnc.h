@@ -0,0 +1,47 @@
+#ifndef YM_SATPBENC_H
+#define YM_SATPBENC_H
+
+/// @file ym/SatPbEnc.h
+/// @brief SatPbEnc の定義ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+
+
+BEGIN_NAMESPACE_YM
+
+/// @brief 擬似ブール制約(add_pb_le() など)を節に展開する方法
+/// @ingroup SatGroup
+enum class SatPbEnc : std::uint8_t {
+  Auto,         ///< 実装に渡すか，制約の大きさから自動で選ぶ
+  Adder,        ///< 重みのビットごとのカウンタと加算器
+  Bdd,          ///< 区間で共有した BDD(Abio et al.)
+  GenTotalizer, ///< generalized totalizer(Joshi et al.)
+  SortNetwork   ///< 重みの数だけ複製した入力のソーティングネットワーク
+};
+
+/// @brief SatPbEnc の内容を出力するストリーム演算子
+/// @ingroup SatGroup
+inline
+ostream&
+operator<<(
+  ostream& s,
+  SatPbEnc val
+)
+{
+  switch ( val ) {
+  case SatPbEnc::Auto:         s << "auto"; break;
+  case SatPbEnc::Adder:        s << "adder"; break;
+  case SatPbEnc::Bdd:          s << "bdd"; break;
+  case SatPbEnc::GenTotalizer: s << "gen_totalizer"; break;
+  case SatPbEnc::SortNetwork:  s << "sort_network"; break;
+  }
+  return s;
+}
+
+END_NAMESPACE_YM
+
+#endif // YM_SATPBENC_H
@@ -9,20 +9,27 @@
 /// All rights reserved.
 
 #include "ym/sat.h"
+#include "ym/SatAmoEnc.h"
 #include "ym/SatBool3.h"
+#include "ym/SatCardEnc.h"
 #include "ym/SatLiteral.h"
 #include "ym/SatModel.h"
+#include "ym/SatOptStrategy.h"
+#include "ym/SatPbEnc.h"
 #include "ym/SatInitParam.h"
 #include "ym/SatStats.h"
 #include "ym/CnfSize.h"
 #include "ym/Expr.h"
 #include "ym/AigHandle.h"
+#include <functional>
 
 
 BEGIN_NAMESPACE_YM_SAT
 
 class SatSolverImpl;
 class SatLogger;
+class Aig2Cnf;
+class Expr2Cnf;
 
 //////////////////////////////////////////////////////////////////////
 /// @class SatSolver SatSolver.h "ym/SatSolver.h"
@@ -46,6 +53,17 @@ public:
 
   /// @brief コンストラクタ
   ///
+  /// 通常は write_DIMACS() や solve_batch() のために追加された節の
+  /// コピーを保持するが，init_param の JSON オブジェクトで
+  /// "lean": true を指定すると保持しない(省メモリモード)．
+  /// また "tseitin_encoding": true を指定すると add_expr()/add_aig() で
+  /// Tseitin 符号化を用いる．"xor_cut": <値> で add_expr() の
+  /// XOR を分解する単位を指定できる．"native_xor": false を指定すると
+  /// add_xor_constraint() を，"native_pb": false を指定すると
+  /// add_card_le() などの擬似ブール制約を常に節に展開する．
+  /// "card_encoding": "totalizer" などで個数制約の符号化方法を，
+  /// "amo_encoding": "ladder" などで at-most-one 制約の符号化方法を，
+  /// "pb_encoding": "bdd" などで擬似ブール制約の展開方法を指定できる．
   /// @sa SatInitParam
   SatSolver(
     const SatInitParam& init_param = SatInitParam{} ///< [in] 初期化パラメータ
@@ -54,6 +72,17 @@ public:
   /// @brief デストラクタ
   ~SatSolver();
 
+  /// @brief 変数と節をすべて削除して生成直後の状態に戻す．
+  ///
+  /// * 実装が対応していれば確保済みの領域を再利用するので，
+  ///   小さな問題を繰り返し解く場合に生成し直すよりも速い．
+  /// * 対応していない実装の場合には同じパラメータで作り直す．
+  ///   その場合も登録されていたメッセージハンドラは新しい実装に登録し直される．
+  /// * 条件リテラルもクリアされる．
+  /// * set_conflict_budget()/set_propagation_budget() の制限値も解除される．
+  void
+  reset();
+
   //////////////////////////////////////////////////////////////////////
   /// @}
   //////////////////////////////////////////////////////////////////////
@@ -75,6 +104,14 @@ public:
     bool decision = false ///< [in] 決定変数の時に true とする．
   );
 
+  /// @brief 定数1を表すリテラルを返す．
+  ///
+  /// * 最初に呼ばれた時に変数を作り，それを true に固定する単位節を加える．
+  /// * この単位節には条件リテラルは付加されない．
+  /// * 否定をとれば定数0を表すリテラルになる．
+  SatLiteral
+  const_true();
+
   /// @brief 条件リテラルを設定する．
   ///
   /// 以降の add_clause() にはこのリテラルの否定が追加される．
@@ -160,7 +197,37 @@ public:
     const vector<SatLiteral>& lits ///< [in] リテラルのリスト
   )
   {
-    _add_clause(lits);
+    _add_clause(lits.size(), lits.data());
+  }
+
+  /// @brief 配列で表された節を追加する．
+  ///
+  /// 条件リテラルがない場合には lits をコピーせずに実装に渡す．
+  void
+  add_clause(
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
+  )
+  {
+    _add_clause(n, lits);
+  }
+
+  /// @brief 複数の節をまとめて追加する．
+  ///
+  /// i 番目の節は lit_list の begin_list[i] から begin_list[i + 1] の
+  /// 直前までとなる．
+  /// そのため begin_list の要素数は節の数 + 1 で，先頭は 0 となる．
+  /// 節ごとの領域確保を行わずに実装に渡すので，
+  /// 大量の節を追加する場合には add_clause() を繰り返すよりも速い．
+  void
+  add_clauses(
+    const vector<SatLiteral>& lit_list, ///< [in] 全ての節のリテラルのリスト
+    const vector<SizeType>& begin_list  ///< [in] 各節の開始位置のリスト
+  )
+  {
+    if ( !begin_list.empty() ) {
+      _add_clauses(begin_list.size() - 1, lit_list.data(), begin_list.data());
+    }
   }
 
   /// @brief 1項の節(リテラル)を追加する．
@@ -242,6 +309,90 @@ public:
     _add_clause(6, tmp_lits);
   }
 
+  /// @brief XOR 制約を追加する．
+  ///
+  /// * lits の XOR が rhs に等しいという制約を追加する．
+  /// * 実装が対応している場合(ymsat 系)はそのまま実装に渡され，
+  ///   Gauss-Jordan 消去と XOR 制約用の含意で処理される．
+  /// * 対応していない実装の場合，条件リテラルがある場合，
+  ///   native_xor() が false の場合には xor_cut() 個ずつの XOR に
+  ///   分解して節に展開する．
+  /// * 実装に渡された XOR 制約は節ではないので write_DIMACS() や
+  ///   write_binary_CNF() では出力できない．
+  void
+  add_xor_constraint(
+    const vector<SatLiteral>& lits, ///< [in] リテラルのリスト
+    bool rhs                        ///< [in] 右辺の値
+  )
+  {
+    _add_xor_constraint(lits.size(), lits.data(), rhs);
+  }
+
+  /// @brief 与えられたリテラルのうち true になる個数が k 以下という制約を追加する．
+  ///
+  /// * add_at_most_k() と異なり，実装が対応している場合(ymsat 系)は
+  ///   基数制約のまま実装に渡されるので補助変数や節を作らない．
+  /// * 対応していない実装の場合や native_pb() が false の場合には
+  ///   add_at_most_k() と同様に節に展開する．
+  /// * 実装に渡された制約は節ではないので write_DIMACS() や
+  ///   write_binary_CNF() では出力できない．
+  void
+  add_card_le(
+    const vector<SatLiteral>& lit_list, ///< [in] リテラルのリスト
+    SizeType k                          ///< [in] しきい値
+  );
+
+  /// @brief 与えられたリテラルのうち true になる個数が k 以上という制約を追加する．
+  ///
+  /// 扱いは add_card_le() と同様
+  void
+  add_card_ge(
+    const vector<SatLiteral>& lit_list, ///< [in] リテラルのリスト
+    SizeType k                          ///< [in] しきい値
+  );
+
+  /// @brief Σ weight_list[i] * lit_list[i] <= bound という擬似ブール制約を追加する．
+  ///
+  /// * 重みは負でもよい．同じ変数が複数回現れてもよい．
+  /// * 重みが正で変数の重複がない形に正規化し，重みの最大公約数で
+  ///   両辺を割ってから処理する．
+  /// * enc が SatPbEnc::Auto の場合は pb_encoding() に従う．
+  ///   それも SatPbEnc::Auto の場合，実装が対応していれば(ymsat 系)
+  ///   そのまま実装に渡される．
+  /// * それ以外の場合には enc で指定された方法で節に展開する．
+  /// * 実装に渡された制約は節ではないので write_DIMACS() や
+  ///   write_binary_CNF() では出力できない．
+  void
+  add_pb_le(
+    const vector<int>& weight_list,     ///< [in] 重みのリスト
+    const vector<SatLiteral>& lit_list, ///< [in] リテラルのリスト
+    int bound,                          ///< [in] 右辺の値
+    SatPbEnc enc = SatPbEnc::Auto       ///< [in] 節に展開する方法
+  );
+
+  /// @brief Σ weight_list[i] * lit_list[i] >= bound という擬似ブール制約を追加する．
+  ///
+  /// 扱いは add_pb_le() と同様
+  void
+  add_pb_ge(
+    const vector<int>& weight_list,     ///< [in] 重みのリスト
+    const vector<SatLiteral>& lit_list, ///< [in] リテラルのリスト
+    int bound,                          ///< [in] 右辺の値
+    SatPbEnc enc = SatPbEnc::Auto       ///< [in] 節に展開する方法
+  );
+
+  /// @brief Σ weight_list[i] * lit_list[i] == bound という擬似ブール制約を追加する．
+  ///
+  /// * add_pb_ge() と add_pb_le() の2つの制約として追加する．
+  /// * 扱いは add_pb_le() と同様
+  void
+  add_pb_eq(
+    const vector<int>& weight_list,     ///< [in] 重みのリスト
+    const vector<SatLiteral>& lit_list, ///< [in] リテラルのリスト
+    int bound,                          ///< [in] 右辺の値
+    SatPbEnc enc = SatPbEnc::Auto       ///< [in] 節に展開する方法
+  );
+
   //////////////////////////////////////////////////////////////////////
   /// @}
   //////////////////////////////////////////////////////////////////////
@@ -517,7 +668,8 @@ public:
     SatLiteral lit4  ///< [in] 入力のリテラル4
   )
   {
-    _add_xorgate_sub(olit, vector<SatLiteral>{lit1, lit2, lit3, lit4}, 0, 4);
+    SatLiteral tmp_lits[] = {lit1, lit2, lit3, lit4};
+    _add_xorgate_sub(olit, tmp_lits, 4);
   }
 
   /// @brief n入力XORゲートの入出力の関係を表す条件を追加する．
@@ -528,7 +680,7 @@ public:
   )
   {
     SizeType n = lit_list.size();
-    _add_xorgate_sub(olit, lit_list, 0, n);
+    _add_xorgate_sub(olit, lit_list.data(), n);
   }
 
   /// @brief 2入力XNORゲートの入出力の関係を表す条件を追加する．
@@ -577,16 +729,197 @@ public:
     add_xorgate(~olit, lit_list);
   }
 
+  /// @brief add_expr()/add_aig() で Tseitin 符号化を用いる時 true を返す．
+  bool
+  tseitin_encoding() const
+  {
+    return mTseitinEncoding;
+  }
+
+  /// @brief add_expr()/add_aig() の符号化方法を設定する．
+  ///
+  /// * false の場合(デフォルト)は実際に用いられる極性の節のみを生成する
+  ///   (Plaisted-Greenbaum 符号化)．結果のリテラルを否定しても
+  ///   元の式が偽となる条件にはならない．
+  /// * true の場合は新しい変数と部分式が等価になるように両方向の節を
+  ///   生成する(Tseitin 符号化)．節の数は増えるが，生成された変数を
+  ///   他の制約で両方の極性で用いることができる．
+  /// * init_param の JSON オブジェクトで "tseitin_encoding": true を指定
+  ///   しても設定できる．
+  /// * 変換済みの部分式が後から別の極性で用いられた場合には
+  ///   その時点で不足している節が追加される．
+  void
+  set_tseitin_encoding(
+    bool enable ///< [in] Tseitin 符号化を用いる時 true
+  )
+  {
+    mTseitinEncoding = enable;
+  }
+
+  /// @brief add_expr() で XOR を分解する単位を返す．
+  SizeType
+  xor_cut() const
+  {
+    return mXorCut;
+  }
+
+  /// @brief add_expr() で XOR を分解する単位を設定する．
+  ///
+  /// * オペランド数が cut を超える XOR は cut 個以下ずつの XOR の木に
+  ///   分解される．
+  /// * cut 入力の XOR 1つあたり 2^cut 個の節が作られるので，大きくすると
+  ///   変数は減るが節は増える．
+  /// * 2 から MAX_XOR_CUT の範囲に丸められる．デフォルトは 2
+  /// * init_param の JSON オブジェクトで "xor_cut": <値> を指定
+  ///   しても設定できる．
+  void
+  set_xor_cut(
+    SizeType cut ///< [in] 分解の単位
+  )
+  {
+    if ( cut < 2 ) {
+      cut = 2;
+    }
+    else if ( cut > MAX_XOR_CUT ) {
+      cut = MAX_XOR_CUT;
+    }
+    mXorCut = cut;
+  }
+
+  /// @brief xor_cut() の最大値
+  static const SizeType MAX_XOR_CUT = 8;
+
+  /// @brief add_xor_constraint() を実装に渡す時 true を返す．
+  bool
+  native_xor() const
+  {
+    return mNativeXor;
+  }
+
+  /// @brief add_xor_constraint() の処理方法を設定する．
+  ///
+  /// * true の場合(デフォルト)は実装が対応していれば XOR 制約のまま渡す．
+  /// * false の場合は常に節に展開する．
+  /// * init_param の JSON オブジェクトで "native_xor": false を指定
+  ///   しても設定できる．
+  void
+  set_native_xor(
+    bool enable ///< [in] XOR 制約を実装に渡す時 true
+  )
+  {
+    mNativeXor = enable;
+  }
+
+  /// @brief add_card_le() などの制約を実装に渡す時 true を返す．
+  bool
+  native_pb() const
+  {
+    return mNativePb;
+  }
+
+  /// @brief add_card_le(), add_card_ge(), add_pb_le(), add_pb_ge() の処理方法を設定する．
+  ///
+  /// * true の場合(デフォルト)は実装が対応していれば制約のまま渡す．
+  /// * false の場合は常に節に展開する．
+  /// * init_param の JSON オブジェクトで "native_pb": false を指定
+  ///   しても設定できる．
+  void
+  set_native_pb(
+    bool enable ///< [in] 制約を実装に渡す時 true
+  )
+  {
+    mNativePb = enable;
+  }
+
+  /// @brief add_pb_le() などの擬似ブール制約を節に展開する方法を返す．
+  SatPbEnc
+  pb_encoding() const
+  {
+    return mPbEnc;
+  }
+
+  /// @brief add_pb_le() などの擬似ブール制約を節に展開する方法を設定する．
+  ///
+  /// * 個々の呼び出しで SatPbEnc::Auto 以外が指定された場合には
+  ///   そちらが優先される．
+  /// * SatPbEnc::Auto 以外を設定すると native_pb() が true でも
+  ///   add_pb_le() などは節に展開される．
+  /// * init_param の JSON オブジェクトで "pb_encoding": <名前> を指定
+  ///   しても設定できる．名前は operator<<(ostream&, SatPbEnc) の
+  ///   出力と同じ("bdd" など)．
+  void
+  set_pb_encoding(
+    SatPbEnc enc ///< [in] 展開する方法
+  )
+  {
+    mPbEnc = enc;
+  }
+
+  /// @brief add_at_most_k() などの個数制約の符号化方法を返す．
+  SatCardEnc
+  card_encoding() const
+  {
+    return mCardEnc;
+  }
+
+  /// @brief add_at_most_k() などの個数制約の符号化方法を設定する．
+  ///
+  /// * 個々の呼び出しで SatCardEnc::Auto 以外が指定された場合には
+  ///   そちらが優先される．
+  /// * SatCardEnc::Auto の場合(デフォルト)は入力数としきい値から選ぶ．
+  /// * init_param の JSON オブジェクトで "card_encoding": <名前> を指定
+  ///   しても設定できる．名前は operator<<(ostream&, SatCardEnc) の
+  ///   出力と同じ("totalizer" など)．
+  void
+  set_card_encoding(
+    SatCardEnc enc ///< [in] 符号化方法
+  )
+  {
+    mCardEnc = enc;
+  }
+
+  /// @brief add_at_most_one() などの at-most-one 制約の符号化方法を返す．
+  SatAmoEnc
+  amo_encoding() const
+  {
+    return mAmoEnc;
+  }
+
+  /// @brief add_at_most_one() などの at-most-one 制約の符号化方法を設定する．
+  ///
+  /// * 個々の呼び出しで SatAmoEnc::Auto 以外が指定された場合には
+  ///   そちらが優先される．
+  /// * SatAmoEnc::Auto の場合(デフォルト)は入力数から選ぶ．
+  /// * init_param の JSON オブジェクトで "amo_encoding": <名前> を指定
+  ///   しても設定できる．名前は operator<<(ostream&, SatAmoEnc) の
+  ///   出力と同じ("ladder" など)．
+  void
+  set_amo_encoding(
+    SatAmoEnc enc ///< [in] 符号化方法
+  )
+  {
+    mAmoEnc = enc;
+  }
+
   /// @brief 与えられた論理式を充足する条件を追加する．
   /// @return 条件を表すリテラルのリストを返す．
   ///
-  /// 変数番号が lit_map に登録されていない時は例外が創出される．
+  /// * 変数番号が lit_map に登録されていない時は例外が創出される．
+  /// * 新しい変数を作る部分式はオペランドのリテラルをキーとして
+  ///   ソルバ内に記録され，以降に同じ条件リテラルのもとで構造的に
+  ///   等しい部分式が現れた場合には同じ変数が再利用される．
   vector<SatLiteral>
   add_expr(
     const Expr& expr,     ///< [in] 対象の論理式
     const LitMap& lit_map ///< [in] 論理式中の変数番号とリテラルの対応関係を表す辞書
   );
 
+  /// @brief add_expr() の変換結果をすべて捨てる．
+  ///
+  /// 以降の add_expr() では全ての部分式を新たに変換する．
+  void
+  clear_expr_cache();
+
   /// @brief 与えられたAIGを充足する条件を追加する．
   /// @return 条件を表すリテラルのリストを返す．
   ///
@@ -604,13 +937,21 @@ public:
   /// @brief 与えられたAIGを充足する条件を追加する．
   /// @return 条件を表すリテラルのリストのリストを返す．
   ///
-  /// 変数番号が lit_map に登録されていない時は例外が創出される．
+  /// * 変数番号が lit_map に登録されていない時は例外が創出される．
+  /// * 変換結果はソルバ内に保持され，以降に同じ lit_map と条件リテラルで
+  ///   呼ばれた場合には変換済みのノードの結果が再利用される．
   vector<vector<SatLiteral>>
   add_aig(
     const vector<AigHandle>& aig_list, ///< [in] 対象のAIGのリスト
     const LitMap& lit_map              ///< [in] AIGの変数番号とリテラルの対応関係を表す辞書
   );
 
+  /// @brief add_aig() の変換結果をすべて捨てる．
+  ///
+  /// 以降の add_aig() では全てのノードを新たに変換する．
+  void
+  clear_aig_cache();
+
   /// @brief half_adder の入出力の関係を表す条件を追加する．
   void
   add_half_adder(
@@ -651,6 +992,30 @@ public:
     bool decision = false            ///< [in] 生成する変数を decision variable にする時 true にする．
   );
 
+  /// @brief 個数を単進数で表すカウンタの入出力の関係を表す条件を追加する．
+  /// @return 出力のリテラルのリストを返す．
+  ///
+  /// * 出力の i 番目のリテラルは入力のうち i + 1 個以上が true の時，
+  ///   かつその時に限り true となる．
+  /// * 出力は m 個(入力数の方が小さければ入力数)で打ち切られる．
+  /// * enc には SatCardEnc::SeqCounter, SatCardEnc::Totalizer,
+  ///   SatCardEnc::CardNetwork が指定できる．それ以外の場合は
+  ///   SatCardEnc::Totalizer を用いる．
+  /// * 生成する変数は決定変数ではないので，出力の値は入力から
+  ///   含意される場合にのみモデルに現れる．
+  vector<SatLiteral>
+  add_unary_counter(
+    const vector<SatLiteral>& ilits,       ///< [in] 入力のリテラルのリスト
+    SizeType m,                            ///< [in] 出力数の上限
+    SatCardEnc enc = SatCardEnc::Totalizer ///< [in] 符号化方法
+  )
+  {
+    if ( enc != SatCardEnc::SeqCounter && enc != SatCardEnc::CardNetwork ) {
+      enc = SatCardEnc::Totalizer;
+    }
+    return _add_unary_counter(ilits, m, enc, true, true);
+  }
+
   /// @brief 与えられたリテラルのうち1つしか true にならない条件を追加する．
   void
   add_at_most_one(
@@ -742,9 +1107,12 @@ public:
   }
 
   /// @brief 与えられたリテラルのうち1つしか true にならない条件を追加する．
+  ///
+  /// * enc が SatAmoEnc::Auto の場合は amo_encoding() に従う．
   void
   add_at_most_one(
-    const vector<SatLiteral>& lit_list ///< [in] 入力のリテラルのリスト
+    const vector<SatLiteral>& lit_list, ///< [in] 入力のリテラルのリスト
+    SatAmoEnc enc = SatAmoEnc::Auto     ///< [in] 符号化方法
   );
 
   /// @brief 与えられたリテラルのうち2つしか true にならない条件を追加する．
@@ -845,10 +1213,13 @@ public:
   );
 
   /// @brief 与えられたリテラルのうちk個しか true にならない条件を追加する．
+  ///
+  /// * enc が SatCardEnc::Auto の場合は card_encoding() に従う．
   void
   add_at_most_k(
     const vector<SatLiteral>& lit_list, ///< [in] 入力のリテラルのリスト
-    SizeType k                          ///< [in] しきい値
+    SizeType k,                         ///< [in] しきい値
+    SatCardEnc enc = SatCardEnc::Auto   ///< [in] 符号化方法
   );
 
   /// @brief 与えられたリテラルのうち1以上は true になる条件を追加する．
@@ -1006,10 +1377,13 @@ public:
   );
 
   /// @brief 与えられたリテラルのうちk個以上は true になる条件を追加する．
+  ///
+  /// * enc が SatCardEnc::Auto の場合は card_encoding() に従う．
   void
   add_at_least_k(
     const vector<SatLiteral>& lit_list, ///< [in] 入力のリテラルのリスト
-    SizeType k                          ///< [in] しきい値
+    SizeType k,                         ///< [in] しきい値
+    SatCardEnc enc = SatCardEnc::Auto   ///< [in] 符号化方法
   );
 
   /// @brief 与えられたリテラルのうち厳密に1つが true になる条件を追加する．
@@ -1078,9 +1452,12 @@ public:
   }
 
   /// @brief 与えられたリテラルのうち厳密に1つが true になる条件を追加する．
+  ///
+  /// * enc が SatAmoEnc::Auto の場合は amo_encoding() に従う．
   void
   add_exact_one(
-    const vector<SatLiteral>& lit_list ///< [in] 入力のリテラルのリスト
+    const vector<SatLiteral>& lit_list, ///< [in] 入力のリテラルのリスト
+    SatAmoEnc enc = SatAmoEnc::Auto     ///< [in] 符号化方法
   );
 
   /// @brief 与えられたリテラルのうち厳密に2つが true になる条件を追加する．
@@ -1155,15 +1532,15 @@ public:
   );
 
   /// @brief 与えられたリテラルのうち厳密にk個が true になる条件を追加する．
+  ///
+  /// * enc が SatCardEnc::Auto の場合は card_encoding() に従う．
+  /// * 単進数の出力を持つ符号化では上限と下限で同じカウンタを共有する．
   void
   add_exact_k(
     const vector<SatLiteral>& lit_list, ///< [in] 入力のリテラルのリスト
-    SizeType k                          ///< [in] しきい値
-  )
-  {
-    add_at_most_k(lit_list, k);
-    add_at_least_k(lit_list, k);
-  }
+    SizeType k,                         ///< [in] しきい値
+    SatCardEnc enc = SatCardEnc::Auto   ///< [in] 符号化方法
+  );
 
   /// @brief 与えられたリテラルのうちtrueになっている個数が1でない条件を追加する．
   void
@@ -1241,9 +1618,16 @@ public:
   }
 
   /// @brief 与えられたリテラルのうちtrueになっている個数が1でない条件を追加する．
+  ///
+  /// * enc が SatAmoEnc::Auto の場合は amo_encoding() に従う．
+  /// * SatAmoEnc::Pairwise では1つだけを反転させた n 個の節を作る．
+  /// * SatAmoEnc::Ladder では「1個以上」と「2個以上」を表す変数を
+  ///   先頭から順に作る．それ以外は二分木状に作る．
+  ///   どちらも節のリテラル数の合計は O(n) となる．
   void
   add_not_one(
-    const vector<SatLiteral>& lit_list ///< [in] 入力のリテラルのリスト
+    const vector<SatLiteral>& lit_list, ///< [in] 入力のリテラルのリスト
+    SatAmoEnc enc = SatAmoEnc::Auto     ///< [in] 符号化方法
   );
 
   /// @brief A == B という条件を追加する．
@@ -1418,6 +1802,28 @@ public:
     return mConflictLiterals;
   }
 
+  /// @brief 複数の assumption の組に対して SAT 問題を解く．
+  /// @return 各組に対する結果(SatBool3)のリストを返す．
+  ///
+  /// * assumption_sets[i] に対する結果は返り値の i 番目に入る．
+  ///   モデルは model_list[i] に，矛盾の原因は conflicts_list[i] に入る．
+  /// * 同じ CNF を複製したソルバを num_threads 個のスレッドで並列に動かす．
+  ///   num_threads が 0 の場合はハードウェアのスレッド数を用いる．
+  /// * 先頭部分の共通な assumption の組が同じスレッドで続けて
+  ///   解かれるように，辞書順に並べ替えてから割り振る．
+  /// * 複製は次回の呼び出しのために保持され，
+  ///   前回以降に追加された変数と節だけが反映される．
+  /// * set_conflict_budget()/set_propagation_budget() で設定された
+  ///   制限値は各複製にも設定される．
+  /// * 省メモリモードの場合は複製を作れないので1つのスレッドで解く．
+  vector<SatBool3>
+  solve_batch(
+    const vector<vector<SatLiteral>>& assumption_sets, ///< [in] assumption の組のリスト
+    vector<SatModel>& model_list,                      ///< [out] 各組に対するモデルのリスト
+    vector<vector<SatLiteral>>& conflicts_list,        ///< [out] 各組に対する矛盾の原因のリスト
+    SizeType num_threads = 0                           ///< [in] スレッド数
+  );
+
   /// @brief 時間計測機能を制御する
   void
   timer_on(
@@ -1439,6 +1845,8 @@ public:
   );
 
   /// @brief solve() 中のリスタートのたびに呼び出されるメッセージハンドラの登録
+  ///
+  /// minimize() の途中経過も SatMsgHandler::print_bound() で出力される．
   void
   reg_msg_handler(
     SatMsgHandler* msg_handler ///< [in] 登録するメッセージハンドラ
@@ -1449,6 +1857,91 @@ public:
   //////////////////////////////////////////////////////////////////////
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 最適化を行う関数
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 2進符号化された数値を最小化する．
+  /// @return 結果(SatBool3)を返す．
+  ///
+  /// 結果の意味は以下の通り
+  /// * SatBool3::True  最適解が得られた．
+  /// * SatBool3::False 解が存在しない．
+  /// * SatBool3::X     時間制約などで中断された．
+  ///
+  /// * 解が得られている場合，model() は最良の解を，opt_value() は
+  ///   その目的関数の値を返す．解が得られていない場合 model() は空となる．
+  /// * 目的関数の上下界は assumption として与えるので，制約節は
+  ///   追加されず学習節は反復の間で保持される．ただし上界を表す
+  ///   リテラルを作るための変数と節(SatBinaryNum::sub() など)は追加される．
+  /// * 解が得られるたびにその値割り当てを次の探索で優先する極性として
+  ///   実装に渡す(対応している実装のみ)．
+  /// * 上下界が更新されるたびに reg_msg_handler() で登録された
+  ///   ハンドラの print_bound() を呼ぶ．
+  /// * 目的関数の値はモデルから求めるので，obj のビットは決定変数
+  ///   でなければならない(ymsat 系では決定変数の値しか得られない)．
+  /// * 条件リテラルは用いられない．
+  /// * time_limit は全ての反復を通した時間制約となる．
+  SatBool3
+  minimize(
+    const SatBinaryNum& obj,                            ///< [in] 目的関数
+    SatOptStrategy strategy = SatOptStrategy::SatUnsat, ///< [in] 探索方法
+    SizeType time_limit = 0                             ///< [in] 時間制約(秒) 0 で制約なし
+  );
+
+  /// @brief 順序符号化された変数を最小化する．
+  /// @return 結果(SatBool3)を返す．
+  ///
+  /// 扱いは minimize(const SatBinaryNum&, SatOptStrategy, SizeType) と同様
+  SatBool3
+  minimize(
+    const SatOrderedSet& obj,                           ///< [in] 目的関数
+    SatOptStrategy strategy = SatOptStrategy::SatUnsat, ///< [in] 探索方法
+    SizeType time_limit = 0                             ///< [in] 時間制約(秒) 0 で制約なし
+  );
+
+  /// @brief Σ weight_list[i] * lit_list[i] を最小化する．
+  /// @return 結果(SatBool3)を返す．
+  ///
+  /// * 目的関数は重み付きのビットを加算器の木で足し合わせた
+  ///   SatBinaryNum として一度だけ符号化し，上界はその値と定数の
+  ///   比較結果のリテラルで表す．
+  /// * 重みは負でもよい．
+  /// * それ以外の扱いは minimize(const SatBinaryNum&, SatOptStrategy, SizeType)
+  ///   と同様
+  SatBool3
+  minimize(
+    const vector<int>& weight_list,                     ///< [in] 重みのリスト
+    const vector<SatLiteral>& lit_list,                 ///< [in] リテラルのリスト
+    SatOptStrategy strategy = SatOptStrategy::SatUnsat, ///< [in] 探索方法
+    SizeType time_limit = 0                             ///< [in] 時間制約(秒) 0 で制約なし
+  );
+
+  /// @brief 直前の minimize() で得られた解の目的関数の値を返す．
+  ///
+  /// 解が得られていない(model() が空の)場合の値は意味を持たない．
+  std::int64_t
+  opt_value() const
+  {
+    return mOptValue;
+  }
+
+  /// @brief 直前の minimize() で証明された最適値の下界を返す．
+  ///
+  /// minimize() が SatBool3::True を返した場合は opt_value() と等しい．
+  std::int64_t
+  opt_lower_bound() const
+  {
+    return mOptLowerBound;
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   /// @name 内部状態の取得を行う関数
@@ -1474,7 +1967,7 @@ public:
   SizeType
   clause_num() const
   {
-    return mClauseList.size();
+    return mClauseNum;
   }
 
   /// @brief 制約節のリテラルの総数を得る．
@@ -1492,11 +1985,59 @@ public:
   }
 
   /// @brief DIMACS 形式で制約節を出力する．
+  ///
+  /// 省メモリモードの場合は実装から節を取り出して出力するので，
+  /// 出力されるのは元の節と同じモデルを持つ簡単化された節となる．
+  /// 節を取り出せない実装の場合や実装に渡した XOR 制約，擬似ブール制約が
+  /// ある場合には
+  /// std::runtime_error 例外を送出する．
+  /// 出力はバッファリングしてまとめて書き出す．
+  /// thread_num が 2 以上で節の数が多い場合には
+  /// 複数のスレッドで文字列化を行う．
   void
   write_DIMACS(
+    ostream& s,             ///< [in] 出力先のストリーム
+    SizeType thread_num = 1 ///< [in] 文字列化に用いるスレッド数
+  ) const;
+
+  /// @brief バイナリ CNF 形式で制約節を出力する．
+  ///
+  /// 出力したデータは read_DIMACS() で読み込むことができる．
+  /// 省メモリモードの場合の動作は write_DIMACS() と同様．
+  /// s はバイナリモードで開かれている必要がある．
+  void
+  write_binary_CNF(
     ostream& s ///< [in] 出力先のストリーム
   ) const;
 
+  /// @brief DIMACS 形式のファイルを読み込んで制約節を追加する．
+  /// @return DIMACS の変数番号(1から始まる)から 1 を引いた値を
+  /// インデックスとするリテラルのリストを返す．
+  ///
+  /// 節は読み込むたびに add_clause() で追加するので
+  /// ファイル全体の節のリストを保持することはない．
+  /// 変数は必要に応じて new_variable() で作られる．
+  /// gzip/bzip2/xz で圧縮されたファイルやバイナリ CNF 形式の
+  /// ファイル(write_binary_CNF() で出力したもの)も読み込める．
+  /// ファイルはメモリマップして読み込み，thread_num が 2 以上で
+  /// ファイルが大きい場合には字句解析を複数のスレッドで行う．
+  /// 読み込みに失敗した場合には std::invalid_argument 例外を送出する．
+  vector<SatLiteral>
+  read_DIMACS(
+    const string& filename, ///< [in] ファイル名
+    SizeType thread_num = 1 ///< [in] 字句解析に用いるスレッド数
+  );
+
+  /// @brief DIMACS 形式のデータをストリームから読み込んで制約節を追加する．
+  /// @return DIMACS の変数番号(1から始まる)から 1 を引いた値を
+  /// インデックスとするリテラルのリストを返す．
+  ///
+  /// 読み込みに失敗した場合には std::invalid_argument 例外を送出する．
+  vector<SatLiteral>
+  read_DIMACS(
+    istream& s ///< [in] 入力元のストリーム
+  );
+
   //////////////////////////////////////////////////////////////////////
   /// @}
   //////////////////////////////////////////////////////////////////////
@@ -1506,6 +2047,28 @@ private:
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  // SatOrderedSet は遅延生成の際に条件リテラルを一時的に無効化する．
+  friend class SatOrderedSet;
+
+  /// @brief 条件リテラルを一時的に無効化する．
+  /// @return それまでの条件リテラルを返す．
+  vector<SatLiteral>
+  _suspend_conditional_literals()
+  {
+    vector<SatLiteral> lits;
+    lits.swap(mConditionalLits);
+    return lits;
+  }
+
+  /// @brief _suspend_conditional_literals() で退避した条件リテラルを元に戻す．
+  void
+  _resume_conditional_literals(
+    vector<SatLiteral>&& lits ///< [in] 条件リテラルのリスト
+  )
+  {
+    mConditionalLits = std::move(lits);
+  }
+
   /// @brief set_conditional_literals() の下請け関数
   void
   _set_conditional_literals(
@@ -1513,45 +2076,293 @@ private:
     SatLiteral lits[] ///< [in] conditional_literal の配列
   );
 
-  /// @brief add_clause() の下請け関数
+  /// @brief 省メモリモードの時に実装から節を列挙する．
+  ///
+  /// 実装が対応していない場合には std::runtime_error 例外を送出する．
   void
-  _add_clause(
-    const vector<SatLiteral>& lits ///< [in] リテラルのリスト
-  );
+  _enum_impl_clauses(
+    const char* func_name, ///< [in] 呼び出し元の関数名(エラーメッセージ用)
+    const std::function<void(const vector<SatLiteral>&)>& func ///< [in] 節を受け取る関数
+  ) const;
 
   /// @brief add_clause() の下請け関数
+  ///
+  /// 条件リテラルがある場合にはそれらの否定を先頭に加える．
   void
   _add_clause(
-    SizeType n,       ///< [in] リテラル数
-    SatLiteral lits[] ///< [in] リテラルの配列
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
   );
 
   /// @brief _add_clause() の下請け関数
   void
   _add_clause_sub(
-    const vector<SatLiteral>& lits ///< [in] リテラルのリスト
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
+  );
+
+  /// @brief add_clauses() の下請け関数
+  ///
+  /// i 番目の節は lits[begin_list[i]] から lits[begin_list[i + 1] - 1] まで．
+  void
+  _add_clauses(
+    SizeType clause_num,       ///< [in] 節の数
+    const SatLiteral* lits,    ///< [in] 全ての節のリテラルの配列
+    const SizeType* begin_list ///< [in] 各節の開始位置の配列(要素数は clause_num + 1)
+  );
+
+  /// @brief add_xor_constraint() の下請け関数
+  void
+  _add_xor_constraint(
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits, ///< [in] リテラルの配列
+    bool rhs                ///< [in] 右辺の値
+  );
+
+  /// @brief XOR 制約を節に展開して追加する．
+  void
+  _add_xor_cnf(
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits, ///< [in] リテラルの配列
+    bool rhs                ///< [in] 右辺の値
+  );
+
+  /// @brief minimize() の下請け関数
+  ///
+  /// 目的関数は [lo, hi] の値をとるものとする．
+  /// le_lit(v) は目的関数の値が v 以下であることを表すリテラルを返す．
+  /// eval(model) は model における目的関数の値を返す．
+  SatBool3
+  _minimize(
+    std::int64_t lo,                                          ///< [in] 目的関数の最小値
+    std::int64_t hi,                                          ///< [in] 目的関数の最大値
+    const std::function<SatLiteral(std::int64_t)>& le_lit,    ///< [in] 上界を表すリテラルを返す関数
+    const std::function<std::int64_t(const SatModel&)>& eval, ///< [in] 目的関数の値を返す関数
+    SatOptStrategy strategy,                                  ///< [in] 探索方法
+    SizeType time_limit                                       ///< [in] 時間制約(秒) 0 で制約なし
+  );
+
+  /// @brief 擬似ブール制約を正規化して追加する．
+  ///
+  /// Σ weight_list[i] * lit_list[i] >= bound を表す．
+  /// 重みが正で変数の重複がない形に直してから実装に渡すか
+  /// 節に展開する．
+  void
+  _add_pb_constraint(
+    const vector<int>& weight_list,     ///< [in] 重みのリスト
+    const vector<SatLiteral>& lit_list, ///< [in] リテラルのリスト
+    std::int64_t bound,                 ///< [in] 右辺の値
+    SatPbEnc enc                        ///< [in] 節に展開する方法
+  );
+
+  /// @brief 正規化された擬似ブール制約を節に展開して追加する．
+  ///
+  /// Σ weights[i] * lits[i] >= bound を表す．
+  void
+  _add_pb_cnf(
+    SizeType n,              ///< [in] リテラル数
+    const SatLiteral* lits,  ///< [in] リテラルの配列
+    const SizeType* weights, ///< [in] 重みの配列
+    SizeType bound,          ///< [in] 右辺の値
+    SatPbEnc enc             ///< [in] 展開する方法
+  );
+
+  /// @brief 加算器を用いて擬似ブール制約を節に展開する．
+  ///
+  /// 引数は _add_pb_cnf() と同じ
+  void
+  _add_pb_adder(
+    SizeType n,              ///< [in] リテラル数
+    const SatLiteral* lits,  ///< [in] リテラルの配列
+    const SizeType* weights, ///< [in] 重みの配列
+    SizeType bound           ///< [in] 右辺の値
+  );
+
+  /// @brief BDD を用いて擬似ブール制約を節に展開する．
+  ///
+  /// 引数は _add_pb_cnf() と同じ
+  void
+  _add_pb_bdd(
+    SizeType n,              ///< [in] リテラル数
+    const SatLiteral* lits,  ///< [in] リテラルの配列
+    const SizeType* weights, ///< [in] 重みの配列
+    SizeType bound           ///< [in] 右辺の値
+  );
+
+  /// @brief generalized totalizer を用いて擬似ブール制約を節に展開する．
+  ///
+  /// 引数は _add_pb_cnf() と同じ
+  void
+  _add_pb_gen_totalizer(
+    SizeType n,              ///< [in] リテラル数
+    const SatLiteral* lits,  ///< [in] リテラルの配列
+    const SizeType* weights, ///< [in] 重みの配列
+    SizeType bound           ///< [in] 右辺の値
+  );
+
+  /// @brief ソーティングネットワークを用いて擬似ブール制約を節に展開する．
+  ///
+  /// 引数は _add_pb_cnf() と同じ
+  void
+  _add_pb_sort_network(
+    SizeType n,              ///< [in] リテラル数
+    const SatLiteral* lits,  ///< [in] リテラルの配列
+    const SizeType* weights, ///< [in] 重みの配列
+    SizeType bound           ///< [in] 右辺の値
   );
 
   /// @brief n入力XORゲートの入出力の関係を表す条件を追加する．
   void
   _add_xorgate_sub(
-    SatLiteral olit,                    ///< [in] 出力のリテラル
-    const vector<SatLiteral>& lit_list, ///< [in] 入力のリテラルのリスト
-    SizeType start,                     ///< [in] 開始位置
-    SizeType num                        ///< [in] 要素数
+    SatLiteral olit,        ///< [in] 出力のリテラル
+    const SatLiteral* lits, ///< [in] 入力のリテラルの配列
+    SizeType num            ///< [in] 要素数
+  );
+
+  /// @brief add_adder() の下請け関数
+  void
+  _add_adder(
+    const SatLiteral* alits, ///< [in] 入力Aのリテラルの配列
+    SizeType na,             ///< [in] alits の要素数
+    const SatLiteral* blits, ///< [in] 入力Bのリテラルの配列
+    SizeType nb,             ///< [in] blits の要素数
+    SatLiteral ilit,         ///< [in] キャリー入力のリテラル
+    const SatLiteral* slits, ///< [in] 出力のリテラルの配列
+    SizeType ns,             ///< [in] slits の要素数
+    SatLiteral olit          ///< [in] キャリー出力のリテラル
+  );
+
+  /// @brief add_counter() の下請け関数
+  /// @return 出力のビット数を返す．
+  ///
+  /// olits には ni を表すのに必要なビット数分の領域が必要となる．
+  SizeType
+  _add_counter(
+    const SatLiteral* ilits, ///< [in] 入力のリテラルの配列
+    SizeType ni,             ///< [in] ilits の要素数
+    bool decision,           ///< [in] 生成する変数を decision variable にする時 true にする．
+    SatLiteral* olits        ///< [out] 個数を表す2進数を表すリテラルを格納する配列
+  );
+
+  /// @brief 個数制約の符号化方法を決める．
+  SatCardEnc
+  _card_encoding(
+    SatCardEnc enc, ///< [in] 指定された符号化方法
+    SizeType n,     ///< [in] 入力数
+    SizeType k      ///< [in] しきい値
+  ) const;
+
+  /// @brief add_unary_counter() の下請け関数
+  ///
+  /// * up が true の時は i + 1 個以上が true なら出力 i が true になる節を，
+  ///   down が true の時はその逆向きの節を生成する．
+  vector<SatLiteral>
+  _add_unary_counter(
+    const vector<SatLiteral>& ilits, ///< [in] 入力のリテラルのリスト
+    SizeType m,                      ///< [in] 出力数の上限
+    SatCardEnc enc,                  ///< [in] 符号化方法
+    bool up,                         ///< [in] 上向きの節を生成する時 true
+    bool down                        ///< [in] 下向きの節を生成する時 true
+  );
+
+  /// @brief 逐次カウンタを作る．
+  vector<SatLiteral>
+  _add_seq_counter(
+    const vector<SatLiteral>& ilits, ///< [in] 入力のリテラルのリスト
+    SizeType m,                      ///< [in] 出力数の上限
+    bool up,                         ///< [in] 上向きの節を生成する時 true
+    bool down                        ///< [in] 下向きの節を生成する時 true
+  );
+
+  /// @brief totalizer を作る．
+  vector<SatLiteral>
+  _add_totalizer(
+    const vector<SatLiteral>& ilits, ///< [in] 入力のリテラルのリスト
+    SizeType m,                      ///< [in] 出力数の上限
+    bool up,                         ///< [in] 上向きの節を生成する時 true
+    bool down                        ///< [in] 下向きの節を生成する時 true
+  );
+
+  /// @brief 出力を打ち切ったソーティングネットワークを作る．
+  vector<SatLiteral>
+  _add_card_network(
+    const vector<SatLiteral>& ilits, ///< [in] 入力のリテラルのリスト
+    SizeType m,                      ///< [in] 出力数の上限
+    bool up,                         ///< [in] 上向きの節を生成する時 true
+    bool down                        ///< [in] 下向きの節を生成する時 true
+  );
+
+  /// @brief modulo totalizer で k 個以下という条件を追加する．
+  void
+  _add_mod_totalizer(
+    const vector<SatLiteral>& ilits, ///< [in] 入力のリテラルのリスト
+    SizeType k                       ///< [in] しきい値
+  );
+
+  /// @brief solve_batch() 用の複製を n 個用意する．
+  ///
+  /// すでにある複製には前回以降に追加された変数と節を加える．
+  void
+  _sync_clones(
+    SizeType n ///< [in] 複製の数
+  );
+
+  /// @brief at-most-one 制約の符号化方法を決める．
+  SatAmoEnc
+  _amo_encoding(
+    SatAmoEnc enc, ///< [in] 指定された符号化方法
+    SizeType n     ///< [in] 入力数
+  ) const;
+
+  /// @brief 全ての対に2項節を作って at-most-one 制約を追加する．
+  void
+  _add_amo_pairwise(
+    const vector<SatLiteral>& lit_list ///< [in] 入力のリテラルのリスト
+  );
+
+  /// @brief 半分に分割する方法で at-most-one 制約を追加する．
+  void
+  _add_amo_halving(
+    const vector<SatLiteral>& lit_list ///< [in] 入力のリテラルのリスト
+  );
+
+  /// @brief 逐次符号化で at-most-one 制約を追加する．
+  void
+  _add_amo_ladder(
+    const vector<SatLiteral>& lit_list ///< [in] 入力のリテラルのリスト
+  );
+
+  /// @brief commander 符号化で at-most-one 制約を追加する．
+  void
+  _add_amo_commander(
+    const vector<SatLiteral>& lit_list ///< [in] 入力のリテラルのリスト
+  );
+
+  /// @brief product 符号化で at-most-one 制約を追加する．
+  void
+  _add_amo_product(
+    const vector<SatLiteral>& lit_list ///< [in] 入力のリテラルのリスト
+  );
+
+  /// @brief bimander 符号化で at-most-one 制約を追加する．
+  void
+  _add_amo_bimander(
+    const vector<SatLiteral>& lit_list ///< [in] 入力のリテラルのリスト
   );
 
   /// @brief add_at_most_one() の下請け関数
   void
   _add_at_most_one(
-    const vector<SatLiteral>& lit_list,
+    const SatLiteral* lits,
+    SizeType n,
     SatLiteral olit
   );
 
   /// @brief add_at_most_two() の下請け関数
   void
   _add_at_most_two(
-    const vector<SatLiteral>& lit_list,
+    const SatLiteral* lits,
+    SizeType n,
     SatLiteral olit1,
     SatLiteral olit0
   );
@@ -1559,7 +2370,8 @@ private:
   /// @brief add_at_least_two() の下請け関数
   void
   _add_at_least_two(
-    const vector<SatLiteral>& lit_list,
+    const SatLiteral* lits,
+    SizeType n,
     SatLiteral olit1,
     SatLiteral olit0
   );
@@ -1582,21 +2394,155 @@ private:
   // 条件リテラル
   vector<SatLiteral> mConditionalLits;
 
+  // 条件リテラル付きの節を作るための作業領域
+  vector<SatLiteral> mTmpLits;
+
+  // ゲートの符号化で節をまとめて作るための作業領域
+  vector<SatLiteral> mGateLits;
+
+  // mGateLits 上の各節の開始位置
+  vector<SizeType> mGateBegin;
+
+  // add_aig() の変換結果のリスト
+  // LitMap と条件リテラルの組み合わせごとに作られる．
+  vector<unique_ptr<Aig2Cnf>> mAig2CnfList;
+
+  // add_expr() の変換結果のリスト
+  // 条件リテラルごとに作られる．
+  vector<unique_ptr<Expr2Cnf>> mExpr2CnfList;
+
+  // const_true() の返すリテラル
+  SatLiteral mConstTrue{SatLiteral::X};
+
   // 直前の問題のモデル
   SatModel mModel;
 
   // 直前の矛盾の原因
   vector<SatLiteral> mConflictLiterals;
 
+  // 登録されたメッセージハンドラのリスト
+  // minimize() の途中経過の出力と reset() 後の再登録に用いる．
+  vector<SatMsgHandler*> mMsgHandlerList;
+
+  // 直前の minimize() で得られた解の値
+  std::int64_t mOptValue{0};
+
+  // 直前の minimize() で証明された下界
+  std::int64_t mOptLowerBound{0};
+
+  // solve_batch() 用の複製
+  struct Clone
+  {
+    // 複製したソルバ
+    unique_ptr<SatSolverImpl> mImpl;
+
+    // 反映済みの変数の数
+    SizeType mVarNum{0};
+
+    // 反映済みの節の数
+    SizeType mClauseNum{0};
+
+    // 反映済みの XOR 制約の数
+    SizeType mXorNum{0};
+
+    // 反映済みの擬似ブール制約の数
+    SizeType mPbNum{0};
+
+    // 反映済みの制限値の設定回数
+    SizeType mBudgetNum{0};
+  };
+
+  // 複製のリスト
+  vector<Clone> mCloneList;
+
+  // set_conflict_budget() で設定された値
+  SizeType mConflictBudget{0};
+
+  // set_propagation_budget() で設定された値
+  SizeType mPropagationBudget{0};
+
+  // set_conflict_budget() が呼ばれた時 true
+  bool mHasConflictBudget{false};
+
+  // set_propagation_budget() が呼ばれた時 true
+  bool mHasPropagationBudget{false};
+
+  // 制限値の設定回数
+  // 複製に反映されていない設定があるかどうかの判定に用いる．
+  SizeType mBudgetNum{0};
+
   // 変数の数(リポート用)
   SizeType mVariableNum{0};
 
-  // 節のリスト(リポート用)
-  vector<vector<SatLiteral>> mClauseList;
+  // 変数ごとの決定変数フラグ(複製用)
+  vector<bool> mDecisionList;
+
+  // 節のコピーを保持する時 true にするフラグ
+  bool mKeepClauses{true};
+
+  // add_expr()/add_aig() で Tseitin 符号化を用いる時 true
+  bool mTseitinEncoding{false};
+
+  // add_expr() で XOR を分解する単位
+  SizeType mXorCut{2};
+
+  // add_xor_constraint() を実装に渡す時 true にするフラグ
+  bool mNativeXor{true};
+
+  // 擬似ブール制約を実装に渡す時 true にするフラグ
+  bool mNativePb{true};
+
+  // 個数制約の符号化方法
+  SatCardEnc mCardEnc{SatCardEnc::Auto};
+
+  // at-most-one 制約の符号化方法
+  SatAmoEnc mAmoEnc{SatAmoEnc::Auto};
+
+  // 擬似ブール制約を節に展開する方法
+  SatPbEnc mPbEnc{SatPbEnc::Auto};
+
+  // 節の数(リポート用)
+  SizeType mClauseNum{0};
 
   // リテラル数(リポート用)
   SizeType mLiteralNum{0};
 
+  // 全ての節のリテラルを平坦に並べたリスト(リポート/複製用)
+  vector<SatLiteral> mClauseLits;
+
+  // 各節の mClauseLits 上の開始位置
+  // 末尾に番兵として mClauseLits.size() を持つ．
+  vector<SizeType> mClauseBegin{0};
+
+  // 実装に渡した XOR 制約の数
+  SizeType mXorNum{0};
+
+  // 実装に渡した XOR 制約のリテラルを平坦に並べたリスト(複製用)
+  vector<SatLiteral> mXorLits;
+
+  // 各 XOR 制約の mXorLits 上の開始位置
+  // 末尾に番兵として mXorLits.size() を持つ．
+  vector<SizeType> mXorBegin{0};
+
+  // 各 XOR 制約の右辺の値
+  vector<bool> mXorRhs;
+
+  // 実装に渡した擬似ブール制約の数
+  SizeType mPbNum{0};
+
+  // 実装に渡した擬似ブール制約のリテラルを平坦に並べたリスト(複製用)
+  vector<SatLiteral> mPbLits;
+
+  // mPbLits の各リテラルの重み
+  vector<SizeType> mPbWeights;
+
+  // 各擬似ブール制約の mPbLits 上の開始位置
+  // 末尾に番兵として mPbLits.size() を持つ．
+  vector<SizeType> mPbBegin{0};
+
+  // 各擬似ブール制約の右辺の値
+  vector<SizeType> mPbBound;
+
 };
 
 END_NAMESPACE_YM_SAT
@@ -0,0 +1,102 @@
+#ifndef SATSOLVERPOOL_H
+#define SATSOLVERPOOL_H
+
+/// @file SatSolverPool.h
+/// @brief SatSolverPool のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+#include "ym/SatSolver.h"
+#include "ym/SatInitParam.h"
+#include <functional>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class SatSolverPool SatSolverPool.h "ym/SatSolverPool.h"
+/// @brief 小さな独立した SAT 問題を大量に解くためのスレッドプール
+///
+/// スレッドごとに SatSolver を1つずつ保持しておき，
+/// タスクごとに SatSolver::reset() で初期化して使い回す．
+/// 生成時の設定ファイルの読み込みや領域の確保が
+/// タスクごとに行われることはない．
+///
+/// 使用例:
+/// @code
+/// SatSolverPool pool{SatInitParam{"ymsat2"}};
+/// vector<SatBool3> ans_list(n);
+/// pool.run(n, [&](SizeType id, SatSolver& solver) {
+///   // solver に id 番目の問題の変数と節を追加する．
+///   ans_list[id] = solver.solve();
+/// });
+/// @endcode
+//////////////////////////////////////////////////////////////////////
+class SatSolverPool
+{
+public:
+
+  /// @brief タスクを表す関数の型
+  ///
+  /// 第1引数はタスク番号，第2引数は初期化済みのソルバ
+  using Task = std::function<void(SizeType, SatSolver&)>;
+
+public:
+
+  /// @brief コンストラクタ
+  SatSolverPool(
+    const SatInitParam& init_param = SatInitParam{}, ///< [in] 初期化パラメータ
+    SizeType num_threads = 0                         ///< [in] スレッド数
+                                                     ///<      0 の場合はハードウェアのスレッド数
+  );
+
+  /// @brief デストラクタ
+  ~SatSolverPool();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッド数を返す．
+  SizeType
+  thread_num() const
+  {
+    return mSolverList.size();
+  }
+
+  /// @brief task_num 個のタスクを並列に実行する．
+  ///
+  /// * 0 から task_num - 1 までの番号に対して task を1回ずつ呼び出す．
+  /// * task に渡されるソルバは変数も節も持たない状態になっている．
+  /// * 全てのタスクが終わるまで戻らない．
+  /// * task が例外を送出した場合には残りのタスクを打ち切って
+  ///   最初の例外を送出し直す．
+  void
+  run(
+    SizeType task_num, ///< [in] タスク数
+    const Task& task   ///< [in] タスクを表す関数
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // スレッドごとのソルバのリスト
+  vector<unique_ptr<SatSolver>> mSolverList;
+
+  // 各ソルバがタスクに使われたかどうかのフラグ
+  // 使われていたら次のタスクの前に reset() する．
+  vector<bool> mDirtyList;
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // SATSOLVERPOOL_H
@@ -42,6 +42,13 @@ public:
     mConflictNum = 0;
     mDecisionNum = 0;
     mPropagationNum = 0;
+    mImportNum = 0;
+    mExportNum = 0;
+    mAigCacheHit = 0;
+    mAigCacheMiss = 0;
+    mExprCacheHit = 0;
+    mExprCacheMiss = 0;
+    mWinner = -1;
   }
 
   /// @brief 加算
@@ -68,6 +75,12 @@ public:
     mConflictNum += right.mConflictNum;
     mDecisionNum += right.mDecisionNum;
     mPropagationNum += right.mPropagationNum;
+    mImportNum += right.mImportNum;
+    mExportNum += right.mExportNum;
+    mAigCacheHit += right.mAigCacheHit;
+    mAigCacheMiss += right.mAigCacheMiss;
+    mExprCacheHit += right.mExprCacheHit;
+    mExprCacheMiss += right.mExprCacheMiss;
 
     return *this;
   }
@@ -96,6 +109,12 @@ public:
     mConflictNum -= right.mConflictNum;
     mDecisionNum -= right.mDecisionNum;
     mPropagationNum -= right.mPropagationNum;
+    mImportNum -= right.mImportNum;
+    mExportNum -= right.mExportNum;
+    mAigCacheHit -= right.mAigCacheHit;
+    mAigCacheMiss -= right.mAigCacheMiss;
+    mExprCacheHit -= right.mExprCacheHit;
+    mExprCacheMiss -= right.mExprCacheMiss;
 
     return *this;
   }
@@ -133,6 +152,24 @@ public:
     if ( mPropagationNum < right.mPropagationNum ) {
       mPropagationNum = right.mPropagationNum;
     }
+    if ( mImportNum < right.mImportNum ) {
+      mImportNum = right.mImportNum;
+    }
+    if ( mExportNum < right.mExportNum ) {
+      mExportNum = right.mExportNum;
+    }
+    if ( mAigCacheHit < right.mAigCacheHit ) {
+      mAigCacheHit = right.mAigCacheHit;
+    }
+    if ( mAigCacheMiss < right.mAigCacheMiss ) {
+      mAigCacheMiss = right.mAigCacheMiss;
+    }
+    if ( mExprCacheHit < right.mExprCacheHit ) {
+      mExprCacheHit = right.mExprCacheHit;
+    }
+    if ( mExprCacheMiss < right.mExprCacheMiss ) {
+      mExprCacheMiss = right.mExprCacheMiss;
+    }
 
     return *this;
   }
@@ -179,6 +216,30 @@ public:
   /// @brief 計算時間(ミリ秒)
   std::chrono::milliseconds mTime;
 
+  /// @brief 他のソルバから取り込んだ学習節の数
+  SizeType mImportNum{0};
+
+  /// @brief 他のソルバに向けて書き出した学習節の数
+  SizeType mExportNum{0};
+
+  /// @brief add_aig() で変換済みの結果を再利用したノード数
+  int mAigCacheHit{0};
+
+  /// @brief add_aig() で新たに変換したノード数
+  int mAigCacheMiss{0};
+
+  /// @brief add_expr() で変換済みの変数を再利用した回数
+  int mExprCacheHit{0};
+
+  /// @brief add_expr() で新たに作った変数の数
+  int mExprCacheMiss{0};
+
+  /// @brief 並列ソルバで答えを出したメンバ(ワーカ)の番号
+  ///
+  /// - 該当しない場合は -1 となる．
+  /// - 加減算や MAX 演算の対象とはならない．
+  int mWinner{-1};
+
 };
 
 
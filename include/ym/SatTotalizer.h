@@ -0,0 +1,106 @@
+#ifndef YM_SATTOTALIZER_H
+#define YM_SATTOTALIZER_H
+
+/// @file ym/SatTotalizer.h
+/// @brief SatTotalizer のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+#include "ym/SatLiteral.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class SatTotalizer SatTotalizer.h "SatTotalizer.h"
+/// @brief 上限を後から設定できる個数制約を表すクラス
+///
+/// * 入力のうち true になっている個数を totalizer で単進数に変換し，
+///   その出力に対する単位節で上限/下限を設定する．
+/// * 上限を厳しくする場合には新しい単位節を加えるだけでよいので，
+///   上限を少しずつ下げながら解き直す用途に向いている．
+/// * le_literal() を仮定として solve() に渡せば節を追加せずに
+///   上限を試すこともできる．
+//////////////////////////////////////////////////////////////////////
+class SatTotalizer
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// ub + 1 個以上は区別しないので，上限は ub 以下でなければならない．
+  SatTotalizer(
+    SatSolver& solver,                  ///< [in] SATソルバ
+    const vector<SatLiteral>& lit_list, ///< [in] 入力のリテラルのリスト
+    SizeType ub                         ///< [in] 設定する上限の最大値
+  );
+
+  /// @brief デストラクタ
+  ~SatTotalizer() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力数を返す．
+  SizeType
+  input_num() const
+  {
+    return mInputNum;
+  }
+
+  /// @brief 出力のリテラルのリストを返す．
+  ///
+  /// i 番目のリテラルは入力のうち i + 1 個以上が true の時，
+  /// かつその時に限り true となる．
+  const vector<SatLiteral>&
+  outputs() const
+  {
+    return mOutputList;
+  }
+
+  /// @brief 個数が k 以下であることを表すリテラルを返す．
+  ///
+  /// k が入力数以上の場合は常に成り立つので SatLiteral::X を返す．
+  SatLiteral
+  le_literal(
+    SizeType k ///< [in] 上限
+  ) const;
+
+  /// @brief 個数が k 以下になるという制約を作る．
+  void
+  add_le_constraint(
+    SizeType k ///< [in] 上限
+  );
+
+  /// @brief 個数が k 以上になるという制約を作る．
+  void
+  add_ge_constraint(
+    SizeType k ///< [in] 下限
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // SATソルバー
+  SatSolver& mSolver;
+
+  // 入力数
+  SizeType mInputNum;
+
+  // 出力のリテラルのリスト
+  vector<SatLiteral> mOutputList;
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // YM_SATTOTALIZER_H
@@ -50,8 +50,10 @@ class SatModel;
 class SatLiteral;
 class SatOrderedSet;
 class SatSolver;
+class SatSolverPool;
 class SatInitParam;
 class SatStats;
+class SatTotalizer;
 class SatMsgHandler;
 class SatMsgHandlerS;
 class CnfSize;
@@ -72,8 +74,10 @@ using nsSat::SatModel;
 using nsSat::SatLiteral;
 using nsSat::SatOrderedSet;
 using nsSat::SatSolver;
+using nsSat::SatSolverPool;
 using nsSat::SatInitParam;
 using nsSat::SatStats;
+using nsSat::SatTotalizer;
 using nsSat::SatMsgHandler;
 using nsSat::SatMsgHandlerS;
 using nsSat::CnfSize;
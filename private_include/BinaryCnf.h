@@ -0,0 +1,283 @@
+#ifndef BINARYCNF_H
+#define BINARYCNF_H
+
+/// @file BinaryCnf.h
+/// @brief BinaryCnfWriter/BinaryCnfReader のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+#include "ym/SatLiteral.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+// バイナリ CNF 形式
+//
+// 先頭の 32 バイトがヘッダで，以下の内容を持つ．
+// - マジックナンバー(8バイト) "YMCNF\0\1\0"
+// - 変数の数(8バイト，リトルエンディアン)
+// - 節の数(8バイト，リトルエンディアン)
+// - リテラルの総数(8バイト，リトルエンディアン)
+//
+// その後に各節が以下の形式で続く．
+// - リテラル数(可変長整数)
+// - リテラルの差分(可変長整数)
+//
+// リテラルは (変数番号 - 1) * 2 + (負なら 1) で符号化し，
+// 直前のリテラル(節の先頭では 0)との差分を zigzag 符号化して
+// 7ビットずつの可変長整数で表す．
+//////////////////////////////////////////////////////////////////////
+
+/// @brief バイナリ CNF 形式のマジックナンバー
+const char BINARY_CNF_MAGIC[8] = { 'Y', 'M', 'C', 'N', 'F', '\0', '\1', '\0' };
+
+/// @brief バイナリ CNF 形式のヘッダサイズ
+const SizeType BINARY_CNF_HEADER_SIZE = 32;
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BinaryCnfWriter BinaryCnf.h "BinaryCnf.h"
+/// @brief バイナリ CNF 形式で出力するクラス
+///
+/// 出力はバッファリングされ，デストラクタか flush() で書き出される．
+//////////////////////////////////////////////////////////////////////
+class BinaryCnfWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// ヘッダを出力する．
+  BinaryCnfWriter(
+    ostream& s,           ///< [in] 出力先のストリーム
+    SizeType var_num,     ///< [in] 変数の数
+    SizeType clause_num,  ///< [in] 節の数
+    SizeType literal_num  ///< [in] リテラルの総数
+  );
+
+  /// @brief デストラクタ
+  ~BinaryCnfWriter()
+  {
+    flush();
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief DIMACS 形式のリテラルのリストで表された節を出力する．
+  void
+  put_clause(
+    const vector<int>& lits ///< [in] リテラルのリスト
+  );
+
+  /// @brief SatLiteral のリストで表された節を出力する．
+  void
+  put_clause(
+    const vector<SatLiteral>& lits ///< [in] リテラルのリスト
+  )
+  {
+    put_clause(lits.data(), lits.data() + lits.size());
+  }
+
+  /// @brief SatLiteral の配列で表された節を出力する．
+  void
+  put_clause(
+    const SatLiteral* begin, ///< [in] 配列の先頭
+    const SatLiteral* end    ///< [in] 配列の末尾
+  );
+
+  /// @brief バッファの内容を書き出す．
+  void
+  flush();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 可変長整数を出力する．
+  void
+  put_varint(
+    std::uint64_t val ///< [in] 値
+  )
+  {
+    while ( val >= 0x80 ) {
+      mBuff.push_back(static_cast<char>((val & 0x7f) | 0x80));
+      val >>= 7;
+    }
+    mBuff.push_back(static_cast<char>(val));
+  }
+
+  /// @brief 符号化したリテラルを出力する．
+  void
+  put_code(
+    std::uint64_t code, ///< [in] 符号化したリテラル
+    std::uint64_t& prev ///< [inout] 直前のリテラル
+  )
+  {
+    auto d = static_cast<std::int64_t>(code - prev);
+    put_varint((static_cast<std::uint64_t>(d) << 1) ^ static_cast<std::uint64_t>(d >> 63));
+    prev = code;
+  }
+
+  /// @brief 必要ならバッファを書き出す．
+  void
+  check_flush()
+  {
+    if ( mBuff.size() >= 64 * 1024 ) {
+      flush();
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 出力先のストリーム
+  ostream& mS;
+
+  // バッファ
+  string mBuff;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BinaryCnfReader BinaryCnf.h "BinaryCnf.h"
+/// @brief メモリ上のバイナリ CNF 形式のデータを読み込むクラス
+///
+/// データはコピーせずに直接復号する．
+//////////////////////////////////////////////////////////////////////
+class BinaryCnfReader
+{
+public:
+
+  /// @brief バイナリ CNF 形式のデータの時 true を返す．
+  static
+  bool
+  check_magic(
+    const char* begin, ///< [in] データの先頭
+    const char* end    ///< [in] データの末尾
+  );
+
+  /// @brief コンストラクタ
+  ///
+  /// ヘッダを読み込む．
+  /// ヘッダが不正な場合には error() が true になる．
+  BinaryCnfReader(
+    const char* begin, ///< [in] データの先頭
+    const char* end    ///< [in] データの末尾
+  );
+
+  /// @brief デストラクタ
+  ~BinaryCnfReader() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数の数を返す．
+  SizeType
+  var_num() const
+  {
+    return mVarNum;
+  }
+
+  /// @brief 節の数を返す．
+  SizeType
+  clause_num() const
+  {
+    return mClauseNum;
+  }
+
+  /// @brief リテラルの総数を返す．
+  SizeType
+  literal_num() const
+  {
+    return mLiteralNum;
+  }
+
+  /// @brief 次の節を読み込む．
+  /// @retval true 読み込んだ．
+  /// @retval false 末尾に達したかエラーが起きた．
+  ///
+  /// lits には DIMACS 形式のリテラルが入る．
+  bool
+  read_clause(
+    vector<int>& lits ///< [out] リテラルのリスト
+  );
+
+  /// @brief エラーが起きていたら true を返す．
+  bool
+  error() const
+  {
+    return mError;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 可変長整数を読み込む．
+  /// @retval true 読み込んだ．
+  /// @retval false データが壊れていた．
+  bool
+  get_varint(
+    std::uint64_t& val ///< [out] 値
+  )
+  {
+    val = 0;
+    for ( int shift = 0; mCur < mEnd && shift < 64; shift += 7 ) {
+      auto c = static_cast<unsigned char>(*mCur);
+      ++ mCur;
+      val |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+      if ( (c & 0x80) == 0 ) {
+	return true;
+      }
+    }
+    return false;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 現在の読み出し位置
+  const char* mCur;
+
+  // データの末尾
+  const char* mEnd;
+
+  // 変数の数
+  SizeType mVarNum{0};
+
+  // 節の数
+  SizeType mClauseNum{0};
+
+  // リテラルの総数
+  SizeType mLiteralNum{0};
+
+  // エラーフラグ
+  bool mError{false};
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // BINARYCNF_H
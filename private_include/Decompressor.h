@@ -0,0 +1,77 @@
+#ifndef DECOMPRESSOR_H
+#define DECOMPRESSOR_H
+
+/// @file Decompressor.h
+/// @brief Decompressor のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class Decompressor Decompressor.h "Decompressor.h"
+/// @brief メモリ上の圧縮データを少しずつ展開するクラス
+///
+/// 圧縮形式は先頭のマジックナンバーで判定する．
+/// 対応している形式は以下の通り
+/// - gzip (zlib が使える場合)
+/// - bzip2 (libbz2 が使える場合)
+/// - xz (liblzma が使える場合)
+///
+/// 複数のストリームを連結したデータにも対応している．
+//////////////////////////////////////////////////////////////////////
+class Decompressor
+{
+public:
+
+  /// @brief データの形式を調べて対応するオブジェクトを生成する．
+  /// @return 圧縮されていない場合には nullptr を返す．
+  ///
+  /// 圧縮されているが対応していない形式の場合には
+  /// std::invalid_argument 例外を送出する．
+  static
+  unique_ptr<Decompressor>
+  new_obj(
+    const char* begin, ///< [in] データの先頭
+    const char* end    ///< [in] データの末尾
+  );
+
+  /// @brief デストラクタ
+  virtual
+  ~Decompressor() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 形式名を返す．
+  virtual
+  const char*
+  name() const = 0;
+
+  /// @brief データを展開する．
+  /// @retval true 成功した．
+  /// @retval false データが壊れていた．
+  ///
+  /// buf に最大 size バイト書き込み，書き込んだサイズを out_size に設定する．
+  /// 全て展開し終わっていたら out_size は 0 になる．
+  virtual
+  bool
+  decode(
+    char* buf,          ///< [in] 書き込み先のバッファ
+    SizeType size,      ///< [in] buf のサイズ
+    SizeType& out_size  ///< [out] 書き込んだサイズ
+  ) = 0;
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // DECOMPRESSOR_H
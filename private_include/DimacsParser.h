@@ -0,0 +1,214 @@
+#ifndef DIMACSPARSER_H
+#define DIMACSPARSER_H
+
+/// @file DimacsParser.h
+/// @brief DimacsParser のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+#include <functional>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+class Decompressor;
+
+//////////////////////////////////////////////////////////////////////
+/// @class DimacsParser DimacsParser.h "DimacsParser.h"
+/// @brief DIMACS 形式のファイルを読み込むパーサー
+///
+/// 正規表現は用いずに1文字ずつ字句解析を行い，
+/// 節を読み込むたびにコールバック関数を呼び出す．
+/// ファイルはメモリマップして読み込む．
+/// gzip/bzip2/xz で圧縮されたデータの場合には別スレッドで展開しながら
+/// 展開済みの部分を順に字句解析する．
+/// バイナリ CNF 形式(BinaryCnf.h 参照)のデータも読み込むことができる．
+///
+/// 大きなファイルの場合は行単位で分割したチャンクを複数のスレッドで
+/// 字句解析し，結果を先頭から順にコールバック関数に渡す．
+///
+/// 文法は以下の通り
+/// - 'c' で始まる行はコメント
+/// - "p cnf <変数の数> <節の数>" の行がヘッダ
+/// - '%' で始まる行があったらそこで終わる．
+/// - それ以外は空白で区切られた整数の並びで 0 が節の終わりを表す．
+///   節は複数の行にまたがってもよく，1行に複数の節があってもよい．
+//////////////////////////////////////////////////////////////////////
+class DimacsParser
+{
+public:
+
+  /// @brief 節を受け取るコールバック関数の型
+  ///
+  /// 引数は DIMACS 形式のリテラル(1 から始まる変数番号に符号をつけたもの)
+  /// のリスト．
+  using ClauseFunc = std::function<void(const vector<int>&)>;
+
+public:
+
+  /// @brief コンストラクタ
+  DimacsParser(
+    const ClauseFunc& clause_func, ///< [in] 節を受け取る関数
+    SizeType thread_num = 1        ///< [in] 字句解析に用いるスレッド数
+  ) : mClauseFunc{clause_func},
+      mThreadNum{thread_num}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~DimacsParser() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief ストリームから読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read(
+    istream& s ///< [in] 入力元のストリーム
+  );
+
+  /// @brief メモリ上のデータを読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  ///
+  /// データが圧縮されている場合には展開しながら読み込む．
+  /// データの形式は先頭のマジックナンバーで判定する．
+  bool
+  parse(
+    const char* begin, ///< [in] データの先頭
+    const char* end    ///< [in] データの末尾
+  );
+
+  /// @brief ヘッダで宣言された変数の数を返す．
+  SizeType
+  dec_var_num() const
+  {
+    return mDecVarNum;
+  }
+
+  /// @brief ヘッダで宣言された節の数を返す．
+  SizeType
+  dec_clause_num() const
+  {
+    return mDecClauseNum;
+  }
+
+  /// @brief 実際に現れた変数番号の最大値を返す．
+  SizeType
+  max_var() const
+  {
+    return mMaxVar;
+  }
+
+  /// @brief 実際に読み込んだ節の数を返す．
+  SizeType
+  clause_num() const
+  {
+    return mClauseNum;
+  }
+
+  /// @brief 直前の読み込みのメッセージを返す．
+  const vector<string>&
+  message_list() const
+  {
+    return mMessageList;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 1つのスレッドで読み込む．
+  bool
+  parse_single(
+    const char* begin, ///< [in] データの先頭
+    const char* end    ///< [in] データの末尾
+  );
+
+  /// @brief 複数のスレッドで読み込む．
+  bool
+  parse_multi(
+    const char* begin, ///< [in] データの先頭
+    const char* end,   ///< [in] データの末尾
+    SizeType chunk_num ///< [in] チャンク数
+  );
+
+  /// @brief 圧縮されたデータを展開しながら読み込む．
+  bool
+  parse_compressed(
+    Decompressor& decomp ///< [in] 展開器
+  );
+
+  /// @brief バイナリ CNF 形式のデータを読み込む．
+  bool
+  parse_binary(
+    const char* begin, ///< [in] データの先頭
+    const char* end    ///< [in] データの末尾
+  );
+
+  /// @brief エラーメッセージを追加する．
+  void
+  add_error(
+    SizeType lineno,   ///< [in] 行番号
+    const string& msg  ///< [in] メッセージ
+  );
+
+  /// @brief 読み込み後のチェックを行う．
+  bool
+  check_result(
+    SizeType lineno ///< [in] 最終行の行番号
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 節を受け取る関数
+  ClauseFunc mClauseFunc;
+
+  // スレッド数
+  SizeType mThreadNum;
+
+  // ヘッダを読み込んだら true にするフラグ
+  bool mHasHeader{false};
+
+  // 宣言された変数の数
+  SizeType mDecVarNum{0};
+
+  // 宣言された節の数
+  SizeType mDecClauseNum{0};
+
+  // 変数番号の最大値
+  SizeType mMaxVar{0};
+
+  // 読み込んだ節の数
+  SizeType mClauseNum{0};
+
+  // メッセージのリスト
+  vector<string> mMessageList;
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // DIMACSPARSER_H
@@ -0,0 +1,121 @@
+#ifndef DIMACSWRITER_H
+#define DIMACSWRITER_H
+
+/// @file DimacsWriter.h
+/// @brief DimacsWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/sat.h"
+#include "ym/SatLiteral.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class DimacsWriter DimacsWriter.h "DimacsWriter.h"
+/// @brief DIMACS 形式で出力するクラス
+///
+/// 整数の文字列化は std::to_chars() で行い，結果を大きなバッファに
+/// ためてからまとめて書き出す．
+/// スレッド数が 2 以上の場合は節のリストをチャンクに分割して
+/// 各スレッドで文字列化し，先頭のチャンクから順に書き出す．
+//////////////////////////////////////////////////////////////////////
+class DimacsWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  DimacsWriter(
+    ostream& s,             ///< [in] 出力先のストリーム
+    SizeType thread_num = 1 ///< [in] 文字列化に用いるスレッド数
+  ) : mS{s},
+      mThreadNum{thread_num}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~DimacsWriter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief DIMACS 形式のリテラルで表された節のリストを出力する．
+  void
+  write(
+    SizeType var_num,                        ///< [in] 変数の数
+    const vector<vector<int>>& clause_list   ///< [in] 節のリスト
+  );
+
+  /// @brief 平坦なリストで表された節のリストを出力する．
+  ///
+  /// i 番目の節は lit_list の begin_list[i] から begin_list[i + 1] の
+  /// 直前までとなる．
+  void
+  write(
+    SizeType var_num,                   ///< [in] 変数の数
+    const vector<SatLiteral>& lit_list, ///< [in] 全ての節のリテラルのリスト
+    const vector<SizeType>& begin_list  ///< [in] 各節の開始位置のリスト
+  );
+
+  /// @brief ヘッダを出力する．
+  ///
+  /// 節を1つずつ出力する場合に用いる．
+  void
+  write_header(
+    SizeType var_num,   ///< [in] 変数の数
+    SizeType clause_num ///< [in] 節の数
+  );
+
+  /// @brief 節を1つ出力する．
+  void
+  put_clause(
+    const vector<SatLiteral>& lits ///< [in] リテラルのリスト
+  );
+
+  /// @brief バッファの内容を書き出す．
+  void
+  flush();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief write() の本体
+  ///
+  /// func(buff, i) で i 番目の節を buff に追加する．
+  template<typename Func>
+  void
+  write_body(
+    SizeType var_num,    ///< [in] 変数の数
+    SizeType clause_num, ///< [in] 節の数
+    Func func            ///< [in] 節を文字列化する関数
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 出力先のストリーム
+  ostream& mS;
+
+  // スレッド数
+  SizeType mThreadNum;
+
+  // 出力用のバッファ
+  string mBuff;
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // DIMACSWRITER_H
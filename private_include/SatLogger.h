@@ -54,7 +54,8 @@ public:
   virtual
   void
   add_clause(
-    const vector<SatLiteral>& lits ///< [in] リテラルのベクタ
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
   );
 
   /// @brief assumption 付きの SAT 問題を解く．
@@ -46,7 +46,8 @@ public:
   /// @brief 節を追加する．
   void
   add_clause(
-    const vector<SatLiteral>& lits
+    SizeType n,
+    const SatLiteral* lits
   ) override;
 
   /// @brief assumption 付きの SAT 問題を解く．
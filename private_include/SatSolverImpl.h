@@ -11,7 +11,9 @@
 #include "ym/sat.h"
 #include "ym/SatBool3.h"
 #include "ym/SatLiteral.h"
+#include "ym/SatModel.h"
 #include "ym/SatStats.h"
+#include <functional>
 
 
 BEGIN_NAMESPACE_YM_SAT
@@ -56,12 +58,92 @@ public:
   ) = 0;
 
   /// @brief 節を追加する．
-  virtual
   void
   add_clause(
     const vector<SatLiteral>& lits ///< [in] リテラルのベクタ
+  )
+  {
+    add_clause(lits.size(), lits.data());
+  }
+
+  /// @brief 節を追加する．
+  ///
+  /// lits の内容は呼び出し後には参照されないので
+  /// 実装側で必要ならコピーを作ること．
+  virtual
+  void
+  add_clause(
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits  ///< [in] リテラルの配列
   ) = 0;
 
+  /// @brief 複数の節をまとめて追加する．
+  ///
+  /// i 番目の節は lits[begin_list[i]] から lits[begin_list[i + 1] - 1] まで．
+  /// デフォルトの実装は1つずつ add_clause() を呼ぶ．
+  virtual
+  void
+  add_clauses(
+    SizeType clause_num,       ///< [in] 節の数
+    const SatLiteral* lits,    ///< [in] 全ての節のリテラルの配列
+    const SizeType* begin_list ///< [in] 各節の開始位置の配列(要素数は clause_num + 1)
+  );
+
+  /// @brief XOR 制約を追加する．
+  /// @return 対応していない場合には何もしないで false を返す．
+  ///
+  /// lits の XOR が rhs に等しいという制約を表す．
+  /// lits の内容は呼び出し後には参照されない．
+  /// デフォルトの実装は何もしないで false を返すので，
+  /// 呼び出し側で節に展開する必要がある．
+  virtual
+  bool
+  add_xor_constraint(
+    SizeType n,             ///< [in] リテラル数
+    const SatLiteral* lits, ///< [in] リテラルの配列
+    bool rhs                ///< [in] 右辺の値
+  );
+
+  /// @brief 擬似ブール制約を追加する．
+  /// @return 対応していない場合には何もしないで false を返す．
+  ///
+  /// Σ weights[i] * lits[i] >= bound という制約を表す．
+  /// 重みは正で，同じ変数は2度以上現れないものとする．
+  /// lits と weights の内容は呼び出し後には参照されない．
+  /// デフォルトの実装は何もしないで false を返すので，
+  /// 呼び出し側で節に展開する必要がある．
+  virtual
+  bool
+  add_pb_constraint(
+    SizeType n,              ///< [in] リテラル数
+    const SatLiteral* lits,  ///< [in] リテラルの配列
+    const SizeType* weights, ///< [in] 重みの配列
+    SizeType bound           ///< [in] 右辺の値
+  );
+
+  /// @brief モデルの値割り当てを優先する極性として設定する．
+  /// @return 対応していない場合には何もしないで false を返す．
+  ///
+  /// 値が X の変数は無視する．
+  bool
+  set_phase(
+    const SatModel& model ///< [in] モデル
+  );
+
+  /// @brief 決定変数の値を選ぶ時に優先する極性を設定する．
+  /// @return 対応していない場合には何もしないで false を返す．
+  ///
+  /// 以降の探索で lits の各リテラルが true となる極性を優先させる．
+  /// 実装によっては探索中に記録される極性(phase saving)で上書きされる．
+  /// lits の内容は呼び出し後には参照されない．
+  /// デフォルトの実装は何もしないで false を返す．
+  virtual
+  bool
+  set_phase(
+    SizeType n,            ///< [in] リテラル数
+    const SatLiteral* lits ///< [in] リテラルの配列
+  );
+
   /// @brief SAT 問題を解く．
   /// @retval kB3True 充足した．
   /// @retval kB3False 充足不能が判明した．
@@ -82,6 +164,28 @@ public:
   void
   stop() = 0;
 
+  /// @brief 変数と節をすべて削除して生成直後の状態に戻す．
+  /// @return 対応していない場合には何もしないで false を返す．
+  ///
+  /// 確保済みの領域を再利用することで小さな問題を
+  /// 繰り返し解く場合の生成コストを抑えるためのもの．
+  /// デフォルトの実装は何もしないで false を返す．
+  virtual
+  bool
+  reset();
+
+  /// @brief 制約節を列挙する．
+  /// @return 対応していない場合には何もしないで false を返す．
+  ///
+  /// 実装によっては追加された節をそのままの形では保持していないので，
+  /// 得られるのは元の節の集合と同じモデルを持つ節の集合となる．
+  /// デフォルトの実装は何もしないで false を返す．
+  virtual
+  bool
+  enum_clauses(
+    const std::function<void(const vector<SatLiteral>&)>& func ///< [in] 節を受け取る関数
+  ) const;
+
   /// @brief 現在の内部状態を得る．
   virtual
   SatStats
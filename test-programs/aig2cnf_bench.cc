@@ -0,0 +1,222 @@
+
+/// @file aig2cnf_bench.cc
+/// @brief add_aig()/add_expr() の変換速度と CNF のサイズの計測
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "ym/AigMgr.h"
+#include "ym/Expr.h"
+#include <chrono>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 入力数
+const SizeType INPUT_NUM = 64;
+
+// func を呼んで生成された CNF のサイズと時間を出力する．
+template<typename Func>
+void
+bench_sub(
+  const string& name,
+  const SatInitParam& init_param,
+  bool tseitin,
+  Func func
+)
+{
+  SatSolver solver{init_param};
+  solver.set_tseitin_encoding(tseitin);
+  std::unordered_map<SizeType, SatLiteral> lit_map;
+  for ( SizeType i = 0; i < INPUT_NUM; ++ i ) {
+    lit_map.emplace(i, solver.new_variable(true));
+  }
+  auto start = std::chrono::steady_clock::now();
+  func(solver, lit_map);
+  auto end = std::chrono::steady_clock::now();
+  auto usec = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  auto cnf_size = solver.cnf_size();
+  cout << setw(28) << std::left << name
+       << ": " << setw(8) << std::right << usec / 1000 << " ms"
+       << " (" << solver.variable_num() << " variables, "
+       << cnf_size.clause_num << " clauses, "
+       << cnf_size.literal_num << " literals)" << endl;
+}
+
+// func を呼んで生成された CNF のサイズと時間を出力する．
+//
+// Tseitin 符号化と Plaisted-Greenbaum 符号化の両方で計測する．
+template<typename Func>
+void
+bench(
+  const string& name,
+  const SatInitParam& init_param,
+  Func func
+)
+{
+  for ( auto tseitin: {true, false} ) {
+    bench_sub(name + (tseitin ? "/tseitin" : "/pg"), init_param, tseitin, func);
+  }
+}
+
+// 深さ depth の AND/OR の鎖を作る．
+AigHandle
+make_deep_aig(
+  AigMgr& mgr,
+  SizeType depth
+)
+{
+  auto f = mgr.input(0);
+  for ( SizeType i = 1; i <= depth; ++ i ) {
+    auto a = mgr.input(i % INPUT_NUM);
+    auto b = mgr.input((i * 7 + 3) % INPUT_NUM);
+    f = (f & a) | ~b;
+  }
+  return f;
+}
+
+// ランダムな2段の AND-OR 回路を num 個作る．
+vector<AigHandle>
+make_wide_aig(
+  AigMgr& mgr,
+  SizeType num,
+  SizeType width
+)
+{
+  std::mt19937 rg;
+  std::uniform_int_distribution<SizeType> var_dist(0, INPUT_NUM - 1);
+  std::uniform_int_distribution<int> pol_dist(0, 1);
+  auto rand_lit = [&]() {
+    auto h = mgr.input(var_dist(rg));
+    return pol_dist(rg) ? ~h : h;
+  };
+  vector<AigHandle> aig_list;
+  aig_list.reserve(num);
+  for ( SizeType i = 0; i < num; ++ i ) {
+    auto f = mgr.make_zero();
+    for ( SizeType j = 0; j < width; ++ j ) {
+      auto cube = mgr.make_one();
+      for ( SizeType k = 0; k < width; ++ k ) {
+	cube = cube & rand_lit();
+      }
+      f = f | cube;
+    }
+    aig_list.push_back(~f);
+  }
+  return aig_list;
+}
+
+// 深さ depth の AND/OR の鎖を作る．
+Expr
+make_deep_expr(
+  SizeType depth
+)
+{
+  auto f = Expr::posi_literal(0);
+  for ( SizeType i = 1; i <= depth; ++ i ) {
+    auto a = Expr::posi_literal(i % INPUT_NUM);
+    auto b = Expr::nega_literal((i * 7 + 3) % INPUT_NUM);
+    f = (f & a) | b;
+  }
+  return f;
+}
+
+// ランダムな num 個のパリティ検査式を作る．
+Expr
+make_parity_expr(
+  SizeType num,
+  SizeType width
+)
+{
+  std::mt19937 rg;
+  std::uniform_int_distribution<SizeType> var_dist(0, INPUT_NUM - 1);
+  vector<Expr> check_list;
+  check_list.reserve(num);
+  for ( SizeType i = 0; i < num; ++ i ) {
+    vector<Expr> opr_list;
+    opr_list.reserve(width);
+    for ( SizeType j = 0; j < width; ++ j ) {
+      opr_list.push_back(Expr::posi_literal(var_dist(rg)));
+    }
+    check_list.push_back(~Expr::xor_op(opr_list));
+  }
+  return Expr::and_op(check_list);
+}
+
+END_NONAMESPACE
+
+int
+aig2cnf_bench(
+  int argc,
+  char** argv
+)
+{
+  string type = "ymsat2";
+  SizeType scale = 1;
+  if ( argc > 1 ) {
+    type = argv[1];
+  }
+  if ( argc > 2 ) {
+    scale = atoi(argv[2]);
+  }
+  if ( scale == 0 ) {
+    scale = 1;
+  }
+  SatInitParam init_param{type};
+
+  {
+    AigMgr mgr;
+    auto aig = make_deep_aig(mgr, 20000 * scale);
+    bench("add_aig(deep)", init_param,
+	  [&](SatSolver& solver, const SatSolver::LitMap& lit_map) {
+	    solver.add_aig(aig, lit_map);
+	  });
+  }
+  {
+    AigMgr mgr;
+    auto aig_list = make_wide_aig(mgr, 2000 * scale, 16);
+    bench("add_aig(wide)", init_param,
+	  [&](SatSolver& solver, const SatSolver::LitMap& lit_map) {
+	    solver.add_aig(aig_list, lit_map);
+	  });
+  }
+  {
+    auto expr = make_deep_expr(20000 * scale);
+    bench("add_expr(deep)", init_param,
+	  [&](SatSolver& solver, const SatSolver::LitMap& lit_map) {
+	    solver.add_expr(expr, lit_map);
+	  });
+  }
+
+  {
+    auto expr = make_parity_expr(2000 * scale, 16);
+    for ( SizeType cut = 2; cut <= 4; ++ cut ) {
+      ostringstream buf;
+      buf << "add_expr(parity," << cut << ")";
+      bench(buf.str(), init_param,
+	    [&](SatSolver& solver, const SatSolver::LitMap& lit_map) {
+	      solver.set_xor_cut(cut);
+	      solver.add_expr(expr, lit_map);
+	    });
+    }
+  }
+
+  return 0;
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::aig2cnf_bench(argc, argv);
+}
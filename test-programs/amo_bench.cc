@@ -0,0 +1,125 @@
+
+/// @file amo_bench.cc
+/// @brief at-most-one 制約の符号化方法ごとの求解時間の計測
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "ym/SatStats.h"
+#include "bench_util.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 求解の時間制限(秒)
+const SizeType TIME_LIMIT = 20;
+
+// pairwise を試す制約の大きさの上限
+const SizeType PAIRWISE_MAX = 500;
+
+const SatAmoEnc enc_list[] = {
+  SatAmoEnc::Auto,
+  SatAmoEnc::Pairwise,
+  SatAmoEnc::Halving,
+  SatAmoEnc::Ladder,
+  SatAmoEnc::Commander,
+  SatAmoEnc::Product,
+  SatAmoEnc::Bimander
+};
+
+// nj 個の仕事を ns 個の枠に割り当てる問題を解く．
+//
+// 仕事ごとに add_exact_one(ns 入力)，枠ごとに add_at_most_one(nj 入力)
+// の制約を持つ．割り当てられない (仕事, 枠) の組を density の割合で
+// ランダムに選ぶ．1回の求解は TIME_LIMIT 秒で打ち切る．
+void
+bench_assign(
+  const SatInitParam& init_param,
+  SizeType nj,
+  SizeType ns,
+  double density
+)
+{
+  cout << "assign nj = " << nj << ", ns = " << ns
+       << ", density = " << density << endl;
+  for ( auto enc: enc_list ) {
+    if ( enc == SatAmoEnc::Pairwise && std::max(nj, ns) > PAIRWISE_MAX ) {
+      cout << "  " << setw(10) << std::left << enc << std::right
+	   << ": skipped" << endl;
+      continue;
+    }
+    SatSolver solver{init_param};
+    std::mt19937 rg;
+    std::bernoulli_distribution forbid_dist(density);
+    SatBool3 ans;
+    auto ms = measure([&]() {
+      vector<vector<SatLiteral>> x_list(nj, vector<SatLiteral>(ns));
+      for ( auto& row: x_list ) {
+	for ( auto& lit: row ) {
+	  lit = solver.new_variable(true);
+	  if ( forbid_dist(rg) ) {
+	    solver.add_clause(~lit);
+	  }
+	}
+	solver.add_exact_one(row, enc);
+      }
+      for ( SizeType s = 0; s < ns; ++ s ) {
+	vector<SatLiteral> col(nj);
+	for ( SizeType j = 0; j < nj; ++ j ) {
+	  col[j] = x_list[j][s];
+	}
+	solver.add_at_most_one(col, enc);
+      }
+      ans = solver.solve(TIME_LIMIT);
+    });
+    auto stats = solver.get_stats();
+    cout << "  " << setw(10) << std::left << enc << std::right
+	 << ": " << setw(9) << std::fixed << std::setprecision(1) << ms << " ms"
+	 << ", " << ans
+	 << " (" << solver.clause_num() << " clauses, "
+	 << stats.mConflictNum << " conflicts)" << endl;
+  }
+}
+
+END_NONAMESPACE
+
+int
+amo_bench(
+  int argc,
+  char** argv
+)
+{
+  string type = "ymsat2";
+  if ( argc > 1 ) {
+    type = argv[1];
+  }
+  SatInitParam init_param{type};
+
+  // 鳩の巣原理の問題(充足不能)
+  bench_assign(init_param, 9, 8, 0.0);
+  bench_assign(init_param, 10, 9, 0.0);
+
+  bench_assign(init_param, 50, 50, 0.5);
+  bench_assign(init_param, 200, 200, 0.9);
+  bench_assign(init_param, 20, 2000, 0.9);
+  bench_assign(init_param, 100, 4000, 0.95);
+
+  return 0;
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::amo_bench(argc, argv);
+}
@@ -0,0 +1,32 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+/// @file bench_util.h
+/// @brief ベンチマークプログラムで共通に用いる関数
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym_config.h"
+#include <chrono>
+
+
+BEGIN_NAMESPACE_YM
+
+/// @brief func() の実行にかかった時間をミリ秒で返す．
+template<typename Func>
+double
+measure(
+  Func func ///< [in] 計測する関数
+)
+{
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+END_NAMESPACE_YM
+
+#endif // BENCH_UTIL_H
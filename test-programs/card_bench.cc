@@ -0,0 +1,157 @@
+
+/// @file card_bench.cc
+/// @brief 個数制約の符号化方法ごとの求解時間の計測
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "ym/SatStats.h"
+#include "bench_util.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 求解の時間制限(秒)
+const SizeType TIME_LIMIT = 20;
+
+const SatCardEnc enc_list[] = {
+  SatCardEnc::Auto,
+  SatCardEnc::Counter,
+  SatCardEnc::SeqCounter,
+  SatCardEnc::Totalizer,
+  SatCardEnc::ModTotalizer,
+  SatCardEnc::CardNetwork
+};
+
+// at_most_test と同様に n 入力の全ての割り当てを仮定として解く．
+void
+bench_exhaustive(
+  const SatInitParam& init_param,
+  SizeType n,
+  SizeType k
+)
+{
+  cout << "exhaustive n = " << n << ", k = " << k << endl;
+  for ( auto enc: enc_list ) {
+    SatSolver solver{init_param};
+    vector<SatLiteral> lit_list(n);
+    for ( auto& lit: lit_list ) {
+      lit = solver.new_variable(true);
+    }
+    auto ms = measure([&]() {
+      solver.add_at_most_k(lit_list, k, enc);
+      vector<SatLiteral> assumptions(n);
+      for ( SizeType p = 0; p < (1U << n); ++ p ) {
+	for ( SizeType i = 0; i < n; ++ i ) {
+	  assumptions[i] = (p & (1U << i)) ? lit_list[i] : ~lit_list[i];
+	}
+	solver.solve(assumptions);
+      }
+    });
+    cout << "  " << setw(14) << std::left << enc << std::right
+	 << ": " << setw(9) << std::fixed << std::setprecision(1) << ms << " ms"
+	 << " (" << solver.clause_num() << " clauses)" << endl;
+  }
+}
+
+// ni 個の要素を容量 k の nb 個の箱に詰める問題を解く．
+//
+// ランダムなグラフの隣接する要素は同じ箱に入れられない．
+// 箱ごとの容量制約が add_at_most_k(ni 入力, k) になる．
+// 1回の求解は TIME_LIMIT 秒で打ち切る．
+void
+bench_packing(
+  const SatInitParam& init_param,
+  SizeType ni,
+  SizeType nb,
+  SizeType k,
+  double density
+)
+{
+  cout << "packing ni = " << ni << ", nb = " << nb << ", k = " << k
+       << ", density = " << density << endl;
+  for ( auto enc: enc_list ) {
+    SatSolver solver{init_param};
+    std::mt19937 rg;
+    std::bernoulli_distribution edge_dist(density);
+    SatBool3 ans;
+    auto ms = measure([&]() {
+      vector<vector<SatLiteral>> x_list(ni, vector<SatLiteral>(nb));
+      for ( auto& row: x_list ) {
+	for ( auto& lit: row ) {
+	  lit = solver.new_variable(true);
+	}
+	solver.add_clause(row);
+      }
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	for ( SizeType j = i + 1; j < ni; ++ j ) {
+	  if ( edge_dist(rg) ) {
+	    for ( SizeType b = 0; b < nb; ++ b ) {
+	      solver.add_clause(~x_list[i][b], ~x_list[j][b]);
+	    }
+	  }
+	}
+      }
+      for ( SizeType b = 0; b < nb; ++ b ) {
+	vector<SatLiteral> col(ni);
+	for ( SizeType i = 0; i < ni; ++ i ) {
+	  col[i] = x_list[i][b];
+	}
+	solver.add_at_most_k(col, k, enc);
+      }
+      ans = solver.solve(TIME_LIMIT);
+    });
+    auto stats = solver.get_stats();
+    cout << "  " << setw(14) << std::left << enc << std::right
+	 << ": " << setw(9) << std::fixed << std::setprecision(1) << ms << " ms"
+	 << ", " << ans
+	 << " (" << solver.clause_num() << " clauses, "
+	 << stats.mConflictNum << " conflicts)" << endl;
+  }
+}
+
+END_NONAMESPACE
+
+int
+card_bench(
+  int argc,
+  char** argv
+)
+{
+  string type = "ymsat2";
+  if ( argc > 1 ) {
+    type = argv[1];
+  }
+  SatInitParam init_param{type};
+
+  for ( SizeType k: {3, 5, 10} ) {
+    bench_exhaustive(init_param, 15, k);
+  }
+
+  bench_packing(init_param, 40, 4, 10, 0.2);
+  bench_packing(init_param, 60, 3, 20, 0.1);
+  bench_packing(init_param, 80, 16, 5, 0.3);
+  bench_packing(init_param, 90, 6, 15, 0.15);
+  bench_packing(init_param, 120, 40, 3, 0.3);
+  bench_packing(init_param, 120, 4, 30, 0.08);
+  bench_packing(init_param, 200, 4, 50, 0.04);
+
+  return 0;
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::card_bench(argc, argv);
+}
@@ -0,0 +1,255 @@
+
+/// @file dimacs_bench.cc
+/// @brief DIMACS 形式のファイルの読み書きの速度の計測
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatDimacs.h"
+#include "ym/SatSolver.h"
+#include "DimacsParser.h"
+#include <chrono>
+#include <random>
+#include <regex>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM
+
+using nsSat::DimacsParser;
+
+BEGIN_NONAMESPACE
+
+// ランダムな 3-SAT 問題のファイルを作る．
+void
+gen_cnf(
+  const string& filename,
+  SizeType nv,
+  SizeType nc
+)
+{
+  std::mt19937 rg;
+  std::uniform_int_distribution<int> var_dist(1, nv);
+  std::uniform_int_distribution<int> pol_dist(0, 1);
+  ofstream s{filename};
+  s << "c random 3-SAT" << endl
+    << "p cnf " << nv << " " << nc << endl;
+  for ( SizeType i = 0; i < nc; ++ i ) {
+    for ( SizeType j = 0; j < 3; ++ j ) {
+      int l = var_dist(rg);
+      if ( pol_dist(rg) ) {
+	l = -l;
+      }
+      s << l << " ";
+    }
+    s << "0\n";
+  }
+}
+
+// 以前の正規表現を用いた実装
+// 読み込んだ節の数を返す．
+SizeType
+regex_read(
+  istream& s
+)
+{
+  regex pat_C{R"(^c)"};
+  regex pat_P{R"(^p\s+cnf\s+(\d+)\s+(\d+)\s*$)"};
+  regex pat_E{R"(^%)"};
+  regex pat_L{R"(^\s*(-?\d+))"};
+
+  SizeType nc = 0;
+  string buff;
+  while ( getline(s, buff) ) {
+    if ( regex_search(buff, pat_C) ) {
+      continue;
+    }
+    smatch match;
+    if ( regex_match(buff, match, pat_P) ) {
+      continue;
+    }
+    if ( regex_search(buff, pat_E) ) {
+      break;
+    }
+    vector<int> lits;
+    auto start = buff.cbegin();
+    auto end = buff.cend();
+    while ( true ) {
+      if ( !regex_search(start, end, match, pat_L) ) {
+	return nc;
+      }
+      int lit = stoi(match[1]);
+      if ( lit == 0 ) {
+	++ nc;
+	break;
+      }
+      lits.push_back(lit);
+      start = match[0].second;
+    }
+  }
+  return nc;
+}
+
+// 以前の実装と同様に ostream の << と endl で出力する．
+void
+legacy_write(
+  ostream& s,
+  const SatDimacs& dimacs
+)
+{
+  s << "p cnf " << dimacs.variable_num() << " " << dimacs.clause_num() << endl;
+  for ( auto& lit_list: dimacs.clause_list() ) {
+    const char* sp = "";
+    for ( auto lit: lit_list ) {
+      s << sp << lit;
+      sp = " ";
+    }
+    s << " 0" << endl;
+  }
+}
+
+// 計測結果を出力する．
+void
+report(
+  const string& name,
+  SizeType size,
+  SizeType nc,
+  std::chrono::steady_clock::time_point start
+)
+{
+  auto end = std::chrono::steady_clock::now();
+  auto usec = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  auto rate = usec > 0 ? static_cast<double>(size) / usec : 0.0;
+  cout << setw(28) << std::left << name
+       << ": " << setw(8) << std::right << usec / 1000 << " ms"
+       << ", " << setw(8) << std::fixed << std::setprecision(1) << rate << " MB/s"
+       << " (" << nc << " clauses)" << endl;
+}
+
+END_NONAMESPACE
+
+int
+dimacs_bench(
+  int argc,
+  char** argv
+)
+{
+  string filename;
+  SizeType num_threads = std::thread::hardware_concurrency();
+  if ( argc > 1 ) {
+    filename = argv[1];
+  }
+  if ( argc > 2 ) {
+    num_threads = atoi(argv[2]);
+  }
+  if ( num_threads == 0 ) {
+    num_threads = 1;
+  }
+
+  if ( filename == string{} ) {
+    filename = "dimacs_bench.cnf";
+    gen_cnf(filename, 100000, 500000);
+  }
+
+  SizeType size;
+  {
+    ifstream s{filename, std::ios::binary | std::ios::ate};
+    if ( !s ) {
+      cerr << filename << ": No such file" << endl;
+      return 1;
+    }
+    size = s.tellg();
+  }
+
+  {
+    auto start = std::chrono::steady_clock::now();
+    ifstream s{filename};
+    auto nc = regex_read(s);
+    report("regex", size, nc, start);
+  }
+  {
+    auto start = std::chrono::steady_clock::now();
+    ifstream s{filename};
+    SatDimacs dimacs;
+    dimacs.read_dimacs(s);
+    report("SatDimacs(istream)", size, dimacs.clause_num(), start);
+  }
+  {
+    auto start = std::chrono::steady_clock::now();
+    SatDimacs dimacs;
+    dimacs.read_dimacs(filename);
+    report("SatDimacs(mmap)", size, dimacs.clause_num(), start);
+  }
+  for ( SizeType n: {SizeType{1}, num_threads} ) {
+    auto start = std::chrono::steady_clock::now();
+    SizeType nl = 0;
+    DimacsParser parser{[&](const vector<int>& lits) { nl += lits.size(); }, n};
+    parser.read(filename);
+    ostringstream buf;
+    buf << "DimacsParser(" << n << ")";
+    report(buf.str(), size, parser.clause_num(), start);
+  }
+  {
+    // バイナリ CNF 形式に変換したものを読み込む．
+    string bin_filename = filename + ".bin";
+    SizeType bin_size;
+    {
+      SatDimacs dimacs;
+      dimacs.read_dimacs(filename);
+      ofstream s{bin_filename, std::ios::binary};
+      dimacs.write_binary(s);
+      bin_size = s.tellp();
+    }
+    auto start = std::chrono::steady_clock::now();
+    SatDimacs dimacs;
+    dimacs.read_dimacs(bin_filename);
+    report("SatDimacs(binary)", bin_size, dimacs.clause_num(), start);
+    std::remove(bin_filename.c_str());
+  }
+  {
+    auto start = std::chrono::steady_clock::now();
+    SatSolver solver;
+    solver.read_DIMACS(filename, num_threads);
+    ostringstream buf;
+    buf << "SatSolver::read_DIMACS(" << num_threads << ")";
+    report(buf.str(), size, solver.clause_num(), start);
+  }
+
+  {
+    // 書き出しの計測
+    SatDimacs dimacs;
+    dimacs.read_dimacs(filename);
+    string out_filename = filename + ".out";
+    {
+      auto start = std::chrono::steady_clock::now();
+      ofstream s{out_filename};
+      legacy_write(s, dimacs);
+      s.close();
+      report("write(endl)", size, dimacs.clause_num(), start);
+    }
+    for ( SizeType n: {SizeType{1}, num_threads} ) {
+      auto start = std::chrono::steady_clock::now();
+      ofstream s{out_filename};
+      dimacs.write_dimacs(s, n);
+      s.close();
+      ostringstream buf;
+      buf << "write_dimacs(" << n << ")";
+      report(buf.str(), size, dimacs.clause_num(), start);
+    }
+    std::remove(out_filename.c_str());
+  }
+
+  return 0;
+}
+
+END_NAMESPACE_YM
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::dimacs_bench(argc, argv);
+}
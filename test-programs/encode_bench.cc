@@ -0,0 +1,186 @@
+
+/// @file encode_bench.cc
+/// @brief ゲートや個数制約の符号化の速度の計測
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include <chrono>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 1回の計測で用いる変数の数
+const SizeType VAR_NUM = 10000;
+
+// 入力用の変数をランダムに選ぶクラス
+class LitGen
+{
+public:
+
+  // コンストラクタ
+  LitGen(
+    SatSolver& solver
+  ) : mVarDist(0, VAR_NUM - 1),
+      mPolDist(0, 1)
+  {
+    mVarList.reserve(VAR_NUM);
+    for ( SizeType i = 0; i < VAR_NUM; ++ i ) {
+      mVarList.push_back(solver.new_variable(true));
+    }
+  }
+
+  // リテラルを1つ選ぶ．
+  SatLiteral
+  lit()
+  {
+    auto lit = mVarList[mVarDist(mRg)];
+    if ( mPolDist(mRg) ) {
+      lit = ~lit;
+    }
+    return lit;
+  }
+
+  // 互いに異なる変数のリテラルを n 個選ぶ．
+  void
+  lits(
+    SizeType n,
+    vector<SatLiteral>& lit_list
+  )
+  {
+    auto base = mVarDist(mRg);
+    lit_list.resize(n);
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto lit = mVarList[(base + i) % VAR_NUM];
+      if ( mPolDist(mRg) ) {
+	lit = ~lit;
+      }
+      lit_list[i] = lit;
+    }
+  }
+
+private:
+
+  std::mt19937 mRg;
+  std::uniform_int_distribution<SizeType> mVarDist;
+  std::uniform_int_distribution<int> mPolDist;
+  vector<SatLiteral> mVarList;
+
+};
+
+// func を num 回呼んで符号化された節の数と時間を出力する．
+template<typename Func>
+void
+bench(
+  const string& name,
+  const SatInitParam& init_param,
+  SizeType num,
+  Func func
+)
+{
+  SatSolver solver{init_param};
+  LitGen gen{solver};
+  vector<SatLiteral> lit_list;
+  auto start = std::chrono::steady_clock::now();
+  for ( SizeType i = 0; i < num; ++ i ) {
+    func(solver, gen, lit_list);
+  }
+  auto end = std::chrono::steady_clock::now();
+  auto usec = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  auto nc = solver.clause_num();
+  auto rate = usec > 0 ? static_cast<double>(nc) / usec : 0.0;
+  cout << setw(24) << std::left << name
+       << ": " << setw(8) << std::right << usec / 1000 << " ms"
+       << ", " << setw(8) << std::fixed << std::setprecision(2) << rate << " Mclauses/s"
+       << " (" << nc << " clauses)" << endl;
+}
+
+END_NONAMESPACE
+
+int
+encode_bench(
+  int argc,
+  char** argv
+)
+{
+  string type = "ymsat2";
+  SizeType scale = 1;
+  if ( argc > 1 ) {
+    type = argv[1];
+  }
+  if ( argc > 2 ) {
+    scale = atoi(argv[2]);
+  }
+  if ( scale == 0 ) {
+    scale = 1;
+  }
+  SatInitParam init_param{type};
+
+  bench("add_andgate(2)", init_param, 500000 * scale,
+	[](SatSolver& solver, LitGen& gen, vector<SatLiteral>&) {
+	  auto olit = solver.new_variable(false);
+	  solver.add_andgate(olit, gen.lit(), gen.lit());
+	});
+  bench("add_andgate(8)", init_param, 200000 * scale,
+	[](SatSolver& solver, LitGen& gen, vector<SatLiteral>& lit_list) {
+	  gen.lits(8, lit_list);
+	  auto olit = solver.new_variable(false);
+	  solver.add_andgate(olit, lit_list);
+	});
+  bench("add_xorgate(8)", init_param, 50000 * scale,
+	[](SatSolver& solver, LitGen& gen, vector<SatLiteral>& lit_list) {
+	  gen.lits(8, lit_list);
+	  auto olit = solver.new_variable(false);
+	  solver.add_xorgate(olit, lit_list);
+	});
+  bench("add_full_adder", init_param, 200000 * scale,
+	[](SatSolver& solver, LitGen& gen, vector<SatLiteral>&) {
+	  auto slit = solver.new_variable(false);
+	  auto olit = solver.new_variable(false);
+	  solver.add_full_adder(gen.lit(), gen.lit(), gen.lit(), slit, olit);
+	});
+  bench("add_counter(64)", init_param, 5000 * scale,
+	[](SatSolver& solver, LitGen& gen, vector<SatLiteral>& lit_list) {
+	  gen.lits(64, lit_list);
+	  solver.add_counter(lit_list);
+	});
+  bench("add_at_most_one(32)", init_param, 20000 * scale,
+	[](SatSolver& solver, LitGen& gen, vector<SatLiteral>& lit_list) {
+	  gen.lits(32, lit_list);
+	  solver.add_at_most_one(lit_list);
+	});
+  bench("add_at_most_two(32)", init_param, 10000 * scale,
+	[](SatSolver& solver, LitGen& gen, vector<SatLiteral>& lit_list) {
+	  gen.lits(32, lit_list);
+	  solver.add_at_most_two(lit_list);
+	});
+  bench("add_at_least_two(32)", init_param, 10000 * scale,
+	[](SatSolver& solver, LitGen& gen, vector<SatLiteral>& lit_list) {
+	  gen.lits(32, lit_list);
+	  solver.add_at_least_two(lit_list);
+	});
+  bench("add_not_one(8)", init_param, 50000 * scale,
+	[](SatSolver& solver, LitGen& gen, vector<SatLiteral>& lit_list) {
+	  gen.lits(8, lit_list);
+	  solver.add_not_one(lit_list);
+	});
+
+  return 0;
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::encode_bench(argc, argv);
+}
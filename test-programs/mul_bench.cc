@@ -0,0 +1,129 @@
+
+/// @file mul_bench.cc
+/// @brief 乗算器(SatBinaryNum::mul())の構成方法ごとの求解時間の計測
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "ym/SatStats.h"
+#include "ym/SatBinaryNum.h"
+#include "bench_util.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 求解の時間制限(秒)
+const SizeType TIME_LIMIT = 20;
+
+const SatMulEnc enc_list[] = {
+  SatMulEnc::ShiftAdd,
+  SatMulEnc::Wallace,
+  SatMulEnc::Dadda
+};
+
+// 結果を出力する．
+void
+print_result(
+  SatMulEnc enc,
+  double ms,
+  SatBool3 ans,
+  SatSolver& solver
+)
+{
+  auto stats = solver.get_stats();
+  cout << "  " << setw(10) << std::left << enc << std::right
+       << ": " << setw(9) << std::fixed << std::setprecision(1) << ms << " ms"
+       << ", " << ans
+       << " (" << solver.variable_num() << " variables, "
+       << solver.clause_num() << " clauses, "
+       << stats.mConflictNum << " conflicts)" << endl;
+}
+
+// n ビットの2数の積が val となるような 2 以上の2数を求める．
+void
+bench_factor(
+  const SatInitParam& init_param,
+  SizeType n,
+  SizeType val
+)
+{
+  cout << "factor n = " << n << ", val = " << val << endl;
+  for ( auto enc: enc_list ) {
+    SatSolver solver{init_param};
+    SatBool3 ans;
+    auto ms = measure([&]() {
+      SatBinaryNum a{solver, n};
+      SatBinaryNum b{solver, n};
+      auto r = a.mul(b, enc);
+      auto c = SatBinaryNum::constant(solver, n * 2, val);
+      solver.add_eq(r.bit_vars(), c.bit_vars());
+      solver.add_gt(a.bit_vars(), 1);
+      solver.add_gt(b.bit_vars(), 1);
+      ans = solver.solve(TIME_LIMIT);
+    });
+    print_result(enc, ms, ans, solver);
+  }
+}
+
+// n ビットの乗算の交換則 a * b == b * a を確かめる(充足不能)．
+void
+bench_commute(
+  const SatInitParam& init_param,
+  SizeType n
+)
+{
+  cout << "commute n = " << n << endl;
+  for ( auto enc: enc_list ) {
+    SatSolver solver{init_param};
+    SatBool3 ans;
+    auto ms = measure([&]() {
+      SatBinaryNum a{solver, n};
+      SatBinaryNum b{solver, n};
+      auto r1 = a.mul(b, enc);
+      auto r2 = b.mul(a, enc);
+      solver.add_ne(r1.bit_vars(), r2.bit_vars());
+      ans = solver.solve(TIME_LIMIT);
+    });
+    print_result(enc, ms, ans, solver);
+  }
+}
+
+END_NONAMESPACE
+
+int
+mul_bench(
+  int argc,
+  char** argv
+)
+{
+  string type = "ymsat2";
+  if ( argc > 1 ) {
+    type = argv[1];
+  }
+  SatInitParam init_param{type};
+
+  bench_factor(init_param, 12, 16744463); // 4093 * 4091
+  bench_factor(init_param, 14, 268140589); // 16381 * 16369
+  bench_factor(init_param, 16, 4292870399); // 65521 * 65519
+  bench_commute(init_param, 6);
+  bench_commute(init_param, 7);
+  bench_commute(init_param, 8);
+
+  return 0;
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::mul_bench(argc, argv);
+}
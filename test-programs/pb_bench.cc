@@ -0,0 +1,141 @@
+
+/// @file pb_bench.cc
+/// @brief 擬似ブール制約の展開方法ごとの求解時間の計測
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "ym/SatStats.h"
+#include "bench_util.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 求解の時間制限(秒)
+const SizeType TIME_LIMIT = 20;
+
+// generalized totalizer と sorting network を試す重みの和の上限
+const int UNARY_MAX = 5000;
+
+const SatPbEnc enc_list[] = {
+  SatPbEnc::Auto,
+  SatPbEnc::Adder,
+  SatPbEnc::Bdd,
+  SatPbEnc::GenTotalizer,
+  SatPbEnc::SortNetwork
+};
+
+// n 個の品物の多次元ナップサック問題を解く．
+//
+// m 個の容量制約 add_pb_le() と価値の下限 add_pb_ge() を持つ．
+// 重みと価値は 1 以上 wmax 以下の乱数で，容量は重みの和の半分，
+// 価値の下限は価値の和の ratio 倍とする．
+// "native" は節に展開せずに実装に渡した場合．
+void
+bench_knapsack(
+  const SatInitParam& init_param,
+  SizeType n,
+  SizeType m,
+  int wmax,
+  double ratio
+)
+{
+  cout << "knapsack n = " << n << ", m = " << m << ", wmax = " << wmax
+       << ", ratio = " << ratio << endl;
+
+  std::mt19937 rg;
+  std::uniform_int_distribution<int> weight_dist(1, wmax);
+  vector<vector<int>> weight_list(m, vector<int>(n));
+  vector<int> cap_list(m);
+  for ( SizeType j = 0; j < m; ++ j ) {
+    int sum = 0;
+    for ( auto& w: weight_list[j] ) {
+      w = weight_dist(rg);
+      sum += w;
+    }
+    cap_list[j] = sum / 2;
+  }
+  vector<int> value_list(n);
+  int vsum = 0;
+  for ( auto& v: value_list ) {
+    v = weight_dist(rg);
+    vsum += v;
+  }
+  int target = static_cast<int>(vsum * ratio);
+
+  auto run = [&](const string& name, SatPbEnc enc, bool native) {
+    if ( (enc == SatPbEnc::GenTotalizer || enc == SatPbEnc::SortNetwork)
+	 && vsum > UNARY_MAX ) {
+      cout << "  " << setw(14) << std::left << name << std::right
+	   << ": skipped" << endl;
+      return;
+    }
+    SatSolver solver{init_param};
+    solver.set_native_pb(native);
+    SatBool3 ans;
+    auto ms = measure([&]() {
+      vector<SatLiteral> x_list(n);
+      for ( auto& lit: x_list ) {
+	lit = solver.new_variable(true);
+      }
+      for ( SizeType j = 0; j < m; ++ j ) {
+	solver.add_pb_le(weight_list[j], x_list, cap_list[j], enc);
+      }
+      solver.add_pb_ge(value_list, x_list, target, enc);
+      ans = solver.solve(TIME_LIMIT);
+    });
+    auto stats = solver.get_stats();
+    cout << "  " << setw(14) << std::left << name << std::right
+	 << ": " << setw(9) << std::fixed << std::setprecision(1) << ms << " ms"
+	 << ", " << ans
+	 << " (" << solver.clause_num() << " clauses, "
+	 << stats.mConflictNum << " conflicts)" << endl;
+  };
+
+  for ( auto enc: enc_list ) {
+    ostringstream buf;
+    buf << enc;
+    run(buf.str(), enc, false);
+  }
+  run("native", SatPbEnc::Auto, true);
+}
+
+END_NONAMESPACE
+
+int
+pb_bench(
+  int argc,
+  char** argv
+)
+{
+  string type = "ymsat2";
+  if ( argc > 1 ) {
+    type = argv[1];
+  }
+  SatInitParam init_param{type};
+
+  bench_knapsack(init_param, 30, 3, 20, 0.6);
+  bench_knapsack(init_param, 40, 4, 50, 0.6);
+  bench_knapsack(init_param, 60, 5, 20, 0.55);
+  bench_knapsack(init_param, 50, 3, 1000, 0.6);
+  bench_knapsack(init_param, 100, 2, 100, 0.6);
+
+  return 0;
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::pb_bench(argc, argv);
+}
@@ -0,0 +1,154 @@
+
+/// @file small_solve_bench.cc
+/// @brief 小さな SAT 問題を大量に解く場合のスループットの計測
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "ym/SatSolverPool.h"
+#include <chrono>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+const SizeType VAR_NUM = 20;
+const SizeType CLAUSE_NUM = 80;
+
+// id 番目のランダムな 3-SAT 問題を作って解く．
+SatBool3
+solve_one(
+  SizeType id,
+  SatSolver& solver
+)
+{
+  std::mt19937 rg{static_cast<std::mt19937::result_type>(id)};
+  std::uniform_int_distribution<int> var_dist(0, VAR_NUM - 1);
+  std::uniform_int_distribution<int> pol_dist(0, 1);
+  vector<SatLiteral> lits(VAR_NUM);
+  for ( SizeType i = 0; i < VAR_NUM; ++ i ) {
+    lits[i] = solver.new_variable(true);
+  }
+  for ( SizeType i = 0; i < CLAUSE_NUM; ++ i ) {
+    auto lit1 = lits[var_dist(rg)] * pol_dist(rg);
+    auto lit2 = lits[var_dist(rg)] * pol_dist(rg);
+    auto lit3 = lits[var_dist(rg)] * pol_dist(rg);
+    solver.add_clause(lit1, lit2, lit3);
+  }
+  return solver.solve();
+}
+
+// 計測結果を出力する．
+void
+report(
+  const char* name,
+  SizeType n,
+  SizeType sat_num,
+  std::chrono::steady_clock::time_point start
+)
+{
+  auto end = std::chrono::steady_clock::now();
+  auto usec = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  auto rate = usec > 0 ? static_cast<double>(n) * 1e+6 / usec : 0.0;
+  cout << setw(24) << std::left << name
+       << ": " << setw(10) << std::right << usec / 1000 << " ms"
+       << ", " << setw(10) << static_cast<SizeType>(rate) << " solves/s"
+       << " (SAT: " << sat_num << ")" << endl;
+}
+
+END_NONAMESPACE
+
+int
+small_solve_bench(
+  int argc,
+  char** argv
+)
+{
+  string type = "ymsat2";
+  SizeType n = 100000;
+  SizeType num_threads = 0;
+  if ( argc > 1 ) {
+    type = argv[1];
+  }
+  if ( argc > 2 ) {
+    n = atoi(argv[2]);
+  }
+  if ( argc > 3 ) {
+    num_threads = atoi(argv[3]);
+  }
+
+  {
+    // 毎回デフォルトのパラメータで生成する場合
+    // (type の指定は無視される)
+    auto start = std::chrono::steady_clock::now();
+    SizeType sat_num = 0;
+    for ( SizeType id = 0; id < n; ++ id ) {
+      SatSolver solver;
+      if ( solve_one(id, solver) == SatBool3::True ) {
+	++ sat_num;
+      }
+    }
+    report("new SatSolver{}", n, sat_num, start);
+  }
+  {
+    // パラメータを使い回して毎回生成する場合
+    auto start = std::chrono::steady_clock::now();
+    SatInitParam param{type};
+    SizeType sat_num = 0;
+    for ( SizeType id = 0; id < n; ++ id ) {
+      SatSolver solver{param};
+      if ( solve_one(id, solver) == SatBool3::True ) {
+	++ sat_num;
+      }
+    }
+    report("new SatSolver{param}", n, sat_num, start);
+  }
+  {
+    // 1つのソルバを reset() して使い回す場合
+    auto start = std::chrono::steady_clock::now();
+    SatSolver solver{SatInitParam{type}};
+    SizeType sat_num = 0;
+    for ( SizeType id = 0; id < n; ++ id ) {
+      solver.reset();
+      if ( solve_one(id, solver) == SatBool3::True ) {
+	++ sat_num;
+      }
+    }
+    report("SatSolver::reset()", n, sat_num, start);
+  }
+  {
+    // SatSolverPool を使う場合
+    auto start = std::chrono::steady_clock::now();
+    SatSolverPool pool{SatInitParam{type}, num_threads};
+    vector<SatBool3> ans_list(n);
+    pool.run(n, [&](SizeType id, SatSolver& solver) {
+      ans_list[id] = solve_one(id, solver);
+    });
+    SizeType sat_num = 0;
+    for ( auto ans: ans_list ) {
+      if ( ans == SatBool3::True ) {
+	++ sat_num;
+      }
+    }
+    ostringstream buf;
+    buf << "SatSolverPool(" << pool.thread_num() << ")";
+    report(buf.str().c_str(), n, sat_num, start);
+  }
+
+  return 0;
+}
+
+END_NAMESPACE_YM
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::small_solve_bench(argc, argv);
+}
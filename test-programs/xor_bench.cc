@@ -0,0 +1,108 @@
+
+/// @file xor_bench.cc
+/// @brief add_xor_constraint() を用いた問題を解く時間の計測
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/SatSolver.h"
+#include "ym/SatStats.h"
+#include <chrono>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 入力の順番を変えた2つの XOR の鎖でパリティを計算し，
+// 出力のいずれかが異なるという(充足不能な)問題を解く．
+//
+// 入力数 n の鎖を m 組作る．各組の入力は乱数で選ぶ．
+void
+bench(
+  const SatInitParam& init_param,
+  bool native,
+  SizeType n,
+  SizeType m
+)
+{
+  SatSolver solver{init_param};
+  solver.set_native_xor(native);
+  vector<SatLiteral> input_list(n * 2);
+  for ( auto& lit: input_list ) {
+    lit = solver.new_variable(true);
+  }
+
+  std::mt19937 rg;
+  auto make_chain = [&](const vector<SatLiteral>& lit_list) {
+    auto olit = lit_list[0];
+    for ( SizeType i = 1; i < lit_list.size(); ++ i ) {
+      auto tlit = solver.new_variable(false);
+      solver.add_xor_constraint({olit, lit_list[i], tlit}, false);
+      olit = tlit;
+    }
+    return olit;
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  vector<SatLiteral> diff_list;
+  for ( SizeType j = 0; j < m; ++ j ) {
+    vector<SatLiteral> lit_list(input_list);
+    std::shuffle(lit_list.begin(), lit_list.end(), rg);
+    lit_list.resize(n);
+    auto olit1 = make_chain(lit_list);
+    std::shuffle(lit_list.begin(), lit_list.end(), rg);
+    auto olit2 = make_chain(lit_list);
+    auto dlit = solver.new_variable(false);
+    solver.add_xor_constraint({olit1, olit2, dlit}, false);
+    diff_list.push_back(dlit);
+  }
+  solver.add_clause(diff_list);
+  auto ans = solver.solve();
+  auto end = std::chrono::steady_clock::now();
+  auto usec = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  auto stats = solver.get_stats();
+  cout << (native ? "native" : "cnf   ")
+       << " n = " << setw(3) << n
+       << ", m = " << setw(3) << m
+       << ": " << setw(8) << usec / 1000 << " ms"
+       << ", " << ans
+       << " (" << stats.mConflictNum << " conflicts)" << endl;
+}
+
+END_NONAMESPACE
+
+int
+xor_bench(
+  int argc,
+  char** argv
+)
+{
+  string type = "ymsat2";
+  if ( argc > 1 ) {
+    type = argv[1];
+  }
+  SatInitParam init_param{type};
+
+  for ( SizeType n: {6, 8, 10, 12} ) {
+    for ( auto native: {false, true} ) {
+      bench(init_param, native, n, 4);
+    }
+  }
+
+  return 0;
+}
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return YM_NAMESPACE::xor_bench(argc, argv);
+}